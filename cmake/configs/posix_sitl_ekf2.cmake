@@ -26,6 +26,7 @@ set(config_module_list
 	systemcmds/topic_listener
 	systemcmds/perf
 	modules/uORB
+	modules/stats_export
 	modules/param
 	modules/systemlib
 	modules/systemlib/mixer
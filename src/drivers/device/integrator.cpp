@@ -46,9 +46,13 @@ Integrator::Integrator(uint64_t auto_reset_interval, bool coning_compensation) :
 	_last_integration(0),
 	_last_auto(0),
 	_integral_auto(0.0f, 0.0f, 0.0f),
-	_integral_read(0.0f, 0.0f, 0.0f),
+	_integral_read{0.0, 0.0, 0.0},
 	_last_val(0.0f, 0.0f, 0.0f),
 	_last_delta(0.0f, 0.0f, 0.0f),
+	_last_rate(0.0f, 0.0f, 0.0f),
+	_alpha(0.0f, 0.0f, 0.0f),
+	_beta(0.0f, 0.0f, 0.0f),
+	_last_delta_alpha(0.0f, 0.0f, 0.0f),
 	_auto_callback(nullptr),
 	_coning_comp_on(coning_compensation)
 {
@@ -63,8 +67,6 @@ Integrator::~Integrator()
 bool
 Integrator::put(uint64_t timestamp, math::Vector<3> &val, math::Vector<3> &integral, uint64_t &integral_dt)
 {
-	bool auto_reset = false;
-
 	if (_last_integration == 0) {
 		/* this is the first item in the integrator */
 		_last_integration = timestamp;
@@ -74,7 +76,8 @@ Integrator::put(uint64_t timestamp, math::Vector<3> &val, math::Vector<3> &integ
 	}
 
 	// Integrate
-	double dt = (double)(timestamp - _last_integration) / 1000000.0;
+	uint64_t sample_dt = timestamp - _last_integration;
+	double dt = (double)sample_dt / 1000000.0;
 	math::Vector<3> i = (val + _last_val) * dt * 0.5f;
 
 	// Apply coning compensation if required
@@ -87,42 +90,117 @@ Integrator::put(uint64_t timestamp, math::Vector<3> &val, math::Vector<3> &integ
 		i += ((_integral_auto + _last_delta * (1.0f / 6.0f)) % i) * 0.5f;
 	}
 
-	_integral_auto += i;
-	_integral_read += i;
+	_accumulate(i);
 
 	_last_integration = timestamp;
 	_last_val = val;
 	_last_delta = i;
 
-	if ((timestamp - _last_auto) > _auto_reset_interval) {
-		if (_auto_callback) {
-			/* call the callback */
-			_auto_callback(timestamp, _integral_auto);
-		}
+	if (!_interval_complete(timestamp, sample_dt)) {
+		return false;
+	}
 
-		integral = _integral_auto;
-		integral_dt = (timestamp - _last_auto);
+	_auto_reset(timestamp, integral, integral_dt);
+	return true;
+}
 
-		auto_reset = true;
+bool
+Integrator::put(uint64_t timestamp, math::Vector<3> &val, const math::Vector<3> &rate, math::Vector<3> &integral,
+		uint64_t &integral_dt)
+{
+	if (_last_integration == 0) {
+		/* this is the first item in the integrator */
+		_last_integration = timestamp;
 		_last_auto = timestamp;
-		_integral_auto(0) = 0.0f;
-		_integral_auto(1) = 0.0f;
-		_integral_auto(2) = 0.0f;
+		_last_val = val;
+		_last_rate = rate;
+		return false;
 	}
 
-	return auto_reset;
+	// Integrate
+	uint64_t sample_dt = timestamp - _last_integration;
+	double dt = (double)sample_dt / 1000000.0;
+	math::Vector<3> dv = (val + _last_val) * dt * 0.5f;
+	math::Vector<3> da = (rate + _last_rate) * dt * 0.5f;
+
+	// Sculling compensation, the recursive two-sample form from
+	// Savage (1998) Strapdown Inertial Navigation Integration Algorithm Design Part 2: Velocity and Position Algorithms
+	math::Vector<3> i = dv + ((_alpha % dv) + (_beta % da)) * 0.5f
+			    + ((_last_delta_alpha % dv) + (_last_delta % da)) * (1.0f / 12.0f);
+
+	_accumulate(i);
+
+	_alpha += da;
+	_beta += dv;
+
+	_last_integration = timestamp;
+	_last_val = val;
+	_last_rate = rate;
+	_last_delta = dv;
+	_last_delta_alpha = da;
+
+	if (!_interval_complete(timestamp, sample_dt)) {
+		return false;
+	}
+
+	// Rotation compensation brings the velocity change into the body frame at
+	// the start of the interval
+	_accumulate((_alpha % _beta) * 0.5f);
+	_alpha.zero();
+	_beta.zero();
+
+	_auto_reset(timestamp, integral, integral_dt);
+	return true;
 }
 
 math::Vector<3>
 Integrator::read(bool auto_reset)
 {
-	math::Vector<3> val = _integral_read;
+	math::Vector<3> val((float)_integral_read[0], (float)_integral_read[1], (float)_integral_read[2]);
 
 	if (auto_reset) {
-		_integral_read(0) = 0.0f;
-		_integral_read(1) = 0.0f;
-		_integral_read(2) = 0.0f;
+		_integral_read[0] = 0.0;
+		_integral_read[1] = 0.0;
+		_integral_read[2] = 0.0;
 	}
 
 	return val;
 }
+
+void
+Integrator::_accumulate(const math::Vector<3> &delta)
+{
+	_integral_auto += delta;
+
+	/* reads can be far apart, so keep the precision of the small deltas */
+	_integral_read[0] += (double)delta(0);
+	_integral_read[1] += (double)delta(1);
+	_integral_read[2] += (double)delta(2);
+}
+
+bool
+Integrator::_interval_complete(uint64_t timestamp, uint64_t sample_dt)
+{
+	/*
+	 * Reset on the sample closest to the interval: now, unless the next
+	 * sample, assumed to arrive after another sample_dt, is closer.
+	 */
+	return 2 * (timestamp - _last_auto) + sample_dt >= 2 * _auto_reset_interval;
+}
+
+void
+Integrator::_auto_reset(uint64_t timestamp, math::Vector<3> &integral, uint64_t &integral_dt)
+{
+	if (_auto_callback) {
+		/* call the callback */
+		_auto_callback(timestamp, _integral_auto);
+	}
+
+	integral = _integral_auto;
+	integral_dt = (timestamp - _last_auto);
+
+	_last_auto = timestamp;
+	_integral_auto(0) = 0.0f;
+	_integral_auto(1) = 0.0f;
+	_integral_auto(2) = 0.0f;
+}
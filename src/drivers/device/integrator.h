@@ -36,6 +36,11 @@
  *
  * A resettable integrator
  *
+ * Integrates high rate samples into deltas published at a lower, configurable
+ * rate. Angular rates can be integrated with coning compensation; specific
+ * force can be integrated with sculling and rotation compensation when the
+ * angular rate sampled at the same time is passed along.
+ *
  * @author Lorenz Meier <lorenz@px4.io>
  */
 
@@ -60,6 +65,23 @@ public:
 	 */
 	bool			put(uint64_t timestamp, math::Vector<3> &val, math::Vector<3> &integral, uint64_t &integral_dt);
 
+	/**
+	 * Put a specific force sample into the integral, applying sculling and
+	 * rotation compensation. The resulting delta velocity is expressed in the
+	 * body frame at the start of the integration interval.
+	 *
+	 * Use either this or the plain put() on an integrator, not both.
+	 *
+	 * @param timestamp	Timestamp of the current value
+	 * @param val		Specific force to put
+	 * @param rate		Angular rate sampled together with val
+	 * @param integral	Current integral in case the integrator did reset, else the value will not be modified
+	 * @return		true if putting the item triggered an integral reset
+	 *			and the integral should be published
+	 */
+	bool			put(uint64_t timestamp, math::Vector<3> &val, const math::Vector<3> &rate, math::Vector<3> &integral,
+				    uint64_t &integral_dt);
+
 	/**
 	 * Get the current integral value
 	 *
@@ -80,17 +102,39 @@ public:
 	 */
 	uint64_t		current_integral_start() { return _last_auto; }
 
+	/**
+	 * Set the auto-reset interval, i.e. the output rate. This is independent
+	 * of the sample rate: the integral is published on the sample closest
+	 * to the interval.
+	 *
+	 * @param auto_reset_interval	new interval in microseconds
+	 */
+	void			set_autoreset_interval(uint64_t auto_reset_interval) { _auto_reset_interval = auto_reset_interval; }
+
+	/**
+	 * Get the auto-reset interval in microseconds
+	 */
+	uint64_t		get_autoreset_interval() { return _auto_reset_interval; }
+
 private:
 	uint64_t _auto_reset_interval;		/**< the interval after which the content will be published and the integrator reset */
 	uint64_t _last_integration;			/**< timestamp of the last integration step */
 	uint64_t _last_auto;				/**< last auto-announcement of integral value */
 	math::Vector<3> _integral_auto;			/**< the integrated value which auto-resets after _auto_reset_interval */
-	math::Vector<3> _integral_read;			/**< the integrated value since the last read */
+	double _integral_read[3];			/**< the integrated value since the last read, which may span many intervals */
 	math::Vector<3> _last_val;			/**< previously integrated last value */
 	math::Vector<3> _last_delta;			/**< last local delta */
+	math::Vector<3> _last_rate;			/**< previous angular rate for sculling compensation */
+	math::Vector<3> _alpha;				/**< uncompensated delta angle since the last auto-reset */
+	math::Vector<3> _beta;				/**< uncompensated delta velocity since the last auto-reset */
+	math::Vector<3> _last_delta_alpha;		/**< last local delta angle */
 	void (*_auto_callback)(uint64_t, math::Vector<3>);	/**< the function callback for auto-reset */
 	bool _coning_comp_on;				/**< coning compensation */
 
+	void			_accumulate(const math::Vector<3> &delta);
+	bool			_interval_complete(uint64_t timestamp, uint64_t sample_dt);
+	void			_auto_reset(uint64_t timestamp, math::Vector<3> &integral, uint64_t &integral_dt);
+
 	/* we don't want this class to be copied */
 	Integrator(const Integrator &);
 	Integrator operator=(const Integrator &);
@@ -40,6 +40,36 @@
 #include "ringbuffer.h"
 #include <string.h>
 
+/*
+ * The producer owns _head and the consumer owns _tail, except that force()
+ * moves _tail from the producer side, which is why the consumer claims items
+ * with a compare and swap. Each side stores its index with release semantics
+ * after touching the item memory and loads the other side's index with
+ * acquire semantics before touching it.
+ */
+
+// FIXME - clang crashes on this get() call
+#ifdef __PX4_QURT
+#define __PX4_SBCAP my_sync_bool_compare_and_swap
+static inline bool my_sync_bool_compare_and_swap(volatile unsigned *a, unsigned b, unsigned c)
+{
+	if (*a == b) {
+		*a = c;
+		return true;
+	}
+
+	return false;
+}
+
+#define __PX4_LOAD_ACQUIRE(x)		(x)
+#define __PX4_STORE_RELEASE(x, v)	((x) = (v))
+
+#else
+#define __PX4_SBCAP __sync_bool_compare_and_swap
+#define __PX4_LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define __PX4_STORE_RELEASE(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#endif
+
 namespace ringbuffer
 {
 
@@ -67,13 +97,13 @@ RingBuffer::_next(unsigned index)
 bool
 RingBuffer::empty()
 {
-	return _tail == _head;
+	return __PX4_LOAD_ACQUIRE(_tail) == __PX4_LOAD_ACQUIRE(_head);
 }
 
 bool
 RingBuffer::full()
 {
-	return _next(_head) == _tail;
+	return _next(__PX4_LOAD_ACQUIRE(_head)) == __PX4_LOAD_ACQUIRE(_tail);
 }
 
 unsigned
@@ -93,15 +123,17 @@ RingBuffer::flush()
 bool
 RingBuffer::put(const void *val, size_t val_size)
 {
-	unsigned next = _next(_head);
+	unsigned head = _head;
+	unsigned next = _next(head);
 
-	if (next != _tail) {
+	/* the consumer is done with the slot once it has moved _tail past it */
+	if (next != __PX4_LOAD_ACQUIRE(_tail)) {
 		if ((val_size == 0) || (val_size > _item_size)) {
 			val_size = _item_size;
 		}
 
-		memcpy(&_buf[_head * _item_size], val, val_size);
-		_head = next;
+		memcpy(&_buf[head * _item_size], val, val_size);
+		__PX4_STORE_RELEASE(_head, next);
 		return true;
 
 	} else {
@@ -169,6 +201,34 @@ RingBuffer::put(double val)
 	return put(&val, sizeof(val));
 }
 
+unsigned
+RingBuffer::put_many(const void *vals, unsigned count)
+{
+	const char *in = (const char *)vals;
+	unsigned head = _head;
+	unsigned tail = __PX4_LOAD_ACQUIRE(_tail);
+	unsigned n = 0;
+
+	/* the tail may move on while we copy, which only frees more space */
+	while (n < count) {
+		unsigned next = _next(head);
+
+		if (next == tail) {
+			break;
+		}
+
+		memcpy(&_buf[head * _item_size], &in[n * _item_size], _item_size);
+		head = next;
+		n++;
+	}
+
+	if (n > 0) {
+		__PX4_STORE_RELEASE(_head, head);
+	}
+
+	return n;
+}
+
 bool
 RingBuffer::force(const void *val, size_t val_size)
 {
@@ -246,53 +306,37 @@ RingBuffer::force(double val)
 	return force(&val, sizeof(val));
 }
 
-// FIXME - clang crashes on this get() call
-#ifdef __PX4_QURT
-#define __PX4_SBCAP my_sync_bool_compare_and_swap
-static inline bool my_sync_bool_compare_and_swap(volatile unsigned *a, unsigned b, unsigned c)
-{
-	if (*a == b) {
-		*a = c;
-		return true;
-	}
-
-	return false;
-}
-
-#else
-#define __PX4_SBCAP __sync_bool_compare_and_swap
-#endif
 bool
 RingBuffer::get(void *val, size_t val_size)
 {
-	if (_tail != _head) {
-		unsigned candidate;
-		unsigned next;
+	unsigned candidate;
+	unsigned next;
 
-		if ((val_size == 0) || (val_size > _item_size)) {
-			val_size = _item_size;
-		}
+	if ((val_size == 0) || (val_size > _item_size)) {
+		val_size = _item_size;
+	}
 
-		do {
-			/* decide which element we think we're going to read */
-			candidate = _tail;
+	do {
+		/* decide which element we think we're going to read */
+		candidate = __PX4_LOAD_ACQUIRE(_tail);
 
-			/* and what the corresponding next index will be */
-			next = _next(candidate);
+		/* force() may have emptied the buffer since the last attempt */
+		if (candidate == __PX4_LOAD_ACQUIRE(_head)) {
+			return false;
+		}
 
-			/* go ahead and read from this index */
-			if (val != NULL) {
-				memcpy(val, &_buf[candidate * _item_size], val_size);
-			}
+		/* and what the corresponding next index will be */
+		next = _next(candidate);
 
-			/* if the tail pointer didn't change, we got our item */
-		} while (!__PX4_SBCAP(&_tail, candidate, next));
+		/* go ahead and read from this index */
+		if (val != NULL) {
+			memcpy(val, &_buf[candidate * _item_size], val_size);
+		}
 
-		return true;
+		/* if the tail pointer didn't change, we got our item */
+	} while (!__PX4_SBCAP(&_tail, candidate, next));
 
-	} else {
-		return false;
-	}
+	return true;
 }
 
 bool
@@ -355,6 +399,38 @@ RingBuffer::get(double &val)
 	return get(&val, sizeof(val));
 }
 
+unsigned
+RingBuffer::get_many(void *vals, unsigned count)
+{
+	char *out = (char *)vals;
+	unsigned candidate;
+	unsigned index;
+	unsigned n;
+
+	do {
+		candidate = __PX4_LOAD_ACQUIRE(_tail);
+		unsigned head = __PX4_LOAD_ACQUIRE(_head);
+
+		/* copy out everything up to the head seen, then claim it all at once */
+		index = candidate;
+		n = 0;
+
+		while (n < count && index != head) {
+			memcpy(&out[n * _item_size], &_buf[index * _item_size], _item_size);
+			index = _next(index);
+			n++;
+		}
+
+		if (n == 0) {
+			return 0;
+		}
+
+		/* if force() discarded items meanwhile, the copies may be stale: retry */
+	} while (!__PX4_SBCAP(&_tail, candidate, index));
+
+	return n;
+}
+
 unsigned
 RingBuffer::space(void)
 {
@@ -369,9 +445,9 @@ RingBuffer::space(void)
 	 * re-try the copy.
 	 */
 	do {
-		head = _head;
-		tail = _tail;
-	} while (head != _head);
+		head = __PX4_LOAD_ACQUIRE(_head);
+		tail = __PX4_LOAD_ACQUIRE(_tail);
+	} while (head != __PX4_LOAD_ACQUIRE(_head));
 
 	return (tail >= head) ? (_num_items - (tail - head)) : (head - tail - 1);
 }
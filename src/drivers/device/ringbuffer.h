@@ -35,6 +35,12 @@
  * @file ringbuffer.h
  *
  * A flexible ringbuffer class.
+ *
+ * The buffer is lock-free for one producer and one consumer, which may run
+ * in different threads or in interrupt context. The producer publishes items
+ * with release semantics and the consumer acquires them, so this also holds
+ * on SMP targets with weak memory ordering. force() may discard items from
+ * the producer side while the consumer is reading.
  */
 
 #pragma once
@@ -71,6 +77,16 @@ public:
 	bool			put(float val);
 	bool			put(double val);
 
+	/**
+	 * Put several items into the buffer, making them visible to the consumer
+	 * all at once.
+	 *
+	 * @param vals		Array of count items of the buffer's item size
+	 * @param count		Number of items to put
+	 * @return		Number of items put, less than count if the buffer became full
+	 */
+	unsigned		put_many(const void *vals, unsigned count);
+
 	/**
 	 * Force an item into the buffer, discarding an older item if there is not space.
 	 *
@@ -109,6 +125,15 @@ public:
 	bool			get(float &val);
 	bool			get(double &val);
 
+	/**
+	 * Get several items from the buffer, oldest first.
+	 *
+	 * @param vals		Array for up to count items of the buffer's item size
+	 * @param count		Maximum number of items to get
+	 * @return		Number of items got, 0 if the buffer was empty
+	 */
+	unsigned		get_many(void *vals, unsigned count);
+
 	/*
 	 * Get the number of slots free in the buffer.
 	 *
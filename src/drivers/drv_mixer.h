@@ -109,6 +109,52 @@ struct mixer_simple_s {
  */
 #define MIXERIOCLOADBUF		_MIXERIOC(5)
 
+/*
+ * Binary mixer definitions.
+ *
+ * A binary image is generated from the text form by mixer_binary.py and
+ * consists of a header followed by record_count records. Each record is a
+ * record header followed by a payload laid out exactly like the matching
+ * in-memory structure on all supported targets (little-endian, IEEE
+ * single precision, natural alignment), so loading is validation plus
+ * memcpy. The checksum is crc32part() over everything after the header.
+ */
+#define MIXER_BINARY_MAGIC	0x584d5850	/**< "PXMX" */
+#define MIXER_BINARY_VERSION	1
+
+struct mixer_binary_header_s {
+	uint32_t		magic;		/**< MIXER_BINARY_MAGIC */
+	uint16_t		version;	/**< MIXER_BINARY_VERSION */
+	uint16_t		record_count;	/**< number of records following the header */
+	uint32_t		length;		/**< total image length, including this header */
+	uint32_t		crc;		/**< crc32part() of the records */
+};
+
+struct mixer_binary_record_s {
+	uint8_t			type;		/**< mixer tag as in the text form: 'Z', 'M' or 'R' */
+	uint8_t			reserved;
+	uint16_t		length;		/**< payload length, a multiple of four */
+};
+
+/**
+ * Multirotor mixer record payload. Simple mixers use struct mixer_simple_s
+ * and null mixers have no payload.
+ */
+struct mixer_multirotor_s {
+	char			geometry[4];	/**< geometry name as in the text form, NUL terminated */
+	float			roll_scale;
+	float			pitch_scale;
+	float			yaw_scale;
+	float			idle_speed;
+};
+
+/**
+ * Add mixer(s) from the binary image in (const struct mixer_binary_header_s *)arg.
+ *
+ * The image length is taken from the header.
+ */
+#define MIXERIOCLOADBIN		_MIXERIOC(6)
+
 /*
  * XXX Thoughts for additional operations:
  *
@@ -95,7 +95,8 @@ UBX::UBX(const int &fd, struct vehicle_gps_position_s *gps_position, struct sate
 	_disable_cmd_last(0),
 	_ack_waiting_msg(0),
 	_ubx_version(0),
-	_use_nav_pvt(false)
+	_use_nav_pvt(false),
+	_replay(false)
 {
 	decode_init();
 }
@@ -331,10 +332,7 @@ UBX::receive(const unsigned timeout)
 			UBX_DEBUG("read %d bytes", ret);
 
 			/* pass received bytes to the packet decoder */
-			for (int i = 0; i < ret; i++) {
-				handled |= parse_char(buf[i]);
-				UBX_DEBUG("parsed %d: 0x%x", i, buf[i]);
-			}
+			handled |= parse(buf, ret);
 		}
 
 		/* abort after timeout if no useful packets received */
@@ -478,6 +476,68 @@ UBX::parse_char(const uint8_t b)
 	return ret;
 }
 
+void
+UBX::set_replay_mode(bool use_nav_pvt)
+{
+	_configured = true;
+	_use_nav_pvt = use_nav_pvt;
+	_replay = true;
+}
+
+int	// bitwise OR of the parse_char() results
+UBX::parse(const uint8_t *buf, unsigned len)
+{
+	const uint8_t *p = buf;
+	const uint8_t *end = buf + len;
+	int ret = 0;
+
+	while (p < end) {
+		switch (_decode_state) {
+
+		/* Expecting Sync1: skip everything up to it in one go */
+		case UBX_DECODE_SYNC1: {
+				const uint8_t *sync = (const uint8_t *)memchr(p, UBX_SYNC1, end - p);
+
+				if (sync == nullptr) {
+					return ret;
+				}
+
+				UBX_TRACE_PARSER("A");
+				_decode_state = UBX_DECODE_SYNC2;
+				p = sync + 1;
+				break;
+			}
+
+		/* Expecting payload: checksum and copy as much of it as is available */
+		case UBX_DECODE_PAYLOAD:
+			if (_rx_msg != UBX_MSG_NAV_SVINFO && _rx_msg != UBX_MSG_MON_VER) {
+				unsigned count = MIN((unsigned)(end - p), (unsigned)(_rx_payload_length - _rx_payload_index));
+
+				UBX_TRACE_PARSER(".");
+				add_bytes_to_checksum(p, count);
+				memcpy(&_buf.raw[_rx_payload_index], p, count);
+				_rx_payload_index += count;
+				p += count;
+
+				if (_rx_payload_index >= _rx_payload_length) {
+					// payload complete, expecting checksum
+					_decode_state = UBX_DECODE_CHKSUM1;
+				}
+
+				break;
+			}
+
+		/* NAV-SVINFO and MON-VER payloads are decoded as they arrive, fall through */
+
+		default:
+			ret |= parse_char(*p++);
+			break;
+		}
+	}
+
+	return ret;
+}
+
 /**
  * Start payload rx
  */
@@ -841,7 +901,7 @@ UBX::payload_rx_done(void)
 				ts.tv_sec = epoch;
 				ts.tv_nsec = _buf.payload_rx_nav_pvt.nano;
 
-				if (clock_settime(CLOCK_REALTIME, &ts)) {
+				if (!_replay && clock_settime(CLOCK_REALTIME, &ts)) {
 					warn("failed setting clock");
 				}
 
@@ -939,7 +999,7 @@ UBX::payload_rx_done(void)
 				ts.tv_sec = epoch;
 				ts.tv_nsec = _buf.payload_rx_nav_timeutc.nano;
 
-				if (clock_settime(CLOCK_REALTIME, &ts)) {
+				if (!_replay && clock_settime(CLOCK_REALTIME, &ts)) {
 					warn("failed setting clock");
 				}
 
@@ -1064,6 +1124,21 @@ UBX::add_byte_to_checksum(const uint8_t b)
 	_rx_ck_b = _rx_ck_b + _rx_ck_a;
 }
 
+void
+UBX::add_bytes_to_checksum(const uint8_t *buf, unsigned len)
+{
+	uint8_t ck_a = _rx_ck_a;
+	uint8_t ck_b = _rx_ck_b;
+
+	for (unsigned i = 0; i < len; i++) {
+		ck_a += buf[i];
+		ck_b += ck_a;
+	}
+
+	_rx_ck_a = ck_a;
+	_rx_ck_b = ck_b;
+}
+
 void
 UBX::calc_checksum(const uint8_t *buffer, const uint16_t length, ubx_checksum_t *checksum)
 {
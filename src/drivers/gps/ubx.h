@@ -495,13 +495,30 @@ public:
 	int			receive(const unsigned timeout);
 	int			configure(unsigned &baudrate);
 
-private:
+	/**
+	 * Parse a block of received bytes
+	 *
+	 * Scans for sync and checksums and copies payloads as a whole instead of
+	 * going through parse_char() for every byte. The result is the same as
+	 * feeding the bytes to parse_char() one by one.
+	 *
+	 * @return bitwise OR of the parse_char() results for the block
+	 */
+	int			parse(const uint8_t *buf, unsigned len);
 
 	/**
 	 * Parse the binary UBX packet
 	 */
 	int			parse_char(const uint8_t b);
 
+	/**
+	 * Decode as if configure() had succeeded, for replaying recorded streams
+	 * without a receiver attached. The system clock is left alone.
+	 */
+	void			set_replay_mode(bool use_nav_pvt);
+
+private:
+
 	/**
 	 * Start payload rx
 	 */
@@ -529,6 +546,11 @@ private:
 	 */
 	void			add_byte_to_checksum(const uint8_t);
 
+	/**
+	 * Add a block of payload bytes to the checksum
+	 */
+	void			add_bytes_to_checksum(const uint8_t *buf, unsigned len);
+
 	/**
 	 * Send a message
 	 */
@@ -573,6 +595,7 @@ private:
 	ubx_buf_t		_buf;
 	uint32_t		_ubx_version;
 	bool			_use_nav_pvt;
+	bool			_replay;
 };
 
 #endif /* UBX_H_ */
@@ -69,7 +69,7 @@
 #include <drivers/device/integrator.h>
 
 #include <board_config.h>
-#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
 #include <lib/conversion/rotation.h>
 
 #define L3GD20_DEVICE_PATH "/dev/l3gd20"
@@ -255,9 +255,7 @@ private:
 
 	uint8_t			_register_wait;
 
-	math::LowPassFilter2p	_gyro_filter_x;
-	math::LowPassFilter2p	_gyro_filter_y;
-	math::LowPassFilter2p	_gyro_filter_z;
+	math::LowPassFilter2pBank<3>	_gyro_filter;
 
 	Integrator		_gyro_int;
 
@@ -432,9 +430,7 @@ L3GD20::L3GD20(int bus, const char *path, spi_dev_e device, enum Rotation rotati
 	_bad_registers(perf_alloc(PC_COUNT, "l3gd20_bad_reg")),
 	_duplicates(perf_alloc(PC_COUNT, "l3gd20_dupe")),
 	_register_wait(0),
-	_gyro_filter_x(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
-	_gyro_filter_y(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
-	_gyro_filter_z(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
+	_gyro_filter(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
 	_gyro_int(1000000 / L3GD20_MAX_OUTPUT_RATE, true),
 	_is_l3g4200d(false),
 	_rotation(rotation),
@@ -641,7 +637,7 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 					_call.period = _call_interval - L3GD20_TIMER_REDUCTION;
 
 					/* adjust filters */
-					float cutoff_freq_hz = _gyro_filter_x.get_cutoff_freq();
+					float cutoff_freq_hz = _gyro_filter.get_cutoff_freq();
 					float sample_rate = 1.0e6f / ticks;
 					set_driver_lowpass_filter(sample_rate, cutoff_freq_hz);
 
@@ -702,7 +698,7 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 		}
 
 	case GYROIOCGLOWPASS:
-		return static_cast<int>(_gyro_filter_x.get_cutoff_freq());
+		return static_cast<int>(_gyro_filter.get_cutoff_freq());
 
 	case GYROIOCSSCALE:
 		/* copy scale in */
@@ -900,9 +896,7 @@ L3GD20::set_samplerate(unsigned frequency, unsigned bandwidth)
 void
 L3GD20::set_driver_lowpass_filter(float samplerate, float bandwidth)
 {
-	_gyro_filter_x.set_cutoff_frequency(samplerate, bandwidth);
-	_gyro_filter_y.set_cutoff_frequency(samplerate, bandwidth);
-	_gyro_filter_z.set_cutoff_frequency(samplerate, bandwidth);
+	_gyro_filter.set_cutoff_frequency(samplerate, bandwidth);
 }
 
 void
@@ -1120,9 +1114,11 @@ L3GD20::measure()
 	float yin = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
 	float zin = ((zraw_f * _gyro_range_scale) - _gyro_scale.z_offset) * _gyro_scale.z_scale;
 
-	report.x = _gyro_filter_x.apply(xin);
-	report.y = _gyro_filter_y.apply(yin);
-	report.z = _gyro_filter_z.apply(zin);
+	float gyro_filtered[3] = {xin, yin, zin};
+	_gyro_filter.apply(gyro_filtered);
+	report.x = gyro_filtered[0];
+	report.y = gyro_filtered[1];
+	report.z = gyro_filtered[2];
 
 	math::Vector<3> gval(xin, yin, zin);
 	math::Vector<3> gval_integrated;
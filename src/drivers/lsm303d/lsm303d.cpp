@@ -68,7 +68,7 @@
 #include <drivers/device/integrator.h>
 
 #include <board_config.h>
-#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
 #include <lib/conversion/rotation.h>
 
 /* oddly, ERROR is not defined for c++ */
@@ -305,9 +305,7 @@ private:
 
 	uint8_t			_register_wait;
 
-	math::LowPassFilter2p	_accel_filter_x;
-	math::LowPassFilter2p	_accel_filter_y;
-	math::LowPassFilter2p	_accel_filter_z;
+	math::LowPassFilter2pBank<3>	_accel_filter;
 
 	Integrator		_accel_int;
 
@@ -579,9 +577,7 @@ LSM303D::LSM303D(int bus, const char *path, spi_dev_e device, enum Rotation rota
 	_bad_values(perf_alloc(PC_COUNT, "lsm303d_bad_val")),
 	_accel_duplicates(perf_alloc(PC_COUNT, "lsm303d_acc_dupe")),
 	_register_wait(0),
-	_accel_filter_x(LSM303D_ACCEL_DEFAULT_RATE, LSM303D_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
-	_accel_filter_y(LSM303D_ACCEL_DEFAULT_RATE, LSM303D_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
-	_accel_filter_z(LSM303D_ACCEL_DEFAULT_RATE, LSM303D_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
+	_accel_filter(LSM303D_ACCEL_DEFAULT_RATE, LSM303D_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
 	_accel_int(1000000 / LSM303D_ACCEL_MAX_OUTPUT_RATE, true),
 	_rotation(rotation),
 	_constant_accel_count(0),
@@ -897,7 +893,7 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 					}
 
 					/* adjust filters */
-					accel_set_driver_lowpass_filter((float)arg, _accel_filter_x.get_cutoff_freq());
+					accel_set_driver_lowpass_filter((float)arg, _accel_filter.get_cutoff_freq());
 
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
@@ -958,7 +954,7 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 		}
 
 	case ACCELIOCGLOWPASS:
-		return static_cast<int>(_accel_filter_x.get_cutoff_freq());
+		return static_cast<int>(_accel_filter.get_cutoff_freq());
 
 	case ACCELIOCSSCALE: {
 			/* copy scale, but only if off by a few percent */
@@ -1368,9 +1364,7 @@ LSM303D::accel_set_onchip_lowpass_filter_bandwidth(unsigned bandwidth)
 int
 LSM303D::accel_set_driver_lowpass_filter(float samplerate, float bandwidth)
 {
-	_accel_filter_x.set_cutoff_frequency(samplerate, bandwidth);
-	_accel_filter_y.set_cutoff_frequency(samplerate, bandwidth);
-	_accel_filter_z.set_cutoff_frequency(samplerate, bandwidth);
+	_accel_filter.set_cutoff_frequency(samplerate, bandwidth);
 
 	return OK;
 }
@@ -1649,9 +1643,11 @@ LSM303D::measure()
 	_last_accel[1] = y_in_new;
 	_last_accel[2] = z_in_new;
 
-	accel_report.x = _accel_filter_x.apply(x_in_new);
-	accel_report.y = _accel_filter_y.apply(y_in_new);
-	accel_report.z = _accel_filter_z.apply(z_in_new);
+	float accel_filtered[3] = {x_in_new, y_in_new, z_in_new};
+	_accel_filter.apply(accel_filtered);
+	accel_report.x = accel_filtered[0];
+	accel_report.y = accel_filtered[1];
+	accel_report.z = accel_filtered[2];
 
 	math::Vector<3> aval(x_in_new, y_in_new, z_in_new);
 	math::Vector<3> aval_integrated;
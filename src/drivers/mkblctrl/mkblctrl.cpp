@@ -1068,10 +1068,8 @@ MK::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 			break;
 		}
 
-	case MIXERIOCLOADBUF: {
-			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
-
+	case MIXERIOCLOADBUF:
+	case MIXERIOCLOADBIN: {
 			if (_mixers == nullptr) {
 				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
 			}
@@ -1081,7 +1079,15 @@ MK::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 			} else {
 
-				ret = _mixers->load_from_buf(buf, buflen);
+				if (cmd == MIXERIOCLOADBIN) {
+					const mixer_binary_header_s *image = (const mixer_binary_header_s *)arg;
+					ret = _mixers->load_from_binary(image, image->length);
+
+				} else {
+					const char *buf = (const char *)arg;
+					unsigned buflen = strnlen(buf, 1024);
+					ret = _mixers->load_from_buf(buf, buflen);
+				}
 
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
@@ -87,12 +87,8 @@ private:
 	uint8_t			_register_wait;
 	uint64_t		_reset_wait;
 
-	math::LowPassFilter2p	_accel_filter_x;
-	math::LowPassFilter2p	_accel_filter_y;
-	math::LowPassFilter2p	_accel_filter_z;
-	math::LowPassFilter2p	_gyro_filter_x;
-	math::LowPassFilter2p	_gyro_filter_y;
-	math::LowPassFilter2p	_gyro_filter_z;
+	math::LowPassFilter2pBank<3>	_accel_filter;
+	math::LowPassFilter2pBank<3>	_gyro_filter;
 
 	Integrator		_accel_int;
 	Integrator		_gyro_int;
@@ -782,10 +782,8 @@ PWMSim::pwm_ioctl(device::file_t *filp, int cmd, unsigned long arg)
 			break;
 		}
 
-	case MIXERIOCLOADBUF: {
-			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
-
+	case MIXERIOCLOADBUF:
+	case MIXERIOCLOADBIN: {
 			if (_mixers == nullptr) {
 				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
 			}
@@ -796,7 +794,15 @@ PWMSim::pwm_ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 			} else {
 
-				ret = _mixers->load_from_buf(buf, buflen);
+				if (cmd == MIXERIOCLOADBIN) {
+					const mixer_binary_header_s *image = (const mixer_binary_header_s *)arg;
+					ret = _mixers->load_from_binary(image, image->length);
+
+				} else {
+					const char *buf = (const char *)arg;
+					unsigned buflen = strnlen(buf, 1024);
+					ret = _mixers->load_from_buf(buf, buflen);
+				}
 
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
@@ -807,6 +813,9 @@ PWMSim::pwm_ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 				} else {
 					_mixers->groups_required(_groups_required);
+
+					/* on failure the mixer list is used uncompiled */
+					_mixers->compile();
 				}
 			}
 
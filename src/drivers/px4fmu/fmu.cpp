@@ -64,6 +64,7 @@
 #include <board_config.h>
 
 #include <systemlib/systemlib.h>
+#include <systemlib/scheduling_priorities.h>
 #include <systemlib/err.h>
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/pwm_limit/pwm_limit.h>
@@ -78,6 +79,7 @@
 #include <lib/rc/st24.h>
 #include <lib/rc/sumd.h>
 #include <lib/rc/srxl.h>
+#include <lib/rc/rc_decode.h>
 
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_controls_0.h>
@@ -95,8 +97,11 @@
 #endif
 
 #include <systemlib/circuit_breaker.h>
+#include <systemlib/latency_trace.h>
+#include <systemlib/perf_counter.h>
 
 #define SCHEDULE_INTERVAL	2000	/**< The schedule interval in usec (500 Hz) */
+#define OUTPUT_POLL_TIMEOUT	100	/**< Output task wait for actuator controls in ms, bounds the reaction to mixer changes */
 #define NAN_VALUE	(0.0f/0.0f)		/**< NaN value for throttle lock mode */
 #define BUTTON_SAFETY	stm32_gpioread(GPIO_BTN_SAFETY)
 #define CYCLE_COUNT 10			/* safety switch must be held for 1 second to activate */
@@ -172,6 +177,7 @@ private:
 
 	hrt_abstime _rc_scan_begin = 0;
 	bool _rc_scan_locked = false;
+	unsigned _rc_scan_decoders = RC_DECODERS_115200;	///< decoders run by the 115200 baud scan states
 	bool _report_lock = true;
 
 	hrt_abstime _cycle_timestamp = 0;
@@ -186,6 +192,10 @@ private:
 	uint8_t		_pwm_clock;
 	unsigned	_current_update_rate;
 	struct work_s	_work;
+	volatile px4_task_t	_output_task;	/**< task running the output stage, -1 if not running */
+	volatile bool	_output_task_should_exit;
+	sem_t		_output_lock;	/**< held by the output task while mixing, guards the mixers and the PWM state */
+	perf_counter_t	_perf_control_latency;
 	int		_armed_sub;
 	int		_param_sub;
 	int		_safety_sub;
@@ -238,6 +248,11 @@ private:
 
 	static void	cycle_trampoline(void *arg);
 	void		cycle();
+	static void	output_task_trampoline(int argc, char *argv[]);
+	void		output_task();
+	void		update_outputs();
+	void		output_lock() { do {} while (sem_wait(&_output_lock) != 0); }
+	void		output_unlock() { sem_post(&_output_lock); }
 	void		work_start();
 	void		work_stop();
 
@@ -448,6 +463,9 @@ PX4FMU::PX4FMU() :
 	_pwm_clock(1),
 	_current_update_rate(0),
 	_work{},
+	_output_task(-1),
+	_output_task_should_exit(false),
+	_perf_control_latency(perf_alloc(PC_ELAPSED_HIST, "fmu control latency")),
 	_armed_sub(-1),
 	_param_sub(-1),
 	_safety_sub(-1),
@@ -495,6 +513,8 @@ PX4FMU::PX4FMU() :
 	memset(_controls, 0, sizeof(_controls));
 	memset(_poll_fds, 0, sizeof(_poll_fds));
 
+	sem_init(&_output_lock, 0, 1);
+
 	// rc input, published to ORB
 	memset(&_rc_in, 0, sizeof(_rc_in));
 	_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_PPM;
@@ -532,6 +552,9 @@ PX4FMU::~PX4FMU()
 	/* clean up the alternate device node */
 	unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
+	perf_free(_perf_control_latency);
+	sem_destroy(&_output_lock);
+
 	g_fmu = nullptr;
 }
 
@@ -652,6 +675,9 @@ PX4FMU::set_mode(Mode mode)
 {
 	unsigned old_mask = _pwm_mask;
 
+	/* the output task must not mix or set outputs while the mode changes */
+	output_lock();
+
 	/*
 	 * Configure for PWM output.
 	 *
@@ -741,11 +767,13 @@ PX4FMU::set_mode(Mode mode)
 		break;
 
 	default:
+		output_unlock();
 		return -EINVAL;
 	}
 
 	_mode = mode;
 	_pwm_alt_rate_channels &= _pwm_mask;
+	output_unlock();
 	return OK;
 }
 
@@ -1024,6 +1052,9 @@ PX4FMU::update_pwm_out_state(void)
 	}
 	_pwm_on = pwm_on;
 
+	/* the output task must not set outputs while the timers are reconfigured */
+	output_lock();
+
 	if (_pwm_on && !_pwm_initialized && _pwm_mask != 0) {
 		up_pwm_servo_init(_pwm_mask);
 		set_pwm_rate(_pwm_alt_rate_channels, _pwm_default_rate, _pwm_alt_rate);
@@ -1034,6 +1065,8 @@ PX4FMU::update_pwm_out_state(void)
 	}
 
 	up_pwm_servo_arm(_pwm_on);
+
+	output_unlock();
 }
 
 void
@@ -1062,170 +1095,24 @@ PX4FMU::cycle()
 #endif
 #endif
 
-		_initialized = true;
-	}
-
-	if (_safety_sub == -1) {
-		_safety_sub = orb_subscribe(ORB_ID(safety));
-	}
-
-	if (_groups_subscribed != _groups_required) {
-		subscribe();
-		_groups_subscribed = _groups_required;
-		/* force setting update rate */
-		_current_update_rate = 0;
-	}
-
-	/*
-	 * Adjust actuator topic update rate to keep up with
-	 * the highest servo update rate configured.
-	 *
-	 * We always mix at max rate; some channels may update slower.
-	 */
-	unsigned max_rate = (_pwm_default_rate > _pwm_alt_rate) ? _pwm_default_rate : _pwm_alt_rate;
-
-	if (_current_update_rate != max_rate) {
-		_current_update_rate = max_rate;
-		int update_rate_in_ms = int(1000 / _current_update_rate);
+		/* the output stage runs in its own task, woken by actuator control publications */
+		_output_task_should_exit = false;
+		_output_task = px4_task_spawn_cmd("fmu_out",
+						  SCHED_DEFAULT,
+						  SCHED_PRIORITY_ACTUATOR_OUTPUTS,
+						  1800,
+						  (main_t)&PX4FMU::output_task_trampoline,
+						  nullptr);
 
-		/* reject faster than 500 Hz updates */
-		if (update_rate_in_ms < 2) {
-			update_rate_in_ms = 2;
+		if (_output_task < 0) {
+			DEVICE_LOG("output task start failed: %d", errno);
 		}
 
-		/* reject slower than 10 Hz updates */
-		if (update_rate_in_ms > 100) {
-			update_rate_in_ms = 100;
-		}
-
-		DEVICE_DEBUG("adjusted actuator update interval to %ums", update_rate_in_ms);
-
-		for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
-			if (_control_subs[i] > 0) {
-				orb_set_interval(_control_subs[i], update_rate_in_ms);
-			}
-		}
-
-		// set to current max rate, even if we are actually checking slower/faster
-		_current_update_rate = max_rate;
+		_initialized = true;
 	}
 
-	/* check if anything updated */
-	int ret = ::poll(_poll_fds, _poll_fds_num, 0);
-
-	/* log if main actuator updated and sync */
-	int main_out_latency = 0;
-
-	/* this would be bad... */
-	if (ret < 0) {
-		DEVICE_LOG("poll error %d", errno);
-
-	} else if (ret == 0) {
-		/* timeout: no control data, switch to failsafe values */
-//			warnx("no PWM: failsafe");
-
-	} else {
-
-		/* get controls for required topics */
-		unsigned poll_id = 0;
-
-		for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
-			if (_control_subs[i] > 0) {
-				if (_poll_fds[poll_id].revents & POLLIN) {
-					orb_copy(_control_topics[i], _control_subs[i], &_controls[i]);
-
-					/* main outputs */
-					if (i == 0) {
-//						main_out_latency = hrt_absolute_time() - _controls[i].timestamp - 250;
-//						warnx("lat: %llu", hrt_absolute_time() - _controls[i].timestamp);
-
-						/* do only correct within the current phase */
-						if (abs(main_out_latency) > SCHEDULE_INTERVAL) {
-							main_out_latency = SCHEDULE_INTERVAL;
-						}
-
-						if (main_out_latency < 250) {
-							main_out_latency = 0;
-						}
-					}
-				}
-
-				poll_id++;
-			}
-		}
-
-		/* can we mix? */
-		if (_mixers != nullptr) {
-
-			size_t num_outputs;
-
-			switch (_mode) {
-			case MODE_2PWM:
-			case MODE_2PWM2CAP:
-				num_outputs = 2;
-				break;
-
-			case MODE_3PWM:
-			case MODE_3PWM1CAP:
-				num_outputs = 3;
-				break;
-
-			case MODE_4PWM:
-				num_outputs = 4;
-				break;
-
-			case MODE_6PWM:
-				num_outputs = 6;
-				break;
-
-			case MODE_8PWM:
-				num_outputs = 8;
-				break;
-
-			case MODE_10PWM:
-				num_outputs = 10;
-				break;
-
-			case MODE_12PWM:
-				num_outputs = 12;
-				break;
-
-			default:
-				num_outputs = 0;
-				break;
-			}
-
-			/* do mixing */
-			float outputs[_max_actuators];
-			num_outputs = _mixers->mix(outputs, num_outputs, NULL);
-
-			/* disable unused ports by setting their output to NaN */
-			for (size_t i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++) {
-				if (i >= num_outputs) {
-					outputs[i] = NAN_VALUE;
-				}
-			}
-
-			uint16_t pwm_limited[_max_actuators];
-
-			/* the PWM limit call takes care of out of band errors, NaN and constrains */
-			pwm_limit_calc(_throttle_armed, arm_nothrottle(), num_outputs, _reverse_pwm_mask, _disarmed_pwm, _min_pwm, _max_pwm,
-				       outputs, pwm_limited, &_pwm_limit);
-
-			/* overwrite outputs in case of lockdown with disarmed PWM values */
-			if (_armed.lockdown) {
-				for (size_t i = 0; i < num_outputs; i++) {
-					pwm_limited[i] = _disarmed_pwm[i];
-				}
-			}
-
-			/* output to the servos */
-			for (size_t i = 0; i < num_outputs; i++) {
-				pwm_output_set(i, pwm_limited[i]);
-			}
-
-			publish_pwm_outputs(pwm_limited, num_outputs);
-		}
+	if (_safety_sub == -1) {
+		_safety_sub = orb_subscribe(ORB_ID(safety));
 	}
 
 	_cycle_timestamp = hrt_absolute_time();
@@ -1327,14 +1214,13 @@ PX4FMU::cycle()
 
 #ifdef RC_SERIAL_PORT
 	// This block scans for a supported serial RC input and locks onto the first one found
-	// Scan for 200 msec, then switch protocol
+	// Scan for 200 msec, then switch protocol. Protocols sharing a port setup are scanned together
 	constexpr hrt_abstime rc_scan_max = 200 * 1000;
 
 	bool sbus_failsafe, sbus_frame_drop;
 	uint16_t raw_rc_values[input_rc_s::RC_INPUT_MAX_CHANNELS];
 	uint16_t raw_rc_count;
 	unsigned frame_drops;
-	bool dsm_11_bit;
 
 
 	if (_report_lock && _rc_scan_locked) {
@@ -1378,85 +1264,9 @@ PX4FMU::cycle()
 		break;
 
 	case RC_SCAN_ST24:
-		if (_rc_scan_begin == 0) {
-			_rc_scan_begin = _cycle_timestamp;
-			// Configure serial port for DSM
-			dsm_config(_rcs_fd);
-			rc_io_invert(false);
-
-		} else if (_rc_scan_locked
-			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
-
-			if (newBytes > 0) {
-				// parse new data
-				uint8_t st24_rssi, rx_count;
-
-				rc_updated = false;
-
-				for (unsigned i = 0; i < (unsigned)newBytes; i++) {
-					/* set updated flag if one complete packet was parsed */
-					st24_rssi = RC_INPUT_RSSI_MAX;
-					rc_updated = (OK == st24_decode(_rcs_buf[i], &st24_rssi, &rx_count,
-									&raw_rc_count, raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS));
-				}
-
-				if (rc_updated) {
-					// we have a new ST24 frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_ST24;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, false, frame_drops, st24_rssi);
-					_rc_scan_locked = true;
-				}
-			}
-
-		} else {
-			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_SUMD);
-		}
-
-		break;
-
 	case RC_SCAN_SUMD:
-		if (_rc_scan_begin == 0) {
-			_rc_scan_begin = _cycle_timestamp;
-			// Configure serial port for DSM
-			dsm_config(_rcs_fd);
-			rc_io_invert(false);
-
-		} else if (_rc_scan_locked
-			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
-
-			if (newBytes > 0) {
-				// parse new data
-				uint8_t sumd_rssi, rx_count;
-
-				rc_updated = false;
-
-				for (unsigned i = 0; i < (unsigned)newBytes; i++) {
-					/* set updated flag if one complete packet was parsed */
-					sumd_rssi = RC_INPUT_RSSI_MAX;
-					rc_updated = (OK == sumd_decode(_rcs_buf[i], &sumd_rssi, &rx_count,
-									&raw_rc_count, raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS));
-				}
-
-				if (rc_updated) {
-					// we have a new SUMD frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SUMD;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, false, frame_drops, sumd_rssi);
-					_rc_scan_locked = true;
-				}
-			}
-
-		} else {
-			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_SRXL);
-		}
-
-		break;
-
-
 	case RC_SCAN_SRXL:
+	case RC_SCAN_DSM:
 		if (_rc_scan_begin == 0) {
 			_rc_scan_begin = _cycle_timestamp;
 			// Configure serial port for 115200, not inverted
@@ -1467,56 +1277,38 @@ PX4FMU::cycle()
 			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
 
 			if (newBytes > 0) {
-				// parse new data
-				rc_updated = false;
-                                uint8_t srxl_chan_count;
-				bool failsafe_state;
-                                
-				for (unsigned i = 0; i < (unsigned)newBytes; i++) {
-					/* set updated flag if one complete packet was parsed */
-					rc_updated = (OK == srxl_decode(_cycle_timestamp, _rcs_buf[i],
-									&srxl_chan_count, raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS, &failsafe_state));
-				}
+				// ST24, SUMD, SRXL and DSM share the port setup, so they all try the same
+				// bytes until one of them decodes a frame and the scan locks onto it
+				rc_decode_s rc_decoded;
+				rc_updated = rc_decode(_cycle_timestamp, &_rcs_buf[0], newBytes, _rc_scan_decoders,
+						       raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS, &rc_decoded) != 0;
 
 				if (rc_updated) {
-					// we have a new SRXL frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SRXL;
-
-					fill_rc_in(srxl_chan_count, raw_rc_values, _cycle_timestamp,
-						   false, failsafe_state, 0);
-					_rc_scan_locked = true;
-				}
-			}
-
-		} else {
-			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_DSM);
-		}
-
-		break;
-
-	case RC_SCAN_DSM:
-		if (_rc_scan_begin == 0) {
-			_rc_scan_begin = _cycle_timestamp;
-			// Configure serial port for DSM
-			dsm_config(_rcs_fd);
-			rc_io_invert(false);
-
-		} else if (_rc_scan_locked
-			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
-
-			rc_io_invert(false);
-
-			if (newBytes > 0 && newBytes <= 16) {
-				// parse new data
-				rc_updated = dsm_parse(_cycle_timestamp, &_rcs_buf[0], newBytes, &raw_rc_values[0], &raw_rc_count,
-						       &dsm_11_bit, &frame_drops, input_rc_s::RC_INPUT_MAX_CHANNELS);
+					switch (rc_decoded.decoder) {
+					case RC_DECODER_ST24:
+						_rc_scan_state = RC_SCAN_ST24;
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_ST24;
+						break;
+
+					case RC_DECODER_SUMD:
+						_rc_scan_state = RC_SCAN_SUMD;
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SUMD;
+						break;
+
+					case RC_DECODER_SRXL:
+						_rc_scan_state = RC_SCAN_SRXL;
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SRXL;
+						break;
+
+					default:
+						_rc_scan_state = RC_SCAN_DSM;
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_DSM;
+						break;
+					}
 
-				if (rc_updated) {
-					// we have a new DSM frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_DSM;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, false, frame_drops);
+					fill_rc_in(rc_decoded.num_values, raw_rc_values, _cycle_timestamp,
+						   rc_decoded.frame_drop, rc_decoded.failsafe, rc_decoded.frame_drops, rc_decoded.rssi);
+					_rc_scan_decoders = RC_DECODER_MASK(rc_decoded.decoder);
 					_rc_scan_locked = true;
 				}
 			}
@@ -1527,7 +1319,7 @@ PX4FMU::cycle()
 		}
 
 		break;
-                
+
 	case RC_SCAN_PPM:
 		// skip PPM if it's not supported
 #ifdef HRT_PPM_CHANNEL
@@ -1592,13 +1384,216 @@ PX4FMU::cycle()
 	}
 
 	work_queue(HPWORK, &_work, (worker_t)&PX4FMU::cycle_trampoline, this,
-		   USEC2TICK(SCHEDULE_INTERVAL - main_out_latency));
+		   USEC2TICK(SCHEDULE_INTERVAL));
+}
+
+void
+PX4FMU::output_task_trampoline(int argc, char *argv[])
+{
+	g_fmu->output_task();
+}
+
+void
+PX4FMU::output_task()
+{
+	while (!_output_task_should_exit) {
+		if (_groups_subscribed != _groups_required) {
+			subscribe();
+			_groups_subscribed = _groups_required;
+			/* force setting update rate */
+			_current_update_rate = 0;
+		}
+
+		/*
+		 * Adjust actuator topic update rate to keep up with
+		 * the highest servo update rate configured. This also caps
+		 * the rate at which the output stage runs.
+		 *
+		 * We always mix at max rate; some channels may update slower.
+		 */
+		unsigned max_rate = (_pwm_default_rate > _pwm_alt_rate) ? _pwm_default_rate : _pwm_alt_rate;
+
+		if (_current_update_rate != max_rate) {
+			_current_update_rate = max_rate;
+			int update_rate_in_ms = int(1000 / _current_update_rate);
+
+			/* reject faster than 500 Hz updates */
+			if (update_rate_in_ms < 2) {
+				update_rate_in_ms = 2;
+			}
+
+			/* reject slower than 10 Hz updates */
+			if (update_rate_in_ms > 100) {
+				update_rate_in_ms = 100;
+			}
+
+			DEVICE_DEBUG("adjusted actuator update interval to %ums", update_rate_in_ms);
+
+			for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
+				if (_control_subs[i] > 0) {
+					orb_set_interval(_control_subs[i], update_rate_in_ms);
+				}
+			}
+
+			// set to current max rate, even if we are actually checking slower/faster
+			_current_update_rate = max_rate;
+		}
+
+		if (_poll_fds_num == 0) {
+			/* no mixer loaded yet */
+			usleep(OUTPUT_POLL_TIMEOUT * 1000);
+			continue;
+		}
+
+		/* wait for any of the control groups to be published */
+		int ret = ::poll(_poll_fds, _poll_fds_num, OUTPUT_POLL_TIMEOUT);
+
+		/* this would be bad... */
+		if (ret < 0) {
+			DEVICE_LOG("poll error %d", errno);
+			usleep(SCHEDULE_INTERVAL);
+
+		} else if (ret == 0) {
+			/* timeout: no control data, switch to failsafe values */
+//			warnx("no PWM: failsafe");
+
+		} else {
+			update_outputs();
+		}
+	}
+
+	_output_task = -1;
+}
+
+void
+PX4FMU::update_outputs()
+{
+	/* get controls for required topics */
+	unsigned poll_id = 0;
+	hrt_abstime timestamp_sample = 0;
+	hrt_abstime control_timestamp = 0;
+
+	for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
+		if (_control_subs[i] > 0) {
+			if (_poll_fds[poll_id].revents & POLLIN) {
+				orb_copy(_control_topics[i], _control_subs[i], &_controls[i]);
+
+				if (_controls[i].timestamp > control_timestamp) {
+					control_timestamp = _controls[i].timestamp;
+				}
+
+				/* main outputs */
+				if (i == 0) {
+					timestamp_sample = _controls[i].timestamp_sample;
+				}
+			}
+
+			poll_id++;
+		}
+	}
+
+	/* the mixers and the mode must not change while mixing */
+	output_lock();
+
+	/* can we mix? */
+	if (_mixers == nullptr) {
+		output_unlock();
+		return;
+	}
+
+	size_t num_outputs;
+
+	switch (_mode) {
+	case MODE_2PWM:
+	case MODE_2PWM2CAP:
+		num_outputs = 2;
+		break;
+
+	case MODE_3PWM:
+	case MODE_3PWM1CAP:
+		num_outputs = 3;
+		break;
+
+	case MODE_4PWM:
+		num_outputs = 4;
+		break;
+
+	case MODE_6PWM:
+		num_outputs = 6;
+		break;
+
+	case MODE_8PWM:
+		num_outputs = 8;
+		break;
+
+	case MODE_10PWM:
+		num_outputs = 10;
+		break;
+
+	case MODE_12PWM:
+		num_outputs = 12;
+		break;
+
+	default:
+		num_outputs = 0;
+		break;
+	}
+
+	/* do mixing */
+	float outputs[_max_actuators];
+	num_outputs = _mixers->mix(outputs, num_outputs, NULL);
+
+	/* disable unused ports by setting their output to NaN */
+	for (size_t i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++) {
+		if (i >= num_outputs) {
+			outputs[i] = NAN_VALUE;
+		}
+	}
+
+	uint16_t pwm_limited[_max_actuators];
+
+	/* the PWM limit call takes care of out of band errors, NaN and constrains */
+	pwm_limit_calc(_throttle_armed, arm_nothrottle(), num_outputs, _reverse_pwm_mask, _disarmed_pwm, _min_pwm, _max_pwm,
+		       outputs, pwm_limited, &_pwm_limit);
+
+	/* overwrite outputs in case of lockdown with disarmed PWM values */
+	if (_armed.lockdown) {
+		for (size_t i = 0; i < num_outputs; i++) {
+			pwm_limited[i] = _disarmed_pwm[i];
+		}
+	}
+
+	/* output to the servos */
+	for (size_t i = 0; i < num_outputs; i++) {
+		pwm_output_set(i, pwm_limited[i]);
+	}
+
+	output_unlock();
+
+	/* time from the controller publishing to the pulse widths being set */
+	if (control_timestamp != 0) {
+		perf_set(_perf_control_latency, hrt_elapsed_time(&control_timestamp));
+	}
+
+	latency_trace_record(LATENCY_STAGE_OUTPUT, timestamp_sample);
+
+	publish_pwm_outputs(pwm_limited, num_outputs);
 }
 
 void PX4FMU::work_stop()
 {
 	work_cancel(HPWORK, &_work);
 
+	/*
+	 * Stop the output task before closing its subscriptions. It checks
+	 * for exit at least every OUTPUT_POLL_TIMEOUT, so wait until it did.
+	 */
+	_output_task_should_exit = true;
+
+	while (_output_task != -1) {
+		usleep(OUTPUT_POLL_TIMEOUT * 1000 / 10);
+	}
+
 	for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
 		if (_control_subs[i] > 0) {
 			::close(_control_subs[i]);
@@ -2304,12 +2299,15 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 #endif
 
 	case MIXERIOCRESET:
+		output_lock();
+
 		if (_mixers != nullptr) {
 			delete _mixers;
 			_mixers = nullptr;
 			_groups_required = 0;
 		}
 
+		output_unlock();
 		break;
 
 	case MIXERIOCADDSIMPLE: {
@@ -2324,20 +2322,23 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 				ret = -EINVAL;
 
 			} else {
+				output_lock();
+
 				if (_mixers == nullptr)
 					_mixers = new MixerGroup(control_callback,
 								 (uintptr_t)_controls);
 
 				_mixers->add_mixer(mixer);
 				_mixers->groups_required(_groups_required);
+				output_unlock();
 			}
 
 			break;
 		}
 
-	case MIXERIOCLOADBUF: {
-			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
+	case MIXERIOCLOADBUF:
+	case MIXERIOCLOADBIN: {
+			output_lock();
 
 			if (_mixers == nullptr) {
 				_mixers = new MixerGroup(control_callback, (uintptr_t)_controls);
@@ -2349,7 +2350,15 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 			} else {
 
-				ret = _mixers->load_from_buf(buf, buflen);
+				if (cmd == MIXERIOCLOADBIN) {
+					const mixer_binary_header_s *image = (const mixer_binary_header_s *)arg;
+					ret = _mixers->load_from_binary(image, image->length);
+
+				} else {
+					const char *buf = (const char *)arg;
+					unsigned buflen = strnlen(buf, 1024);
+					ret = _mixers->load_from_buf(buf, buflen);
+				}
 
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
@@ -2361,9 +2370,13 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 				} else {
 
 					_mixers->groups_required(_groups_required);
+
+					/* on failure the mixer list is used uncompiled */
+					_mixers->compile();
 				}
 			}
 
+			output_unlock();
 			break;
 		}
 
@@ -3191,6 +3204,8 @@ PX4FMU::status(void)
 	       (unsigned)_ignore_safety_mask,
 	       _pwm_initialized?"YES":"NO");
 
+	perf_print_counter(_perf_control_latency);
+
 	printf("failsafe PWM ");
 	for (uint8_t i = 0; i < _max_actuators; i++) {
 		printf("%u ", _failsafe_pwm[i]);
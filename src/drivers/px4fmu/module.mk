@@ -9,6 +9,7 @@ SRCS		 = fmu.cpp \
 		  ../../lib/rc/st24.c \
 		  ../../lib/rc/sumd.c \
 		  ../../lib/rc/srxl.c \
+		  ../../lib/rc/rc_decode.c \
 		   px4fmu_params.c
 
 MODULE_STACKSIZE = 1200
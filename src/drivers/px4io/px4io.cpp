@@ -68,6 +68,7 @@
 
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/scheduling_priorities.h>
@@ -768,7 +769,7 @@ PX4IO::init()
 		} while (true);
 
 		/* send command to arm system via command API */
-		vehicle_command_s cmd;
+		vehicle_command_s cmd = {};
 		/* send this to itself */
 		param_t sys_id_param = param_find("MAV_SYS_ID");
 		param_t comp_id_param = param_find("MAV_COMP_ID");
@@ -802,6 +803,7 @@ PX4IO::init()
 		cmd.confirmation =  1;
 
 		/* send command once */
+		cmd.timestamp = hrt_absolute_time();
 		orb_advert_t pub = orb_advertise(ORB_ID(vehicle_command), &cmd);
 
 		/* spin here until IO's state has propagated into the system */
@@ -823,6 +825,7 @@ PX4IO::init()
 
 			/* re-send if necessary */
 			if (!safety.armed) {
+				cmd.timestamp = hrt_absolute_time();
 				orb_publish(ORB_ID(vehicle_command), pub, &cmd);
 				DEVICE_LOG("re-sending arm cmd");
 			}
@@ -1310,7 +1313,13 @@ PX4IO::io_set_control_state(unsigned group)
 	}
 
 	/* copy values to registers in IO */
-	return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+	int ret = io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+
+	if (group == 0 && changed) {
+		latency_trace_record(LATENCY_STAGE_OUTPUT, controls.timestamp_sample);
+	}
+
+	return ret;
 }
 
 
@@ -134,19 +134,12 @@ __EXPORT int map_projection_global_project(double lat, double lon, float *x, flo
 
 }
 
-__EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
-				    float *y)
+/* projection of a point whose latitude terms are known, the reference has to be initialized */
+static void project(const struct map_projection_reference_s *ref, double lon_rad, double sin_lat, double cos_lat,
+		    float *x, float *y)
 {
-	if (!map_projection_initialized(ref)) {
-		return -1;
-	}
-
-	double lat_rad = lat * M_DEG_TO_RAD;
-	double lon_rad = lon * M_DEG_TO_RAD;
-
-	double sin_lat = sin(lat_rad);
-	double cos_lat = cos(lat_rad);
-	double cos_d_lon = cos(lon_rad - ref->lon_rad);
+	double d_lon = lon_rad - ref->lon_rad;
+	double cos_d_lon = cos(d_lon);
 
 	double arg = ref->sin_lat * sin_lat + ref->cos_lat * cos_lat * cos_d_lon;
 
@@ -161,23 +154,59 @@ __EXPORT int map_projection_project(const struct map_projection_reference_s *ref
 	double k = (fabs(c) < DBL_EPSILON) ? 1.0 : (c / sin(c));
 
 	*x = k * (ref->cos_lat * sin_lat - ref->sin_lat * cos_lat * cos_d_lon) * CONSTANTS_RADIUS_OF_EARTH;
-	*y = k * cos_lat * sin(lon_rad - ref->lon_rad) * CONSTANTS_RADIUS_OF_EARTH;
+	*y = k * cos_lat * sin(d_lon) * CONSTANTS_RADIUS_OF_EARTH;
+}
+
+__EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
+				    float *y)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	double lat_rad = lat * M_DEG_TO_RAD;
+
+	project(ref, lon * M_DEG_TO_RAD, sin(lat_rad), cos(lat_rad), x, y);
 
 	return 0;
 }
 
-__EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
+__EXPORT int map_projection_project_point(const struct map_projection_reference_s *ref,
+		const struct geo_point_s *point, float *x, float *y)
 {
-	return map_projection_reproject(&mp_ref, x, y, lat, lon);
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	project(ref, point->lon_rad, point->sin_lat, point->cos_lat, x, y);
+
+	return 0;
 }
 
-__EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
-				      double *lon)
+__EXPORT int map_projection_project_batch(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned count)
 {
 	if (!map_projection_initialized(ref)) {
 		return -1;
 	}
 
+	for (unsigned i = 0; i < count; i++) {
+		double lat_rad = lat[i] * M_DEG_TO_RAD;
+
+		project(ref, lon[i] * M_DEG_TO_RAD, sin(lat_rad), cos(lat_rad), &x[i], &y[i]);
+	}
+
+	return 0;
+}
+
+__EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
+{
+	return map_projection_reproject(&mp_ref, x, y, lat, lon);
+}
+
+/* inverse of project(), the reference has to be initialized */
+static void reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat, double *lon)
+{
 	double x_rad = x / CONSTANTS_RADIUS_OF_EARTH;
 	double y_rad = y / CONSTANTS_RADIUS_OF_EARTH;
 	double c = sqrtf(x_rad * x_rad + y_rad * y_rad);
@@ -198,6 +227,30 @@ __EXPORT int map_projection_reproject(const struct map_projection_reference_s *r
 
 	*lat = lat_rad * 180.0 / M_PI;
 	*lon = lon_rad * 180.0 / M_PI;
+}
+
+__EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
+				      double *lon)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	reproject(ref, x, y, lat, lon);
+
+	return 0;
+}
+
+__EXPORT int map_projection_reproject_batch(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, unsigned count)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		reproject(ref, x[i], y[i], &lat[i], &lon[i]);
+	}
 
 	return 0;
 }
@@ -297,6 +350,37 @@ __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, dou
 	return CONSTANTS_RADIUS_OF_EARTH * c;
 }
 
+__EXPORT void geo_point_init(struct geo_point_s *point, double lat, double lon)
+{
+	point->lat_rad = lat * M_DEG_TO_RAD;
+	point->lon_rad = lon * M_DEG_TO_RAD;
+	point->sin_lat = sin(point->lat_rad);
+	point->cos_lat = cos(point->lat_rad);
+}
+
+__EXPORT float get_distance_between_points(const struct geo_point_s *from, const struct geo_point_s *to)
+{
+	/* the half angle sines keep the precision for short distances */
+	double sin_d_lat_2 = sin((to->lat_rad - from->lat_rad) / 2.0);
+	double sin_d_lon_2 = sin((to->lon_rad - from->lon_rad) / 2.0);
+
+	double a = sin_d_lat_2 * sin_d_lat_2 + sin_d_lon_2 * sin_d_lon_2 * from->cos_lat * to->cos_lat;
+	double c = 2.0 * atan2(sqrt(a), sqrt(1.0 - a));
+
+	return CONSTANTS_RADIUS_OF_EARTH * c;
+}
+
+__EXPORT float get_bearing_between_points(const struct geo_point_s *from, const struct geo_point_s *to)
+{
+	double d_lon = to->lon_rad - from->lon_rad;
+
+	/* conscious mix of double and float trig function to maximize speed and efficiency */
+	float theta = atan2f(sin(d_lon) * to->cos_lat,
+			     from->cos_lat * to->sin_lat - from->sin_lat * to->cos_lat * cos(d_lon));
+
+	return _wrap_pi(theta);
+}
+
 __EXPORT void create_waypoint_from_line_and_dist(double lat_A, double lon_A, double lat_B, double lon_B, float dist,
 		double *lat_target, double *lon_target)
 {
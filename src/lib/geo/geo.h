@@ -74,6 +74,14 @@ struct map_projection_reference_s {
 	uint64_t timestamp;
 };
 
+/* a position prepared for repeated use, lat/lon are in radians */
+struct geo_point_s {
+	double lat_rad;
+	double lon_rad;
+	double sin_lat;
+	double cos_lat;
+};
+
 struct globallocal_converter_reference_s {
 	float alt;
 	bool init_done;
@@ -170,6 +178,31 @@ __EXPORT int map_projection_global_project(double lat, double lon, float *x, flo
 __EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
 				    float *y);
 
+/**
+ * Transforms a prepared point to the local azimuthal equidistant plane
+ * using the projection given by the argument
+ *
+ * @param point prepared by geo_point_init
+ * @param x north
+ * @param y east
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_point(const struct map_projection_reference_s *ref,
+		const struct geo_point_s *point, float *x, float *y);
+
+/**
+ * Transforms count points to the local azimuthal equidistant plane
+ * using the projection given by the argument
+ *
+ * @param lat array of latitudes in degrees (47.1234567°, not 471234567°)
+ * @param lon array of longitudes in degrees (8.1234567°, not 81234567°)
+ * @param x array of count north coordinates
+ * @param y array of count east coordinates
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_batch(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned count);
+
 /**
  * Transforms a point in the local azimuthal equidistant plane to the
  * geographic coordinate system using the global projection
@@ -195,6 +228,19 @@ __EXPORT int map_projection_global_reproject(float x, float y, double *lat, doub
 __EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
 				      double *lon);
 
+/**
+ * Transforms count points in the local azimuthal equidistant plane to the
+ * geographic coordinate system using the projection given by the argument
+ *
+ * @param x array of north coordinates
+ * @param y array of east coordinates
+ * @param lat array of count latitudes in degrees (47.1234567°, not 471234567°)
+ * @param lon array of count longitudes in degrees (8.1234567°, not 81234567°)
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_reproject_batch(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, unsigned count);
+
 /**
  * Get reference position of the global map projection
  */
@@ -236,6 +282,25 @@ __EXPORT int globallocalconverter_getref(double *lat_0, double *lon_0, float *al
  */
 __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
+/**
+ * Prepares a position for the functions taking a geo_point_s, which skip the
+ * trigonometry of its latitude. Worth it for points used more than once.
+ *
+ * @param lat in degrees (47.1234567°, not 471234567°)
+ * @param lon in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT void geo_point_init(struct geo_point_s *point, double lat, double lon);
+
+/**
+ * Returns the distance between two prepared points in meters, as get_distance_to_next_waypoint.
+ */
+__EXPORT float get_distance_between_points(const struct geo_point_s *from, const struct geo_point_s *to);
+
+/**
+ * Returns the bearing from one prepared point to another in radians, as get_bearing_to_next_waypoint.
+ */
+__EXPORT float get_bearing_between_points(const struct geo_point_s *from, const struct geo_point_s *to);
+
 
 /**
  * Creates a new waypoint C on the line of two given waypoints (A, B) at certain distance
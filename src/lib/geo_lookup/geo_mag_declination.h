@@ -34,7 +34,8 @@
 /**
 * @file geo_mag_declination.h
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup table for earth magnetic field declination,
+* inclination and strength.
 *
 */
 
@@ -42,6 +43,27 @@
 
 __BEGIN_DECLS
 
+/**
+ * Magnetic declination in degrees, positive east of true north
+ *
+ * @param lat in degrees (47.1234567°, not 471234567°)
+ * @param lon in degrees (8.1234567°, not 81234567°)
+ * @return declination, 0 outside of the valid latitude and longitude ranges
+ */
 __EXPORT float get_mag_declination(float lat, float lon);
 
+/**
+ * Magnetic inclination in degrees, positive down
+ *
+ * @return inclination, 0 outside of the valid latitude and longitude ranges
+ */
+__EXPORT float get_mag_inclination(float lat, float lon);
+
+/**
+ * Magnetic field strength in Gauss
+ *
+ * @return strength, 0 outside of the valid latitude and longitude ranges
+ */
+__EXPORT float get_mag_strength(float lat, float lon);
+
 __END_DECLS
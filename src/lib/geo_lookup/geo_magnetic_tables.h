@@ -0,0 +1,141 @@
+/*
+* This file is automatically generated by mag_tables.py - do not edit.
+*
+* WMM-2015 evaluated for 2015.0 at sea level on a 5 degree grid,
+* rows from -90 to 90 latitude, columns from -180 to 180 longitude.
+*/
+
+#pragma once
+
+#define SAMPLING_RES		5
+#define SAMPLING_MIN_LAT	-90
+#define SAMPLING_MAX_LAT	90
+#define SAMPLING_MIN_LON	-180
+#define SAMPLING_MAX_LON	180
+
+#define LAT_DIM			37
+#define LON_DIM			73
+
+/* declination in 0.01 degrees, positive east */
+static const int16_t declination_table[37][73] = {
+	{14996, 14496, 13996, 13496, 12996, 12496, 11996, 11496, 10996, 10496, 9996, 9496, 8996, 8496, 7996, 7496, 6996, 6496, 5996, 5496, 4996, 4496, 3996, 3496, 2996, 2496, 1996, 1496, 996, 496, -4, -504, -1004, -1504, -2004, -2504, -3004, -3504, -4004, -4504, -5004, -5504, -6004, -6504, -7004, -7504, -8004, -8504, -9004, -9504, -10004, -10504, -11004, -11504, -12004, -12504, -13004, -13504, -14004, -14504, -15004, -15504, -16004, -16504, -17004, -17504, 17996, 17496, 16996, 16496, 15996, 15496, 14996},
+	{14257, 13690, 13131, 12581, 12040, 11508, 10985, 10471, 9966, 9468, 8979, 8496, 8021, 7552, 7088, 6630, 6177, 5728, 5282, 4840, 4401, 3965, 3530, 3097, 2666, 2235, 1805, 1375, 945, 515, 83, -350, -785, -1221, -1660, -2102, -2547, -2994, -3445, -3900, -4359, -4822, -5289, -5760, -6236, -6717, -7203, -7695, -8192, -8694, -9203, -9718, -10240, -10768, -11303, -11846, -12395, -12952, -13516, -14086, -14663, -15246, -15834, -16426, -17021, -17618, 17784, 17187, 16592, 16000, 15413, 14832, 14257},
+	{13040, 12408, 11804, 11229, 10680, 10157, 9655, 9173, 8709, 8259, 7823, 7397, 6981, 6572, 6169, 5772, 5379, 4990, 4604, 4220, 3839, 3460, 3082, 2706, 2331, 1957, 1584, 1210, 836, 460, 83, -297, -681, -1068, -1460, -1857, -2260, -2669, -3084, -3505, -3932, -4365, -4804, -5249, -5700, -6157, -6620, -7090, -7567, -8051, -8544, -9047, -9560, -10086, -10626, -11181, -11754, -12346, -12960, -13596, -14256, -14939, -15646, -16374, -17119, -17876, 17361, 16599, 15847, 15109, 14393, 13703, 13040},
+	{11096, 10477, 9918, 9410, 8943, 8511, 8106, 7724, 7359, 7007, 6665, 6329, 5998, 5669, 5340, 5010, 4679, 4347, 4012, 3676, 3339, 3002, 2665, 2329, 1995, 1662, 1331, 1002, 673, 344, 13, -321, -660, -1005, -1357, -1718, -2088, -2468, -2856, -3253, -3659, -4071, -4490, -4914, -5344, -5777, -6214, -6656, -7101, -7552, -8009, -8473, -8949, -9437, -9942, -10468, -11022, -11608, -12237, -12915, -13654, -14464, -15350, -16316, -17352, 17562, 16460, 15380, 14356, 13412, 12555, 11785, 11096},
+	{8551, 8127, 7755, 7423, 7120, 6842, 6581, 6333, 6095, 5861, 5628, 5394, 5155, 4909, 4654, 4389, 4114, 3828, 3533, 3230, 2920, 2607, 2291, 1976, 1664, 1355, 1052, 754, 461, 171, -119, -411, -707, -1012, -1328, -1656, -1998, -2354, -2723, -3105, -3496, -3895, -4299, -4708, -5117, -5527, -5935, -6342, -6746, -7150, -7552, -7957, -8364, -8779, -9205, -9648, -10116, -10620, -11177, -11811, -12558, -13474, -14637, -16137, 17999, 15941, 14024, 12467, 11273, 10356, 9633, 9044, 8551},
+	{6258, 6073, 5899, 5735, 5581, 5435, 5297, 5163, 5031, 4900, 4764, 4620, 4465, 4295, 4108, 3901, 3674, 3427, 3161, 2878, 2581, 2275, 1962, 1649, 1340, 1038, 746, 467, 198, -60, -312, -563, -818, -1082, -1360, -1655, -1970, -2305, -2658, -3027, -3408, -3798, -4191, -4584, -4974, -5357, -5733, -6098, -6453, -6798, -7131, -7454, -7767, -8073, -8371, -8664, -8956, -9248, -9548, -9865, -10223, -10676, -11422, -13887, 10995, 8627, 7910, 7489, 7172, 6907, 6672, 6457, 6258},
+	{4704, 4649, 4586, 4517, 4447, 4379, 4312, 4249, 4187, 4125, 4059, 3985, 3899, 3794, 3666, 3511, 3328, 3114, 2870, 2599, 2304, 1992, 1668, 1341, 1017, 705, 409, 134, -120, -353, -572, -783, -993, -1212, -1448, -1706, -1990, -2301, -2637, -2993, -3365, -3744, -4126, -4503, -4871, -5225, -5563, -5882, -6180, -6455, -6706, -6931, -7128, -7293, -7421, -7504, -7526, -7465, -7277, -6884, -6129, -4719, -2349, 413, 2398, 3518, 4130, 4465, 4644, 4729, 4755, 4742, 4704},
+	{3715, 3715, 3700, 3675, 3644, 3611, 3580, 3551, 3526, 3503, 3481, 3454, 3417, 3363, 3285, 3176, 3032, 2848, 2624, 2361, 2063, 1737, 1391, 1036, 685, 348, 35, -246, -495, -711, -900, -1071, -1235, -1403, -1588, -1800, -2044, -2323, -2635, -2975, -3333, -3700, -4067, -4426, -4769, -5091, -5387, -5653, -5887, -6085, -6245, -6360, -6426, -6434, -6370, -6216, -5946, -5524, -4906, -4049, -2944, -1665, -377, 754, 1652, 2321, 2805, 3146, 3382, 3539, 3637, 3692, 3715},
+	{3053, 3075, 3081, 3076, 3063, 3046, 3029, 3014, 3003, 2998, 2996, 2995, 2990, 2971, 2931, 2861, 2752, 2597, 2392, 2136, 1832, 1488, 1114, 725, 338, -31, -368, -664, -913, -1117, -1282, -1417, -1535, -1651, -1779, -1933, -2123, -2357, -2633, -2946, -3283, -3633, -3982, -4317, -4631, -4916, -5165, -5375, -5540, -5656, -5719, -5721, -5654, -5506, -5264, -4912, -4436, -3830, -3105, -2293, -1447, -624, 130, 787, 1341, 1794, 2158, 2443, 2660, 2820, 2933, 3008, 3053},
+	{2575, 2606, 2621, 2625, 2622, 2613, 2602, 2591, 2584, 2581, 2585, 2593, 2601, 2602, 2588, 2546, 2466, 2336, 2149, 1901, 1592, 1229, 827, 404, -19, -419, -779, -1086, -1336, -1530, -1676, -1785, -1867, -1936, -2007, -2096, -2218, -2387, -2608, -2878, -3183, -3506, -3830, -4138, -4418, -4661, -4860, -5010, -5104, -5138, -5106, -5002, -4818, -4545, -4178, -3715, -3169, -2562, -1930, -1306, -715, -171, 319, 756, 1140, 1473, 1757, 1993, 2184, 2333, 2444, 2523, 2575},
+	{2205, 2239, 2259, 2269, 2272, 2269, 2262, 2252, 2243, 2237, 2236, 2241, 2249, 2256, 2253, 2229, 2169, 2060, 1888, 1647, 1335, 958, 533, 82, -367, -788, -1158, -1467, -1711, -1895, -2027, -2119, -2180, -2218, -2242, -2265, -2308, -2391, -2532, -2735, -2989, -3273, -3563, -3838, -4083, -4285, -4435, -4526, -4554, -4515, -4404, -4218, -3953, -3607, -3186, -2704, -2188, -1670, -1176, -723, -314, 56, 393, 703, 986, 1243, 1472, 1671, 1838, 1973, 2078, 2153, 2205},
+	{1908, 1940, 1961, 1975, 1983, 1985, 1982, 1973, 1962, 1951, 1942, 1938, 1938, 1941, 1940, 1922, 1874, 1778, 1617, 1382, 1068, 682, 243, -223, -684, -1109, -1476, -1775, -2004, -2172, -2291, -2372, -2420, -2438, -2425, -2390, -2348, -2328, -2362, -2468, -2645, -2873, -3123, -3367, -3583, -3752, -3865, -3913, -3894, -3804, -3645, -3416, -3118, -2758, -2345, -1904, -1463, -1050, -682, -362, -80, 175, 414, 642, 860, 1066, 1255, 1425, 1572, 1694, 1789, 1859, 1908},
+	{1663, 1692, 1711, 1726, 1737, 1744, 1745, 1740, 1728, 1713, 1697, 1682, 1673, 1667, 1661, 1643, 1599, 1508, 1353, 1120, 805, 416, -28, -496, -954, -1368, -1719, -1997, -2205, -2353, -2455, -2519, -2550, -2544, -2494, -2400, -2274, -2146, -2058, -2047, -2126, -2284, -2490, -2709, -2910, -3069, -3169, -3202, -3165, -3060, -2891, -2662, -2378, -2045, -1678, -1301, -941, -623, -355, -133, 58, 234, 407, 581, 755, 924, 1085, 1232, 1362, 1471, 1557, 1620, 1663},
+	{1462, 1485, 1501, 1514, 1526, 1536, 1541, 1539, 1529, 1512, 1491, 1470, 1451, 1437, 1425, 1404, 1358, 1267, 1112, 878, 562, 173, -267, -726, -1168, -1562, -1888, -2140, -2322, -2444, -2519, -2554, -2552, -2506, -2408, -2253, -2053, -1836, -1646, -1528, -1508, -1588, -1745, -1943, -2141, -2308, -2420, -2466, -2443, -2355, -2209, -2013, -1770, -1486, -1177, -864, -576, -333, -141, 9, 135, 255, 383, 520, 665, 810, 949, 1078, 1195, 1293, 1371, 1426, 1462},
+	{1300, 1315, 1325, 1335, 1346, 1357, 1364, 1365, 1357, 1341, 1318, 1293, 1270, 1252, 1235, 1209, 1159, 1063, 904, 666, 349, -36, -466, -908, -1327, -1694, -1992, -2215, -2366, -2454, -2490, -2480, -2427, -2327, -2175, -1970, -1723, -1459, -1217, -1034, -942, -953, -1055, -1222, -1412, -1589, -1722, -1794, -1800, -1747, -1642, -1491, -1299, -1069, -816, -560, -329, -143, -7, 90, 169, 251, 347, 461, 587, 715, 839, 956, 1062, 1152, 1223, 1271, 1300},
+	{1172, 1180, 1183, 1186, 1194, 1204, 1212, 1215, 1210, 1195, 1174, 1149, 1126, 1106, 1087, 1057, 1001, 898, 731, 488, 170, -209, -625, -1044, -1435, -1772, -2040, -2230, -2346, -2392, -2379, -2313, -2202, -2047, -1851, -1619, -1361, -1097, -851, -651, -523, -484, -536, -662, -830, -1004, -1148, -1242, -1278, -1260, -1196, -1091, -948, -769, -565, -357, -172, -29, 67, 127, 173, 228, 304, 403, 516, 634, 749, 858, 957, 1042, 1108, 1150, 1172},
+	{1076, 1077, 1072, 1069, 1072, 1079, 1088, 1092, 1088, 1076, 1057, 1034, 1013, 994, 974, 941, 878, 765, 589, 340, 23, -348, -745, -1140, -1502, -1808, -2042, -2197, -2273, -2274, -2208, -2087, -1922, -1726, -1506, -1271, -1030, -793, -573, -385, -249, -182, -194, -280, -419, -576, -719, -823, -879, -889, -859, -793, -691, -556, -395, -228, -79, 31, 96, 129, 153, 189, 252, 341, 447, 560, 671, 776, 873, 956, 1020, 1059, 1076},
+	{1006, 1003, 992, 982, 980, 985, 992, 998, 996, 986, 970, 950, 931, 913, 892, 853, 780, 657, 470, 215, -100, -459, -837, -1205, -1537, -1810, -2010, -2128, -2162, -2118, -2006, -1840, -1638, -1417, -1191, -970, -758, -558, -372, -208, -78, 1, 15, -39, -148, -284, -416, -521, -586, -614, -608, -572, -505, -406, -282, -150, -34, 49, 92, 106, 113, 137, 191, 273, 375, 485, 596, 702, 801, 887, 952, 992, 1006},
+	{957, 953, 938, 925, 919, 922, 930, 937, 938, 931, 917, 899, 880, 861, 835, 787, 702, 565, 367, 107, -205, -551, -907, -1249, -1550, -1790, -1953, -2034, -2030, -1947, -1800, -1605, -1382, -1153, -932, -729, -546, -380, -227, -87, 31, 112, 141, 110, 26, -90, -209, -308, -376, -413, -423, -409, -368, -300, -208, -108, -20, 39, 62, 61, 57, 71, 117, 195, 294, 404, 516, 627, 732, 825, 897, 941, 957},
+	{922, 922, 908, 894, 887, 890, 900, 911, 916, 913, 900, 882, 862, 837, 801, 739, 638, 485, 274, 9, -299, -632, -967, -1280, -1549, -1754, -1881, -1925, -1887, -1777, -1607, -1398, -1170, -942, -730, -544, -385, -246, -119, -1, 104, 182, 218, 202, 137, 39, -67, -159, -226, -267, -286, -286, -265, -222, -159, -88, -27, 9, 15, 1, -14, -8, 30, 101, 197, 308, 424, 542, 657, 760, 843, 898, 922},
+	{891, 901, 895, 886, 882, 889, 903, 920, 930, 931, 920, 901, 876, 841, 790, 710, 588, 415, 189, -83, -388, -708, -1021, -1306, -1541, -1709, -1800, -1811, -1746, -1616, -1437, -1226, -1001, -780, -579, -407, -264, -144, -37, 64, 157, 230, 269, 263, 211, 127, 33, -52, -115, -156, -180, -189, -183, -160, -123, -79, -44, -31, -43, -71, -97, -102, -73, -10, 82, 192, 314, 440, 566, 684, 783, 853, 891},
+	{855, 884, 893, 895, 900, 914, 936, 960, 977, 982, 974, 953, 920, 872, 802, 700, 553, 357, 114, -169, -474, -784, -1076, -1332, -1532, -1663, -1718, -1699, -1614, -1474, -1293, -1087, -870, -659, -468, -305, -173, -65, 30, 117, 200, 267, 307, 306, 265, 193, 109, 33, -26, -67, -92, -108, -113, -107, -92, -74, -65, -76, -107, -151, -191, -208, -191, -138, -52, 57, 182, 317, 456, 589, 706, 797, 855},
+	{808, 862, 894, 914, 935, 962, 994, 1026, 1051, 1061, 1054, 1030, 988, 926, 835, 708, 534, 313, 48, -249, -558, -860, -1134, -1362, -1527, -1622, -1645, -1601, -1500, -1355, -1177, -979, -773, -572, -388, -231, -104, -2, 84, 164, 237, 300, 339, 343, 311, 251, 178, 109, 54, 16, -11, -31, -45, -54, -60, -68, -86, -121, -175, -237, -293, -326, -323, -281, -203, -97, 31, 173, 324, 474, 611, 724, 808},
+	{745, 829, 891, 938, 981, 1025, 1071, 1113, 1145, 1160, 1154, 1126, 1075, 997, 885, 732, 531, 281, -8, -322, -640, -939, -1198, -1400, -1534, -1597, -1591, -1526, -1413, -1265, -1091, -902, -705, -512, -333, -179, -54, 47, 131, 205, 273, 331, 370, 380, 358, 310, 250, 190, 141, 104, 75, 51, 27, 3, -24, -57, -103, -166, -244, -328, -403, -452, -464, -435, -366, -264, -135, 14, 175, 339, 495, 633, 745},
+	{668, 785, 880, 960, 1031, 1098, 1159, 1213, 1252, 1271, 1266, 1234, 1174, 1080, 947, 768, 538, 260, -57, -393, -723, -1022, -1270, -1451, -1559, -1594, -1565, -1483, -1361, -1210, -1039, -855, -665, -477, -302, -147, -19, 84, 169, 242, 309, 365, 406, 424, 415, 382, 336, 288, 245, 209, 178, 146, 111, 70, 20, -41, -117, -210, -315, -423, -518, -585, -612, -595, -535, -436, -306, -152, 17, 194, 367, 527, 668},
+	{583, 732, 863, 978, 1080, 1172, 1252, 1319, 1366, 1389, 1384, 1348, 1278, 1169, 1016, 811, 552, 242, -105, -465, -811, -1115, -1356, -1522, -1609, -1624, -1577, -1482, -1351, -1197, -1026, -843, -655, -469, -293, -135, -2, 108, 199, 276, 345, 405, 452, 481, 487, 474, 446, 412, 377, 343, 306, 265, 214, 151, 75, -17, -127, -253, -389, -523, -639, -724, -765, -758, -703, -607, -476, -317, -140, 46, 235, 416, 583},
+	{500, 679, 842, 991, 1125, 1243, 1344, 1425, 1482, 1510, 1505, 1466, 1386, 1263, 1088, 855, 564, 220, -160, -549, -914, -1226, -1464, -1619, -1693, -1693, -1633, -1528, -1390, -1229, -1054, -869, -679, -490, -309, -145, -3, 118, 220, 307, 385, 454, 513, 557, 585, 594, 588, 571, 546, 513, 470, 414, 343, 254, 145, 16, -133, -296, -466, -628, -767, -867, -919, -919, -868, -771, -637, -473, -289, -92, 110, 309, 500},
+	{430, 634, 826, 1004, 1166, 1310, 1432, 1530, 1598, 1633, 1632, 1589, 1501, 1361, 1162, 899, 571, 186, -234, -657, -1045, -1368, -1607, -1756, -1820, -1809, -1740, -1626, -1480, -1312, -1129, -937, -740, -544, -355, -181, -24, 113, 232, 337, 431, 518, 595, 662, 714, 750, 769, 772, 758, 727, 676, 604, 507, 385, 236, 63, -132, -339, -547, -739, -900, -1014, -1073, -1076, -1024, -924, -784, -613, -420, -213, 2, 218, 430},
+	{379, 604, 819, 1021, 1208, 1375, 1518, 1633, 1716, 1762, 1766, 1723, 1626, 1468, 1241, 940, 564, 127, -343, -807, -1224, -1561, -1802, -1946, -2002, -1983, -1905, -1782, -1627, -1448, -1255, -1051, -843, -635, -433, -243, -67, 93, 236, 367, 488, 601, 706, 801, 883, 949, 995, 1020, 1019, 992, 934, 843, 717, 555, 358, 130, -119, -378, -630, -855, -1036, -1162, -1226, -1227, -1170, -1063, -914, -734, -530, -311, -83, 149, 379},
+	{348, 590, 825, 1048, 1255, 1442, 1606, 1740, 1839, 1899, 1912, 1870, 1765, 1587, 1325, 973, 534, 26, -511, -1029, -1479, -1831, -2073, -2211, -2256, -2226, -2136, -2001, -1833, -1641, -1433, -1214, -990, -764, -543, -331, -129, 61, 237, 403, 560, 708, 848, 978, 1095, 1194, 1271, 1320, 1337, 1316, 1254, 1145, 987, 780, 525, 233, -84, -406, -708, -970, -1174, -1309, -1374, -1369, -1304, -1187, -1027, -835, -619, -387, -145, 101, 348},
+	{333, 592, 843, 1084, 1310, 1516, 1699, 1853, 1971, 2047, 2071, 2033, 1919, 1716, 1408, 986, 456, -152, -781, -1367, -1855, -2217, -2453, -2574, -2601, -2551, -2442, -2288, -2101, -1890, -1662, -1422, -1176, -927, -680, -438, -203, 23, 241, 449, 650, 841, 1024, 1195, 1351, 1487, 1598, 1676, 1716, 1710, 1650, 1529, 1342, 1087, 767, 397, -3, -402, -768, -1074, -1303, -1449, -1512, -1501, -1426, -1297, -1125, -920, -691, -446, -190, 72, 333},
+	{328, 602, 870, 1127, 1371, 1597, 1800, 1974, 2112, 2204, 2240, 2204, 2077, 1837, 1461, 934, 267, -487, -1240, -1902, -2416, -2769, -2976, -3061, -3050, -2966, -2825, -2641, -2426, -2187, -1932, -1664, -1389, -1110, -830, -552, -278, -9, 254, 510, 758, 998, 1228, 1444, 1644, 1822, 1973, 2089, 2163, 2183, 2140, 2022, 1819, 1523, 1137, 676, 174, -324, -773, -1139, -1403, -1564, -1631, -1615, -1531, -1391, -1208, -991, -750, -492, -223, 52, 328},
+	{327, 615, 898, 1172, 1433, 1678, 1899, 2092, 2248, 2354, 2396, 2353, 2195, 1888, 1393, 687, -201, -1165, -2053, -2755, -3240, -3529, -3662, -3675, -3601, -3460, -3269, -3042, -2786, -2510, -2219, -1916, -1606, -1291, -974, -656, -340, -26, 283, 587, 884, 1173, 1451, 1715, 1963, 2189, 2388, 2553, 2675, 2742, 2741, 2656, 2469, 2164, 1732, 1185, 563, -67, -637, -1094, -1419, -1616, -1700, -1689, -1604, -1460, -1270, -1046, -796, -529, -249, 38, 327},
+	{332, 629, 923, 1210, 1484, 1742, 1976, 2179, 2340, 2443, 2466, 2375, 2125, 1650, 887, -177, -1414, -2572, -3457, -4032, -4350, -4480, -4476, -4376, -4208, -3989, -3734, -3450, -3145, -2823, -2490, -2147, -1798, -1445, -1089, -732, -375, -20, 332, 679, 1021, 1356, 1681, 1994, 2292, 2571, 2826, 3052, 3240, 3380, 3458, 3456, 3350, 3114, 2721, 2156, 1443, 655, -101, -730, -1189, -1479, -1623, -1652, -1591, -1462, -1280, -1060, -811, -542, -258, 35, 332},
+	{388, 678, 965, 1244, 1511, 1756, 1972, 2144, 2252, 2267, 2141, 1799, 1128, 10, -1526, -3116, -4340, -5098, -5493, -5644, -5635, -5519, -5330, -5088, -4809, -4500, -4171, -3825, -3465, -3097, -2720, -2337, -1951, -1561, -1169, -777, -385, 6, 395, 780, 1161, 1537, 1905, 2265, 2614, 2949, 3268, 3566, 3838, 4077, 4273, 4414, 4481, 4449, 4288, 3955, 3415, 2658, 1744, 811, 8, -586, -965, -1166, -1228, -1187, -1070, -897, -684, -440, -176, 102, 388},
+	{1224, 1333, 1440, 1521, 1541, 1444, 1127, 385, -1150, -3674, -6146, -7601, -8272, -8517, -8531, -8410, -8206, -7945, -7645, -7317, -6967, -6601, -6223, -5834, -5437, -5033, -4624, -4211, -3794, -3374, -2951, -2527, -2102, -1676, -1250, -824, -398, 27, 450, 871, 1290, 1706, 2119, 2527, 2931, 3328, 3718, 4100, 4472, 4832, 5178, 5505, 5811, 6089, 6334, 6534, 6678, 6747, 6718, 6561, 6238, 5717, 4993, 4122, 3226, 2441, 1844, 1442, 1206, 1099, 1084, 1134, 1224},
+	{17385, 17885, -17615, -17115, -16615, -16115, -15615, -15115, -14615, -14115, -13615, -13115, -12615, -12115, -11615, -11115, -10615, -10115, -9615, -9115, -8615, -8115, -7615, -7115, -6615, -6115, -5615, -5115, -4615, -4115, -3615, -3115, -2615, -2115, -1615, -1115, -615, -115, 385, 885, 1385, 1885, 2385, 2885, 3385, 3885, 4385, 4885, 5385, 5885, 6385, 6885, 7385, 7885, 8385, 8885, 9385, 9885, 10385, 10885, 11385, 11885, 12385, 12885, 13385, 13885, 14385, 14885, 15385, 15885, 16385, 16885, 17385},
+};
+
+/* inclination in 0.01 degrees, positive down */
+static const int16_t inclination_table[37][73] = {
+	{-7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228},
+	{-7560, -7546, -7529, -7510, -7489, -7466, -7442, -7415, -7388, -7359, -7330, -7300, -7270, -7240, -7210, -7180, -7151, -7123, -7095, -7069, -7044, -7021, -6999, -6978, -6960, -6943, -6928, -6915, -6904, -6895, -6888, -6884, -6881, -6881, -6883, -6887, -6893, -6902, -6912, -6925, -6941, -6958, -6977, -6999, -7022, -7047, -7074, -7102, -7131, -7162, -7193, -7225, -7257, -7289, -7321, -7352, -7383, -7412, -7440, -7466, -7490, -7512, -7532, -7548, -7562, -7573, -7580, -7585, -7586, -7584, -7579, -7571, -7560},
+	{-7857, -7821, -7781, -7737, -7689, -7639, -7586, -7531, -7474, -7416, -7358, -7298, -7239, -7181, -7123, -7067, -7012, -6959, -6909, -6862, -6818, -6777, -6740, -6706, -6676, -6649, -6626, -6606, -6590, -6577, -6567, -6560, -6556, -6556, -6558, -6564, -6574, -6588, -6605, -6626, -6652, -6682, -6716, -6754, -6797, -6844, -6895, -6949, -7006, -7067, -7129, -7194, -7260, -7326, -7393, -7459, -7524, -7586, -7646, -7703, -7755, -7802, -7843, -7878, -7906, -7926, -7939, -7943, -7940, -7929, -7911, -7887, -7857},
+	{-8066, -8001, -7933, -7861, -7786, -7710, -7632, -7551, -7470, -7387, -7303, -7219, -7135, -7051, -6969, -6888, -6811, -6737, -6667, -6603, -6544, -6491, -6445, -6405, -6372, -6344, -6321, -6303, -6290, -6280, -6273, -6268, -6267, -6268, -6272, -6279, -6290, -6305, -6326, -6351, -6383, -6422, -6467, -6519, -6578, -6644, -6716, -6794, -6878, -6967, -7059, -7156, -7254, -7355, -7456, -7558, -7658, -7756, -7851, -7941, -8024, -8100, -8165, -8219, -8259, -8283, -8291, -8283, -8260, -8225, -8180, -8126, -8066},
+	{-8119, -8028, -7936, -7845, -7753, -7661, -7568, -7473, -7376, -7278, -7177, -7075, -6971, -6867, -6763, -6661, -6562, -6468, -6381, -6301, -6230, -6170, -6120, -6080, -6051, -6032, -6020, -6015, -6014, -6017, -6022, -6027, -6032, -6038, -6045, -6052, -6063, -6077, -6096, -6122, -6156, -6198, -6251, -6313, -6385, -6467, -6558, -6657, -6765, -6879, -6999, -7124, -7252, -7384, -7517, -7650, -7784, -7915, -8044, -8169, -8288, -8397, -8493, -8569, -8615, -8624, -8596, -8541, -8468, -8386, -8299, -8209, -8119},
+	{-7998, -7897, -7798, -7700, -7604, -7507, -7410, -7311, -7210, -7105, -6996, -6884, -6767, -6648, -6527, -6405, -6287, -6173, -6068, -5973, -5891, -5825, -5776, -5744, -5728, -5726, -5737, -5757, -5781, -5808, -5835, -5858, -5877, -5892, -5902, -5910, -5917, -5926, -5940, -5960, -5990, -6031, -6084, -6152, -6232, -6326, -6433, -6550, -6677, -6813, -6955, -7103, -7256, -7411, -7569, -7727, -7885, -8043, -8198, -8351, -8501, -8647, -8788, -8918, -8917, -8796, -8672, -8550, -8433, -8319, -8209, -8102, -7998},
+	{-7766, -7665, -7567, -7470, -7375, -7281, -7186, -7089, -6989, -6885, -6775, -6659, -6536, -6407, -6273, -6137, -6001, -5869, -5746, -5636, -5545, -5476, -5431, -5411, -5416, -5443, -5488, -5545, -5608, -5671, -5730, -5782, -5822, -5851, -5868, -5876, -5878, -5877, -5877, -5884, -5901, -5932, -5980, -6045, -6128, -6229, -6346, -6476, -6618, -6770, -6928, -7092, -7260, -7430, -7601, -7771, -7939, -8103, -8261, -8411, -8546, -8656, -8719, -8708, -8638, -8537, -8426, -8312, -8198, -8086, -7977, -7870, -7766},
+	{-7482, -7383, -7287, -7193, -7100, -7008, -6916, -6823, -6727, -6626, -6519, -6405, -6281, -6149, -6008, -5861, -5711, -5564, -5426, -5303, -5203, -5131, -5094, -5092, -5126, -5190, -5279, -5384, -5496, -5606, -5708, -5796, -5866, -5916, -5946, -5957, -5953, -5939, -5921, -5905, -5899, -5910, -5941, -5995, -6073, -6174, -6295, -6433, -6584, -6745, -6912, -7084, -7257, -7430, -7600, -7764, -7920, -8063, -8189, -8291, -8362, -8394, -8386, -8344, -8276, -8192, -8097, -7996, -7893, -7789, -7685, -7582, -7482},
+	{-7167, -7070, -6975, -6882, -6790, -6699, -6608, -6516, -6423, -6326, -6224, -6114, -5994, -5864, -5722, -5571, -5413, -5255, -5105, -4970, -4863, -4792, -4764, -4785, -4852, -4961, -5100, -5259, -5424, -5587, -5736, -5867, -5973, -6053, -6105, -6129, -6126, -6102, -6064, -6022, -5985, -5964, -5967, -5999, -6062, -6154, -6272, -6410, -6564, -6727, -6896, -7066, -7234, -7397, -7551, -7692, -7815, -7918, -7994, -8042, -8061, -8053, -8022, -7972, -7907, -7831, -7746, -7656, -7560, -7463, -7364, -7265, -7167},
+	{-6823, -6727, -6632, -6538, -6444, -6351, -6259, -6166, -6073, -5977, -5878, -5773, -5659, -5534, -5397, -5248, -5088, -4924, -4764, -4621, -4507, -4438, -4423, -4468, -4573, -4728, -4919, -5132, -5350, -5562, -5758, -5933, -6081, -6200, -6286, -6336, -6350, -6329, -6281, -6215, -6145, -6086, -6051, -6049, -6086, -6158, -6263, -6393, -6541, -6699, -6860, -7019, -7172, -7313, -7439, -7545, -7627, -7682, -7713, -7719, -7707, -7679, -7638, -7586, -7525, -7456, -7379, -7295, -7206, -7113, -7017, -6920, -6823},
+	{-6440, -6342, -6246, -6150, -6054, -5957, -5860, -5763, -5665, -5568, -5469, -5367, -5259, -5142, -5012, -4867, -4709, -4542, -4375, -4224, -4106, -4039, -4038, -4110, -4253, -4456, -4698, -4961, -5228, -5484, -5722, -5939, -6129, -6292, -6421, -6511, -6558, -6559, -6517, -6442, -6346, -6251, -6173, -6128, -6126, -6167, -6248, -6359, -6490, -6633, -6778, -6918, -7047, -7160, -7252, -7319, -7359, -7373, -7367, -7345, -7312, -7273, -7228, -7177, -7120, -7056, -6985, -6906, -6820, -6729, -6634, -6537, -6440},
+	{-6003, -5903, -5804, -5705, -5605, -5503, -5400, -5296, -5192, -5089, -4987, -4885, -4780, -4668, -4544, -4405, -4248, -4078, -3905, -3746, -3624, -3560, -3575, -3677, -3862, -4113, -4407, -4719, -5030, -5328, -5604, -5858, -6088, -6292, -6466, -6600, -6688, -6722, -6702, -6633, -6527, -6404, -6287, -6196, -6147, -6147, -6192, -6273, -6379, -6497, -6618, -6733, -6835, -6919, -6978, -7009, -7014, -6995, -6960, -6918, -6873, -6828, -6782, -6734, -6680, -6620, -6551, -6475, -6390, -6299, -6202, -6103, -6003},
+	{-5496, -5392, -5290, -5187, -5083, -4976, -4866, -4754, -4641, -4530, -4422, -4317, -4211, -4101, -3980, -3842, -3683, -3507, -3326, -3159, -3033, -2976, -3010, -3146, -3375, -3679, -4026, -4390, -4748, -5087, -5401, -5690, -5953, -6191, -6399, -6569, -6691, -6756, -6759, -6704, -6600, -6463, -6317, -6186, -6092, -6046, -6049, -6094, -6168, -6257, -6351, -6440, -6517, -6574, -6607, -6611, -6587, -6543, -6487, -6430, -6377, -6330, -6286, -6241, -6190, -6132, -6065, -5988, -5901, -5807, -5705, -5601, -5496},
+	{-4904, -4794, -4686, -4580, -4472, -4360, -4244, -4125, -4004, -3884, -3768, -3657, -3547, -3435, -3311, -3168, -3001, -2815, -2623, -2448, -2321, -2274, -2332, -2505, -2783, -3141, -3547, -3967, -4377, -4762, -5115, -5435, -5725, -5984, -6210, -6397, -6535, -6615, -6632, -6586, -6485, -6343, -6180, -6021, -5890, -5805, -5770, -5780, -5823, -5884, -5953, -6020, -6077, -6116, -6130, -6114, -6071, -6007, -5936, -5869, -5813, -5767, -5727, -5686, -5638, -5580, -5511, -5431, -5340, -5238, -5130, -5017, -4904},
+	{-4213, -4093, -3979, -3869, -3758, -3643, -3522, -3397, -3269, -3142, -3019, -2901, -2786, -2667, -2535, -2382, -2203, -2003, -1800, -1619, -1496, -1464, -1549, -1760, -2085, -2497, -2961, -3441, -3908, -4343, -4737, -5087, -5393, -5660, -5886, -6068, -6199, -6275, -6291, -6245, -6144, -5997, -5824, -5647, -5493, -5380, -5318, -5301, -5320, -5360, -5410, -5461, -5505, -5534, -5538, -5510, -5454, -5377, -5295, -5223, -5167, -5125, -5092, -5055, -5009, -4950, -4878, -4792, -4694, -4583, -4462, -4337, -4213},
+	{-3415, -3283, -3161, -3045, -2932, -2815, -2693, -2565, -2434, -2303, -2175, -2052, -1931, -1805, -1663, -1497, -1304, -1092, -881, -701, -588, -575, -686, -929, -1293, -1752, -2269, -2805, -3329, -3815, -4247, -4621, -4936, -5196, -5405, -5564, -5674, -5732, -5735, -5683, -5576, -5424, -5243, -5054, -4884, -4755, -4676, -4644, -4648, -4674, -4712, -4755, -4794, -4820, -4820, -4788, -4724, -4640, -4553, -4479, -4427, -4393, -4368, -4338, -4295, -4235, -4158, -4065, -3956, -3832, -3696, -3555, -3415},
+	{-2514, -2367, -2235, -2115, -2000, -1884, -1763, -1636, -1505, -1374, -1246, -1122, -998, -866, -715, -538, -336, -118, 91, 262, 359, 351, 219, -46, -435, -923, -1478, -2059, -2629, -3157, -3621, -4010, -4323, -4567, -4749, -4876, -4956, -4990, -4977, -4914, -4802, -4643, -4454, -4255, -4075, -3936, -3849, -3810, -3807, -3826, -3859, -3898, -3937, -3965, -3968, -3937, -3872, -3786, -3698, -3628, -3584, -3562, -3548, -3527, -3488, -3428, -3347, -3246, -3126, -2987, -2833, -2672, -2514},
+	{-1529, -1368, -1226, -1101, -986, -873, -757, -635, -508, -381, -257, -136, -13, 121, 275, 455, 658, 870, 1066, 1217, 1293, 1267, 1121, 848, 455, -42, -611, -1214, -1810, -2361, -2841, -3234, -3537, -3758, -3909, -4002, -4050, -4059, -4030, -3958, -3840, -3677, -3482, -3276, -3088, -2944, -2853, -2812, -2807, -2825, -2856, -2895, -2936, -2968, -2977, -2952, -2893, -2811, -2729, -2667, -2635, -2627, -2628, -2619, -2588, -2531, -2449, -2342, -2211, -2058, -1886, -1705, -1529},
+	{-499, -326, -177, -50, 62, 169, 278, 393, 511, 631, 749, 864, 983, 1113, 1264, 1438, 1630, 1824, 1997, 2122, 2174, 2132, 1981, 1714, 1333, 853, 298, -296, -888, -1436, -1911, -2294, -2579, -2774, -2894, -2955, -2974, -2961, -2917, -2839, -2718, -2554, -2357, -2148, -1959, -1813, -1723, -1683, -1679, -1696, -1726, -1765, -1808, -1845, -1861, -1845, -1795, -1723, -1653, -1605, -1589, -1599, -1618, -1624, -1605, -1556, -1477, -1369, -1234, -1071, -886, -690, -499},
+	{523, 702, 854, 981, 1088, 1187, 1287, 1392, 1501, 1613, 1723, 1832, 1945, 2070, 2212, 2372, 2544, 2712, 2854, 2949, 2978, 2922, 2772, 2520, 2167, 1722, 1208, 654, 101, -415, -860, -1216, -1475, -1643, -1734, -1768, -1762, -1731, -1677, -1594, -1475, -1316, -1124, -922, -738, -597, -511, -474, -471, -488, -517, -554, -596, -634, -655, -647, -610, -554, -502, -472, -475, -503, -540, -564, -562, -527, -459, -360, -228, -64, 124, 326, 523},
+	{1487, 1664, 1814, 1936, 2038, 2130, 2220, 2316, 2416, 2520, 2624, 2729, 2837, 2954, 3085, 3228, 3376, 3514, 3625, 3691, 3696, 3630, 3483, 3251, 2933, 2538, 2083, 1595, 1107, 652, 258, -56, -281, -421, -488, -500, -476, -431, -370, -287, -175, -27, 150, 336, 506, 635, 714, 747, 748, 732, 706, 674, 637, 602, 580, 581, 605, 642, 675, 684, 663, 617, 562, 519, 501, 516, 564, 648, 766, 918, 1098, 1293, 1487},
+	{2356, 2522, 2665, 2782, 2879, 2964, 3047, 3135, 3229, 3327, 3428, 3530, 3635, 3747, 3867, 3994, 4118, 4229, 4310, 4349, 4335, 4260, 4118, 3905, 3625, 3285, 2899, 2490, 2083, 1705, 1377, 1115, 928, 816, 769, 773, 808, 861, 925, 1004, 1106, 1237, 1391, 1554, 1701, 1814, 1883, 1911, 1912, 1897, 1876, 1849, 1820, 1792, 1773, 1769, 1782, 1802, 1815, 1806, 1769, 1708, 1639, 1577, 1538, 1529, 1554, 1613, 1709, 1839, 1999, 2176, 2356},
+	{3116, 3266, 3397, 3507, 3599, 3679, 3758, 3841, 3932, 4028, 4127, 4229, 4333, 4442, 4554, 4667, 4773, 4860, 4918, 4936, 4906, 4823, 4685, 4493, 4249, 3962, 3645, 3315, 2992, 2693, 2434, 2227, 2079, 1992, 1961, 1974, 2014, 2070, 2133, 2207, 2297, 2408, 2537, 2671, 2794, 2888, 2945, 2970, 2970, 2959, 2942, 2922, 2901, 2881, 2867, 2863, 2868, 2874, 2871, 2847, 2797, 2725, 2644, 2568, 2509, 2476, 2475, 2507, 2574, 2675, 2807, 2958, 3116},
+	{3772, 3900, 4017, 4118, 4206, 4285, 4362, 4444, 4533, 4629, 4729, 4833, 4938, 5045, 5153, 5256, 5348, 5419, 5459, 5462, 5420, 5333, 5200, 5025, 4814, 4575, 4320, 4061, 3812, 3585, 3388, 3231, 3120, 3056, 3037, 3054, 3095, 3149, 3209, 3276, 3354, 3445, 3549, 3656, 3753, 3829, 3877, 3898, 3901, 3893, 3881, 3868, 3855, 3844, 3836, 3833, 3832, 3829, 3814, 3779, 3720, 3641, 3551, 3463, 3388, 3335, 3309, 3314, 3352, 3422, 3521, 3641, 3772},
+	{4340, 4445, 4545, 4637, 4720, 4799, 4878, 4962, 5053, 5150, 5252, 5358, 5465, 5572, 5676, 5773, 5856, 5916, 5946, 5938, 5890, 5801, 5674, 5515, 5332, 5134, 4929, 4729, 4540, 4371, 4225, 4110, 4028, 3983, 3973, 3991, 4030, 4080, 4136, 4195, 4261, 4335, 4417, 4500, 4575, 4635, 4675, 4695, 4701, 4698, 4693, 4687, 4682, 4678, 4675, 4674, 4671, 4661, 4638, 4595, 4530, 4446, 4351, 4255, 4168, 4099, 4053, 4034, 4044, 4084, 4151, 4239, 4340},
+	{4844, 4925, 5008, 5089, 5169, 5248, 5330, 5417, 5512, 5612, 5717, 5825, 5933, 6040, 6142, 6235, 6311, 6365, 6387, 6373, 6322, 6234, 6115, 5972, 5813, 5647, 5482, 5325, 5182, 5055, 4948, 4864, 4806, 4775, 4771, 4789, 4824, 4868, 4918, 4970, 5025, 5084, 5147, 5210, 5268, 5316, 5350, 5371, 5381, 5386, 5388, 5390, 5392, 5395, 5398, 5399, 5394, 5380, 5351, 5303, 5234, 5147, 5049, 4949, 4854, 4774, 4712, 4674, 4662, 4676, 4713, 4772, 4844},
+	{5307, 5366, 5433, 5504, 5579, 5659, 5744, 5835, 5933, 6036, 6143, 6252, 6361, 6467, 6567, 6656, 6727, 6775, 6792, 6775, 6723, 6639, 6528, 6399, 6260, 6120, 5984, 5859, 5747, 5650, 5570, 5508, 5467, 5445, 5445, 5461, 5491, 5529, 5571, 5615, 5661, 5708, 5756, 5804, 5849, 5888, 5919, 5942, 5959, 5971, 5983, 5993, 6004, 6014, 6021, 6024, 6019, 6002, 5969, 5917, 5845, 5757, 5658, 5556, 5458, 5371, 5300, 5249, 5219, 5212, 5226, 5259, 5307},
+	{5748, 5791, 5844, 5906, 5977, 6055, 6141, 6234, 6334, 6439, 6546, 6655, 6763, 6867, 6963, 7047, 7113, 7156, 7169, 7149, 7098, 7017, 6915, 6799, 6677, 6556, 6442, 6338, 6247, 6170, 6107, 6060, 6028, 6013, 6013, 6027, 6051, 6081, 6116, 6152, 6188, 6225, 6263, 6300, 6336, 6370, 6400, 6427, 6451, 6473, 6494, 6514, 6534, 6551, 6563, 6568, 6563, 6544, 6507, 6452, 6379, 6291, 6194, 6093, 5995, 5906, 5831, 5772, 5731, 5709, 5705, 5719, 5748},
+	{6183, 6214, 6257, 6311, 6377, 6452, 6536, 6628, 6726, 6830, 6935, 7042, 7146, 7246, 7337, 7415, 7475, 7511, 7519, 7497, 7446, 7370, 7276, 7172, 7063, 6957, 6858, 6769, 6692, 6627, 6574, 6535, 6509, 6496, 6494, 6503, 6521, 6544, 6570, 6598, 6627, 6657, 6687, 6717, 6748, 6780, 6811, 6843, 6874, 6906, 6937, 6968, 6996, 7020, 7038, 7046, 7041, 7020, 6982, 6925, 6852, 6765, 6671, 6574, 6480, 6393, 6317, 6255, 6209, 6178, 6164, 6166, 6183},
+	{6618, 6641, 6677, 6725, 6784, 6854, 6933, 7020, 7113, 7211, 7312, 7412, 7511, 7604, 7688, 7759, 7812, 7841, 7843, 7818, 7766, 7694, 7608, 7513, 7416, 7322, 7235, 7156, 7087, 7029, 6983, 6947, 6923, 6908, 6904, 6907, 6918, 6933, 6952, 6973, 6996, 7020, 7045, 7072, 7102, 7133, 7167, 7204, 7243, 7283, 7324, 7364, 7401, 7433, 7456, 7467, 7464, 7442, 7403, 7346, 7275, 7192, 7103, 7012, 6923, 6842, 6770, 6710, 6663, 6631, 6612, 6608, 6618},
+	{7051, 7069, 7100, 7142, 7194, 7256, 7327, 7406, 7490, 7579, 7670, 7762, 7851, 7936, 8011, 8073, 8117, 8139, 8135, 8105, 8053, 7984, 7904, 7818, 7732, 7648, 7570, 7499, 7437, 7384, 7340, 7306, 7281, 7264, 7255, 7253, 7257, 7265, 7278, 7293, 7311, 7331, 7354, 7380, 7409, 7443, 7480, 7521, 7566, 7613, 7662, 7710, 7755, 7793, 7822, 7837, 7836, 7816, 7779, 7724, 7656, 7580, 7498, 7415, 7336, 7263, 7198, 7143, 7100, 7069, 7050, 7044, 7051},
+	{7475, 7490, 7516, 7551, 7596, 7649, 7709, 7776, 7849, 7925, 8004, 8084, 8161, 8234, 8299, 8350, 8384, 8396, 8384, 8349, 8296, 8231, 8158, 8081, 8005, 7931, 7862, 7799, 7743, 7694, 7653, 7619, 7593, 7573, 7560, 7554, 7552, 7555, 7562, 7573, 7587, 7605, 7627, 7653, 7683, 7718, 7757, 7801, 7850, 7901, 7954, 8007, 8058, 8102, 8136, 8156, 8159, 8143, 8110, 8061, 8001, 7933, 7861, 7790, 7722, 7659, 7603, 7556, 7519, 7492, 7476, 7470, 7475},
+	{7880, 7892, 7912, 7940, 7976, 8018, 8067, 8121, 8179, 8241, 8305, 8370, 8433, 8492, 8543, 8582, 8603, 8603, 8581, 8541, 8488, 8427, 8362, 8296, 8230, 8167, 8108, 8054, 8005, 7962, 7924, 7892, 7867, 7846, 7831, 7822, 7817, 7816, 7820, 7828, 7840, 7857, 7877, 7902, 7932, 7967, 8006, 8049, 8097, 8148, 8202, 8256, 8307, 8354, 8393, 8418, 8428, 8420, 8396, 8357, 8308, 8252, 8194, 8136, 8081, 8030, 7985, 7947, 7917, 7895, 7881, 7876, 7880},
+	{8258, 8266, 8280, 8301, 8326, 8357, 8393, 8433, 8476, 8522, 8569, 8617, 8663, 8706, 8740, 8761, 8764, 8748, 8716, 8673, 8623, 8570, 8516, 8462, 8410, 8360, 8313, 8270, 8230, 8194, 8162, 8135, 8112, 8094, 8079, 8069, 8064, 8062, 8064, 8071, 8081, 8095, 8114, 8137, 8164, 8195, 8230, 8269, 8311, 8357, 8405, 8453, 8501, 8547, 8587, 8619, 8638, 8642, 8632, 8608, 8574, 8535, 8492, 8450, 8409, 8371, 8338, 8310, 8287, 8270, 8260, 8255, 8258},
+	{8602, 8606, 8615, 8627, 8644, 8663, 8685, 8711, 8738, 8767, 8797, 8826, 8852, 8872, 8880, 8872, 8852, 8822, 8787, 8749, 8709, 8670, 8631, 8592, 8555, 8520, 8487, 8456, 8428, 8402, 8379, 8359, 8342, 8328, 8317, 8309, 8304, 8303, 8305, 8310, 8318, 8330, 8344, 8362, 8383, 8407, 8434, 8464, 8496, 8530, 8566, 8604, 8642, 8679, 8715, 8748, 8775, 8795, 8804, 8802, 8791, 8772, 8749, 8725, 8700, 8677, 8656, 8638, 8623, 8612, 8604, 8601, 8602},
+	{8911, 8913, 8917, 8923, 8930, 8939, 8949, 8959, 8967, 8970, 8964, 8951, 8934, 8916, 8896, 8875, 8853, 8831, 8809, 8787, 8765, 8744, 8722, 8702, 8682, 8664, 8646, 8630, 8614, 8601, 8588, 8577, 8568, 8561, 8555, 8551, 8549, 8548, 8550, 8553, 8558, 8565, 8573, 8584, 8595, 8609, 8624, 8640, 8658, 8677, 8696, 8717, 8738, 8760, 8781, 8803, 8824, 8845, 8865, 8882, 8898, 8912, 8921, 8927, 8929, 8928, 8924, 8920, 8916, 8913, 8911, 8910, 8911},
+	{8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806},
+};
+
+/* total intensity in 10 nT */
+static const int16_t strength_table[37][73] = {
+	{5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494},
+	{5836, 5823, 5808, 5790, 5771, 5749, 5725, 5700, 5673, 5645, 5615, 5585, 5554, 5522, 5490, 5457, 5425, 5393, 5362, 5331, 5301, 5273, 5245, 5220, 5196, 5174, 5154, 5136, 5120, 5107, 5097, 5090, 5085, 5083, 5084, 5089, 5096, 5106, 5119, 5135, 5154, 5176, 5200, 5226, 5255, 5285, 5317, 5351, 5385, 5421, 5456, 5492, 5528, 5563, 5597, 5631, 5662, 5692, 5720, 5746, 5770, 5791, 5810, 5825, 5838, 5848, 5855, 5859, 5860, 5858, 5853, 5846, 5836},
+	{6100, 6072, 6041, 6005, 5966, 5923, 5877, 5829, 5778, 5724, 5668, 5611, 5552, 5492, 5431, 5370, 5309, 5249, 5189, 5131, 5074, 5019, 4967, 4918, 4872, 4829, 4791, 4756, 4725, 4699, 4678, 4662, 4651, 4645, 4645, 4651, 4663, 4681, 4706, 4736, 4772, 4815, 4862, 4915, 4973, 5036, 5102, 5171, 5243, 5316, 5391, 5465, 5539, 5612, 5682, 5749, 5813, 5873, 5928, 5978, 6022, 6061, 6093, 6120, 6140, 6155, 6163, 6166, 6163, 6155, 6141, 6123, 6100},
+	{6271, 6228, 6179, 6126, 6068, 6007, 5942, 5873, 5801, 5726, 5647, 5567, 5484, 5399, 5313, 5226, 5139, 5053, 4968, 4885, 4805, 4728, 4654, 4586, 4521, 4462, 4408, 4360, 4317, 4280, 4250, 4226, 4209, 4199, 4197, 4204, 4219, 4243, 4276, 4319, 4371, 4432, 4503, 4583, 4670, 4765, 4866, 4972, 5082, 5195, 5309, 5423, 5536, 5646, 5752, 5853, 5947, 6034, 6112, 6182, 6242, 6293, 6334, 6366, 6388, 6401, 6404, 6400, 6388, 6368, 6342, 6310, 6271},
+	{6344, 6284, 6219, 6150, 6076, 5999, 5918, 5833, 5744, 5652, 5555, 5455, 5352, 5246, 5138, 5028, 4918, 4808, 4701, 4596, 4495, 4399, 4309, 4225, 4148, 4078, 4014, 3957, 3907, 3864, 3828, 3799, 3777, 3764, 3761, 3767, 3784, 3812, 3853, 3906, 3972, 4052, 4144, 4249, 4365, 4491, 4626, 4768, 4916, 5067, 5220, 5372, 5522, 5667, 5806, 5937, 6058, 6167, 6265, 6349, 6420, 6477, 6520, 6550, 6567, 6572, 6566, 6550, 6524, 6489, 6447, 6399, 6344},
+	{6324, 6248, 6168, 6085, 5998, 5908, 5815, 5718, 5617, 5512, 5403, 5289, 5170, 5046, 4919, 4790, 4659, 4529, 4401, 4277, 4159, 4048, 3945, 3851, 3766, 3690, 3623, 3564, 3513, 3468, 3431, 3400, 3377, 3362, 3357, 3363, 3380, 3411, 3458, 3520, 3598, 3694, 3806, 3934, 4076, 4231, 4397, 4572, 4754, 4940, 5127, 5314, 5496, 5672, 5838, 5994, 6136, 6263, 6373, 6466, 6541, 6599, 6639, 6662, 6670, 6663, 6644, 6612, 6570, 6519, 6460, 6395, 6324},
+	{6226, 6136, 6044, 5948, 5851, 5751, 5649, 5545, 5436, 5324, 5206, 5082, 4952, 4816, 4674, 4529, 4381, 4233, 4088, 3948, 3816, 3693, 3582, 3483, 3396, 3321, 3257, 3202, 3156, 3116, 3082, 3054, 3031, 3016, 3009, 3013, 3030, 3062, 3111, 3178, 3266, 3375, 3503, 3651, 3816, 3997, 4191, 4394, 4605, 4820, 5036, 5250, 5458, 5657, 5845, 6018, 6174, 6312, 6429, 6525, 6599, 6653, 6685, 6699, 6695, 6675, 6640, 6593, 6535, 6468, 6393, 6312, 6226},
+	{6070, 5969, 5866, 5761, 5656, 5549, 5442, 5332, 5219, 5103, 4981, 4852, 4716, 4572, 4421, 4264, 4104, 3943, 3784, 3632, 3490, 3360, 3244, 3145, 3062, 2993, 2938, 2894, 2858, 2828, 2802, 2780, 2761, 2746, 2738, 2739, 2752, 2780, 2827, 2896, 2988, 3105, 3245, 3409, 3593, 3796, 4013, 4240, 4475, 4713, 4950, 5183, 5409, 5623, 5824, 6007, 6170, 6311, 6428, 6522, 6591, 6637, 6660, 6663, 6646, 6613, 6565, 6504, 6432, 6351, 6263, 6169, 6070},
+	{5876, 5766, 5655, 5543, 5431, 5320, 5208, 5096, 4982, 4864, 4741, 4612, 4474, 4327, 4172, 4010, 3843, 3675, 3508, 3349, 3200, 3067, 2951, 2856, 2781, 2724, 2683, 2655, 2634, 2618, 2604, 2590, 2576, 2564, 2554, 2551, 2558, 2579, 2619, 2682, 2772, 2891, 3038, 3213, 3412, 3631, 3867, 4113, 4366, 4620, 4872, 5117, 5352, 5573, 5778, 5962, 6124, 6261, 6373, 6459, 6519, 6555, 6568, 6560, 6534, 6490, 6431, 6360, 6278, 6186, 6087, 5983, 5876},
+	{5655, 5539, 5423, 5306, 5191, 5076, 4962, 4848, 4733, 4616, 4495, 4368, 4233, 4089, 3936, 3775, 3608, 3438, 3270, 3108, 2959, 2826, 2715, 2627, 2563, 2521, 2497, 2486, 2483, 2483, 2482, 2479, 2474, 2466, 2458, 2452, 2452, 2464, 2493, 2545, 2626, 2739, 2886, 3064, 3272, 3504, 3753, 4013, 4279, 4544, 4803, 5053, 5290, 5510, 5710, 5888, 6041, 6167, 6268, 6341, 6390, 6415, 6419, 6403, 6368, 6317, 6252, 6174, 6084, 5986, 5880, 5769, 5655},
+	{5416, 5297, 5178, 5059, 4942, 4825, 4709, 4595, 4480, 4365, 4247, 4124, 3995, 3858, 3713, 3560, 3400, 3236, 3072, 2914, 2768, 2641, 2536, 2458, 2407, 2381, 2373, 2380, 2393, 2408, 2421, 2431, 2436, 2438, 2435, 2432, 2429, 2434, 2451, 2489, 2555, 2656, 2794, 2968, 3177, 3413, 3670, 3938, 4211, 4481, 4742, 4991, 5223, 5435, 5624, 5788, 5925, 6035, 6119, 6177, 6213, 6227, 6222, 6199, 6159, 6105, 6036, 5954, 5861, 5759, 5649, 5534, 5416},
+	{5162, 5043, 4923, 4805, 4687, 4570, 4455, 4340, 4227, 4115, 4001, 3885, 3765, 3639, 3506, 3366, 3219, 3066, 2913, 2765, 2627, 2508, 2413, 2345, 2307, 2293, 2300, 2320, 2347, 2375, 2401, 2424, 2444, 2459, 2470, 2476, 2479, 2482, 2492, 2516, 2565, 2646, 2767, 2928, 3127, 3359, 3614, 3883, 4156, 4424, 4682, 4924, 5146, 5346, 5519, 5664, 5781, 5869, 5932, 5973, 5994, 5998, 5985, 5958, 5915, 5858, 5788, 5706, 5612, 5508, 5397, 5281, 5162},
+	{4894, 4777, 4660, 4544, 4429, 4315, 4202, 4090, 3980, 3871, 3763, 3656, 3546, 3434, 3317, 3194, 3064, 2929, 2791, 2656, 2531, 2423, 2339, 2282, 2253, 2250, 2266, 2295, 2331, 2369, 2407, 2444, 2480, 2514, 2544, 2567, 2583, 2592, 2600, 2615, 2647, 2707, 2803, 2941, 3121, 3337, 3580, 3840, 4105, 4365, 4613, 4844, 5053, 5237, 5391, 5514, 5607, 5671, 5711, 5733, 5740, 5734, 5716, 5685, 5640, 5583, 5513, 5431, 5338, 5236, 5126, 5012, 4894},
+	{4615, 4503, 4392, 4282, 4173, 4064, 3956, 3849, 3744, 3642, 3543, 3445, 3349, 3253, 3154, 3050, 2940, 2825, 2706, 2588, 2479, 2384, 2310, 2262, 2241, 2243, 2264, 2299, 2340, 2386, 2434, 2485, 2538, 2591, 2642, 2686, 2719, 2740, 2753, 2764, 2782, 2820, 2890, 2998, 3149, 3339, 3560, 3801, 4049, 4294, 4527, 4743, 4936, 5101, 5235, 5335, 5403, 5442, 5459, 5463, 5456, 5442, 5419, 5386, 5340, 5283, 5214, 5134, 5043, 4944, 4838, 4728, 4615},
+	{4331, 4227, 4125, 4024, 3924, 3825, 3725, 3628, 3532, 3440, 3351, 3266, 3184, 3105, 3024, 2941, 2853, 2759, 2661, 2564, 2471, 2390, 2327, 2285, 2267, 2270, 2292, 2327, 2372, 2424, 2480, 2543, 2610, 2681, 2750, 2812, 2862, 2897, 2917, 2927, 2937, 2958, 3001, 3079, 3197, 3354, 3546, 3759, 3983, 4205, 4417, 4614, 4789, 4935, 5049, 5127, 5171, 5187, 5184, 5171, 5153, 5131, 5104, 5069, 5022, 4965, 4897, 4819, 4733, 4639, 4539, 4436, 4331},
+	{4053, 3960, 3870, 3782, 3694, 3607, 3521, 3436, 3354, 3275, 3200, 3131, 3065, 3003, 2942, 2879, 2812, 2741, 2665, 2587, 2512, 2444, 2389, 2350, 2330, 2330, 2348, 2381, 2426, 2481, 2544, 2614, 2691, 2773, 2853, 2927, 2989, 3034, 3062, 3075, 3080, 3088, 3112, 3162, 3248, 3372, 3530, 3712, 3905, 4099, 4287, 4461, 4615, 4742, 4837, 4895, 4919, 4916, 4897, 4871, 4843, 4816, 4785, 4747, 4699, 4641, 4575, 4500, 4419, 4332, 4240, 4147, 4053},
+	{3796, 3718, 3642, 3569, 3496, 3425, 3355, 3287, 3221, 3160, 3103, 3050, 3002, 2958, 2916, 2874, 2828, 2778, 2722, 2664, 2604, 2547, 2497, 2457, 2432, 2423, 2432, 2458, 2499, 2554, 2619, 2692, 2772, 2856, 2940, 3018, 3084, 3135, 3168, 3185, 3190, 3193, 3203, 3234, 3294, 3389, 3514, 3663, 3823, 3987, 4147, 4296, 4428, 4536, 4613, 4656, 4665, 4649, 4619, 4583, 4549, 4516, 4481, 4440, 4389, 4331, 4265, 4194, 4118, 4039, 3958, 3876, 3796},
+	{3579, 3517, 3458, 3400, 3345, 3291, 3239, 3190, 3145, 3103, 3066, 3033, 3004, 2979, 2956, 2933, 2907, 2876, 2838, 2795, 2747, 2697, 2648, 2605, 2571, 2550, 2545, 2559, 2592, 2640, 2701, 2772, 2848, 2927, 3006, 3080, 3145, 3197, 3234, 3255, 3264, 3267, 3273, 3294, 3338, 3409, 3507, 3625, 3755, 3888, 4019, 4143, 4252, 4341, 4403, 4434, 4435, 4412, 4376, 4335, 4296, 4257, 4216, 4169, 4115, 4054, 3989, 3921, 3851, 3781, 3712, 3644, 3579},
+	{3416, 3371, 3330, 3290, 3251, 3216, 3183, 3154, 3130, 3110, 3094, 3082, 3073, 3068, 3063, 3058, 3050, 3035, 3012, 2979, 2938, 2890, 2840, 2790, 2745, 2709, 2689, 2687, 2705, 2742, 2793, 2854, 2921, 2990, 3060, 3126, 3186, 3237, 3276, 3302, 3317, 3325, 3335, 3355, 3391, 3449, 3526, 3619, 3721, 3827, 3931, 4030, 4119, 4190, 4239, 4262, 4259, 4235, 4197, 4154, 4109, 4063, 4014, 3959, 3899, 3835, 3769, 3702, 3638, 3576, 3519, 3465, 3416},
+	{3319, 3290, 3265, 3241, 3220, 3202, 3188, 3179, 3176, 3178, 3184, 3194, 3206, 3219, 3233, 3245, 3252, 3250, 3236, 3209, 3170, 3122, 3066, 3008, 2950, 2900, 2863, 2844, 2845, 2865, 2901, 2949, 3003, 3060, 3120, 3178, 3232, 3281, 3321, 3352, 3375, 3393, 3412, 3438, 3475, 3526, 3590, 3664, 3744, 3827, 3909, 3987, 4057, 4114, 4153, 4171, 4167, 4144, 4108, 4063, 4012, 3956, 3896, 3831, 3762, 3692, 3622, 3555, 3494, 3439, 3392, 3352, 3319},
+	{3286, 3272, 3261, 3253, 3247, 3245, 3249, 3260, 3277, 3301, 3329, 3359, 3392, 3424, 3456, 3483, 3502, 3510, 3502, 3477, 3437, 3385, 3322, 3253, 3184, 3121, 3069, 3033, 3017, 3021, 3040, 3072, 3112, 3158, 3207, 3259, 3310, 3357, 3399, 3436, 3467, 3496, 3526, 3562, 3604, 3654, 3711, 3772, 3835, 3901, 3967, 4029, 4086, 4132, 4164, 4179, 4177, 4157, 4122, 4075, 4017, 3950, 3876, 3797, 3716, 3636, 3559, 3489, 3428, 3377, 3337, 3307, 3286},
+	{3316, 3312, 3313, 3318, 3326, 3339, 3360, 3388, 3425, 3468, 3516, 3567, 3618, 3669, 3717, 3758, 3788, 3802, 3798, 3774, 3731, 3673, 3601, 3523, 3443, 3367, 3303, 3254, 3224, 3213, 3217, 3234, 3262, 3298, 3340, 3387, 3435, 3483, 3528, 3569, 3608, 3646, 3687, 3731, 3780, 3832, 3885, 3939, 3993, 4048, 4103, 4156, 4205, 4245, 4274, 4290, 4289, 4272, 4238, 4187, 4121, 4042, 3953, 3858, 3762, 3669, 3583, 3506, 3441, 3389, 3352, 3328, 3316},
+	{3402, 3404, 3414, 3429, 3449, 3477, 3512, 3557, 3610, 3672, 3738, 3806, 3875, 3941, 4003, 4055, 4094, 4115, 4114, 4090, 4044, 3979, 3899, 3811, 3721, 3636, 3562, 3504, 3464, 3441, 3433, 3439, 3456, 3483, 3519, 3563, 3610, 3659, 3706, 3751, 3794, 3839, 3887, 3938, 3992, 4046, 4098, 4149, 4200, 4250, 4301, 4352, 4398, 4438, 4468, 4485, 4487, 4473, 4438, 4384, 4309, 4218, 4114, 4004, 3892, 3785, 3686, 3600, 3527, 3472, 3433, 3410, 3402},
+	{3539, 3543, 3558, 3581, 3612, 3652, 3701, 3760, 3829, 3905, 3986, 4069, 4151, 4230, 4301, 4363, 4408, 4434, 4435, 4412, 4363, 4294, 4208, 4113, 4015, 3922, 3841, 3776, 3728, 3696, 3680, 3676, 3684, 3705, 3735, 3775, 3821, 3869, 3917, 3963, 4010, 4057, 4108, 4163, 4219, 4275, 4330, 4382, 4434, 4486, 4539, 4591, 4640, 4683, 4717, 4738, 4744, 4731, 4696, 4638, 4557, 4455, 4339, 4215, 4090, 3969, 3858, 3761, 3680, 3617, 3573, 3548, 3539},
+	{3723, 3726, 3743, 3772, 3812, 3862, 3924, 3996, 4077, 4165, 4257, 4349, 4440, 4526, 4604, 4671, 4720, 4748, 4751, 4728, 4679, 4607, 4518, 4418, 4315, 4217, 4131, 4059, 4005, 3966, 3942, 3931, 3932, 3945, 3970, 4005, 4048, 4093, 4140, 4186, 4232, 4280, 4331, 4385, 4443, 4501, 4559, 4616, 4674, 4732, 4791, 4850, 4905, 4953, 4993, 5019, 5028, 5017, 4982, 4922, 4836, 4728, 4604, 4470, 4334, 4203, 4083, 3976, 3887, 3817, 3766, 3735, 3723},
+	{3952, 3953, 3970, 4002, 4048, 4107, 4178, 4259, 4349, 4445, 4543, 4641, 4735, 4824, 4903, 4969, 5019, 5047, 5050, 5027, 4978, 4906, 4816, 4715, 4611, 4510, 4420, 4344, 4283, 4238, 4206, 4187, 4181, 4188, 4206, 4235, 4271, 4313, 4355, 4399, 4443, 4489, 4538, 4592, 4650, 4710, 4773, 4837, 4903, 4971, 5039, 5106, 5169, 5225, 5271, 5301, 5314, 5304, 5270, 5209, 5121, 5011, 4883, 4746, 4606, 4470, 4343, 4231, 4136, 4060, 4004, 3968, 3952},
+	{4219, 4218, 4236, 4269, 4319, 4382, 4458, 4545, 4638, 4736, 4835, 4933, 5025, 5111, 5186, 5248, 5293, 5318, 5319, 5296, 5248, 5177, 5090, 4991, 4888, 4788, 4696, 4616, 4550, 4498, 4460, 4434, 4420, 4419, 4429, 4450, 4480, 4514, 4552, 4591, 4631, 4675, 4722, 4775, 4833, 4897, 4965, 5038, 5113, 5191, 5269, 5345, 5416, 5479, 5530, 5565, 5580, 5572, 5538, 5478, 5392, 5284, 5159, 5023, 4885, 4750, 4624, 4511, 4415, 4337, 4278, 4239, 4219},
+	{4516, 4514, 4531, 4565, 4614, 4678, 4754, 4839, 4930, 5025, 5119, 5210, 5295, 5373, 5439, 5493, 5531, 5549, 5547, 5522, 5475, 5408, 5326, 5232, 5134, 5037, 4946, 4865, 4795, 4738, 4693, 4660, 4639, 4630, 4632, 4645, 4665, 4692, 4723, 4757, 4794, 4835, 4882, 4934, 4994, 5061, 5134, 5213, 5297, 5383, 5470, 5553, 5631, 5699, 5754, 5792, 5809, 5803, 5771, 5714, 5633, 5531, 5413, 5286, 5155, 5027, 4907, 4800, 4707, 4632, 4574, 4535, 4516},
+	{4824, 4823, 4839, 4871, 4917, 4976, 5046, 5123, 5206, 5290, 5373, 5453, 5526, 5592, 5647, 5689, 5717, 5728, 5721, 5694, 5649, 5588, 5512, 5427, 5337, 5246, 5159, 5080, 5009, 4948, 4899, 4860, 4833, 4816, 4810, 4814, 4826, 4845, 4869, 4899, 4933, 4972, 5018, 5071, 5133, 5202, 5279, 5363, 5452, 5543, 5635, 5722, 5803, 5874, 5930, 5969, 5988, 5984, 5956, 5905, 5831, 5740, 5634, 5520, 5402, 5287, 5179, 5082, 4998, 4930, 4877, 4842, 4824},
+	{5122, 5121, 5135, 5162, 5202, 5252, 5310, 5375, 5443, 5512, 5580, 5644, 5702, 5752, 5793, 5823, 5840, 5844, 5832, 5805, 5763, 5708, 5641, 5566, 5486, 5405, 5326, 5251, 5183, 5123, 5071, 5030, 4998, 4975, 4963, 4959, 4964, 4976, 4995, 5021, 5052, 5090, 5136, 5190, 5252, 5322, 5401, 5485, 5575, 5666, 5757, 5844, 5924, 5993, 6048, 6087, 6106, 6105, 6082, 6039, 5977, 5899, 5810, 5713, 5613, 5516, 5424, 5341, 5269, 5211, 5166, 5137, 5122},
+	{5383, 5382, 5392, 5413, 5443, 5481, 5524, 5573, 5623, 5674, 5723, 5769, 5810, 5844, 5871, 5889, 5896, 5893, 5878, 5852, 5814, 5766, 5710, 5647, 5579, 5510, 5441, 5375, 5313, 5257, 5208, 5167, 5134, 5109, 5092, 5084, 5084, 5092, 5106, 5129, 5158, 5195, 5240, 5292, 5353, 5422, 5497, 5578, 5663, 5749, 5834, 5914, 5988, 6052, 6102, 6138, 6158, 6160, 6144, 6111, 6063, 6002, 5931, 5855, 5776, 5699, 5625, 5559, 5502, 5455, 5419, 5395, 5383},
+	{5586, 5583, 5589, 5601, 5620, 5644, 5672, 5703, 5735, 5768, 5798, 5826, 5851, 5870, 5884, 5891, 5891, 5882, 5866, 5841, 5809, 5769, 5724, 5673, 5619, 5564, 5508, 5453, 5402, 5354, 5311, 5274, 5243, 5219, 5203, 5193, 5191, 5196, 5209, 5229, 5256, 5290, 5332, 5381, 5437, 5500, 5567, 5639, 5714, 5789, 5862, 5932, 5995, 6049, 6093, 6126, 6144, 6149, 6141, 6119, 6086, 6044, 5994, 5939, 5882, 5825, 5771, 5722, 5679, 5643, 5616, 5597, 5586},
+	{5718, 5714, 5714, 5718, 5726, 5738, 5751, 5767, 5783, 5798, 5813, 5826, 5836, 5843, 5846, 5845, 5839, 5828, 5812, 5790, 5764, 5733, 5698, 5660, 5620, 5578, 5536, 5495, 5456, 5420, 5386, 5357, 5333, 5314, 5300, 5293, 5291, 5296, 5307, 5325, 5349, 5379, 5415, 5457, 5505, 5557, 5612, 5671, 5730, 5790, 5848, 5903, 5952, 5995, 6031, 6058, 6075, 6083, 6082, 6071, 6053, 6027, 5996, 5962, 5925, 5888, 5853, 5819, 5790, 5764, 5744, 5728, 5718},
+	{5780, 5773, 5769, 5767, 5767, 5769, 5772, 5775, 5779, 5783, 5785, 5787, 5787, 5786, 5782, 5775, 5766, 5755, 5740, 5722, 5702, 5680, 5655, 5629, 5602, 5574, 5546, 5519, 5493, 5469, 5447, 5427, 5412, 5399, 5391, 5387, 5388, 5393, 5403, 5418, 5437, 5461, 5489, 5521, 5557, 5595, 5635, 5677, 5720, 5762, 5802, 5841, 5876, 5907, 5933, 5954, 5969, 5978, 5982, 5980, 5973, 5962, 5947, 5929, 5910, 5890, 5869, 5850, 5831, 5815, 5801, 5789, 5780},
+	{5780, 5774, 5769, 5764, 5760, 5756, 5753, 5749, 5746, 5743, 5739, 5734, 5729, 5723, 5717, 5709, 5699, 5689, 5678, 5665, 5652, 5637, 5622, 5607, 5591, 5575, 5559, 5545, 5531, 5518, 5507, 5497, 5490, 5484, 5482, 5481, 5484, 5489, 5497, 5507, 5520, 5536, 5554, 5574, 5596, 5620, 5644, 5669, 5694, 5719, 5743, 5766, 5787, 5806, 5823, 5837, 5849, 5857, 5863, 5866, 5866, 5864, 5860, 5854, 5847, 5839, 5830, 5821, 5812, 5804, 5795, 5787, 5780},
+	{5736, 5733, 5729, 5725, 5721, 5717, 5712, 5708, 5704, 5699, 5694, 5689, 5684, 5679, 5673, 5667, 5661, 5654, 5648, 5641, 5635, 5628, 5621, 5614, 5608, 5602, 5596, 5591, 5586, 5582, 5578, 5576, 5574, 5573, 5573, 5575, 5577, 5580, 5585, 5590, 5596, 5604, 5612, 5620, 5630, 5640, 5650, 5660, 5671, 5681, 5691, 5701, 5710, 5718, 5726, 5733, 5740, 5745, 5749, 5753, 5755, 5757, 5758, 5758, 5757, 5756, 5754, 5752, 5750, 5747, 5743, 5740, 5736},
+	{5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664},
+};
+
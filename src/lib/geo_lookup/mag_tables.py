@@ -0,0 +1,301 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Generate the earth magnetic field lookup tables from the World Magnetic
+# Model coefficient file (WMM.COF, published by NOAA):
+#
+#   mag_tables.py WMM.COF [decimal year] > geo_magnetic_tables.h
+#
+# The date defaults to the epoch of the model. With --check the tables are
+# not printed, instead the error of the interpolated tables against the full
+# model is reported, and with --reference lat lon the full model is evaluated
+# at a single position.
+#
+
+# for python2.7 compatibility
+from __future__ import print_function
+
+import math
+import sys
+
+# grid spacing of the tables in degrees, has to divide 90 and 180
+SAMPLING_RES = 5
+
+# the tables store integers, these are the units
+DECLINATION_SCALE = 100.0	# 0.01 degrees
+INCLINATION_SCALE = 100.0	# 0.01 degrees
+STRENGTH_SCALE = 0.1		# 10 nT
+
+# WGS84 ellipsoid and the reference radius of the model, km
+WGS84_A = 6378.137
+WGS84_F = 1.0 / 298.257223563
+WGS84_E2 = WGS84_F * (2.0 - WGS84_F)
+MODEL_RADIUS = 6371.2
+
+
+def load_model(path):
+    """Read the epoch, name and Gauss coefficients g, h, dg/dt, dh/dt from a WMM.COF file."""
+    with open(path) as f:
+        header = f.readline().split()
+        epoch = float(header[0])
+        name = header[1]
+        coefficients = {}
+
+        for line in f:
+            fields = line.split()
+
+            if len(fields) < 6:
+                break
+
+            n, m = int(fields[0]), int(fields[1])
+            coefficients[(n, m)] = [float(x) for x in fields[2:6]]
+
+    degree = max(n for n, m in coefficients)
+    return epoch, name, degree, coefficients
+
+
+def legendre(degree, theta):
+    """Schmidt semi-normalised associated Legendre functions of cos(theta) and their derivatives by theta."""
+    cos_theta = math.cos(theta)
+    sin_theta = math.sin(theta)
+    p = {(0, 0): 1.0, (1, 0): cos_theta, (1, 1): sin_theta}
+    dp = {(0, 0): 0.0, (1, 0): -sin_theta, (1, 1): cos_theta}
+
+    for n in range(2, degree + 1):
+        k = math.sqrt((2.0 * n - 1.0) / (2.0 * n))
+        p[(n, n)] = k * sin_theta * p[(n - 1, n - 1)]
+        dp[(n, n)] = k * (cos_theta * p[(n - 1, n - 1)] + sin_theta * dp[(n - 1, n - 1)])
+
+        for m in range(0, n):
+            k = math.sqrt(n * n - m * m)
+            k2 = math.sqrt((n - 1) * (n - 1) - m * m)
+            p2 = p.get((n - 2, m), 0.0)
+            dp2 = dp.get((n - 2, m), 0.0)
+            p[(n, m)] = ((2 * n - 1) * cos_theta * p[(n - 1, m)] - k2 * p2) / k
+            dp[(n, m)] = ((2 * n - 1) * (cos_theta * dp[(n - 1, m)] - sin_theta * p[(n - 1, m)]) - k2 * dp2) / k
+
+    return p, dp
+
+
+def field(model, year, lat, lon, alt=0.0):
+    """North, east and down field components in nT at the geodetic position, degrees and km."""
+    epoch, name, degree, coefficients = model
+
+    # the poles are singular in longitude, approach them along the meridian
+    lat = max(-89.99999, min(89.99999, lat))
+    lat_rad = math.radians(lat)
+    lon_rad = math.radians(lon)
+
+    # geodetic to geocentric spherical coordinates
+    rc = WGS84_A / math.sqrt(1.0 - WGS84_E2 * math.sin(lat_rad) ** 2)
+    p = (rc + alt) * math.cos(lat_rad)
+    z = (rc * (1.0 - WGS84_E2) + alt) * math.sin(lat_rad)
+    r = math.sqrt(p * p + z * z)
+    lat_c = math.asin(z / r)
+    theta = math.pi / 2.0 - lat_c
+
+    leg, dleg = legendre(degree, theta)
+    x = y = z = 0.0
+
+    for n in range(1, degree + 1):
+        ratio = (MODEL_RADIUS / r) ** (n + 2)
+
+        for m in range(0, n + 1):
+            g, h, dg, dh = coefficients[(n, m)]
+            g += (year - epoch) * dg
+            h += (year - epoch) * dh
+            cos_m = math.cos(m * lon_rad)
+            sin_m = math.sin(m * lon_rad)
+
+            x += ratio * (g * cos_m + h * sin_m) * dleg[(n, m)]
+            y += ratio * m * (g * sin_m - h * cos_m) * leg[(n, m)] / math.sin(theta)
+            z -= ratio * (n + 1) * (g * cos_m + h * sin_m) * leg[(n, m)]
+
+    # rotate from the geocentric to the geodetic frame
+    psi = lat_c - lat_rad
+    return (x * math.cos(psi) - z * math.sin(psi), y, x * math.sin(psi) + z * math.cos(psi))
+
+
+def elements(model, year, lat, lon):
+    """Declination and inclination in degrees, total intensity in nT."""
+    north, east, down = field(model, year, lat, lon)
+    horizontal = math.sqrt(north * north + east * east)
+    return (math.degrees(math.atan2(east, north)), math.degrees(math.atan2(down, horizontal)),
+            math.sqrt(horizontal * horizontal + down * down))
+
+
+def make_tables(model, year):
+    """Quantised declination, inclination and strength tables, rows from south to north, columns from west to east."""
+    lats = range(-90, 90 + 1, SAMPLING_RES)
+    lons = range(-180, 180 + 1, SAMPLING_RES)
+    tables = ([], [], [])
+
+    for lat in lats:
+        rows = ([], [], [])
+
+        for lon in lons:
+            declination, inclination, strength = elements(model, year, lat, lon)
+            rows[0].append(int(round(declination * DECLINATION_SCALE)))
+            rows[1].append(int(round(inclination * INCLINATION_SCALE)))
+            rows[2].append(int(round(strength * STRENGTH_SCALE)))
+
+        for table, row in zip(tables, rows):
+            table.append(row)
+
+    return tables
+
+
+def interpolate(table, lat, lon, angle):
+    """The lookup of geo_mag_declination.c"""
+    lat_pos = (lat + 90.0) / SAMPLING_RES
+    lon_pos = (lon + 180.0) / SAMPLING_RES
+    lat_index = min(int(lat_pos), len(table) - 2)
+    lon_index = min(int(lon_pos), len(table[0]) - 2)
+    lat_frac = lat_pos - lat_index
+    lon_frac = lon_pos - lon_index
+
+    sw = table[lat_index][lon_index]
+    corners = [table[lat_index][lon_index + 1], table[lat_index + 1][lon_index + 1], table[lat_index + 1][lon_index]]
+
+    if angle:
+        corners = [c - 36000 if c - sw > 18000 else c + 36000 if c - sw < -18000 else c for c in corners]
+
+    se, ne, nw = corners
+    south = sw + lon_frac * (se - sw)
+    north = nw + lon_frac * (ne - nw)
+    value = south + lat_frac * (north - south)
+
+    if angle and value > 18000:
+        value -= 36000
+
+    elif angle and value < -18000:
+        value += 36000
+
+    return value
+
+
+def check(model, year, tables):
+    """Print the interpolation error over a grid offset from the table grid to stderr."""
+    names = ('declination (deg)', 'inclination (deg)', 'strength (nT)')
+    scales = (DECLINATION_SCALE, INCLINATION_SCALE, STRENGTH_SCALE)
+
+    # the declination is of no use close to the magnetic poles, report the rest separately
+    for lat_limit in (60, 80):
+        errors = ([], [], [])
+        lat = -lat_limit + 0.35
+
+        while lat < lat_limit:
+            lon = -180.0 + 0.45
+
+            while lon < 180.0:
+                exact = elements(model, year, lat, lon)
+
+                for i in range(3):
+                    error = interpolate(tables[i], lat, lon, i == 0) / scales[i] - exact[i]
+
+                    if i == 0:
+                        error = (error + 180.0) % 360.0 - 180.0
+
+                    errors[i].append(abs(error))
+
+                lon += 1.3
+
+            lat += 1.1
+
+        for name, error in zip(names, errors):
+            print('|lat| < %d: %s error mean %.3f, max %.3f' % (lat_limit, name, sum(error) / len(error), max(error)),
+                  file=sys.stderr)
+
+
+def print_table(name, ctype, table, unit):
+    print('/* %s */' % unit)
+    print('static const %s %s[%d][%d] = {' % (ctype, name, len(table), len(table[0])))
+
+    for row in table:
+        print('\t{%s},' % ', '.join(str(v) for v in row))
+
+    print('};')
+    print('')
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith('--')]
+    options = [a for a in sys.argv[1:] if a.startswith('--')]
+
+    if not args:
+        print('usage: %s WMM.COF [decimal year] [--check | --reference lat lon]' % sys.argv[0], file=sys.stderr)
+        sys.exit(1)
+
+    model = load_model(args[0])
+    epoch, name = model[0], model[1]
+
+    if '--reference' in options:
+        year = float(args[3]) if len(args) > 3 else epoch
+        declination, inclination, strength = elements(model, year, float(args[1]), float(args[2]))
+        print('%.4f %.4f %.1f' % (declination, inclination, strength))
+        return
+
+    year = float(args[1]) if len(args) > 1 else epoch
+    tables = make_tables(model, year)
+
+    if '--check' in options:
+        check(model, year, tables)
+        return
+
+    print('/*')
+    print('* This file is automatically generated by mag_tables.py - do not edit.')
+    print('*')
+    print('* %s evaluated for %.1f at sea level on a %d degree grid,' % (name, year, SAMPLING_RES))
+    print('* rows from %d to %d latitude, columns from %d to %d longitude.' % (-90, 90, -180, 180))
+    print('*/')
+    print('')
+    print('#pragma once')
+    print('')
+    print('#define SAMPLING_RES\t\t%d' % SAMPLING_RES)
+    print('#define SAMPLING_MIN_LAT\t%d' % -90)
+    print('#define SAMPLING_MAX_LAT\t%d' % 90)
+    print('#define SAMPLING_MIN_LON\t%d' % -180)
+    print('#define SAMPLING_MAX_LON\t%d' % 180)
+    print('')
+    print('#define LAT_DIM\t\t\t%d' % len(tables[0]))
+    print('#define LON_DIM\t\t\t%d' % len(tables[0][0]))
+    print('')
+    print_table('declination_table', 'int16_t', tables[0], 'declination in 0.01 degrees, positive east')
+    print_table('inclination_table', 'int16_t', tables[1], 'inclination in 0.01 degrees, positive down')
+    print_table('strength_table', 'int16_t', tables[2], 'total intensity in 10 nT')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,260 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BiquadFilterBank.hpp
+ *
+ * Second order filters applied to several channels at once, for the axes
+ * of a sensor sampled together.
+ */
+
+#pragma once
+
+#include <px4_defines.h>
+#include <math.h>
+
+namespace math
+{
+
+/**
+ * N channels filtered by the same biquad (direct form II).
+ *
+ * The filter state is kept in one array per delay element, so a sample of all
+ * channels is processed by loops over contiguous data that the compiler can
+ * unroll and vectorise. Each channel computes exactly what a scalar filter
+ * with the same coefficients would.
+ */
+template <unsigned N>
+class __EXPORT BiquadFilterBank
+{
+public:
+	BiquadFilterBank() :
+		_passthrough(true),
+		_a1(0.0f),
+		_a2(0.0f),
+		_b0(1.0f),
+		_b1(0.0f),
+		_b2(0.0f)
+	{
+		for (unsigned i = 0; i < N; i++) {
+			_delay_element_1[i] = 0.0f;
+			_delay_element_2[i] = 0.0f;
+		}
+	}
+
+	/**
+	 * Add a new raw sample of all channels to the filter
+	 *
+	 * @param samples	in: raw sample, out: filtered sample
+	 */
+	void apply(float samples[N])
+	{
+		if (_passthrough) {
+			return;
+		}
+
+		float delay_element_0[N];
+		float sum = 0.0f;
+
+		for (unsigned i = 0; i < N; i++) {
+			delay_element_0[i] = samples[i] - _delay_element_1[i] * _a1 - _delay_element_2[i] * _a2;
+			sum += delay_element_0[i];
+		}
+
+		// a non-finite value in any channel makes the sum non-finite
+		if (!PX4_ISFINITE(sum)) {
+			for (unsigned i = 0; i < N; i++) {
+				if (!PX4_ISFINITE(delay_element_0[i])) {
+					// don't allow bad values to propagate via the filter
+					delay_element_0[i] = samples[i];
+				}
+			}
+		}
+
+		for (unsigned i = 0; i < N; i++) {
+			samples[i] = delay_element_0[i] * _b0 + _delay_element_1[i] * _b1 + _delay_element_2[i] * _b2;
+			_delay_element_2[i] = _delay_element_1[i];
+			_delay_element_1[i] = delay_element_0[i];
+		}
+	}
+
+	/**
+	 * Reset the filter state to the steady state for these samples
+	 *
+	 * @param samples	in: sample to settle on, out: filtered sample
+	 */
+	void reset(float samples[N])
+	{
+		if (!_passthrough) {
+			for (unsigned i = 0; i < N; i++) {
+				float dval = samples[i] / (_b0 + _b1 + _b2);
+				_delay_element_1[i] = dval;
+				_delay_element_2[i] = dval;
+			}
+		}
+
+		apply(samples);
+	}
+
+protected:
+	/**
+	 * Set the coefficients, normalised to a0 = 1. The filter state is kept.
+	 */
+	void set_coefficients(float a1, float a2, float b0, float b1, float b2)
+	{
+		_passthrough = false;
+		_a1 = a1;
+		_a2 = a2;
+		_b0 = b0;
+		_b1 = b1;
+		_b2 = b2;
+	}
+
+	/**
+	 * Pass samples through unmodified.
+	 */
+	void set_passthrough() { _passthrough = true; }
+
+private:
+	bool		_passthrough;
+	float		_a1;
+	float		_a2;
+	float		_b0;
+	float		_b1;
+	float		_b2;
+	float		_delay_element_1[N];	// buffered sample -1
+	float		_delay_element_2[N];	// buffered sample -2
+};
+
+/**
+ * Second order Butterworth low pass on N channels, the same filter as
+ * LowPassFilter2p.
+ */
+template <unsigned N>
+class __EXPORT LowPassFilter2pBank : public BiquadFilterBank<N>
+{
+public:
+	LowPassFilter2pBank(float sample_freq, float cutoff_freq) :
+		_cutoff_freq(cutoff_freq)
+	{
+		set_cutoff_frequency(sample_freq, cutoff_freq);
+	}
+
+	/**
+	 * Change filter parameters, a cutoff of 0 disables filtering
+	 */
+	void set_cutoff_frequency(float sample_freq, float cutoff_freq)
+	{
+		_cutoff_freq = cutoff_freq;
+
+		if (_cutoff_freq <= 0.0f) {
+			// no filtering
+			this->set_passthrough();
+			return;
+		}
+
+		float fr = sample_freq / _cutoff_freq;
+		float ohm = tanf(M_PI_F / fr);
+		float c = 1.0f + 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm;
+		float b0 = ohm * ohm / c;
+		this->set_coefficients(2.0f * (ohm * ohm - 1.0f) / c,
+				       (1.0f - 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm) / c,
+				       b0, 2.0f * b0, b0);
+	}
+
+	/**
+	 * Return the cutoff frequency
+	 */
+	float get_cutoff_freq() const { return _cutoff_freq; }
+
+private:
+	float		_cutoff_freq;
+};
+
+/**
+ * Second order notch on N channels, to remove a narrow band such as a
+ * propeller vibration. Coefficients follow the RBJ audio EQ cookbook.
+ */
+template <unsigned N>
+class __EXPORT NotchFilterBank : public BiquadFilterBank<N>
+{
+public:
+	NotchFilterBank(float sample_freq, float notch_freq, float bandwidth) :
+		_notch_freq(notch_freq),
+		_bandwidth(bandwidth)
+	{
+		set_notch_frequency(sample_freq, notch_freq, bandwidth);
+	}
+
+	/**
+	 * Change filter parameters
+	 *
+	 * @param sample_freq	Sample rate in Hz.
+	 * @param notch_freq	Centre frequency in Hz, 0 disables filtering.
+	 * @param bandwidth	Width of the notch at -3 dB in Hz.
+	 */
+	void set_notch_frequency(float sample_freq, float notch_freq, float bandwidth)
+	{
+		_notch_freq = notch_freq;
+		_bandwidth = bandwidth;
+
+		if (notch_freq <= 0.0f || bandwidth <= 0.0f || notch_freq >= sample_freq / 2.0f) {
+			// no filtering
+			this->set_passthrough();
+			return;
+		}
+
+		float w0 = 2.0f * M_PI_F * notch_freq / sample_freq;
+		float alpha = sinf(w0) * bandwidth / (2.0f * notch_freq);
+		float a0 = 1.0f + alpha;
+		float cos_w0 = cosf(w0);
+		this->set_coefficients(-2.0f * cos_w0 / a0, (1.0f - alpha) / a0,
+				       1.0f / a0, -2.0f * cos_w0 / a0, 1.0f / a0);
+	}
+
+	/**
+	 * Return the centre frequency
+	 */
+	float get_notch_freq() const { return _notch_freq; }
+
+	/**
+	 * Return the notch width
+	 */
+	float get_bandwidth() const { return _bandwidth; }
+
+private:
+	float		_notch_freq;
+	float		_bandwidth;
+};
+
+} // namespace math
@@ -581,7 +581,7 @@ dsm_input(int fd, uint16_t *values, uint16_t *num_values, bool *dsm_11_bit, uint
 }
 
 bool
-dsm_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
+dsm_parse(uint64_t now, const uint8_t *frame, unsigned len, uint16_t *values,
 	  uint16_t *num_values, bool *dsm_11_bit, unsigned *frame_drops, uint16_t max_channels)
 {
 	// persistent set of channel values in case caller has values array on stack
@@ -645,12 +645,25 @@ dsm_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 				dsm_partial_frame_count = 0;
 				dsm_chan_count = 0;
 				dsm_frame[dsm_partial_frame_count++] = frame[d];
+
+			} else {
+				/* the whole buffer shares the timestamp, nothing else in it can start a frame */
+				d = len - 1;
 			}
 
 			break;
 
 		case DSM_DECODE_STATE_SYNC: {
-				dsm_frame[dsm_partial_frame_count++] = frame[d];
+				/* take as much of the frame as the buffer holds */
+				unsigned n = DSM_FRAME_SIZE - dsm_partial_frame_count;
+
+				if (n > len - d) {
+					n = len - d;
+				}
+
+				memcpy(&dsm_frame[dsm_partial_frame_count], &frame[d], n);
+				dsm_partial_frame_count += n;
+				d += n - 1;
 
 				/* decode whatever we got and expect */
 				if (dsm_partial_frame_count < DSM_FRAME_SIZE) {
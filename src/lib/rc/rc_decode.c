@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rc_decode.c
+ *
+ * Common entry point to the serial RC protocol decoders.
+ */
+
+#include <px4_config.h>
+#include <drivers/drv_rc_input.h>
+
+#include "rc_decode.h"
+#include "sbus.h"
+#include "dsm.h"
+#include "st24.h"
+#include "sumd.h"
+#include "srxl.h"
+
+unsigned
+rc_decode(uint64_t now, const uint8_t *buf, unsigned len, unsigned decoders,
+	  uint16_t *values, uint16_t max_values, struct rc_decode_s *result)
+{
+	unsigned decoded = 0;
+
+	/* run the least preferred decoder first, so that the preferred one writes the values last */
+	for (int d = RC_DECODER_COUNT - 1; d >= 0; d--) {
+
+		if (!(decoders & RC_DECODER_MASK(d))) {
+			continue;
+		}
+
+		struct rc_decode_s frame = { .decoder = (enum RC_DECODER)d, .rssi = -1 };
+		bool updated = false;
+
+		switch (d) {
+		case RC_DECODER_SBUS:
+			updated = sbus_parse(now, buf, len, values, &frame.num_values, &frame.failsafe, &frame.frame_drop,
+					     &frame.frame_drops, max_values);
+			break;
+
+		case RC_DECODER_ST24: {
+				uint8_t rssi = RC_INPUT_RSSI_MAX;
+				uint8_t rx_count = 0;
+				updated = st24_parse(buf, len, &rssi, &rx_count, &frame.num_values, values, max_values);
+				frame.rssi = rssi;
+			}
+			break;
+
+		case RC_DECODER_SUMD: {
+				uint8_t rssi = RC_INPUT_RSSI_MAX;
+				uint8_t rx_count = 0;
+				updated = sumd_parse(buf, len, &rssi, &rx_count, &frame.num_values, values, max_values);
+				frame.rssi = rssi;
+			}
+			break;
+
+		case RC_DECODER_SRXL: {
+				uint8_t num_values = 0;
+				updated = srxl_parse(now, buf, len, &num_values, values, max_values, &frame.failsafe);
+				frame.num_values = num_values;
+			}
+			break;
+
+		case RC_DECODER_DSM:
+			updated = dsm_parse(now, buf, len, values, &frame.num_values, &frame.dsm_11_bit, &frame.frame_drops,
+					    max_values);
+			break;
+
+		default:
+			break;
+		}
+
+		if (updated) {
+			*result = frame;
+			decoded |= RC_DECODER_MASK(d);
+		}
+	}
+
+	return decoded;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rc_decode.h
+ *
+ * Common entry point to the serial RC protocol decoders.
+ *
+ * Protocols sharing a UART configuration can be auto-detected by running
+ * their decoders over the same receive buffer and taking whichever one
+ * decodes a frame first.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+__BEGIN_DECLS
+
+/**
+ * Serial RC decoders, in order of preference when more than one of them
+ * decodes a frame from the same buffer. Protocols with a checksum come
+ * first, as S.BUS and DSM frames can be guessed from other protocols' data.
+ */
+enum RC_DECODER {
+	RC_DECODER_ST24 = 0,
+	RC_DECODER_SUMD,
+	RC_DECODER_SRXL,
+	RC_DECODER_SBUS,
+	RC_DECODER_DSM,
+	RC_DECODER_COUNT
+};
+
+#define RC_DECODER_MASK(_d)	(1u << (_d))
+
+/** decoders expecting 115200 baud, 8N1, non-inverted input as set up by dsm_config() */
+#define RC_DECODERS_115200	(RC_DECODER_MASK(RC_DECODER_ST24) | RC_DECODER_MASK(RC_DECODER_SUMD) | \
+				 RC_DECODER_MASK(RC_DECODER_SRXL) | RC_DECODER_MASK(RC_DECODER_DSM))
+
+/** frame details reported alongside the channel values */
+struct rc_decode_s {
+	enum RC_DECODER	decoder;	/**< decoder the channel values came from */
+	uint16_t	num_values;	/**< number of channel values */
+	int		rssi;		/**< 0..RC_INPUT_RSSI_MAX, -1 if the protocol does not report it */
+	bool		failsafe;	/**< receiver reports failsafe */
+	bool		frame_drop;	/**< receiver reports a dropped frame */
+	bool		dsm_11_bit;	/**< DSM frame used 11 bit resolution */
+	unsigned	frame_drops;	/**< frames dropped by the decoder so far */
+};
+
+/**
+ * Run a set of decoders over the same receive buffer.
+ *
+ * Every selected decoder consumes the whole buffer, so the ones that do not
+ * match the received protocol keep resyncing and cost little more than a
+ * scan for their start byte.
+ *
+ * @param now time the buffer was received, used by the protocols framed by gaps
+ * @param buf received bytes
+ * @param len number of bytes in buf
+ * @param decoders RC_DECODER_MASK() of the decoders to run
+ * @param values array of max_values where the channel values are written back to
+ * @param max_values maximum number of channel values
+ * @param result frame details of the preferred decoder that decoded a frame
+ * @return RC_DECODER_MASK() of the decoders that decoded a frame, 0 if none did
+ */
+__EXPORT unsigned rc_decode(uint64_t now, const uint8_t *buf, unsigned len, unsigned decoders,
+			    uint16_t *values, uint16_t max_values, struct rc_decode_s *result);
+
+__END_DECLS
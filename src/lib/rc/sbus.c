@@ -275,7 +275,7 @@ sbus_input(int sbus_fd, uint16_t *values, uint16_t *num_values, bool *sbus_fails
 }
 
 bool
-sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
+sbus_parse(uint64_t now, const uint8_t *frame, unsigned len, uint16_t *values,
 	   uint16_t *num_values, bool *sbus_failsafe, bool *sbus_frame_drop, unsigned *frame_drops, uint16_t max_channels)
 {
 
@@ -321,15 +321,21 @@ sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 #endif
 
 		switch (sbus_decode_state) {
-		case SBUS2_DECODE_STATE_DESYNC:
+		case SBUS2_DECODE_STATE_DESYNC: {
+				/* we are de-synced and only interested in the frame marker */
+				const uint8_t *start = (const uint8_t *)memchr(&frame[d], SBUS_START_SYMBOL, len - d);
 
-			/* we are de-synced and only interested in the frame marker */
-			if (frame[d] == SBUS_START_SYMBOL) {
+				if (start == NULL) {
+					/* nothing to sync on in the rest of the buffer */
+					d = len - 1;
+					break;
+				}
+
+				d = start - frame;
 				sbus_decode_state = SBUS2_DECODE_STATE_SBUS_START;
 				partial_frame_count = 0;
 				sbus_frame[partial_frame_count++] = frame[d];
 			}
-
 			break;
 
 		/* fall through */
@@ -338,7 +344,16 @@ sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 
 		/* fall through */
 		case SBUS2_DECODE_STATE_SBUS2_SYNC: {
-				sbus_frame[partial_frame_count++] = frame[d];
+				/* take as much of the frame as the buffer holds */
+				unsigned n = SBUS_FRAME_SIZE - partial_frame_count;
+
+				if (n > len - d) {
+					n = len - d;
+				}
+
+				memcpy(&sbus_frame[partial_frame_count], &frame[d], n);
+				partial_frame_count += n;
+				d += n - 1;
 
 				/* decode whatever we got and expect */
 				if (partial_frame_count < SBUS_FRAME_SIZE) {
@@ -357,6 +357,62 @@ int srxl_decode(uint64_t timestamp_us, uint8_t byte, uint8_t *num_values, uint16
 }
 
 
+/**
+ * Decode SRXL frames from a whole receive buffer
+ *
+ * Equivalent to calling srxl_decode() for every byte with the same timestamp. As there
+ * is no frame gap between bytes of one buffer, bytes outside of a frame are dropped at once
+ * and frame data is collected without going through the state machine.
+ *
+ * @param[in]  timestamp_us - timestamp in microseconds
+ * @param[in]  buf - received bytes
+ * @param[in]  len - number of bytes in buf
+ * @param[out] num_values - number of RC channels extracted from srxl frame
+ * @param[out] values - array of RC channels with refreshed information as pulsewidth in microseconds Range: 800us - 2200us
+ * @param[in]  max_values - maximum number of values supported by pixhawk
+ * @param[out] failsafe_state - true: RC-receiver is in failsafe state, false: RC-receiver is not in failsafe state
+ * @return true if at least one frame was decoded, the outputs hold the last one
+ */
+bool srxl_parse(uint64_t timestamp_us, const uint8_t *buf, unsigned len, uint8_t *num_values, uint16_t *values, uint16_t max_values, bool *failsafe_state)
+{
+    bool decoded = false;
+    unsigned i = 0;
+
+    while (i < len) {
+        if ((timestamp_us - last_data_us) < SRXL_MIN_FRAMESPACE_US) {
+            if (decode_state == STATE_IDLE && decode_state_next == STATE_IDLE) {
+                /* no frame gap within the buffer --> nothing left can start a frame */
+                last_data_us = timestamp_us;
+                break;
+            }
+
+            if (decode_state == STATE_COLLECT && (buflen + 1U) < frame_len_full) {
+                /* collect everything but the last frame byte, which completes the frame below */
+                unsigned n = frame_len_full - 1U - buflen;
+                if (n > len - i) {
+                    n = len - i;
+                }
+                for (unsigned j = 0; j < n; j++) {
+                    if (buflen < (frame_len_full - 2)) {
+                        crc_fmu = srxl_crc16(crc_fmu, buf[i + j]);
+                    }
+                    buffer[buflen++] = buf[i + j];
+                }
+                last_data_us = timestamp_us;
+                i += n;
+                continue;
+            }
+        }
+
+        if (srxl_decode(timestamp_us, buf[i], num_values, values, max_values, failsafe_state) == 0) {
+            decoded = true;
+        }
+        i++;
+    }
+
+    return decoded;
+}
+
 
 #ifdef TEST_MAIN_PROGRAM
 /*
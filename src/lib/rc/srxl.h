@@ -38,6 +38,13 @@ __BEGIN_DECLS
  */
 __EXPORT int srxl_decode(uint64_t timestamp_us, uint8_t byte, uint8_t *num_values, uint16_t *values, uint16_t max_values, bool *failsafe_state);
 
+/*
+ * Decoder for SRXL protocol, consuming a whole receive buffer received at timestamp_us
+ *
+ * @return true if at least one frame was decoded, the outputs hold the last one
+ */
+__EXPORT bool srxl_parse(uint64_t timestamp_us, const uint8_t *buf, unsigned len, uint8_t *num_values, uint16_t *values, uint16_t max_values, bool *failsafe_state);
+
 __END_DECLS
 
 #endif
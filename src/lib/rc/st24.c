@@ -41,6 +41,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "st24.h"
 
 enum ST24_DECODE_STATE {
@@ -132,8 +133,9 @@ int st24_decode(uint8_t byte, uint8_t *rssi, uint8_t *rx_count, uint16_t *channe
 
 	case ST24_DECODE_STATE_GOT_STX2:
 
-		/* ensure no data overflow failure or hack is possible */
-		if ((unsigned)byte <= sizeof(_rxpacket.length) + sizeof(_rxpacket.type) + sizeof(_rxpacket.st24_data)) {
+		/* ensure no data overflow failure or hack is possible, and that there is room for type and crc */
+		if ((unsigned)byte <= sizeof(_rxpacket.length) + sizeof(_rxpacket.type) + sizeof(_rxpacket.st24_data)
+		    && byte >= 3) {
 			_rxpacket.length = byte;
 			_rxlen = 0;
 			_decode_state = ST24_DECODE_STATE_GOT_LEN;
@@ -252,3 +254,49 @@ int st24_decode(uint8_t byte, uint8_t *rssi, uint8_t *rx_count, uint16_t *channe
 
 	return ret;
 }
+
+bool st24_parse(const uint8_t *buf, unsigned len, uint8_t *rssi, uint8_t *rx_count, uint16_t *channel_count,
+		uint16_t *channels, uint16_t max_chan_count)
+{
+	bool decoded = false;
+	unsigned i = 0;
+
+	while (i < len) {
+		if (_decode_state == ST24_DECODE_STATE_UNSYNCED) {
+			/* skip straight to the next start byte */
+			const uint8_t *stx = (const uint8_t *)memchr(&buf[i], ST24_STX1, len - i);
+
+			if (stx == NULL) {
+				break;
+			}
+
+			i = stx - buf;
+
+		} else if (_decode_state == ST24_DECODE_STATE_GOT_TYPE) {
+			/* copy as much of the payload as we have, the crc byte completes the packet */
+			unsigned n = (_rxpacket.length - 1) - _rxlen;
+
+			if (n > len - i) {
+				n = len - i;
+			}
+
+			memcpy(&_rxpacket.st24_data[_rxlen - 1], &buf[i], n);
+			_rxlen += n;
+			i += n;
+
+			if (_rxlen == (_rxpacket.length - 1)) {
+				_decode_state = ST24_DECODE_STATE_GOT_DATA;
+			}
+
+			continue;
+		}
+
+		if (st24_decode(buf[i], rssi, rx_count, channel_count, channels, max_chan_count) == 0) {
+			decoded = true;
+		}
+
+		i++;
+	}
+
+	return decoded;
+}
@@ -41,6 +41,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "sumd.h"
 
 
@@ -363,3 +364,58 @@ int sumd_decode(uint8_t byte, uint8_t *rssi, uint8_t *rx_count, uint16_t *channe
 
 	return ret;
 }
+
+bool sumd_parse(const uint8_t *buf, unsigned len, uint8_t *rssi, uint8_t *rx_count, uint16_t *channel_count,
+		uint16_t *channels, uint16_t max_chan_count)
+{
+	bool decoded = false;
+	unsigned i = 0;
+
+	while (i < len) {
+		if (_decode_state == SUMD_DECODE_STATE_UNSYNCED) {
+			/* skip straight to the next header byte */
+			const uint8_t *header = (const uint8_t *)memchr(&buf[i], SUMD_HEADER_ID, len - i);
+
+			if (header == NULL) {
+				break;
+			}
+
+			i = header - buf;
+
+		} else if (_decode_state == SUMD_DECODE_STATE_GOT_LEN && !_debug) {
+			/* channel data up to, but not including, the last byte which changes state */
+			unsigned n = _rxpacket.length * 2 - _rxlen;
+
+			if (n > len - i) {
+				n = len - i;
+			}
+
+			for (unsigned j = 0; j < n; j++) {
+				uint8_t byte = buf[i + j];
+				_rxpacket.sumd_data[_rxlen + j] = byte;
+
+				if (_sumd) {
+					_crc16 = sumd_crc16(_crc16, byte);
+
+				} else {
+					_crc8 = sumd_crc8(_crc8, byte);
+				}
+			}
+
+			_rxlen += n;
+			i += n;
+
+			if (i == len) {
+				break;
+			}
+		}
+
+		if (sumd_decode(buf[i], rssi, rx_count, channel_count, channels, max_chan_count) == 0) {
+			decoded = true;
+		}
+
+		i++;
+	}
+
+	return decoded;
+}
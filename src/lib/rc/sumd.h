@@ -42,6 +42,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 __BEGIN_DECLS
 
@@ -104,5 +105,22 @@ __EXPORT int sumd_decode(uint8_t byte, uint8_t *rssi, uint8_t *rx_count, uint16_
 __EXPORT int sumd_decode(uint8_t byte, uint8_t *rssi, uint8_t *rx_count, uint16_t *channel_count,
 			 uint16_t *channels, uint16_t max_chan_count);
 
+/**
+ * Decoder for SUMD/SUMH protocol, consuming a whole receive buffer
+ *
+ * Equivalent to passing every byte to sumd_decode(), but skips to the next
+ * header byte while out of sync and runs the channel data through the
+ * checksum without going through the state machine.
+ *
+ * @param buf received bytes
+ * @param len number of bytes in buf
+ * @param rssi pointer to a byte where the RSSI value is written back to
+ * @param rx_count pointer to a byte where the receive count of packets since last wireless frame is written back to
+ * @param channels pointer to a datastructure of size max_chan_count where channel values (12 bit) are written back to
+ * @param max_chan_count maximum channels to decode
+ * @return true if at least one packet was decoded, the outputs hold the last one
+ */
+__EXPORT bool sumd_parse(const uint8_t *buf, unsigned len, uint8_t *rssi, uint8_t *rx_count, uint16_t *channel_count,
+			 uint16_t *channels, uint16_t max_chan_count);
 
 __END_DECLS
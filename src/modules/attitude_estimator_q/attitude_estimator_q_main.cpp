@@ -72,6 +72,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/err.h>
 #include <systemlib/mavlink_log.h>
 
@@ -608,6 +609,7 @@ void AttitudeEstimatorQ::task_main()
 			struct control_state_s ctrl_state = {};
 
 			ctrl_state.timestamp = sensors.timestamp;
+			ctrl_state.timestamp_sample = sensors.timestamp;
 
 			/* attitude quaternions for control state */
 			ctrl_state.q[0] = _q(0);
@@ -636,6 +638,7 @@ void AttitudeEstimatorQ::task_main()
 			int ctrl_inst;
 			/* publish to control state topic */
 			orb_publish_auto(ORB_ID(control_state), &_ctrl_state_pub, &ctrl_state, &ctrl_inst, ORB_PRIO_HIGH);
+			latency_trace_record(LATENCY_STAGE_ESTIMATOR, ctrl_state.timestamp_sample);
 		}
 
 		{
@@ -0,0 +1,403 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file calibration_fit.cpp
+ * Sphere and ellipsoid fits to a stream of points.
+ */
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+#include "calibration_fit.h"
+
+/* index of the product of monomials i <= j in sum_product */
+static unsigned product_index(unsigned i, unsigned j)
+{
+	return i * calibration_fit_monomials - i * (i - 1) / 2 + (j - i);
+}
+
+static double sum_product(const struct calibration_fit_s *fit, unsigned i, unsigned j)
+{
+	return (i <= j) ? fit->sum_product[product_index(i, j)] : fit->sum_product[product_index(j, i)];
+}
+
+void calibration_fit_reset(struct calibration_fit_s *fit)
+{
+	memset(fit, 0, sizeof(*fit));
+}
+
+void calibration_fit_add(struct calibration_fit_s *fit, float x, float y, float z)
+{
+	const double dx = x;
+	const double dy = y;
+	const double dz = z;
+	const double u[calibration_fit_monomials] = {dx * dx, dy * dy, dz * dz, dx * dy, dx * dz, dy * dz, dx, dy, dz};
+
+	double *product = fit->sum_product;
+
+	for (unsigned i = 0; i < calibration_fit_monomials; i++) {
+		fit->sum[i] += u[i];
+
+		for (unsigned j = i; j < calibration_fit_monomials; j++) {
+			*product++ += u[i] * u[j];
+		}
+	}
+
+	fit->count++;
+}
+
+int sphere_fit_least_squares(const struct calibration_fit_s *fit, unsigned int max_iterations, float delta,
+			     float *sphere_x, float *sphere_y, float *sphere_z, float *sphere_radius)
+{
+	if (fit->count == 0) {
+		return 1;
+	}
+
+	const double size = fit->count;
+
+	//
+	//Least Squares Fit a sphere A,B,C with radius squared Rsq to 3D data
+	//
+	//    A is the x coordiante of the sphere
+	//    B is the y coordiante of the sphere
+	//    C is the z coordiante of the sphere
+	//    Rsq is the radius squared of the sphere.
+	//
+	//This method should converge; maybe 5-100 iterations or more.
+	//
+	float x_sum = fit->sum[6] / size;        //sum( X[n] )
+	float x_sum2 = fit->sum[0] / size;    //sum( X[n]^2 )
+	float x_sum3 = sum_product(fit, 0, 6) / size;    //sum( X[n]^3 )
+	float y_sum = fit->sum[7] / size;        //sum( Y[n] )
+	float y_sum2 = fit->sum[1] / size;    //sum( Y[n]^2 )
+	float y_sum3 = sum_product(fit, 1, 7) / size;    //sum( Y[n]^3 )
+	float z_sum = fit->sum[8] / size;        //sum( Z[n] )
+	float z_sum2 = fit->sum[2] / size;    //sum( Z[n]^2 )
+	float z_sum3 = sum_product(fit, 2, 8) / size;    //sum( Z[n]^3 )
+
+	float XY = fit->sum[3] / size;        //sum( X[n] * Y[n] )
+	float XZ = fit->sum[4] / size;        //sum( X[n] * Z[n] )
+	float YZ = fit->sum[5] / size;        //sum( Y[n] * Z[n] )
+	float X2Y = sum_product(fit, 0, 7) / size;    //sum( X[n]^2 * Y[n] )
+	float X2Z = sum_product(fit, 0, 8) / size;    //sum( X[n]^2 * Z[n] )
+	float Y2X = sum_product(fit, 1, 6) / size;    //sum( Y[n]^2 * X[n] )
+	float Y2Z = sum_product(fit, 1, 8) / size;    //sum( Y[n]^2 * Z[n] )
+	float Z2X = sum_product(fit, 2, 6) / size;    //sum( Z[n]^2 * X[n] )
+	float Z2Y = sum_product(fit, 2, 7) / size;    //sum( Z[n]^2 * Y[n] )
+
+	//Reduction of multiplications
+	float F0 = x_sum2 + y_sum2 + z_sum2;
+	float F1 =  0.5f * F0;
+	float F2 = -8.0f * (x_sum3 + Y2X + Z2X);
+	float F3 = -8.0f * (X2Y + y_sum3 + Z2Y);
+	float F4 = -8.0f * (X2Z + Y2Z + z_sum3);
+
+	//Set initial conditions:
+	float A = x_sum;
+	float B = y_sum;
+	float C = z_sum;
+
+	//First iteration computation:
+	float A2 = A * A;
+	float B2 = B * B;
+	float C2 = C * C;
+	float QS = A2 + B2 + C2;
+	float QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
+
+	//Set initial conditions:
+	float Rsq = F0 + QB + QS;
+
+	//First iteration computation:
+	float Q0 = 0.5f * (QS - Rsq);
+	float Q1 = F1 + Q0;
+	float Q2 = 8.0f * (QS - Rsq + QB + F0);
+	float aA, aB, aC, nA, nB, nC, dA, dB, dC;
+
+	//Iterate N times, ignore stop condition.
+	unsigned int n = 0;
+
+	while (n < max_iterations) {
+		n++;
+
+		//Compute denominator:
+		aA = Q2 + 16.0f * (A2 - 2.0f * A * x_sum + x_sum2);
+		aB = Q2 + 16.0f * (B2 - 2.0f * B * y_sum + y_sum2);
+		aC = Q2 + 16.0f * (C2 - 2.0f * C * z_sum + z_sum2);
+		aA = (fabsf(aA) < FLT_EPSILON) ? 1.0f : aA;
+		aB = (fabsf(aB) < FLT_EPSILON) ? 1.0f : aB;
+		aC = (fabsf(aC) < FLT_EPSILON) ? 1.0f : aC;
+
+		//Compute next iteration
+		nA = A - ((F2 + 16.0f * (B * XY + C * XZ + x_sum * (-A2 - Q0) + A * (x_sum2 + Q1 - C * z_sum - B * y_sum))) / aA);
+		nB = B - ((F3 + 16.0f * (A * XY + C * YZ + y_sum * (-B2 - Q0) + B * (y_sum2 + Q1 - A * x_sum - C * z_sum))) / aB);
+		nC = C - ((F4 + 16.0f * (A * XZ + B * YZ + z_sum * (-C2 - Q0) + C * (z_sum2 + Q1 - A * x_sum - B * y_sum))) / aC);
+
+		//Check for stop condition
+		dA = (nA - A);
+		dB = (nB - B);
+		dC = (nC - C);
+
+		if ((dA * dA + dB * dB + dC * dC) <= delta) { break; }
+
+		//Compute next iteration's values
+		A = nA;
+		B = nB;
+		C = nC;
+		A2 = A * A;
+		B2 = B * B;
+		C2 = C * C;
+		QS = A2 + B2 + C2;
+		QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
+		Rsq = F0 + QB + QS;
+		Q0 = 0.5f * (QS - Rsq);
+		Q1 = F1 + Q0;
+		Q2 = 8.0f * (QS - Rsq + QB + F0);
+	}
+
+	*sphere_x = A;
+	*sphere_y = B;
+	*sphere_z = C;
+	*sphere_radius = sqrtf(Rsq);
+
+	return 0;
+}
+
+/**
+ * Solve a * x = b in place by Cholesky decomposition, a is symmetric.
+ *
+ * @return false if a is not positive definite
+ */
+static bool cholesky_solve(double *a, double *b, unsigned n)
+{
+	/* a = L * L', with L stored in the lower triangle of a */
+	for (unsigned j = 0; j < n; j++) {
+		double d = a[j * n + j];
+
+		for (unsigned k = 0; k < j; k++) {
+			d -= a[j * n + k] * a[j * n + k];
+		}
+
+		if (!(d > 0.0)) {
+			return false;
+		}
+
+		a[j * n + j] = sqrt(d);
+
+		for (unsigned i = j + 1; i < n; i++) {
+			double s = a[i * n + j];
+
+			for (unsigned k = 0; k < j; k++) {
+				s -= a[i * n + k] * a[j * n + k];
+			}
+
+			a[i * n + j] = s / a[j * n + j];
+		}
+	}
+
+	/* forward and back substitution */
+	for (unsigned i = 0; i < n; i++) {
+		for (unsigned k = 0; k < i; k++) {
+			b[i] -= a[i * n + k] * b[k];
+		}
+
+		b[i] /= a[i * n + i];
+	}
+
+	for (unsigned i = n; i-- > 0;) {
+		for (unsigned k = i + 1; k < n; k++) {
+			b[i] -= a[k * n + i] * b[k];
+		}
+
+		b[i] /= a[i * n + i];
+	}
+
+	return true;
+}
+
+/**
+ * Eigen decomposition of a symmetric 3x3 matrix by Jacobi rotations,
+ * a = v * diag(eig) * v'.
+ */
+static void symmetric_eigen3(const double a_in[3][3], double eig[3], double v[3][3])
+{
+	double a[3][3];
+	memcpy(a, a_in, sizeof(a));
+
+	for (unsigned i = 0; i < 3; i++) {
+		for (unsigned j = 0; j < 3; j++) {
+			v[i][j] = (i == j) ? 1.0 : 0.0;
+		}
+	}
+
+	for (unsigned sweep = 0; sweep < 20; sweep++) {
+		double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+
+		if (off < 1e-30) {
+			break;
+		}
+
+		for (unsigned p = 0; p < 2; p++) {
+			for (unsigned q = p + 1; q < 3; q++) {
+				if (fabs(a[p][q]) < 1e-300) {
+					continue;
+				}
+
+				/* rotation that zeroes a[p][q] */
+				double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+				double t = ((theta >= 0.0) ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+				double c = 1.0 / sqrt(t * t + 1.0);
+				double s = t * c;
+
+				for (unsigned k = 0; k < 3; k++) {
+					double akp = a[k][p];
+					double akq = a[k][q];
+					a[k][p] = c * akp - s * akq;
+					a[k][q] = s * akp + c * akq;
+				}
+
+				for (unsigned k = 0; k < 3; k++) {
+					double apk = a[p][k];
+					double aqk = a[q][k];
+					a[p][k] = c * apk - s * aqk;
+					a[q][k] = s * apk + c * aqk;
+				}
+
+				for (unsigned k = 0; k < 3; k++) {
+					double vkp = v[k][p];
+					double vkq = v[k][q];
+					v[k][p] = c * vkp - s * vkq;
+					v[k][q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	for (unsigned i = 0; i < 3; i++) {
+		eig[i] = a[i][i];
+	}
+}
+
+int ellipsoid_fit_least_squares(const struct calibration_fit_s *fit, float offset[3], float soft_iron[3][3],
+				float *radius)
+{
+	const unsigned n = calibration_fit_monomials;
+
+	if (fit->count < n) {
+		return 1;
+	}
+
+	/*
+	 * Algebraic fit of
+	 *   a x^2 + b y^2 + c z^2 + 2d xy + 2e xz + 2f yz + 2g x + 2h y + 2i z = 1
+	 * by the normal equations of the monomials, scaled to the coefficients.
+	 */
+	const double w[calibration_fit_monomials] = {1.0, 1.0, 1.0, 2.0, 2.0, 2.0, 2.0, 2.0, 2.0};
+	double normal[calibration_fit_monomials * calibration_fit_monomials];
+	double p[calibration_fit_monomials];
+
+	for (unsigned i = 0; i < n; i++) {
+		for (unsigned j = 0; j < n; j++) {
+			normal[i * n + j] = w[i] * w[j] * sum_product(fit, i, j);
+		}
+
+		p[i] = w[i] * fit->sum[i];
+	}
+
+	if (!cholesky_solve(normal, p, n)) {
+		return 1;
+	}
+
+	double a[3][3] = {
+		{p[0], p[3], p[4]},
+		{p[3], p[1], p[5]},
+		{p[4], p[5], p[2]}
+	};
+
+	/* the center solves a * center = -(g, h, i) */
+	double a_copy[9] = {a[0][0], a[0][1], a[0][2], a[1][0], a[1][1], a[1][2], a[2][0], a[2][1], a[2][2]};
+	double center[3] = {-p[6], -p[7], -p[8]};
+
+	if (!cholesky_solve(a_copy, center, 3)) {
+		return 1;
+	}
+
+	/* about the center the ellipsoid is x' * a * x = k */
+	double k = 1.0;
+
+	for (unsigned i = 0; i < 3; i++) {
+		for (unsigned j = 0; j < 3; j++) {
+			k += center[i] * a[i][j] * center[j];
+		}
+	}
+
+	if (!(k > 0.0)) {
+		return 1;
+	}
+
+	for (unsigned i = 0; i < 3; i++) {
+		for (unsigned j = 0; j < 3; j++) {
+			a[i][j] /= k;
+		}
+	}
+
+	/* the semi-axes are 1 / sqrt(eig) along the eigenvectors */
+	double eig[3];
+	double v[3][3];
+	symmetric_eigen3(a, eig, v);
+
+	if (!(eig[0] > 0.0 && eig[1] > 0.0 && eig[2] > 0.0)) {
+		return 1;
+	}
+
+	double r = pow(eig[0] * eig[1] * eig[2], -1.0 / 6.0);
+
+	for (unsigned i = 0; i < 3; i++) {
+		for (unsigned j = 0; j < 3; j++) {
+			double s = 0.0;
+
+			for (unsigned l = 0; l < 3; l++) {
+				s += v[i][l] * r * sqrt(eig[l]) * v[j][l];
+			}
+
+			soft_iron[i][j] = s;
+		}
+
+		offset[i] = center[i];
+	}
+
+	*radius = r;
+
+	return 0;
+}
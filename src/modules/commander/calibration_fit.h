@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file calibration_fit.h
+ *
+ * Sphere and ellipsoid fits to a stream of points, for the magnetometer
+ * calibration. The points are not kept: each one is folded into the sums
+ * the least-squares problems need, so the memory used does not depend on
+ * the number of points.
+ */
+
+#pragma once
+
+/** number of monomials the fits are built from: x^2, y^2, z^2, xy, xz, yz, x, y, z */
+static const unsigned calibration_fit_monomials = 9;
+
+/**
+ * Running sums of a set of points.
+ */
+struct calibration_fit_s {
+	unsigned	count;						///< number of points
+	double		sum[calibration_fit_monomials];			///< sum of each monomial
+	double		sum_product[calibration_fit_monomials * (calibration_fit_monomials + 1) / 2];	///< sums of the products of two monomials, upper triangle
+};
+
+/**
+ * Start a new set of points.
+ */
+void calibration_fit_reset(struct calibration_fit_s *fit);
+
+/**
+ * Add a point to the set.
+ */
+void calibration_fit_add(struct calibration_fit_s *fit, float x, float y, float z);
+
+/**
+ * Least-squares fit of a sphere to the points on its surface.
+ *
+ * @param fit sums of the points
+ * @param max_iterations abort if maximum number of iterations have been reached. If unsure, set to 100.
+ * @param delta abort if error is below delta. If unsure, set to 0 to run max_iterations times.
+ * @param sphere_x coordinate of the sphere center on the X axis
+ * @param sphere_y coordinate of the sphere center on the Y axis
+ * @param sphere_z coordinate of the sphere center on the Z axis
+ * @param sphere_radius sphere radius
+ *
+ * @return 0 on success, 1 on failure
+ */
+int sphere_fit_least_squares(const struct calibration_fit_s *fit, unsigned int max_iterations, float delta,
+			     float *sphere_x, float *sphere_y, float *sphere_z, float *sphere_radius);
+
+/**
+ * Least-squares fit of an ellipsoid to the points on its surface.
+ *
+ * The result maps a point p onto a sphere: soft_iron * (p - offset) has the
+ * length radius. The soft iron matrix is symmetric with a determinant of one,
+ * so the radius is the geometric mean of the ellipsoid's semi-axes.
+ *
+ * @param fit sums of the points, which have to cover the ellipsoid in all directions
+ * @param offset center of the ellipsoid
+ * @param soft_iron correction matrix
+ * @param radius radius of the corrected sphere
+ *
+ * @return 0 on success, 1 if the points do not describe an ellipsoid
+ */
+int ellipsoid_fit_least_squares(const struct calibration_fit_s *fit, float offset[3], float soft_iron[3][3],
+				float *radius);
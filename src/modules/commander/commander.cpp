@@ -108,6 +108,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
 #include <systemlib/cpuload.h>
+#include <systemlib/perf_counter.h>
 #include <systemlib/rc_check.h>
 #include <geo/geo.h>
 #include <systemlib/state_table.h>
@@ -159,6 +160,8 @@ static constexpr uint8_t COMMANDER_MAX_GPS_NOISE = 60;		/**< Maximum percentage
 
 #define INAIR_RESTART_HOLDOFF_INTERVAL	500000
 
+#define COMMAND_LATENCY_MAX		1000000	/**< commands older than this are not counted in the latency */
+
 #define HIL_ID_MIN 1000
 #define HIL_ID_MAX 1999
 
@@ -185,11 +188,11 @@ static bool commander_initialized = false;
 static volatile bool thread_should_exit = false;	/**< daemon exit flag */
 static volatile bool thread_running = false;		/**< daemon status flag */
 static int daemon_task;					/**< Handle of daemon task / thread */
-static bool need_param_autosave = false;		/**< Flag set to true if parameters should be autosaved in next iteration (happens on param update and if functionality is enabled) */
 static bool _usb_telemetry_active = false;
 static hrt_abstime commander_boot_timestamp = 0;
 
 static unsigned int leds_counter;
+static perf_counter_t command_latency_perf = nullptr;	/**< time from a vehicle_command to the vehicle_status it changed */
 /* To remember when last notification was sent */
 static uint64_t last_print_mode_reject_time = 0;
 static uint64_t _inair_last_time = 0;
@@ -417,6 +420,7 @@ int commander_main(int argc, char *argv[])
 			if (TRANSITION_DENIED != arm_disarm(true, &mavlink_log_pub, "command line")) {
 
 				vehicle_command_s cmd = {};
+				cmd.timestamp = hrt_absolute_time();
 				cmd.target_system = status.system_id;
 				cmd.target_component = status.component_id;
 
@@ -445,6 +449,7 @@ int commander_main(int argc, char *argv[])
 	if (!strcmp(argv[1], "land")) {
 
 		vehicle_command_s cmd = {};
+		cmd.timestamp = hrt_absolute_time();
 		cmd.target_system = status.system_id;
 		cmd.target_component = status.component_id;
 
@@ -511,6 +516,7 @@ int commander_main(int argc, char *argv[])
 		}
 
 		vehicle_command_s cmd = {};
+		cmd.timestamp = hrt_absolute_time();
 		cmd.target_system = status.system_id;
 		cmd.target_component = status.component_id;
 
@@ -597,6 +603,10 @@ void print_status()
 
 
 	warnx("arming: %s", armed_str);
+
+	if (command_latency_perf != nullptr) {
+		perf_print_counter(command_latency_perf);
+	}
 }
 
 static orb_advert_t status_pub;
@@ -1520,10 +1530,45 @@ int commander_thread_main(int argc, char *argv[])
 	pthread_create(&commander_low_prio_thread, &commander_low_prio_attr, commander_low_prio_loop, NULL);
 	pthread_attr_destroy(&commander_low_prio_attr);
 
+	/* wake up as soon as a command, RC input, a battery update or a land detector
+	 * change comes in, and at least every COMMANDER_MONITORING_INTERVAL for the
+	 * housekeeping. The telemetry, sensor and GPS checks only run on housekeeping. */
+	px4_pollfd_struct_t fds[4] = {};
+	fds[0].fd = cmd_sub;
+	fds[1].fd = sp_man_sub;
+	fds[2].fd = battery_sub;
+	fds[3].fd = land_detector_sub;
+
+	for (unsigned i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+		fds[i].events = POLLIN;
+	}
+
+	/* RC and battery are published much faster than their transitions need */
+	orb_set_interval(sp_man_sub, 20);
+	orb_set_interval(battery_sub, 100);
+
+	hrt_abstime next_housekeeping = 0;
+	bool leds_changed = true;
+
+	command_latency_perf = perf_alloc(PC_ELAPSED_HIST, "commander_command_latency");
+	hrt_abstime command_timestamp = 0;
+
 	while (!thread_should_exit) {
 
 		arming_ret = TRANSITION_NOT_CHANGED;
 
+		/* the counters and hysteresis run at the housekeeping rate, not per wakeup */
+		const hrt_abstime loop_start = hrt_absolute_time();
+		const bool housekeeping = (loop_start >= next_housekeeping);
+
+		if (housekeeping) {
+			next_housekeeping += COMMANDER_MONITORING_INTERVAL;
+
+			if (next_housekeeping <= loop_start) {
+				next_housekeeping = loop_start + COMMANDER_MONITORING_INTERVAL;
+			}
+		}
+
 
 		/* update parameters */
 		orb_check(param_changed_sub, &updated);
@@ -1577,8 +1622,9 @@ int commander_thread_main(int argc, char *argv[])
 			/* Autostart id */
 			param_get(_param_autostart_id, &autostart_id);
 
-			/* Parameter autosave setting */
+			/* Parameter autosave setting, the parameter store coalesces and saves changes */
 			param_get(_param_autosave_params, &autosave_params);
+			param_control_autosave(autosave_params != 0);
 
 			/* EPH / EPV */
 			param_get(_param_eph, &eph_threshold);
@@ -1591,12 +1637,6 @@ int commander_thread_main(int argc, char *argv[])
 			param_get(_param_fmode_4, &_flight_mode_slots[3]);
 			param_get(_param_fmode_5, &_flight_mode_slots[4]);
 			param_get(_param_fmode_6, &_flight_mode_slots[5]);
-
-			/* Set flag to autosave parameters if necessary */
-			if (updated && autosave_params != 0 && param_changed.saved == false) {
-				/* trigger an autosave */
-				need_param_autosave = true;
-			}
 		}
 
 		orb_check(sp_man_sub, &updated);
@@ -1625,132 +1665,135 @@ int commander_thread_main(int argc, char *argv[])
 			}
 		}
 
-		for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
+		/* telemetry links and sensors are checked at the housekeeping rate, not on RC or battery wakeups */
+		if (housekeeping) {
+			for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
 
-			if (telemetry_subs[i] < 0 && (OK == orb_exists(ORB_ID(telemetry_status), i))) {
-				telemetry_subs[i] = orb_subscribe_multi(ORB_ID(telemetry_status), i);
-			}
+				if (telemetry_subs[i] < 0 && (OK == orb_exists(ORB_ID(telemetry_status), i))) {
+					telemetry_subs[i] = orb_subscribe_multi(ORB_ID(telemetry_status), i);
+				}
 
-			orb_check(telemetry_subs[i], &updated);
+				orb_check(telemetry_subs[i], &updated);
 
-			if (updated) {
-				struct telemetry_status_s telemetry;
-				memset(&telemetry, 0, sizeof(telemetry));
-
-				orb_copy(ORB_ID(telemetry_status), telemetry_subs[i], &telemetry);
-
-				/* perform system checks when new telemetry link connected */
-				if (/* we first connect a link or re-connect a link after loosing it */
-				    (telemetry_last_heartbeat[i] == 0 || (hrt_elapsed_time(&telemetry_last_heartbeat[i]) > 3 * 1000 * 1000)) &&
-				    /* and this link has a communication partner */
-				    (telemetry.heartbeat_time > 0) &&
-				    /* and it is still connected */
-				    (hrt_elapsed_time(&telemetry.heartbeat_time) < 2 * 1000 * 1000) &&
-				    /* and the system is not already armed (and potentially flying) */
-				    !armed.armed) {
-
-					bool chAirspeed = false;
-					bool hotplug_timeout = hrt_elapsed_time(&commander_boot_timestamp) > HOTPLUG_SENS_TIMEOUT;
-
-					/* Perform airspeed check only if circuit breaker is not
-					 * engaged and it's not a rotary wing
-					 */
-					if (!status.circuit_breaker_engaged_airspd_check && !status.is_rotary_wing) {
-						chAirspeed = true;
-					}
+				if (updated) {
+					struct telemetry_status_s telemetry;
+					memset(&telemetry, 0, sizeof(telemetry));
 
-					/* provide RC and sensor status feedback to the user */
-					if (is_hil_setup(autostart_id)) {
-						/* HIL configuration: check only RC input */
-						(void)Commander::preflightCheck(&mavlink_log_pub, false, false, false, false, false,
-								(status.rc_input_mode == vehicle_status_s::RC_IN_MODE_DEFAULT), false, true);
-					} else {
-						/* check sensors also */
-						(void)Commander::preflightCheck(&mavlink_log_pub, true, true, true, true, chAirspeed,
-								(status.rc_input_mode == vehicle_status_s::RC_IN_MODE_DEFAULT), !status.circuit_breaker_engaged_gpsfailure_check, hotplug_timeout);
+					orb_copy(ORB_ID(telemetry_status), telemetry_subs[i], &telemetry);
+
+					/* perform system checks when new telemetry link connected */
+					if (/* we first connect a link or re-connect a link after loosing it */
+					    (telemetry_last_heartbeat[i] == 0 || (hrt_elapsed_time(&telemetry_last_heartbeat[i]) > 3 * 1000 * 1000)) &&
+					    /* and this link has a communication partner */
+					    (telemetry.heartbeat_time > 0) &&
+					    /* and it is still connected */
+					    (hrt_elapsed_time(&telemetry.heartbeat_time) < 2 * 1000 * 1000) &&
+					    /* and the system is not already armed (and potentially flying) */
+					    !armed.armed) {
+
+						bool chAirspeed = false;
+						bool hotplug_timeout = hrt_elapsed_time(&commander_boot_timestamp) > HOTPLUG_SENS_TIMEOUT;
+
+						/* Perform airspeed check only if circuit breaker is not
+						 * engaged and it's not a rotary wing
+						 */
+						if (!status.circuit_breaker_engaged_airspd_check && !status.is_rotary_wing) {
+							chAirspeed = true;
+						}
+
+						/* provide RC and sensor status feedback to the user */
+						if (is_hil_setup(autostart_id)) {
+							/* HIL configuration: check only RC input */
+							(void)Commander::preflightCheck(&mavlink_log_pub, false, false, false, false, false,
+									(status.rc_input_mode == vehicle_status_s::RC_IN_MODE_DEFAULT), false, true);
+						} else {
+							/* check sensors also */
+							(void)Commander::preflightCheck(&mavlink_log_pub, true, true, true, true, chAirspeed,
+									(status.rc_input_mode == vehicle_status_s::RC_IN_MODE_DEFAULT), !status.circuit_breaker_engaged_gpsfailure_check, hotplug_timeout);
+						}
 					}
-				}
 
-				/* set (and don't reset) telemetry via USB as active once a MAVLink connection is up */
-				if (telemetry.type == telemetry_status_s::TELEMETRY_STATUS_RADIO_TYPE_USB) {
-					_usb_telemetry_active = true;
-				}
+					/* set (and don't reset) telemetry via USB as active once a MAVLink connection is up */
+					if (telemetry.type == telemetry_status_s::TELEMETRY_STATUS_RADIO_TYPE_USB) {
+						_usb_telemetry_active = true;
+					}
 
-				if (telemetry.heartbeat_time > 0) {
-					telemetry_last_heartbeat[i] = telemetry.heartbeat_time;
+					if (telemetry.heartbeat_time > 0) {
+						telemetry_last_heartbeat[i] = telemetry.heartbeat_time;
+					}
 				}
 			}
-		}
 
-		orb_check(sensor_sub, &updated);
+			orb_check(sensor_sub, &updated);
 
-		if (updated) {
-			orb_copy(ORB_ID(sensor_combined), sensor_sub, &sensors);
-
-			/* Check if the barometer is healthy and issue a warning in the GCS if not so.
-			 * Because the barometer is used for calculating AMSL altitude which is used to ensure
-			 * vertical separation from other airtraffic the operator has to know when the
-			 * barometer is inoperational.
-			 * */
-			if (hrt_elapsed_time(&sensors.baro_timestamp[0]) < FAILSAFE_DEFAULT_TIMEOUT) {
-				/* handle the case where baro was regained */
-				if (status.barometer_failure) {
-					status.barometer_failure = false;
-					status_changed = true;
-					mavlink_log_critical(&mavlink_log_pub, "baro healthy");
-				}
+			if (updated) {
+				orb_copy(ORB_ID(sensor_combined), sensor_sub, &sensors);
 
-			} else {
-				if (!status.barometer_failure) {
-					status.barometer_failure = true;
-					status_changed = true;
-					mavlink_log_critical(&mavlink_log_pub, "baro failed");
+				/* Check if the barometer is healthy and issue a warning in the GCS if not so.
+				 * Because the barometer is used for calculating AMSL altitude which is used to ensure
+				 * vertical separation from other airtraffic the operator has to know when the
+				 * barometer is inoperational.
+				 * */
+				if (hrt_elapsed_time(&sensors.baro_timestamp[0]) < FAILSAFE_DEFAULT_TIMEOUT) {
+					/* handle the case where baro was regained */
+					if (status.barometer_failure) {
+						status.barometer_failure = false;
+						status_changed = true;
+						mavlink_log_critical(&mavlink_log_pub, "baro healthy");
+					}
+
+				} else {
+					if (!status.barometer_failure) {
+						status.barometer_failure = true;
+						status_changed = true;
+						mavlink_log_critical(&mavlink_log_pub, "baro failed");
+					}
 				}
 			}
-		}
 
-		orb_check(diff_pres_sub, &updated);
+			orb_check(diff_pres_sub, &updated);
 
-		if (updated) {
-			orb_copy(ORB_ID(differential_pressure), diff_pres_sub, &diff_pres);
-		}
+			if (updated) {
+				orb_copy(ORB_ID(differential_pressure), diff_pres_sub, &diff_pres);
+			}
 
-		orb_check(system_power_sub, &updated);
+			orb_check(system_power_sub, &updated);
 
-		if (updated) {
-			orb_copy(ORB_ID(system_power), system_power_sub, &system_power);
+			if (updated) {
+				orb_copy(ORB_ID(system_power), system_power_sub, &system_power);
 
-			if (hrt_elapsed_time(&system_power.timestamp) < 200000) {
-				if (system_power.servo_valid &&
-				    !system_power.brick_valid &&
-				    !system_power.usb_connected) {
-					/* flying only on servo rail, this is unsafe */
-					status.condition_power_input_valid = false;
+				if (hrt_elapsed_time(&system_power.timestamp) < 200000) {
+					if (system_power.servo_valid &&
+					    !system_power.brick_valid &&
+					    !system_power.usb_connected) {
+						/* flying only on servo rail, this is unsafe */
+						status.condition_power_input_valid = false;
 
-				} else {
-					status.condition_power_input_valid = true;
-				}
+					} else {
+						status.condition_power_input_valid = true;
+					}
 
-				/* copy avionics voltage */
-				status.avionics_power_rail_voltage = system_power.voltage5V_v;
+					/* copy avionics voltage */
+					status.avionics_power_rail_voltage = system_power.voltage5V_v;
+
+					/* if the USB hardware connection went away, reboot */
+					if (status.usb_connected && !system_power.usb_connected) {
+						/*
+						 * apparently the USB cable went away but we are still powered,
+						 * so lets reset to a classic non-usb state.
+						 */
+						mavlink_log_critical(&mavlink_log_pub, "USB disconnected, rebooting.")
+						usleep(400000);
+						px4_systemreset(false);
+					}
 
-				/* if the USB hardware connection went away, reboot */
-				if (status.usb_connected && !system_power.usb_connected) {
-					/*
-					 * apparently the USB cable went away but we are still powered,
-					 * so lets reset to a classic non-usb state.
-					 */
-					mavlink_log_critical(&mavlink_log_pub, "USB disconnected, rebooting.")
-					usleep(400000);
-					px4_systemreset(false);
+					/* finally judge the USB connected state based on software detection */
+					status.usb_connected = _usb_telemetry_active;
 				}
-
-				/* finally judge the USB connected state based on software detection */
-				status.usb_connected = _usb_telemetry_active;
 			}
-		}
 
-		check_valid(diff_pres.timestamp, DIFFPRESS_TIMEOUT, true, &(status.condition_airspeed_valid), &status_changed);
+			check_valid(diff_pres.timestamp, DIFFPRESS_TIMEOUT, true, &(status.condition_airspeed_valid), &status_changed);
+		}
 
 		/* update safety topic */
 		orb_check(safety_sub, &updated);
@@ -1989,7 +2032,7 @@ int commander_thread_main(int argc, char *argv[])
 			orb_copy(ORB_ID(position_setpoint_triplet), pos_sp_triplet_sub, &pos_sp_triplet);
 		}
 
-		if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+		if (housekeeping && counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
 			/* compute system load */
 			uint64_t interval_runtime = system_load.tasks[0].total_runtime - last_idle_time;
 
@@ -2052,50 +2095,53 @@ int commander_thread_main(int argc, char *argv[])
 		 * set of position measurements is available.
 		 */
 
-		orb_check(gps_sub, &updated);
+		/* GPS health is checked at the housekeeping rate */
+		if (housekeeping) {
+			orb_check(gps_sub, &updated);
 
-		if (updated) {
-			orb_copy(ORB_ID(vehicle_gps_position), gps_sub, &gps_position);
-		}
+			if (updated) {
+				orb_copy(ORB_ID(vehicle_gps_position), gps_sub, &gps_position);
+			}
 
-		/* Initialize map projection if gps is valid */
-		if (!map_projection_global_initialized()
-		    && (gps_position.eph < eph_threshold)
-		    && (gps_position.epv < epv_threshold)
-		    && hrt_elapsed_time((hrt_abstime *)&gps_position.timestamp_position) < 1e6) {
-			/* set reference for global coordinates <--> local coordiantes conversion and map_projection */
-			globallocalconverter_init((double)gps_position.lat * 1.0e-7, (double)gps_position.lon * 1.0e-7,
-						  (float)gps_position.alt * 1.0e-3f, hrt_absolute_time());
-		}
+			/* Initialize map projection if gps is valid */
+			if (!map_projection_global_initialized()
+			    && (gps_position.eph < eph_threshold)
+			    && (gps_position.epv < epv_threshold)
+			    && hrt_elapsed_time((hrt_abstime *)&gps_position.timestamp_position) < 1e6) {
+				/* set reference for global coordinates <--> local coordiantes conversion and map_projection */
+				globallocalconverter_init((double)gps_position.lat * 1.0e-7, (double)gps_position.lon * 1.0e-7,
+							  (float)gps_position.alt * 1.0e-3f, hrt_absolute_time());
+			}
 
-		/* check if GPS is ok */
-		if (!status.circuit_breaker_engaged_gpsfailure_check) {
-			bool gpsIsNoisy = gps_position.noise_per_ms > 0 && gps_position.noise_per_ms < COMMANDER_MAX_GPS_NOISE;
+			/* check if GPS is ok */
+			if (!status.circuit_breaker_engaged_gpsfailure_check) {
+				bool gpsIsNoisy = gps_position.noise_per_ms > 0 && gps_position.noise_per_ms < COMMANDER_MAX_GPS_NOISE;
 
-			//Check if GPS receiver is too noisy while we are disarmed
-			if (!armed.armed && gpsIsNoisy) {
-				if (!status.gps_failure) {
-					mavlink_log_critical(&mavlink_log_pub, "GPS signal noisy");
-					set_tune_override(TONE_GPS_WARNING_TUNE);
+				//Check if GPS receiver is too noisy while we are disarmed
+				if (!armed.armed && gpsIsNoisy) {
+					if (!status.gps_failure) {
+						mavlink_log_critical(&mavlink_log_pub, "GPS signal noisy");
+						set_tune_override(TONE_GPS_WARNING_TUNE);
 
-					//GPS suffers from signal jamming or excessive noise, disable GPS-aided flight
-					status.gps_failure = true;
-					status_changed = true;
+						//GPS suffers from signal jamming or excessive noise, disable GPS-aided flight
+						status.gps_failure = true;
+						status_changed = true;
+					}
 				}
-			}
 
-			if (gps_position.fix_type >= 3 && hrt_elapsed_time(&gps_position.timestamp_position) < FAILSAFE_DEFAULT_TIMEOUT) {
-				/* handle the case where gps was regained */
-				if (status.gps_failure && !gpsIsNoisy) {
-					status.gps_failure = false;
+				if (gps_position.fix_type >= 3 && hrt_elapsed_time(&gps_position.timestamp_position) < FAILSAFE_DEFAULT_TIMEOUT) {
+					/* handle the case where gps was regained */
+					if (status.gps_failure && !gpsIsNoisy) {
+						status.gps_failure = false;
+						status_changed = true;
+						mavlink_log_critical(&mavlink_log_pub, "gps fix regained");
+					}
+
+				} else if (!status.gps_failure) {
+					status.gps_failure = true;
 					status_changed = true;
-					mavlink_log_critical(&mavlink_log_pub, "gps fix regained");
+					mavlink_log_critical(&mavlink_log_pub, "gps fix lost");
 				}
-
-			} else if (!status.gps_failure) {
-				status.gps_failure = true;
-				status_changed = true;
-				mavlink_log_critical(&mavlink_log_pub, "gps fix lost");
 			}
 		}
 
@@ -2218,7 +2264,7 @@ int commander_thread_main(int argc, char *argv[])
 				flight_termination_printed = true;
 			}
 
-			if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+			if (housekeeping && counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
 				mavlink_and_console_log_critical(&mavlink_log_pub, "Flight termination active");
 			}
 		}
@@ -2290,7 +2336,7 @@ int commander_thread_main(int argc, char *argv[])
 
 					stick_off_counter = 0;
 
-				} else {
+				} else if (housekeeping) {
 					stick_off_counter++;
 				}
 
@@ -2330,7 +2376,7 @@ int commander_thread_main(int argc, char *argv[])
 					}
 					stick_on_counter = 0;
 
-				} else {
+				} else if (housekeeping) {
 					stick_on_counter++;
 				}
 
@@ -2513,6 +2559,13 @@ int commander_thread_main(int argc, char *argv[])
 			if (handle_command(&status, &safety, &cmd, &armed, &_home, &global_position, &local_position,
 					&attitude, &home_pub, &command_ack_pub, &command_ack)) {
 				status_changed = true;
+
+				/* a timestamp from the future or the distant past says nothing about the latency */
+				hrt_abstime cmd_now = hrt_absolute_time();
+
+				if (cmd.timestamp != 0 && cmd.timestamp <= cmd_now && cmd_now - cmd.timestamp < COMMAND_LATENCY_MAX) {
+					command_timestamp = cmd.timestamp;
+				}
 			}
 		}
 
@@ -2539,7 +2592,7 @@ int commander_thread_main(int argc, char *argv[])
 					flight_termination_printed = true;
 				}
 
-				if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+				if (housekeeping && counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
 					mavlink_log_critical(&mavlink_log_pub, "DL and GPS lost: flight termination");
 				}
 			}
@@ -2564,7 +2617,7 @@ int commander_thread_main(int argc, char *argv[])
 					flight_termination_printed = true;
 				}
 
-				if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+				if (housekeeping && counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
 					mavlink_log_critical(&mavlink_log_pub, "RC and GPS lost: flight termination");
 				}
 			}
@@ -2618,7 +2671,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* publish states (armed, control mode, vehicle status) at least with 5 Hz */
-		if (counter % (200000 / COMMANDER_MONITORING_INTERVAL) == 0 || status_changed) {
+		if ((housekeeping && counter % (200000 / COMMANDER_MONITORING_INTERVAL) == 0) || status_changed) {
 			set_control_mode();
 			control_mode.timestamp = now;
 			orb_publish(ORB_ID(vehicle_control_mode), control_mode_pub, &control_mode);
@@ -2626,6 +2679,11 @@ int commander_thread_main(int argc, char *argv[])
 			status.timestamp = now;
 			orb_publish(ORB_ID(vehicle_status), status_pub, &status);
 
+			if (command_timestamp != 0) {
+				perf_set(command_latency_perf, hrt_absolute_time() - command_timestamp);
+				command_timestamp = 0;
+			}
+
 			armed.timestamp = now;
 
 			/* set prearmed state if safety is off, or safety is not present and 5 seconds passed */
@@ -2690,27 +2748,40 @@ int commander_thread_main(int argc, char *argv[])
 			status_changed = true;
 		}
 
-		counter++;
+		leds_changed |= status_changed;
+		status_changed = false;
+
+		if (housekeeping) {
+			counter++;
 
-		int blink_state = blink_msg_state();
+			int blink_state = blink_msg_state();
 
-		if (blink_state > 0) {
-			/* blinking LED message, don't touch LEDs */
-			if (blink_state == 2) {
-				/* blinking LED message completed, restore normal state */
-				control_status_leds(&status, &armed, true);
+			if (blink_state > 0) {
+				/* blinking LED message, don't touch LEDs */
+				if (blink_state == 2) {
+					/* blinking LED message completed, restore normal state */
+					control_status_leds(&status, &armed, true);
+				}
+
+			} else {
+				/* normal state */
+				control_status_leds(&status, &armed, leds_changed);
 			}
 
-		} else {
-			/* normal state */
-			control_status_leds(&status, &armed, status_changed);
+			leds_changed = false;
 		}
 
-		status_changed = false;
+		/* sleep until the next housekeeping, or until a polled topic changes */
+		const hrt_abstime loop_end = hrt_absolute_time();
+		int timeout_ms = (next_housekeeping > loop_end) ? (next_housekeeping - loop_end + 999) / 1000 : 0;
 
-		usleep(COMMANDER_MONITORING_INTERVAL);
+		px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
 	}
 
+	perf_counter_t latency_perf = command_latency_perf;
+	command_latency_perf = nullptr;
+	perf_free(latency_perf);
+
 	/* wait for threads to complete */
 	ret = pthread_join(commander_low_prio_thread, NULL);
 
@@ -3402,9 +3473,6 @@ void *commander_low_prio_loop(void *arg)
 	struct vehicle_command_ack_s command_ack;
 	memset(&command_ack, 0, sizeof(command_ack));
 
-	/* timeout for param autosave */
-	hrt_abstime need_param_autosave_timeout = 0;
-
 	/* wakeup source(s) */
 	px4_pollfd_struct_t fds[1];
 
@@ -3418,23 +3486,7 @@ void *commander_low_prio_loop(void *arg)
 
 		/* timed out - periodic check for thread_should_exit, etc. */
 		if (pret == 0) {
-			/* trigger a param autosave if required */
-			if (need_param_autosave) {
-				if (need_param_autosave_timeout > 0 && hrt_elapsed_time(&need_param_autosave_timeout) > 200000ULL) {
-					int ret = param_save_default();
-
-					if (ret != OK) {
-						mavlink_and_console_log_critical(&mavlink_log_pub, "settings auto save error");
-					} else {
-						warnx("settings saved.");
-					}
-
-					need_param_autosave = false;
-					need_param_autosave_timeout = 0;
-				} else {
-					need_param_autosave_timeout = hrt_absolute_time();
-				}
-			}
+			continue;
 		} else if (pret < 0) {
 		/* this is undesirable but not much we can do - might want to flag unhappy status */
 			warn("commander: poll error %d, %d", pret, errno);
@@ -3617,11 +3669,6 @@ void *commander_low_prio_loop(void *arg)
 						int ret = param_save_default();
 
 						if (ret == OK) {
-							if (need_param_autosave) {
-								need_param_autosave = false;
-								need_param_autosave_timeout = 0;
-							}
-
 							/* do not spam MAVLink, but provide the answer / green led mechanism */
 							answer_command(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED, command_ack_pub, command_ack);
 
@@ -73,7 +73,11 @@ static constexpr unsigned int calibration_sides = 6;			///< The total number of
 static constexpr unsigned int calibration_total_points = 240;		///< The total points per magnetometer
 static constexpr unsigned int calibraton_duration_seconds = 42; 	///< The total duration the routine is allowed to take
 
+static constexpr unsigned int calibration_recent_points = calibration_total_points / calibration_sides;	///< The points kept per magnetometer to reject duplicates
+
 static constexpr float MAG_MAX_OFFSET_LEN = 0.75f;	///< The maximum measurement range is ~1.4 Ga, the earth field is ~0.6 Ga, so an offset larger than ~0.8-0.6 Ga means the mag will saturate in some directions.
+static constexpr float MAG_MAX_SCALE_DEV = 0.25f;	///< The largest deviation of a scale from 1 taken from the ellipsoid fit
+static constexpr float MAG_MAX_SOFT_IRON_CROSS = 0.1f;	///< The largest cross-axis term of the ellipsoid fit, the driver only scales each axis
 
 int32_t	device_ids[max_mags];
 bool internal[max_mags];
@@ -82,6 +86,13 @@ int32_t device_id_primary = 0;
 
 calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t (&device_ids)[max_mags]);
 
+/// Points collected from one mag
+typedef struct {
+	struct calibration_fit_s fit;				///< Sums of all accepted points
+	float		recent[calibration_recent_points][3];	///< Last accepted points, to reject duplicates
+	unsigned	recent_count;				///< Number of points accepted so far, the ring index
+} mag_points_t;
+
 /// Data passed to calibration worker routine
 typedef struct  {
 	orb_advert_t	*mavlink_log_pub;
@@ -92,9 +103,7 @@ typedef struct  {
 	uint64_t	calibration_interval_perside_useconds;
 	unsigned int	calibration_counter_total[max_mags];
 	bool		side_data_collected[detect_orientation_side_count];
-	float		*x[max_mags];
-	float		*y[max_mags];
-	float		*z[max_mags];
+	mag_points_t	*points[max_mags];
 } mag_worker_data_t;
 
 
@@ -237,14 +246,17 @@ int do_mag_calibration(orb_advert_t *mavlink_log_pub)
 	return result;
 }
 
-static bool reject_sample(float sx, float sy, float sz, float x[], float y[], float z[], unsigned count, unsigned max_count)
+static bool reject_sample(float sx, float sy, float sz, const mag_points_t *points, unsigned max_count)
 {
 	float min_sample_dist = fabsf(5.4f * mag_sphere_radius / sqrtf(max_count)) / 3.0f;
 
+	// The vehicle turns slowly, so a duplicate is one of the last points
+	unsigned count = points->recent_count < calibration_recent_points ? points->recent_count : calibration_recent_points;
+
 	for (size_t i = 0; i < count; i++) {
-		float dx = sx - x[i];
-		float dy = sy - y[i];
-		float dz = sz - z[i];
+		float dx = sx - points->recent[i][0];
+		float dy = sy - points->recent[i][1];
+		float dz = sz - points->recent[i][2];
 		float dist = sqrtf(dx * dx + dy * dy + dz * dz);
 
 		if (dist < min_sample_dist) {
@@ -255,6 +267,24 @@ static bool reject_sample(float sx, float sy, float sz, float x[], float y[], fl
 	return false;
 }
 
+/// The driver applies a scale per axis, which only corrects the soft iron if it is close to diagonal
+static bool soft_iron_usable(const float soft_iron[3][3])
+{
+	for (unsigned i = 0; i < 3; i++) {
+		if (!PX4_ISFINITE(soft_iron[i][i]) || fabsf(soft_iron[i][i] - 1.0f) > MAG_MAX_SCALE_DEV) {
+			return false;
+		}
+
+		for (unsigned j = i + 1; j < 3; j++) {
+			if (fabsf(soft_iron[i][j]) > MAG_MAX_SOFT_IRON_CROSS) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 static unsigned progress_percentage(mag_worker_data_t* worker_data) {
 	return 100 * ((float)worker_data->done_count) / calibration_sides;
 }
@@ -363,38 +393,42 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 
 		if (poll_ret > 0) {
 
-			int prev_count[max_mags];
+			struct mag_report mag[max_mags];
 			bool rejected = false;
 
 			for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
 
-				prev_count[cur_mag] = worker_data->calibration_counter_total[cur_mag];
-
 				if (worker_data->sub_mag[cur_mag] >= 0) {
-					struct mag_report mag;
-
-					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag);
+					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag[cur_mag]);
 
 					// Check if this measurement is good to go in
-					rejected = rejected || reject_sample(mag.x, mag.y, mag.z,
-						worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
-						worker_data->calibration_counter_total[cur_mag],
+					rejected = rejected || reject_sample(mag[cur_mag].x, mag[cur_mag].y, mag[cur_mag].z,
+						worker_data->points[cur_mag],
 						calibration_sides * worker_data->calibration_points_perside);
-
-					worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.x;
-					worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.y;
-					worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.z;
-					worker_data->calibration_counter_total[cur_mag]++;
 				}
 			}
 
-			// Keep calibration of all mags in lockstep
-			if (rejected) {
-				// Reset counts, since one of the mags rejected the measurement
-				for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-					worker_data->calibration_counter_total[cur_mag] = prev_count[cur_mag];
+			// Keep calibration of all mags in lockstep: the points only go in if no mag rejected its measurement
+			if (!rejected) {
+				for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
+
+					if (worker_data->sub_mag[cur_mag] >= 0) {
+						mag_points_t *points = worker_data->points[cur_mag];
+						float *recent = points->recent[points->recent_count % calibration_recent_points];
+
+						calibration_fit_add(&points->fit, mag[cur_mag].x, mag[cur_mag].y, mag[cur_mag].z);
+						recent[0] = mag[cur_mag].x;
+						recent[1] = mag[cur_mag].y;
+						recent[2] = mag[cur_mag].z;
+						points->recent_count++;
+						worker_data->calibration_counter_total[cur_mag]++;
+
+						// DO NOT REMOVE! Critical validation data!
+						// printf("RAW: MAG %u: %8.4f, %8.4f, %8.4f\n", (unsigned)cur_mag,
+						//	(double)mag[cur_mag].x, (double)mag[cur_mag].y, (double)mag[cur_mag].z);
+					}
 				}
-			} else {
+
 				calibration_counter_side++;
 
 				// Progress indicator for side
@@ -451,23 +485,21 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t (&devi
 		worker_data.sub_mag[cur_mag] = -1;
 
 		// Initialize to no memory allocated
-		worker_data.x[cur_mag] = NULL;
-		worker_data.y[cur_mag] = NULL;
-		worker_data.z[cur_mag] = NULL;
+		worker_data.points[cur_mag] = NULL;
 		worker_data.calibration_counter_total[cur_mag] = 0;
 	}
 
-	const unsigned int calibration_points_maxcount = calibration_sides * worker_data.calibration_points_perside;
-
 	char str[30];
 
+	// The points are folded into sums as they come in, only the last few are kept
 	for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
-		worker_data.x[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.y[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.z[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		if (worker_data.x[cur_mag] == NULL || worker_data.y[cur_mag] == NULL || worker_data.z[cur_mag] == NULL) {
+		worker_data.points[cur_mag] = reinterpret_cast<mag_points_t *>(malloc(sizeof(mag_points_t)));
+		if (worker_data.points[cur_mag] == NULL) {
 			calibration_log_critical(mavlink_log_pub, "[cal] ERROR: out of memory");
 			result = calibrate_return_error;
+		} else {
+			calibration_fit_reset(&worker_data.points[cur_mag]->fit);
+			worker_data.points[cur_mag]->recent_count = 0;
 		}
 	}
 
@@ -551,19 +583,43 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t (&devi
 	float sphere_y[max_mags];
 	float sphere_z[max_mags];
 	float sphere_radius[max_mags];
+	float scale_x[max_mags];
+	float scale_y[max_mags];
+	float scale_z[max_mags];
 
-	// Sphere fit the data to get calibration values
+	// Sphere fit the data to get calibration values, refined by an ellipsoid fit where it is usable
 	if (result == calibrate_return_ok) {
 		for (unsigned cur_mag=0; cur_mag<max_mags; cur_mag++) {
 			if (device_ids[cur_mag] != 0) {
 				// Mag in this slot is available and we should have values for it to calibrate
 
-				sphere_fit_least_squares(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-							 worker_data.calibration_counter_total[cur_mag],
+				sphere_fit_least_squares(&worker_data.points[cur_mag]->fit,
 							 100, 0.0f,
 							 &sphere_x[cur_mag], &sphere_y[cur_mag], &sphere_z[cur_mag],
 							 &sphere_radius[cur_mag]);
 
+				scale_x[cur_mag] = 1.0f;
+				scale_y[cur_mag] = 1.0f;
+				scale_z[cur_mag] = 1.0f;
+
+				float offset[3];
+				float soft_iron[3][3];
+				float radius;
+
+				if (ellipsoid_fit_least_squares(&worker_data.points[cur_mag]->fit, offset, soft_iron, &radius) == 0 &&
+				    soft_iron_usable(soft_iron)) {
+					sphere_x[cur_mag] = offset[0];
+					sphere_y[cur_mag] = offset[1];
+					sphere_z[cur_mag] = offset[2];
+					sphere_radius[cur_mag] = radius;
+					scale_x[cur_mag] = soft_iron[0][0];
+					scale_y[cur_mag] = soft_iron[1][1];
+					scale_z[cur_mag] = soft_iron[2][2];
+
+				} else {
+					calibration_log_info(mavlink_log_pub, "[cal] mag #%u: no scale, using sphere fit", cur_mag);
+				}
+
 				if (!PX4_ISFINITE(sphere_x[cur_mag]) || !PX4_ISFINITE(sphere_y[cur_mag]) || !PX4_ISFINITE(sphere_z[cur_mag])) {
 					calibration_log_emergency(mavlink_log_pub, "ERROR: Retry calibration (sphere NaN, #%u)", cur_mag);
 					result = calibrate_return_error;
@@ -581,56 +637,9 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t (&devi
 		}
 	}
 
-	// Print uncalibrated data points
-	if (result == calibrate_return_ok) {
-
-		// DO NOT REMOVE! Critical validation data!
-
-		// printf("RAW DATA:\n--------------------\n");
-		// for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-
-		// 	if (worker_data.calibration_counter_total[cur_mag] == 0) {
-		// 		continue;
-		// 	}
-
-		// 	printf("RAW: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-		// 	for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-		// 		float x = worker_data.x[cur_mag][i];
-		// 		float y = worker_data.y[cur_mag][i];
-		// 		float z = worker_data.z[cur_mag][i];
-		// 		printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-		// 	}
-
-		// 	printf(">>>>>>>\n");
-		// }
-
-		// printf("CALIBRATED DATA:\n--------------------\n");
-		// for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-
-		// 	if (worker_data.calibration_counter_total[cur_mag] == 0) {
-		// 		continue;
-		// 	}
-
-		// 	printf("Calibrated: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-		// 	for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-		// 		float x = worker_data.x[cur_mag][i] - sphere_x[cur_mag];
-		// 		float y = worker_data.y[cur_mag][i] - sphere_y[cur_mag];
-		// 		float z = worker_data.z[cur_mag][i] - sphere_z[cur_mag];
-		// 		printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-		// 	}
-
-		// 	printf("SPHERE RADIUS: %8.4f\n", (double)sphere_radius[cur_mag]);
-		// 	printf(">>>>>>>\n");
-		// }
-	}
-
 	// Data points are no longer needed
 	for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
-		free(worker_data.x[cur_mag]);
-		free(worker_data.y[cur_mag]);
-		free(worker_data.z[cur_mag]);
+		free(worker_data.points[cur_mag]);
 	}
 
 	if (result == calibrate_return_ok) {
@@ -663,6 +672,9 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t (&devi
 					mscale.x_offset = sphere_x[cur_mag];
 					mscale.y_offset = sphere_y[cur_mag];
 					mscale.z_offset = sphere_z[cur_mag];
+					mscale.x_scale = scale_x[cur_mag];
+					mscale.y_scale = scale_y[cur_mag];
+					mscale.z_scale = scale_z[cur_mag];
 
 #ifndef __PX4_QURT
 					if (px4_ioctl(fd_mag, MAGIOCSSCALE, (long unsigned int)&mscale) != OK) {
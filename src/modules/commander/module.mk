@@ -41,6 +41,7 @@ SRCS		 	= commander.cpp \
 			state_machine_helper.cpp \
 			commander_helper.cpp \
 			calibration_routines.cpp \
+			calibration_fit.cpp \
 			accelerometer_calibration.cpp \
 			gyro_calibration.cpp \
 			mag_calibration.cpp \
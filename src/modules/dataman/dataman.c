@@ -66,6 +66,9 @@ __EXPORT int dataman_main(int argc, char *argv[]);
 __EXPORT ssize_t dm_read(dm_item_t item, unsigned char index, void *buffer, size_t buflen);
 __EXPORT ssize_t dm_write(dm_item_t  item, unsigned char index, dm_persitence_t persistence, const void *buffer,
 			  size_t buflen);
+__EXPORT ssize_t dm_read_items(dm_item_t item, unsigned char index, void *buffer, size_t item_len, unsigned count);
+__EXPORT ssize_t dm_write_items(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buffer,
+				size_t item_len, unsigned count);
 __EXPORT int dm_clear(dm_item_t item);
 __EXPORT void dm_lock(dm_item_t item);
 __EXPORT void dm_unlock(dm_item_t item);
@@ -75,6 +78,8 @@ __EXPORT int dm_restart(dm_reset_reason restart_type);
 typedef enum {
 	dm_write_func = 0,
 	dm_read_func,
+	dm_write_items_func,
+	dm_read_items_func,
 	dm_clear_func,
 	dm_restart_func,
 	dm_number_of_funcs
@@ -101,6 +106,14 @@ typedef struct {
 			void *buf;
 			size_t count;
 		} read_params;
+		struct {
+			dm_item_t item;
+			unsigned char index;
+			dm_persitence_t persistence;
+			void *buf;
+			size_t item_len;
+			unsigned count;
+		} items_params;
 		struct {
 			dm_item_t item;
 		} clear_params;
@@ -320,9 +333,9 @@ calculate_offset(dm_item_t item, unsigned char index)
  * The total size must not exceed k_sector_size
  */
 
-/* write to the data manager file */
+/* write to the data manager file, without flushing it to the physical media */
 static ssize_t
-_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+_write_sector(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
 {
 	unsigned char buffer[k_sector_size];
 	size_t len;
@@ -356,10 +369,9 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 	len = -1;
 
 	/* Seek to the right spot in the data manager file and write the data item */
-	if (lseek(g_task_fd, offset, SEEK_SET) == offset)
-		if ((len = write(g_task_fd, buffer, count)) == count) {
-			fsync(g_task_fd);        /* Make sure data is written to physical media */
-		}
+	if (lseek(g_task_fd, offset, SEEK_SET) == offset) {
+		len = write(g_task_fd, buffer, count);
+	}
 
 	/* Make sure the write succeeded */
 	if (len != count) {
@@ -370,6 +382,50 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 	return count - DM_SECTOR_HDR_SIZE;
 }
 
+/* write to the data manager file */
+static ssize_t
+_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	ssize_t result = _write_sector(item, index, persistence, buf, count);
+
+	if (result >= 0) {
+		fsync(g_task_fd);        /* Make sure data is written to physical media */
+	}
+
+	return result;
+}
+
+/* write consecutive items to the data manager file, flushing it to the physical media once */
+static ssize_t
+_write_items(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t item_len,
+	     unsigned count)
+{
+	const unsigned char *data = (const unsigned char *)buf;
+	ssize_t result = 0;
+	unsigned i;
+
+	/* Make sure all the indices are valid for this item type */
+	if (item >= DM_KEY_NUM_KEYS || (unsigned)index + count > g_per_item_max_index[item]) {
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (_write_sector(item, index + i, persistence, data + i * item_len, item_len) != (ssize_t)item_len) {
+			result = -1;
+			break;
+		}
+
+		result++;
+	}
+
+	/* Whatever made it into the file has to reach the physical media */
+	if (count > 0) {
+		fsync(g_task_fd);
+	}
+
+	return result;
+}
+
 /* Retrieve from the data manager file */
 static ssize_t
 _read(dm_item_t item, unsigned char index, void *buf, size_t count)
@@ -422,6 +478,27 @@ _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	return buffer[0];
 }
 
+/* Retrieve consecutive items from the data manager file, all of which have to be complete */
+static ssize_t
+_read_items(dm_item_t item, unsigned char index, void *buf, size_t item_len, unsigned count)
+{
+	unsigned char *data = (unsigned char *)buf;
+	unsigned i;
+
+	/* Make sure all the indices are valid for this item type */
+	if (item >= DM_KEY_NUM_KEYS || (unsigned)index + count > g_per_item_max_index[item]) {
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (_read(item, index + i, data + i * item_len, item_len) != (ssize_t)item_len) {
+			return -1;
+		}
+	}
+
+	return count;
+}
+
 static int
 _clear(dm_item_t item)
 {
@@ -594,6 +671,62 @@ dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
 }
 
+/** Write consecutive items to the data manager file */
+__EXPORT ssize_t
+dm_write_items(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t item_len,
+	       unsigned count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a write request */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_write_items_func;
+	work->items_params.item = item;
+	work->items_params.index = index;
+	work->items_params.persistence = persistence;
+	work->items_params.buf = (void *)buf;
+	work->items_params.item_len = item_len;
+	work->items_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Retrieve consecutive items from the data manager file */
+__EXPORT ssize_t
+dm_read_items(dm_item_t item, unsigned char index, void *buf, size_t item_len, unsigned count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a read request */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_read_items_func;
+	work->items_params.item = item;
+	work->items_params.index = index;
+	work->items_params.buf = buf;
+	work->items_params.item_len = item_len;
+	work->items_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
 __EXPORT int
 dm_clear(dm_item_t item)
 {
@@ -810,6 +943,20 @@ task_main(int argc, char *argv[])
 					_read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
 				break;
 
+			case dm_write_items_func:
+				g_func_counts[dm_write_items_func]++;
+				work->result =
+					_write_items(work->items_params.item, work->items_params.index, work->items_params.persistence,
+						     work->items_params.buf, work->items_params.item_len, work->items_params.count);
+				break;
+
+			case dm_read_items_func:
+				g_func_counts[dm_read_items_func]++;
+				work->result =
+					_read_items(work->items_params.item, work->items_params.index, work->items_params.buf,
+						    work->items_params.item_len, work->items_params.count);
+				break;
+
 			case dm_clear_func:
 				g_func_counts[dm_clear_func]++;
 				work->result = _clear(work->clear_params.item);
@@ -883,6 +1030,8 @@ status(void)
 	/* display usage statistics */
 	warnx("Writes   %d", g_func_counts[dm_write_func]);
 	warnx("Reads    %d", g_func_counts[dm_read_func]);
+	warnx("Block writes %d", g_func_counts[dm_write_items_func]);
+	warnx("Block reads  %d", g_func_counts[dm_read_items_func]);
 	warnx("Clears   %d", g_func_counts[dm_clear_func]);
 	warnx("Restarts %d", g_func_counts[dm_restart_func]);
 	warnx("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
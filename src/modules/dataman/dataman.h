@@ -110,6 +110,27 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/** Retrieve consecutive items from the data manager store, returns count or -1 unless all items are complete */
+__EXPORT ssize_t
+dm_read_items(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned char index,		/* The index of the first item */
+	void *buffer,			/* Pointer to caller data buffer of count * item_len bytes */
+	size_t item_len,		/* Length in bytes of each item */
+	unsigned count			/* Number of items to retrieve */
+);
+
+/** write consecutive items to the data manager store with a single flush, returns count or -1 */
+__EXPORT ssize_t
+dm_write_items(
+	dm_item_t  item,		/* The item type to store */
+	unsigned char index,		/* The index of the first item */
+	dm_persitence_t persistence,	/* The persistence level of these items */
+	const void *buffer,		/* Pointer to caller data buffer of count * item_len bytes */
+	size_t item_len,		/* Length in bytes of each item */
+	unsigned count			/* Number of items to store */
+);
+
 /** Lock all items of this type */
 __EXPORT void
 dm_lock(
@@ -59,6 +59,7 @@
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/mavlink_log.h>
+#include <systemlib/latency_trace.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <platforms/px4_defines.h>
@@ -485,6 +486,7 @@ void Ekf2::task_main()
 			// generate control state data
 			control_state_s ctrl_state = {};
 			ctrl_state.timestamp = hrt_absolute_time();
+			ctrl_state.timestamp_sample = sensors.timestamp;
 			ctrl_state.roll_rate = _lp_roll_rate.apply(sensors.gyro_rad_s[0]);
 			ctrl_state.pitch_rate = _lp_pitch_rate.apply(sensors.gyro_rad_s[1]);
 			ctrl_state.yaw_rate = _lp_yaw_rate.apply(sensors.gyro_rad_s[2]);
@@ -512,6 +514,8 @@ void Ekf2::task_main()
 				orb_publish(ORB_ID(control_state), _control_state_pub, &ctrl_state);
 			}
 
+			latency_trace_record(LATENCY_STAGE_ESTIMATOR, ctrl_state.timestamp_sample);
+
 
 			// generate remaining vehicle attitude data
 			att.timestamp = hrt_absolute_time();
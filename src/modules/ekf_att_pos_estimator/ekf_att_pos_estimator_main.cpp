@@ -64,6 +64,7 @@
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/mavlink_log.h>
+#include <systemlib/latency_trace.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <platforms/px4_defines.h>
@@ -896,6 +897,7 @@ void AttitudePositionEstimatorEKF::publishControlState()
 
 	/* Attitude */
 	_ctrl_state.timestamp = _last_sensor_timestamp;
+	_ctrl_state.timestamp_sample = _last_sensor_timestamp;
 	_ctrl_state.q[0] = _ekf->states[0];
 	_ctrl_state.q[1] = _ekf->states[1];
 	_ctrl_state.q[2] = _ekf->states[2];
@@ -939,6 +941,8 @@ void AttitudePositionEstimatorEKF::publishControlState()
 		/* advertise and publish */
 		_ctrl_state_pub = orb_advertise(ORB_ID(control_state), &_ctrl_state);
 	}
+
+	latency_trace_record(LATENCY_STAGE_ESTIMATOR, _ctrl_state.timestamp_sample);
 }
 
 void AttitudePositionEstimatorEKF::publishLocalPosition()
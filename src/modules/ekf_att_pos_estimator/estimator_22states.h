@@ -327,8 +327,6 @@ public:
 
     void ConstrainStates();
 
-    void ForceSymmetry();
-
     /**
     * @brief
     *   Check the filter inputs and bound its operational state
@@ -412,6 +410,27 @@ protected:
 
     void ResetStoredStates();
 
+    /**
+     * @brief
+     *   Apply the covariance update P = (I - K*H)*P of a single observation
+     *
+     *   K*H*P is evaluated as K*(H*P), with numerical protection only its
+     *   upper triangle is computed and mirrored.
+     * @param K
+     *   the Kalman gains
+     * @param HP
+     *   the product of the observation jacobian and P
+     * @return
+     *   true if the updated covariance diverged
+     */
+    bool UpdateCovariance(const float (&K)[EKF_STATE_ESTIMATES], const float (&HP)[EKF_STATE_ESTIMATES]);
+
+    /**
+     * @brief
+     *   Flag excessive covariances and reinitialize the filter
+     */
+    void ResetDivergedCovariance();
+
 private:
     bool _isFixedWing;               ///< True if the vehicle is a fixed-wing frame type
     bool _onGround;                  ///< boolean true when the flight vehicle is on the ground (not flying)
@@ -1359,13 +1359,18 @@ FixedwingPositionControl::control_position(const math::Vector<2> &current_positi
 				_time_started_landing = hrt_absolute_time();
 			}
 
-			float bearing_lastwp_currwp = get_bearing_to_next_waypoint(prev_wp(0), prev_wp(1), curr_wp(0), curr_wp(1));
-			float bearing_airplane_currwp = get_bearing_to_next_waypoint(current_position(0), current_position(1), curr_wp(0),
-							curr_wp(1));
+			/* the current waypoint and position are used more than once */
+			struct geo_point_s prev_wp_point, curr_wp_point, position_point;
+			geo_point_init(&prev_wp_point, prev_wp(0), prev_wp(1));
+			geo_point_init(&curr_wp_point, curr_wp(0), curr_wp(1));
+			geo_point_init(&position_point, current_position(0), current_position(1));
+
+			float bearing_lastwp_currwp = get_bearing_between_points(&prev_wp_point, &curr_wp_point);
+			float bearing_airplane_currwp = get_bearing_between_points(&position_point, &curr_wp_point);
 
 			/* Horizontal landing control */
 			/* switch to heading hold for the last meters, continue heading hold after */
-			float wp_distance = get_distance_to_next_waypoint(current_position(0), current_position(1), curr_wp(0), curr_wp(1));
+			float wp_distance = get_distance_between_points(&position_point, &curr_wp_point);
 			/* calculate a waypoint distance value which is 0 when the aircraft is behind the waypoint */
 			float wp_distance_save = wp_distance;
 
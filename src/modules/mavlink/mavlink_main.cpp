@@ -133,6 +133,7 @@ Mavlink::Mavlink() :
 	_generate_rc(false),
 	_use_hil_gps(false),
 	_forward_externalsp(false),
+	_mission_window(1),
 	_is_usb_uart(false),
 	_wait_to_transmit(false),
 	_received_messages(false),
@@ -196,6 +197,7 @@ Mavlink::Mavlink() :
 	_param_system_type(MAV_TYPE_FIXED_WING),
 	_param_use_hil_gps(0),
 	_param_forward_externalsp(0),
+	_param_mission_window(0),
 	_system_type(0),
 
 	/* performance counters */
@@ -479,6 +481,7 @@ void Mavlink::mavlink_update_system(void)
 		_param_system_type = param_find("MAV_TYPE");
 		_param_use_hil_gps = param_find("MAV_USEHILGPS");
 		_param_forward_externalsp = param_find("MAV_FWDEXTSP");
+		_param_mission_window = param_find("MAV_MIS_WINDOW");
 
 		/* test param - needs to be referenced, but is unused */
 		(void)param_find("MAV_TEST_PAR");
@@ -534,6 +537,13 @@ void Mavlink::mavlink_update_system(void)
 	param_get(_param_forward_externalsp, &forward_externalsp);
 
 	_forward_externalsp = (bool)forward_externalsp;
+
+	int32_t mission_window;
+	param_get(_param_mission_window, &mission_window);
+
+	if (mission_window >= 1 && mission_window <= MAVLINK_MISSION_TRANSFER_WINDOW) {
+		_mission_window = mission_window;
+	}
 }
 
 int Mavlink::get_system_id()
@@ -44,6 +44,7 @@
 #include "mavlink_main.h"
 
 #include <math.h>
+#include <string.h>
 #include <lib/geo/geo.h>
 #include <systemlib/err.h>
 #include <drivers/drv_hrt.h>
@@ -85,6 +86,11 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) : MavlinkStream(m
 	_transfer_current_seq(0),
 	_transfer_partner_sysid(0),
 	_transfer_partner_compid(0),
+	_transfer_window(),
+	_transfer_items{},
+	_read_ahead_dataman_id(0),
+	_read_ahead_seq(0),
+	_read_ahead_count(0),
 	_offboard_mission_sub(-1),
 	_mission_result_sub(-1),
 	_offboard_mission_pub(nullptr),
@@ -232,13 +238,41 @@ MavlinkMissionManager::send_mission_count(uint8_t sysid, uint8_t compid, uint16_
 }
 
 
+bool
+MavlinkMissionManager::read_mission_item(uint16_t seq, struct mission_item_s *mission_item)
+{
+	dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_dataman_id);
+
+	/* the buffer holds the upload block while receiving, read ahead only while sending the list */
+	if (_state != MAVLINK_WPM_STATE_SENDLIST || seq >= _count) {
+		return dm_read(dm_item, seq, mission_item, sizeof(struct mission_item_s)) == sizeof(struct mission_item_s);
+	}
+
+	if (_read_ahead_dataman_id != _dataman_id || seq < _read_ahead_seq || seq >= _read_ahead_seq + _read_ahead_count) {
+		unsigned count = _count - seq < MAVLINK_MISSION_TRANSFER_WINDOW ? _count - seq : MAVLINK_MISSION_TRANSFER_WINDOW;
+
+		_read_ahead_count = 0;
+
+		if (dm_read_items(dm_item, seq, _transfer_items, sizeof(struct mission_item_s), count) != (ssize_t)count) {
+			return false;
+		}
+
+		_read_ahead_dataman_id = _dataman_id;
+		_read_ahead_seq = seq;
+		_read_ahead_count = count;
+	}
+
+	memcpy(mission_item, &_transfer_items[seq - _read_ahead_seq], sizeof(struct mission_item_s));
+	return true;
+}
+
+
 void
 MavlinkMissionManager::send_mission_item(uint8_t sysid, uint8_t compid, uint16_t seq)
 {
-	dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_dataman_id);
 	struct mission_item_s mission_item;
 
-	if (dm_read(dm_item, seq, &mission_item, sizeof(struct mission_item_s)) == sizeof(struct mission_item_s)) {
+	if (read_mission_item(seq, &mission_item)) {
 		_time_last_sent = hrt_absolute_time();
 
 		/* create mission_item_s from mavlink_mission_item_t */
@@ -288,6 +322,17 @@ MavlinkMissionManager::send_mission_request(uint8_t sysid, uint8_t compid, uint1
 }
 
 
+void
+MavlinkMissionManager::request_missing_items()
+{
+	for (unsigned seq = _transfer_window.next_missing(_transfer_window.first());
+	     seq < _transfer_window.first() + _transfer_window.size();
+	     seq = _transfer_window.next_missing(seq + 1)) {
+		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, seq);
+	}
+}
+
+
 void
 MavlinkMissionManager::send_mission_item_reached(uint16_t seq)
 {
@@ -322,6 +367,9 @@ MavlinkMissionManager::send(const hrt_abstime now)
 		send_mission_current(_current_seq);
 
 		if (mission_result.item_do_jump_changed) {
+			/* the item read ahead is outdated */
+			_read_ahead_count = 0;
+
 			/* send a mission item again if the remaining DO_JUMPs has changed */
 			send_mission_item(_transfer_partner_sysid, _transfer_partner_compid,
 					  (uint16_t)mission_result.item_changed_index);
@@ -342,8 +390,8 @@ MavlinkMissionManager::send(const hrt_abstime now)
 		_state = MAVLINK_WPM_STATE_IDLE;
 
 	} else if (_state == MAVLINK_WPM_STATE_GETLIST && hrt_elapsed_time(&_time_last_sent) > _retry_timeout) {
-		/* try to request item again after timeout */
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		/* try to request the missing items again after timeout */
+		request_missing_items();
 
 	} else if (_state == MAVLINK_WPM_STATE_SENDLIST && hrt_elapsed_time(&_time_last_sent) > _retry_timeout) {
 		if (_transfer_seq == 0) {
@@ -478,6 +526,7 @@ MavlinkMissionManager::handle_mission_request_list(const mavlink_message_t *msg)
 			_state = MAVLINK_WPM_STATE_SENDLIST;
 			_transfer_seq = 0;
 			_transfer_count = _count;
+			_read_ahead_count = 0;
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 
@@ -615,11 +664,12 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_count = wpc.count;
 			_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
 			_transfer_current_seq = -1;
+			_transfer_window.start(_transfer_count, _mavlink->get_mission_window());
 
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
-			if (_transfer_seq == 0) {
+			if (_transfer_seq == 0 && _transfer_window.empty()) {
 				/* looks like our MISSION_REQUEST was lost, try again */
 				if (_verbose) { warnx("WPM: MISSION_COUNT %u from ID %u (again)", wpc.count, msg->sysid); }
 
@@ -639,7 +689,7 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			return;
 		}
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		request_missing_items();
 	}
 }
 
@@ -654,8 +704,8 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 		if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
-			if (wp.seq != _transfer_seq) {
-				if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_seq); }
+			if (!_transfer_window.contains(wp.seq) || _transfer_window.received(wp.seq)) {
+				if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: seq %u was not expected in [%u, %u)", wp.seq, _transfer_window.first(), _transfer_window.first() + _transfer_window.size()); }
 
 				/* don't send request here, it will be performed in eventloop after timeout */
 				return;
@@ -674,7 +724,8 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 			return;
 		}
 
-		struct mission_item_s mission_item = {};
+		struct mission_item_s &mission_item = _transfer_items[wp.seq - _transfer_window.first()];
+		memset(&mission_item, 0, sizeof(mission_item));
 		int ret = parse_mavlink_mission_item(&wp, &mission_item);
 
 		if (ret != OK) {
@@ -688,10 +739,27 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 			return;
 		}
 
+		_transfer_window.set_received(wp.seq);
+
+		/* waypoint marked as current */
+		if (wp.current) {
+			_transfer_current_seq = wp.seq;
+		}
+
+		if (_verbose) { warnx("WPM: MISSION_ITEM seq %u received", wp.seq); }
+
+		if (!_transfer_window.complete()) {
+			/* wait for the rest of the block */
+			return;
+		}
+
+		/* store the whole block at once */
 		dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
+		unsigned first = _transfer_window.first();
+		unsigned size = _transfer_window.size();
 
-		if (dm_write(dm_item, wp.seq, DM_PERSIST_POWER_ON_RESET, &mission_item, sizeof(struct mission_item_s)) != sizeof(struct mission_item_s)) {
-			if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id); }
+		if (dm_write_items(dm_item, first, DM_PERSIST_POWER_ON_RESET, _transfer_items, sizeof(struct mission_item_s), size) != (ssize_t)size) {
+			if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u to %u to dataman ID %i", first, first + size - 1, _transfer_dataman_id); }
 
 			send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
 			_mavlink->send_statustext_critical("Unable to write on micro SD");
@@ -700,16 +768,9 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 			return;
 		}
 
-		/* waypoint marked as current */
-		if (wp.current) {
-			_transfer_current_seq = wp.seq;
-		}
-
-		if (_verbose) { warnx("WPM: MISSION_ITEM seq %u received", wp.seq); }
-
-		_transfer_seq = wp.seq + 1;
+		_transfer_seq = first + size;
 
-		if (_transfer_seq == _transfer_count) {
+		if (!_transfer_window.advance()) {
 			/* got all new mission items successfully */
 			if (_verbose) { warnx("WPM: MISSION_ITEM got all %u items, current_seq=%u, changing state to MAVLINK_WPM_STATE_IDLE", _transfer_count, _transfer_current_seq); }
 
@@ -724,8 +785,8 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 			_transfer_in_progress = false;
 
 		} else {
-			/* request next item */
-			send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+			/* request next block */
+			request_missing_items();
 		}
 	}
 }
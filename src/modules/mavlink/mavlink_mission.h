@@ -44,7 +44,10 @@
 
 #include <uORB/uORB.h>
 
+#include <navigator/navigation.h>
+
 #include "mavlink_bridge_header.h"
+#include "mavlink_mission_window.h"
 #include "mavlink_rate_limiter.h"
 #include "mavlink_stream.h"
 
@@ -66,6 +69,7 @@ enum MAVLINK_WPM_CODES {
 
 #define MAVLINK_MISSION_PROTOCOL_TIMEOUT_DEFAULT 5000000    ///< Protocol communication action timeout in useconds
 #define MAVLINK_MISSION_RETRY_TIMEOUT_DEFAULT 500000        ///< Protocol communication retry timeout in useconds
+#define MAVLINK_MISSION_TRANSFER_WINDOW 8                   ///< Maximum number of items requested at once, and stored or read ahead in one dataman access
 
 class MavlinkMissionManager : public MavlinkStream {
 public:
@@ -125,6 +129,12 @@ private:
 	unsigned		_transfer_partner_compid;		///< Partner component ID for current transmission
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
+	MavlinkMissionWindow	_transfer_window;			///< Requested block of the current upload
+	struct mission_item_s	_transfer_items[MAVLINK_MISSION_TRANSFER_WINDOW];	///< Items of the current upload block or download read ahead
+	int			_read_ahead_dataman_id;			///< Dataman storage ID of the items read ahead
+	unsigned		_read_ahead_seq;			///< Sequence of the first item read ahead
+	unsigned		_read_ahead_count;			///< Items count read ahead, 0 if none
+
 	int			_offboard_mission_sub;
 	int			_mission_result_sub;
 	orb_advert_t		_offboard_mission_pub;
@@ -165,6 +175,16 @@ private:
 
 	void send_mission_request(uint8_t sysid, uint8_t compid, uint16_t seq);
 
+	/**
+	 *  @brief Requests all items of the current upload block that have not been received yet
+	 */
+	void request_missing_items();
+
+	/**
+	 *  @brief Reads an item of the active mission, ahead by a block while sending the list
+	 */
+	bool read_mission_item(uint16_t seq, struct mission_item_s *mission_item);
+
 	/**
 	 *  @brief emits a message that a waypoint reached
 	 *
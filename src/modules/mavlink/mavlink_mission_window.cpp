@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_mission_window.cpp
+ * Bookkeeping of a windowed mission upload.
+ */
+
+#include "mavlink_mission_window.h"
+
+constexpr unsigned MavlinkMissionWindow::MAX_SIZE;
+
+MavlinkMissionWindow::MavlinkMissionWindow() :
+	_count(0),
+	_block_size(1),
+	_first(0),
+	_size(0),
+	_received(0)
+{
+}
+
+void
+MavlinkMissionWindow::start(unsigned count, unsigned size)
+{
+	if (size < 1) {
+		size = 1;
+
+	} else if (size > MAX_SIZE) {
+		size = MAX_SIZE;
+	}
+
+	_count = count;
+	_block_size = size;
+	_first = 0;
+	_size = count < size ? count : size;
+	_received = 0;
+}
+
+bool
+MavlinkMissionWindow::set_received(unsigned seq)
+{
+	if (!contains(seq) || received(seq)) {
+		return false;
+	}
+
+	_received |= 1u << (seq - _first);
+	return true;
+}
+
+unsigned
+MavlinkMissionWindow::next_missing(unsigned seq) const
+{
+	if (seq < _first) {
+		seq = _first;
+	}
+
+	while (seq < _first + _size && received(seq)) {
+		seq++;
+	}
+
+	return seq;
+}
+
+bool
+MavlinkMissionWindow::advance()
+{
+	_first += _size;
+	_received = 0;
+
+	if (_first >= _count) {
+		_first = _count;
+		_size = 0;
+		return false;
+	}
+
+	_size = _count - _first < _block_size ? _count - _first : _block_size;
+	return true;
+}
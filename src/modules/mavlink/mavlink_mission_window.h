@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_mission_window.h
+ * Bookkeeping of a windowed mission upload.
+ *
+ * The items of a mission are requested in blocks: all requests of a block are
+ * sent at once, the items may arrive in any order, and the block is stored
+ * when it is complete, after which the next block is requested.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class MavlinkMissionWindow
+{
+public:
+	static constexpr unsigned MAX_SIZE = 16;	///< Maximum number of items in a block
+
+	MavlinkMissionWindow();
+
+	/**
+	 * Start a transfer.
+	 *
+	 * @param count number of items in the transfer
+	 * @param size number of items in a block, limited to 1 ... MAX_SIZE
+	 */
+	void start(unsigned count, unsigned size);
+
+	/**
+	 * Sequence number of the first item in the current block.
+	 */
+	unsigned first() const { return _first; }
+
+	/**
+	 * Number of items in the current block.
+	 */
+	unsigned size() const { return _size; }
+
+	/**
+	 * True if the item belongs to the current block.
+	 */
+	bool contains(unsigned seq) const { return seq >= _first && seq < _first + _size; }
+
+	/**
+	 * True if the item of the current block has been received.
+	 */
+	bool received(unsigned seq) const { return contains(seq) && (_received & (1u << (seq - _first))); }
+
+	/**
+	 * True if no item of the current block has been received yet.
+	 */
+	bool empty() const { return _received == 0; }
+
+	/**
+	 * True if all items of the current block have been received.
+	 */
+	bool complete() const { return _size > 0 && _received == (1u << _size) - 1; }
+
+	/**
+	 * True if all blocks have been completed.
+	 */
+	bool finished() const { return _first >= _count; }
+
+	/**
+	 * Mark an item of the current block as received.
+	 *
+	 * @return false if the item is not in the block or has been received already
+	 */
+	bool set_received(unsigned seq);
+
+	/**
+	 * First item of the current block at or after seq that has not been received.
+	 *
+	 * @return sequence number of the item, first() + size() if there is none
+	 */
+	unsigned next_missing(unsigned seq) const;
+
+	/**
+	 * Move on to the next block, after the current one has been stored.
+	 *
+	 * @return false if the transfer is finished
+	 */
+	bool advance();
+
+private:
+	unsigned	_count;		///< Items count in the transfer
+	unsigned	_block_size;	///< Items count in a full block
+	unsigned	_first;		///< First item of the current block
+	unsigned	_size;		///< Items count in the current block
+	uint32_t	_received;	///< Received items of the current block, bit 0 is the first item
+};
@@ -90,6 +90,18 @@ PARAM_DEFINE_INT32(MAV_USEHILGPS, 0);
  */
 PARAM_DEFINE_INT32(MAV_FWDEXTSP, 1);
 
+/**
+ * Mission upload window
+ *
+ * Number of mission items requested at once during a mission upload. Ground
+ * stations which answer only one MISSION_REQUEST at a time need 1.
+ *
+ * @min 1
+ * @max 8
+ * @group MAVLink
+ */
+PARAM_DEFINE_INT32(MAV_MIS_WINDOW, 1);
+
 /**
  * Test parameter
  *
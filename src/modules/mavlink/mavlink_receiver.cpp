@@ -339,6 +339,7 @@ MavlinkReceiver::handle_message_command_long(mavlink_message_t *msg)
 
 			struct vehicle_command_s vcmd;
 			memset(&vcmd, 0, sizeof(vcmd));
+			vcmd.timestamp = hrt_absolute_time();
 
 			/* Copy the content of mavlink_command_long_t cmd_mavlink into command_t cmd */
 			vcmd.param1 = cmd_mavlink.param1;
@@ -403,6 +404,7 @@ MavlinkReceiver::handle_message_command_int(mavlink_message_t *msg)
 
 			struct vehicle_command_s vcmd;
 			memset(&vcmd, 0, sizeof(vcmd));
+			vcmd.timestamp = hrt_absolute_time();
 
 			/* Copy the content of mavlink_command_int_t cmd_mavlink into command_t cmd */
 			vcmd.param1 = cmd_mavlink.param1;
@@ -548,6 +550,7 @@ MavlinkReceiver::handle_message_set_mode(mavlink_message_t *msg)
 
 	struct vehicle_command_s vcmd;
 	memset(&vcmd, 0, sizeof(vcmd));
+	vcmd.timestamp = hrt_absolute_time();
 
 	union px4_custom_mode custom_mode;
 	custom_mode.data = new_mode.custom_mode;
@@ -40,6 +40,7 @@ MODULE_COMMAND  = mavlink
 SRCS 		 +=	mavlink.c \
 		  	mavlink_main.cpp \
 			mavlink_mission.cpp \
+			mavlink_mission_window.cpp \
 			mavlink_parameters.cpp \
 			mavlink_orb_subscription.cpp \
 			mavlink_messages.cpp \
@@ -85,6 +85,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/circuit_breaker.h>
 #include <lib/mathlib/mathlib.h>
@@ -234,21 +235,6 @@ private:
 	 */
 	int			parameters_update();
 
-	/**
-	 * Check for parameter update and handle it.
-	 */
-	void		parameter_update_poll();
-
-	/**
-	 * Check for changes in vehicle control mode.
-	 */
-	void		vehicle_control_mode_poll();
-
-	/**
-	 * Check for changes in manual inputs.
-	 */
-	void		vehicle_manual_poll();
-
 	/**
 	 * Check for attitude setpoint updates.
 	 */
@@ -259,11 +245,6 @@ private:
 	 */
 	void		vehicle_rates_setpoint_poll();
 
-	/**
-	 * Check for arming status updates.
-	 */
-	void		arming_status_poll();
-
 	/**
 	 * Attitude controller.
 	 */
@@ -275,14 +256,10 @@ private:
 	void		control_attitude_rates(float dt);
 
 	/**
-	 * Check for vehicle status updates.
+	 * Check for updates of the vehicle status, mode, manual input, arming,
+	 * motor limits and parameter topics and handle them.
 	 */
-	void		vehicle_status_poll();
-
-	/**
-	 * Check for vehicle motor limits status.
-	 */
-	void		vehicle_motor_limits_poll();
+	void		poll_subscriptions();
 
 	/**
 	 * Shim for calling task_main from task_create.
@@ -326,7 +303,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 
 	/* performance counters */
 	_loop_perf(perf_alloc(PC_ELAPSED, "mc_att_control")),
-	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency")),
+	_controller_latency_perf(perf_alloc_once(PC_ELAPSED_HIST, "ctrl_latency")),
 	_ts_opt_recovery(nullptr)
 
 {
@@ -527,47 +504,6 @@ MulticopterAttitudeControl::parameters_update()
 	return OK;
 }
 
-void
-MulticopterAttitudeControl::parameter_update_poll()
-{
-	bool updated;
-
-	/* Check if parameters have changed */
-	orb_check(_params_sub, &updated);
-
-	if (updated) {
-		struct parameter_update_s param_update;
-		orb_copy(ORB_ID(parameter_update), _params_sub, &param_update);
-		parameters_update();
-	}
-}
-
-void
-MulticopterAttitudeControl::vehicle_control_mode_poll()
-{
-	bool updated;
-
-	/* Check if vehicle control mode has changed */
-	orb_check(_v_control_mode_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(vehicle_control_mode), _v_control_mode_sub, &_v_control_mode);
-	}
-}
-
-void
-MulticopterAttitudeControl::vehicle_manual_poll()
-{
-	bool updated;
-
-	/* get pilots inputs */
-	orb_check(_manual_control_sp_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(manual_control_setpoint), _manual_control_sp_sub, &_manual_control_sp);
-	}
-}
-
 void
 MulticopterAttitudeControl::vehicle_attitude_setpoint_poll()
 {
@@ -593,27 +529,38 @@ MulticopterAttitudeControl::vehicle_rates_setpoint_poll()
 }
 
 void
-MulticopterAttitudeControl::arming_status_poll()
+MulticopterAttitudeControl::poll_subscriptions()
 {
-	/* check if there is a new setpoint */
-	bool updated;
-	orb_check(_armed_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(actuator_armed), _armed_sub, &_armed);
+	enum {
+		SUB_PARAMS = 0,
+		SUB_CONTROL_MODE,
+		SUB_ARMED,
+		SUB_MANUAL,
+		SUB_VEHICLE_STATUS,
+		SUB_MOTOR_LIMITS
+	};
+
+	struct parameter_update_s param_update;
+
+	const struct orb_check_item items[] = {
+		{ORB_ID(parameter_update), _params_sub, &param_update},
+		{ORB_ID(vehicle_control_mode), _v_control_mode_sub, &_v_control_mode},
+		{ORB_ID(actuator_armed), _armed_sub, &_armed},
+		{ORB_ID(manual_control_setpoint), _manual_control_sp_sub, &_manual_control_sp},
+		{ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status},
+		{ORB_ID(multirotor_motor_limits), _motor_limits_sub, &_motor_limits}
+	};
+
+	/* check and copy all topics in one go */
+	uint32_t updated;
+	orb_check_many(items, sizeof(items) / sizeof(items[0]), &updated);
+
+	/* check if parameters have changed */
+	if (updated & (1 << SUB_PARAMS)) {
+		parameters_update();
 	}
-}
-
-void
-MulticopterAttitudeControl::vehicle_status_poll()
-{
-	/* check if there is new status information */
-	bool vehicle_status_updated;
-	orb_check(_vehicle_status_sub, &vehicle_status_updated);
-
-	if (vehicle_status_updated) {
-		orb_copy(ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status);
 
+	if (updated & (1 << SUB_VEHICLE_STATUS)) {
 		/* set correct uORB ID, depending on if vehicle is VTOL or not */
 		if (!_rates_sp_id) {
 			if (_vehicle_status.is_vtol) {
@@ -628,18 +575,6 @@ MulticopterAttitudeControl::vehicle_status_poll()
 	}
 }
 
-void
-MulticopterAttitudeControl::vehicle_motor_limits_poll()
-{
-	/* check if there is a new message */
-	bool updated;
-	orb_check(_motor_limits_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(multirotor_motor_limits), _motor_limits_sub, &_motor_limits);
-	}
-}
-
 /**
  * Attitude controller.
  * Input: 'vehicle_attitude_setpoint' topics (depending on mode)
@@ -867,12 +802,7 @@ MulticopterAttitudeControl::task_main()
 			orb_copy(ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state);
 
 			/* check for updates in other topics */
-			parameter_update_poll();
-			vehicle_control_mode_poll();
-			arming_status_poll();
-			vehicle_manual_poll();
-			vehicle_status_poll();
-			vehicle_motor_limits_poll();
+			poll_subscriptions();
 
 			/* Check if we are in rattitude mode and the pilot is above the threshold on pitch
 			 * or roll (yaw can rotate 360 in normal att control).  If both are true don't
@@ -962,7 +892,7 @@ MulticopterAttitudeControl::task_main()
 				_actuators.control[2] = (PX4_ISFINITE(_att_control(2))) ? _att_control(2) : 0.0f;
 				_actuators.control[3] = (PX4_ISFINITE(_thrust_sp)) ? _thrust_sp : 0.0f;
 				_actuators.timestamp = hrt_absolute_time();
-				_actuators.timestamp_sample = _ctrl_state.timestamp;
+				_actuators.timestamp_sample = _ctrl_state.timestamp_sample;
 
 				_controller_status.roll_rate_integ = _rates_int(0);
 				_controller_status.pitch_rate_integ = _rates_int(1);
@@ -974,6 +904,7 @@ MulticopterAttitudeControl::task_main()
 
 						orb_publish(_actuators_id, _actuators_0_pub, &_actuators);
 						perf_end(_controller_latency_perf);
+						latency_trace_record(LATENCY_STAGE_CONTROLLER, _actuators.timestamp_sample);
 
 					} else if (_actuators_id) {
 						_actuators_0_pub = orb_advertise(_actuators_id, &_actuators);
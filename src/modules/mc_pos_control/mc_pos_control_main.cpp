@@ -589,13 +589,31 @@ MulticopterPositionControl::parameters_update(bool force)
 void
 MulticopterPositionControl::poll_subscriptions()
 {
-	bool updated;
-
-	orb_check(_vehicle_status_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status);
-
+	enum {
+		SUB_VEHICLE_STATUS = 0,
+		SUB_CTRL_STATE,
+		SUB_ATT_SP,
+		SUB_CONTROL_MODE,
+		SUB_MANUAL,
+		SUB_ARMING,
+		SUB_LOCAL_POS
+	};
+
+	const struct orb_check_item items[] = {
+		{ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status},
+		{ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state},
+		{ORB_ID(vehicle_attitude_setpoint), _att_sp_sub, &_att_sp},
+		{ORB_ID(vehicle_control_mode), _control_mode_sub, &_control_mode},
+		{ORB_ID(manual_control_setpoint), _manual_sub, &_manual},
+		{ORB_ID(actuator_armed), _arming_sub, &_arming},
+		{ORB_ID(vehicle_local_position), _local_pos_sub, &_local_pos}
+	};
+
+	/* check and copy all topics in one go */
+	uint32_t updated;
+	orb_check_many(items, sizeof(items) / sizeof(items[0]), &updated);
+
+	if (updated & (1 << SUB_VEHICLE_STATUS)) {
 		/* set correct uORB ID, depending on if vehicle is VTOL or not */
 		if (!_attitude_setpoint_id) {
 			if (_vehicle_status.is_vtol) {
@@ -607,11 +625,7 @@ MulticopterPositionControl::poll_subscriptions()
 		}
 	}
 
-	orb_check(_ctrl_state_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state);
-
+	if (updated & (1 << SUB_CTRL_STATE)) {
 		/* get current rotation matrix and euler angles from control state quaternions */
 		math::Quaternion q_att(_ctrl_state.q[0], _ctrl_state.q[1], _ctrl_state.q[2], _ctrl_state.q[3]);
 		_R = q_att.to_dcm();
@@ -619,36 +633,6 @@ MulticopterPositionControl::poll_subscriptions()
 		euler_angles = _R.to_euler();
 		_yaw = euler_angles(2);
 	}
-
-	orb_check(_att_sp_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(vehicle_attitude_setpoint), _att_sp_sub, &_att_sp);
-	}
-
-	orb_check(_control_mode_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(vehicle_control_mode), _control_mode_sub, &_control_mode);
-	}
-
-	orb_check(_manual_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(manual_control_setpoint), _manual_sub, &_manual);
-	}
-
-	orb_check(_arming_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(actuator_armed), _arming_sub, &_arming);
-	}
-
-	orb_check(_local_pos_sub, &updated);
-
-	if (updated) {
-		orb_copy(ORB_ID(vehicle_local_position), _local_pos_sub, &_local_pos);
-	}
 }
 
 float
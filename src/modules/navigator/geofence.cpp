@@ -74,6 +74,8 @@ Geofence::Geofence(Navigator *navigator) :
 	_altitude_min(0),
 	_altitude_max(0),
 	_vertices_count(0),
+	_vertices{},
+	_update_count(0),
 	_param_action(this, "ACTION"),
 	_param_altitude_mode(this, "ALTMODE"),
 	_param_source(this, "SOURCE"),
@@ -205,18 +207,10 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 
 			bool c = false;
 
-			struct fence_vertex_s temp_vertex_i;
-			struct fence_vertex_s temp_vertex_j;
-
 			/* Red until fence is finished */
 			for (unsigned i = 0, j = _vertices_count - 1; i < _vertices_count; j = i++) {
-				if (dm_read(DM_KEY_FENCE_POINTS, i, &temp_vertex_i, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
-
-				if (dm_read(DM_KEY_FENCE_POINTS, j, &temp_vertex_j, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
+				const struct fence_vertex_s &temp_vertex_i = _vertices[i];
+				const struct fence_vertex_s &temp_vertex_j = _vertices[j];
 
 				// skip vertex 0 (return point)
 				if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
@@ -266,7 +260,7 @@ Geofence::addPoint(int argc, char *argv[])
 	char *end;
 
 	if ((argc == 1) && (strcmp("-clear", argv[0]) == 0)) {
-		dm_clear(DM_KEY_FENCE_POINTS);
+		clearDm();
 		publishFence(0);
 		return;
 	}
@@ -294,6 +288,12 @@ Geofence::addPoint(int argc, char *argv[])
 	vertex.lon = (float)lon;
 
 	if (dm_write(DM_KEY_FENCE_POINTS, ix, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) == sizeof(vertex)) {
+		if (ix >= 0 && ix < fence_s::GEOFENCE_MAX_VERTICES) {
+			_vertices[ix] = vertex;
+		}
+
+		_update_count++;
+
 		if (last) {
 			publishFence((unsigned)ix + 1);
 		}
@@ -384,16 +384,21 @@ Geofence::loadFromFile(const char *filename)
 				}
 			}
 
-			if (dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex)) {
+			if (pointCounter >= fence_s::GEOFENCE_MAX_VERTICES ||
+			    dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex)) {
 				goto error;
 			}
 
+			_vertices[pointCounter] = vertex;
+
 			warnx("Geofence: point: %d, lat %.5f: lon: %.5f", pointCounter, (double)vertex.lat, (double)vertex.lon);
 
 			pointCounter++;
 
 		} else {
 			/* Parse the line as the vertical limits */
+			_update_count++;
+
 			if (sscanf(line, "%f %f", &_altitude_min, &_altitude_max) != 2) {
 				goto error;
 			}
@@ -406,6 +411,7 @@ Geofence::loadFromFile(const char *filename)
 	/* Check if import was successful */
 	if (gotVertical && pointCounter > 0) {
 		_vertices_count = pointCounter;
+		_update_count++;
 		warnx("Geofence: imported successfully");
 		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Geofence imported");
 		rc = OK;
@@ -423,5 +429,10 @@ error:
 int Geofence::clearDm()
 {
 	dm_clear(DM_KEY_FENCE_POINTS);
+
+	/* a cleared vertex reads as zero, the fence count is left alone */
+	memset(_vertices, 0, sizeof(_vertices));
+	_update_count++;
+
 	return OK;
 }
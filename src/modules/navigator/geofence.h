@@ -101,6 +101,11 @@ public:
 
 	bool isEmpty() {return _vertices_count == 0;}
 
+	/**
+	 * Number of times the fence was changed, to tell whether a check against it is still valid
+	 */
+	unsigned getUpdateCount() { return _update_count; }
+
 	int getAltitudeMode() { return _param_altitude_mode.get(); }
 
 	int getSource() { return _param_source.get(); }
@@ -122,6 +127,8 @@ private:
 	float _altitude_max;
 
 	unsigned _vertices_count;
+	struct fence_vertex_s _vertices[fence_s::GEOFENCE_MAX_VERTICES];	/**< copy of the vertices in the dataman */
+	unsigned _update_count;
 
 	/* Params */
 	control::BlockParamInt _param_action;
@@ -84,6 +84,7 @@ Mission::Mission(Navigator *navigator, const char *name) :
 	_home_inited(false),
 	_need_mission_reset(false),
 	_missionFeasibilityChecker(),
+	_mission_cache(),
 	_min_current_sp_distance_xy(FLT_MAX),
 	_mission_item_previous_alt(NAN),
 	_distance_current_previous(0.0f),
@@ -111,6 +112,8 @@ Mission::on_inactive()
 		bool offboard_updated = false;
 		orb_check(_navigator->get_offboard_mission_sub(), &offboard_updated);
 		if (offboard_updated) {
+			/* the items may have been written in place */
+			_missionFeasibilityChecker.invalidate();
 			update_offboard_mission();
 		}
 
@@ -170,6 +173,8 @@ Mission::on_active()
 	bool offboard_updated = false;
 	orb_check(_navigator->get_offboard_mission_sub(), &offboard_updated);
 	if (offboard_updated) {
+		/* the items may have been written in place */
+		_missionFeasibilityChecker.invalidate();
 		update_offboard_mission();
 	}
 
@@ -217,6 +222,8 @@ Mission::on_active()
 void
 Mission::update_onboard_mission()
 {
+	_mission_cache.invalidate(DM_KEY_WAYPOINTS_ONBOARD);
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >=0
@@ -252,6 +259,10 @@ Mission::update_offboard_mission()
 {
 	bool failed = true;
 
+	/* the items of either storage may have been rewritten, a new upload goes to the other one */
+	_mission_cache.invalidate(DM_KEY_WAYPOINTS_OFFBOARD_0);
+	_mission_cache.invalidate(DM_KEY_WAYPOINTS_OFFBOARD_1);
+
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		warnx("offboard mission updated: dataman_id=%d, count=%d, current_seq=%d", _offboard_mission.dataman_id, _offboard_mission.count, _offboard_mission.current_seq);
 		/* determine current index */
@@ -968,13 +979,11 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 			return false;
 		}
 
-		const ssize_t len = sizeof(struct mission_item_s);
-
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the cache, or the datamanager if it does not hold it */
+		if (!_mission_cache.read(dm_item, *mission_index_ptr, &mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_and_console_log_critical(_navigator->get_mavlink_log_pub(), "ERROR waypoint could not be read");
 			return false;
@@ -990,9 +999,9 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 				* but not for the read ahead mission item */
 				if (offset == 0) {
 					(mission_item_tmp.do_jump_current_count)++;
-					/* save repeat count */
-					if (dm_write(dm_item, *mission_index_ptr, DM_PERSIST_POWER_ON_RESET,
-						&mission_item_tmp, len) != len) {
+					/* save repeat count, before it is reported */
+					if (!_mission_cache.set_do_jump_current_count(dm_item, *mission_index_ptr,
+						mission_item_tmp.do_jump_current_count)) {
 						/* not supposed to happen unless the datamanager can't access the
 						 * dataman */
 						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR DO JUMP waypoint could not be written");
@@ -1143,6 +1152,9 @@ Mission::reset_offboard_mission(struct mission_s &mission)
 			if (mission.count > 0) {
 				dm_item_t dm_current = DM_KEY_WAYPOINTS_OFFBOARD(mission.dataman_id);
 
+				/* the cached items hold the old counters */
+				_mission_cache.invalidate(dm_current);
+
 				for (int index = 0; index < mission.count; index++) {
 					struct mission_item_s item;
 					const ssize_t len = sizeof(struct mission_item_s);
@@ -63,6 +63,7 @@
 #include "navigator_mode.h"
 #include "mission_block.h"
 #include "mission_feasibility_checker.h"
+#include "mission_cache.h"
 
 class Navigator;
 
@@ -177,7 +178,7 @@ private:
 
 	/**
 	 * Read current (offset == 0) or a specific (offset > 0) mission item
-	 * from the dataman and watch out for DO_JUMPS
+	 * from the mission cache and watch out for DO_JUMPS
 	 *
 	 * @return true if successful
 	 */
@@ -249,6 +250,8 @@ private:
 
 	MissionFeasibilityChecker _missionFeasibilityChecker; /**< class that checks if a mission is feasible */
 
+	MissionCache _mission_cache; /**< mission items around the current one */
+
 	float _min_current_sp_distance_xy; /**< minimum distance which was achieved to the current waypoint  */
 	float _mission_item_previous_alt; /**< holds the altitude of the previous mission item,
 					    can be replaced by a full copy of the previous mission item if needed */
@@ -303,6 +303,7 @@ MissionBlock::issue_command(const struct mission_item_s *item)
 		PX4_WARN("forwarding command %d\n", item->nav_cmd);
 		struct vehicle_command_s cmd = {};
 		mission_item_to_vehicle_command(item, &cmd);
+		cmd.timestamp = hrt_absolute_time();
 		_action_start = hrt_absolute_time();
 
 		if (_cmd_pub != nullptr) {
@@ -522,6 +523,7 @@ MissionBlock::set_land_item(struct mission_item_s *item, bool at_current_locatio
 	/* VTOL transition to RW before landing */
 	if(_navigator->get_vstatus()->is_vtol && !_navigator->get_vstatus()->is_rotary_wing){
 		struct vehicle_command_s cmd = {};
+		cmd.timestamp = hrt_absolute_time();
 		cmd.command = NAV_CMD_DO_VTOL_TRANSITION;
 		cmd.param1 = vehicle_status_s::VEHICLE_VTOL_STATE_MC;
 		if (_cmd_pub != nullptr) {
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_cache.cpp
+ * In-memory copy of the mission items navigator works on
+ */
+
+#include <string.h>
+
+#include <systemlib/err.h>
+
+#include "mission_cache.h"
+
+MissionCache::MissionCache() :
+	_misses(0),
+	_hits(0)
+{
+	for (unsigned i = 0; i < cache_size; i++) {
+		_entries[i].index = -1;
+	}
+}
+
+bool
+MissionCache::read(dm_item_t dm_item, int index, struct mission_item_s *mission_item)
+{
+	cache_entry_s &entry = _entries[index & (cache_size - 1)];
+
+	if (entry.index != index || entry.dm_item != dm_item) {
+		const ssize_t len = sizeof(struct mission_item_s);
+
+		/* read to the entry, and only keep it if the item is complete */
+		if (dm_read(dm_item, index, &entry.item, len) != len) {
+			entry.index = -1;
+			return false;
+		}
+
+		entry.dm_item = dm_item;
+		entry.index = index;
+		_misses++;
+
+	} else {
+		_hits++;
+	}
+
+	memcpy(mission_item, &entry.item, sizeof(struct mission_item_s));
+	return true;
+}
+
+bool
+MissionCache::set_do_jump_current_count(dm_item_t dm_item, int index, unsigned count)
+{
+	struct mission_item_s item;
+
+	if (!read(dm_item, index, &item) || item.nav_cmd != NAV_CMD_DO_JUMP) {
+		return false;
+	}
+
+	item.do_jump_current_count = count;
+
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_write(dm_item, index, DM_PERSIST_POWER_ON_RESET, &item, len) != len) {
+		/* the dataman may hold either counter now */
+		_entries[index & (cache_size - 1)].index = -1;
+		return false;
+	}
+
+	_entries[index & (cache_size - 1)].item.do_jump_current_count = count;
+	return true;
+}
+
+void
+MissionCache::invalidate(dm_item_t dm_item)
+{
+	for (unsigned i = 0; i < cache_size; i++) {
+		if (_entries[i].index >= 0 && _entries[i].dm_item == dm_item) {
+			_entries[i].index = -1;
+		}
+	}
+}
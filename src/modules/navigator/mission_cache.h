@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_cache.h
+ * In-memory copy of the mission items navigator works on
+ *
+ * Mission items live in the dataman, which on NuttX is a file on the SD
+ * card. The cache keeps the items around the current one, so following a
+ * mission does not read the same items again on every update. DO_JUMP
+ * counters are written through, a ground station reads them back from the
+ * dataman as soon as their change is reported.
+ */
+
+#ifndef NAVIGATOR_MISSION_CACHE_H
+#define NAVIGATOR_MISSION_CACHE_H
+
+#include <dataman/dataman.h>
+#include <navigator/navigation.h>
+
+class MissionCache
+{
+public:
+	MissionCache();
+	~MissionCache() {}
+
+	/**
+	 * Read a mission item, from the cache if it holds it.
+	 *
+	 * @return true if successful
+	 */
+	bool read(dm_item_t dm_item, int index, struct mission_item_s *mission_item);
+
+	/**
+	 * Set the counter of the DO_JUMP item at index, in the cache and in
+	 * the dataman.
+	 *
+	 * @return true if successful
+	 */
+	bool set_do_jump_current_count(dm_item_t dm_item, int index, unsigned count);
+
+	/**
+	 * Forget the items of a mission, which has changed in the dataman.
+	 */
+	void invalidate(dm_item_t dm_item);
+
+	/**
+	 * Number of items read from the dataman and from the cache
+	 */
+	unsigned get_misses() { return _misses; }
+	unsigned get_hits() { return _hits; }
+
+private:
+	/* a power of two, so the slot of an item is index & (cache_size - 1) */
+	static constexpr unsigned cache_size = 16;
+
+	struct cache_entry_s {
+		dm_item_t dm_item;
+		int index;			/**< item index, -1 if the entry is empty */
+		struct mission_item_s item;
+	};
+
+	cache_entry_s _entries[cache_size];
+
+	unsigned _misses;
+	unsigned _hits;
+};
+
+#endif
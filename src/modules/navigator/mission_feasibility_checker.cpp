@@ -49,6 +49,7 @@
 #include <fw_pos_control_l1/landingslope.h>
 #include <systemlib/err.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <uORB/topics/fence.h>
@@ -57,7 +58,10 @@ MissionFeasibilityChecker::MissionFeasibilityChecker() :
 	_mavlink_log_pub(nullptr),
 	_capabilities_sub(-1),
 	_initDone(false),
-	_dist_1wp_ok(false)
+	_dist_1wp_ok(false),
+	_summary_key{},
+	_summary{},
+	_summary_valid(false)
 {
 	_nav_caps = {0};
 }
@@ -76,323 +80,371 @@ bool MissionFeasibilityChecker::checkMissionFeasible(orb_advert_t *mavlink_log_p
 
 	_mavlink_log_pub = mavlink_log_pub;
 
+	if (!isRotarywing) {
+		/* Update fixed wing navigation capabilites */
+		updateNavigationCapabilities();
+	}
+
+	/* the key is compared as a whole, including the padding */
+	struct mission_key_s key;
+	memset(&key, 0, sizeof(key));
+	key.dm_current = dm_current;
+	key.nMissionItems = nMissionItems;
+	key.isRotarywing = isRotarywing;
+	key.home_valid = home_valid;
+	key.home_alt = home_alt;
+	key.default_acceptance_rad = default_acceptance_rad;
+	key.geofence_updates = geofence.getUpdateCount();
+
+	if (!isRotarywing) {
+		key.landing_horizontal_slope_displacement = _nav_caps.landing_horizontal_slope_displacement;
+		key.landing_slope_angle_rad = _nav_caps.landing_slope_angle_rad;
+		key.landing_flare_length = _nav_caps.landing_flare_length;
+	}
+
+	/* only read the mission if it or what it is checked against changed */
+	if (!_summary_valid || memcmp(&key, &_summary_key, sizeof(key)) != 0) {
+		_summary_valid = updateSummary(key, geofence);
+	}
+
+	if (_summary.read_failed_index >= 0) {
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
+		return false;
+	}
+
 	// first check if we have a valid position
 	if (!home_valid /* can later use global / local pos for finer granularity */) {
 		failed = true;
 		warned = true;
 		mavlink_log_info(_mavlink_log_pub, "Not yet ready for mission, no position lock.");
 	} else {
-		failed = failed || !check_dist_1wp(dm_current, nMissionItems, curr_lat, curr_lon, max_waypoint_distance, warning_issued);
+		failed = failed || !check_dist_1wp(curr_lat, curr_lon, max_waypoint_distance, warning_issued);
 	}
 
 	// check if all mission item commands are supported
-	failed = failed || !checkMissionItemValidity(dm_current, nMissionItems, condition_landed);
-	failed = failed || !checkGeofence(dm_current, nMissionItems, geofence);
-	failed = failed || !checkHomePositionAltitude(dm_current, nMissionItems, home_alt, home_valid, warned);
+	failed = failed || !checkMissionItemValidity(condition_landed);
+	failed = failed || !checkGeofence();
+	failed = failed || !checkHomePositionAltitude(warned);
 
 	if (isRotarywing) {
-		failed = failed || !checkMissionFeasibleRotarywing(dm_current, nMissionItems, geofence, home_alt, home_valid, default_acceptance_rad);
+		failed = failed || !checkMissionFeasibleRotarywing();
 	} else {
-		failed = failed || !checkMissionFeasibleFixedwing(dm_current, nMissionItems, geofence, home_alt, home_valid);
+		failed = failed || !checkMissionFeasibleFixedwing();
 	}
 
 	return !failed;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems,
-	Geofence &geofence, float home_alt, bool home_valid, float default_acceptance_rad)
+bool MissionFeasibilityChecker::updateSummary(const struct mission_key_s &key, Geofence &geofence)
 {
-	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
+	memcpy(&_summary_key, &key, sizeof(key));
+
+	_summary.read_failed_index = -1;
+	_summary.first_position_index = -1;
+	_summary.servo_index = -1;
+	_summary.starts_with_land = false;
+	_summary.unsupported_index = -1;
+	_summary.geofence_violation_index = -1;
+	_summary.home_alt_index = -1;
+	_summary.takeoff_too_low_index = -1;
+	_summary.landing = LANDING_NONE;
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
+	Geofence *fence = geofence.valid() ? &geofence : nullptr;
 
-		// look for a takeoff waypoint
-		if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
-			// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
-			// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
-			float takeoff_alt = missionitem.altitude_is_relative
-				      ? missionitem.altitude
-			              : missionitem.altitude - home_alt;
-			// check if we should use default acceptance radius
-			float acceptance_radius = default_acceptance_rad;
-
-			if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
-				acceptance_radius = missionitem.acceptance_radius;
-			}
+	/* the item and the one before it, alternating */
+	struct mission_item_s missionitems[2];
+	const ssize_t len = sizeof(struct mission_item_s);
 
-			if (takeoff_alt - 1.0f < acceptance_radius) {
-				mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff altitude too low!");
-				return false;
-			}
+	for (size_t i = 0; i < key.nMissionItems; i++) {
+		struct mission_item_s &missionitem = missionitems[i & 1];
+
+		if (dm_read(key.dm_current, i, &missionitem, len) != len) {
+			_summary.read_failed_index = i;
+			return false;
 		}
+
+		checkItem(key, fence, i, missionitem, missionitems[(i + 1) & 1]);
 	}
 
-	// all checks have passed
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid)
+void MissionFeasibilityChecker::checkItem(const struct mission_key_s &key, Geofence *geofence, size_t i,
+	const struct mission_item_s &missionitem, const struct mission_item_s &missionitem_previous)
 {
-	/* Update fixed wing navigation capabilites */
-	updateNavigationCapabilities();
+	bool position = isPositionCommand(missionitem.nav_cmd);
+
+	/* find first waypoint (with lat/lon), and check the actuator commands before it */
+	if (_summary.first_position_index < 0) {
+		if (missionitem.nav_cmd == NAV_CMD_DO_SET_SERVO) {
+			if (_summary.servo_index < 0) {
+				/* check actuator number */
+				if (missionitem.params[0] < 0 || missionitem.params[0] > 5) {
+					_summary.servo_index = i;
+					_summary.servo_number_invalid = true;
+					_summary.servo_param = missionitem.params[0];
+
+				/* check actuator value */
+				} else if (missionitem.params[1] < -2000 || missionitem.params[1] > 2000) {
+					_summary.servo_index = i;
+					_summary.servo_number_invalid = false;
+					_summary.servo_param = missionitem.params[1];
+				}
+			}
 
-	/* Perform checks and issue feedback to the user for all checks */
-	bool resLanding = checkFixedWingLanding(dm_current, nMissionItems);
+		} else if (position) {
+			_summary.first_position_index = i;
+			_summary.first_position_lat = missionitem.lat;
+			_summary.first_position_lon = missionitem.lon;
+		}
+	}
 
-	/* Mission is only marked as feasible if all checks return true */
-	return resLanding;
-}
+	// check if we find unsupported items
+	if (_summary.unsupported_index < 0 && !isSupportedCommand(missionitem.nav_cmd)) {
+		_summary.unsupported_index = i;
+		_summary.unsupported_cmd = missionitem.nav_cmd;
+	}
 
-bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence)
-{
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (geofence.valid()) {
-		for (size_t i = 0; i < nMissionItems; i++) {
-			struct mission_item_s missionitem;
-			const ssize_t len = sizeof(missionitem);
+	// check if the mission starts with a land command
+	if (i == 0) {
+		_summary.starts_with_land = (missionitem.nav_cmd == NAV_CMD_LAND);
+	}
 
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+	if (geofence != nullptr && _summary.geofence_violation_index < 0 &&
+		MissionBlock::item_contains_position(&missionitem) &&
+		!geofence->inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
 
-			if (MissionBlock::item_contains_position(&missionitem) &&
-				!geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+		_summary.geofence_violation_index = i;
+	}
 
-				mavlink_log_critical(_mavlink_log_pub, "Geofence violation for waypoint %d", i);
-				return false;
+	/* check if the waypoint is above the home altitude */
+	if (_summary.home_alt_index < 0 && position) {
+		/* relative alt without home set */
+		if (missionitem.altitude_is_relative && !key.home_valid) {
+			_summary.home_alt_index = i;
+			_summary.home_alt_relative = true;
+
+		} else {
+			/* calculate the global waypoint altitude */
+			float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + key.home_alt : missionitem.altitude;
+
+			if (key.home_alt > wp_alt) {
+				_summary.home_alt_index = i;
+				_summary.home_alt_relative = false;
 			}
 		}
 	}
 
-	return true;
+	// look for a takeoff waypoint
+	if (key.isRotarywing && _summary.takeoff_too_low_index < 0 && missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
+		// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
+		// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
+		float takeoff_alt = missionitem.altitude_is_relative
+			      ? missionitem.altitude
+		              : missionitem.altitude - key.home_alt;
+		// check if we should use default acceptance radius
+		float acceptance_radius = key.default_acceptance_rad;
+
+		if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
+			acceptance_radius = missionitem.acceptance_radius;
+		}
+
+		if (takeoff_alt - 1.0f < acceptance_radius) {
+			_summary.takeoff_too_low_index = i;
+		}
+	}
+
+	/* only the first landing waypoint is checked */
+	if (!key.isRotarywing && _summary.landing == LANDING_NONE && missionitem.nav_cmd == NAV_CMD_LAND) {
+		checkLanding(i, missionitem, missionitem_previous);
+	}
 }
 
-bool MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems,
-	float home_alt, bool home_valid, bool &warning_issued, bool throw_error)
+void MissionFeasibilityChecker::checkLanding(size_t i, const struct mission_item_s &missionitem,
+	const struct mission_item_s &missionitem_previous)
 {
-	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
+	/* the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
+	if (i == 0) {
+		_summary.landing = LANDING_FIRST;
+		return;
+	}
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			warning_issued = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
+	float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+	float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+	float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
 
-		/* reject relative alt without home set */
-		if (missionitem.altitude_is_relative && !home_valid && isPositionCommand(missionitem.nav_cmd)) {
+	if (wp_distance > _nav_caps.landing_flare_length) {
+		/* Last wp is before flare region */
 
-			warning_issued = true;
+		if (delta_altitude < 0) {
+			if (missionitem_previous.altitude <= slope_alt_req) {
+				/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
+				_summary.landing = LANDING_OK;
 
-			if (throw_error) {
-				mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: No home pos, WP %d uses rel alt", i+1);
-				return false;
-			} else	{
-				mavlink_log_critical(_mavlink_log_pub, "Warning: No home pos, WP %d uses rel alt", i+1);
-				return true;
+			} else {
+				/* Landing waypoint is above altitude of slope at the given waypoint distance */
+				_summary.landing = LANDING_TOO_HIGH;
+				_summary.landing_slope_alt_req = slope_alt_req;
+				_summary.landing_distance_missing = wp_distance_req - wp_distance;
 			}
+
+		} else {
+			/* Landing waypoint is above last waypoint */
+			_summary.landing = LANDING_ABOVE_LAST;
 		}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+	} else {
+		/* Last wp is in flare region */
+		_summary.landing = LANDING_IN_FLARE;
+	}
+}
 
-		if (home_alt > wp_alt && isPositionCommand(missionitem.nav_cmd)) {
+bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing()
+{
+	if (_summary.takeoff_too_low_index >= 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff altitude too low!");
+		return false;
+	}
 
-			warning_issued = true;
+	// all checks have passed
+	return true;
+}
 
-			if (throw_error) {
-				mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: Waypoint %d below home", i+1);
-				return false;
-			} else	{
-				mavlink_log_critical(_mavlink_log_pub, "Warning: Waypoint %d below home", i+1);
-				return true;
-			}
-		}
+bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing()
+{
+	/* Perform checks and issue feedback to the user for all checks */
+	bool resLanding = checkFixedWingLanding();
+
+	/* Mission is only marked as feasible if all checks return true */
+	return resLanding;
+}
+
+bool MissionFeasibilityChecker::checkGeofence()
+{
+	if (_summary.geofence_violation_index >= 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Geofence violation for waypoint %d", _summary.geofence_violation_index);
+		return false;
 	}
 
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed) {
-	// do not allow mission if we find unsupported item
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
+bool MissionFeasibilityChecker::checkHomePositionAltitude(bool &warning_issued, bool throw_error)
+{
+	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
+	if (_summary.home_alt_index < 0) {
+		return true;
+	}
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			// not supposed to happen unless the datamanager can't access the SD card, etc.
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
-			return false;
-		}
+	warning_issued = true;
 
-		// check if we find unsupported items and reject mission if so
-		if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-			missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
-			missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
-			/* not yet supported: missionitem.nav_cmd != NAV_CMD_LOITER_TURN_COUNT && */
-			missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
-			missionitem.nav_cmd != NAV_CMD_LAND &&
-			missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
-			missionitem.nav_cmd != NAV_CMD_VTOL_LAND &&
-			missionitem.nav_cmd != NAV_CMD_VTOL_TAKEOFF &&
-			missionitem.nav_cmd != NAV_CMD_PATHPLANNING &&
-			missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-			missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
-			missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
-			missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
-			missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
-			missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
-
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission item %i: unsupported cmd: %d", (int)(i+1), (int)missionitem.nav_cmd);
+	/* reject relative alt without home set */
+	if (_summary.home_alt_relative) {
+		if (throw_error) {
+			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: No home pos, WP %d uses rel alt", _summary.home_alt_index + 1);
 			return false;
+		} else	{
+			mavlink_log_critical(_mavlink_log_pub, "Warning: No home pos, WP %d uses rel alt", _summary.home_alt_index + 1);
+			return true;
 		}
+	}
 
-		// check if the mission starts with a land command while the vehicle is landed
-		if (missionitem.nav_cmd == NAV_CMD_LAND &&
-			i == 0 &&
-			condition_landed) {
-
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission that starts with LAND command while vehicle is landed.");
-			return false;
-		}
+	if (throw_error) {
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: Waypoint %d below home", _summary.home_alt_index + 1);
+		return false;
+	} else	{
+		mavlink_log_critical(_mavlink_log_pub, "Warning: Waypoint %d below home", _summary.home_alt_index + 1);
+		return true;
+	}
+}
 
+bool MissionFeasibilityChecker::checkMissionItemValidity(bool condition_landed) {
+	// check if the mission starts with a land command while the vehicle is landed
+	if (_summary.starts_with_land && condition_landed) {
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting mission that starts with LAND command while vehicle is landed.");
+		return false;
+	}
 
+	// do not allow mission if we find unsupported item
+	if (_summary.unsupported_index >= 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting mission item %i: unsupported cmd: %d", _summary.unsupported_index + 1, (int)_summary.unsupported_cmd);
+		return false;
 	}
+
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems)
+bool MissionFeasibilityChecker::checkFixedWingLanding()
 {
-	/* Go through all mission items and search for a landing waypoint
-	 * if landing waypoint is found: the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
+	switch (_summary.landing) {
+	case LANDING_TOO_HIGH:
+		mavlink_log_critical(_mavlink_log_pub, "Landing: last waypoint too high/too close");
+		mavlink_log_critical(_mavlink_log_pub, "Move down to %.1fm or move further away by %.1fm",
+				(double)(_summary.landing_slope_alt_req),
+				(double)(_summary.landing_distance_missing));
+		return false;
 
+	case LANDING_ABOVE_LAST:
+		mavlink_log_critical(_mavlink_log_pub, "Landing waypoint above last nav waypoint");
+		return false;
 
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	case LANDING_IN_FLARE:
+		//xxx give recommendations
+		mavlink_log_critical(_mavlink_log_pub, "Warning: Landing: last waypoint in flare region");
+		return false;
 
-		if (missionitem.nav_cmd == NAV_CMD_LAND) {
-			struct mission_item_s missionitem_previous;
-			if (i != 0) {
-				if (dm_read(dm_current, i-1, &missionitem_previous, len) != len) {
-					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-					return false;
-				}
+	case LANDING_FIRST:
+		mavlink_log_critical(_mavlink_log_pub, "Warning: starting with land waypoint");
+		return false;
 
-				float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
-				float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
-//				warnx("wp_distance %.2f, delta_altitude %.2f, missionitem_previous.altitude %.2f, missionitem.altitude %.2f, slope_alt_req %.2f, wp_distance_req %.2f",
-//						wp_distance, delta_altitude, missionitem_previous.altitude, missionitem.altitude, slope_alt_req, wp_distance_req);
-//				warnx("_nav_caps.landing_horizontal_slope_displacement %.4f, _nav_caps.landing_slope_angle_rad %.4f, _nav_caps.landing_flare_length %.4f",
-//						_nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad, _nav_caps.landing_flare_length);
-
-				if (wp_distance > _nav_caps.landing_flare_length) {
-					/* Last wp is before flare region */
-
-					if (delta_altitude < 0) {
-						if (missionitem_previous.altitude <= slope_alt_req) {
-							/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
-							return true;
-						} else {
-							/* Landing waypoint is above altitude of slope at the given waypoint distance */
-							mavlink_log_critical(_mavlink_log_pub, "Landing: last waypoint too high/too close");
-							mavlink_log_critical(_mavlink_log_pub, "Move down to %.1fm or move further away by %.1fm",
-									(double)(slope_alt_req),
-									(double)(wp_distance_req - wp_distance));
-							return false;
-						}
-					} else {
-						/* Landing waypoint is above last waypoint */
-						mavlink_log_critical(_mavlink_log_pub, "Landing waypoint above last nav waypoint");
-						return false;
-					}
-				} else {
-					/* Last wp is in flare region */
-					//xxx give recommendations
-					mavlink_log_critical(_mavlink_log_pub, "Warning: Landing: last waypoint in flare region");
-					return false;
-				}
-			} else {
-				mavlink_log_critical(_mavlink_log_pub, "Warning: starting with land waypoint");
-				return false;
-			}
-		}
+	case LANDING_OK:
+	case LANDING_NONE:
+	default:
+		/* No landing waypoints or no waypoints */
+		return true;
 	}
-
-	/* No landing waypoints or no waypoints */
-	return true;
 }
 
 bool
-MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued)
+MissionFeasibilityChecker::check_dist_1wp(double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued)
 {
 
 	/* check if first waypoint is not too far from home */
 	if (dist_first_wp > 0.0f) {
-		struct mission_item_s mission_item;
-
-		/* find first waypoint (with lat/lon) item in datamanager */
-		for (unsigned i = 0; i < nMissionItems; i++) {
-			if (dm_read(dm_current, i,
-					&mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s)) {
-				/* Check non navigation item */
-				if (mission_item.nav_cmd == NAV_CMD_DO_SET_SERVO){
-
-					/* check actuator number */
-					if (mission_item.params[0] < 0 || mission_item.params[0] > 5) {
-						mavlink_log_critical(_mavlink_log_pub, "Actuator number %d is out of bounds 0..5", (int)mission_item.params[0]);
-						warning_issued = true;
-						return false;
-					}
-					/* check actuator value */
-					if (mission_item.params[1] < -2000 || mission_item.params[1] > 2000) {
-						mavlink_log_critical(_mavlink_log_pub, "Actuator value %d is out of bounds -2000..2000", (int)mission_item.params[1]);
-						warning_issued = true;
-						return false;
-					}
-				}
-				/* check only items with valid lat/lon */
-				else if (isPositionCommand(mission_item.nav_cmd)) {
-
-					/* check distance from current position to item */
-					float dist_to_1wp = get_distance_to_next_waypoint(
-							mission_item.lat, mission_item.lon, curr_lat, curr_lon);
-
-					if (dist_to_1wp < dist_first_wp) {
-						_dist_1wp_ok = true;
-						if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
-							/* allow at 2/3 distance, but warn */
-							mavlink_log_critical(_mavlink_log_pub, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
-							warning_issued = true;
-						}
-						return true;
-
-					} else {
-						/* item is too far from home */
-						mavlink_log_critical(_mavlink_log_pub, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
-						warning_issued = true;
-						return false;
-					}
+		/* Check non navigation items before the first waypoint */
+		if (_summary.servo_index >= 0) {
+			if (_summary.servo_number_invalid) {
+				mavlink_log_critical(_mavlink_log_pub, "Actuator number %d is out of bounds 0..5", (int)_summary.servo_param);
+			} else {
+				mavlink_log_critical(_mavlink_log_pub, "Actuator value %d is out of bounds -2000..2000", (int)_summary.servo_param);
+			}
+			warning_issued = true;
+			return false;
+		}
+
+		/* check only items with valid lat/lon */
+		if (_summary.first_position_index >= 0) {
+
+			/* check distance from current position to item */
+			float dist_to_1wp = get_distance_to_next_waypoint(
+					_summary.first_position_lat, _summary.first_position_lon, curr_lat, curr_lon);
+
+			if (dist_to_1wp < dist_first_wp) {
+				_dist_1wp_ok = true;
+				if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
+					/* allow at 2/3 distance, but warn */
+					mavlink_log_critical(_mavlink_log_pub, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
+					warning_issued = true;
 				}
+				return true;
 
 			} else {
-				/* error reading, mission is invalid */
-				mavlink_log_info(_mavlink_log_pub, "error reading offboard mission");
+				/* item is too far from home */
+				mavlink_log_critical(_mavlink_log_pub, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
+				warning_issued = true;
 				return false;
 			}
 		}
@@ -406,6 +458,27 @@ MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionI
 	}
 }
 
+bool
+MissionFeasibilityChecker::isSupportedCommand(unsigned cmd)
+{
+	return cmd == NAV_CMD_IDLE ||
+		cmd == NAV_CMD_WAYPOINT ||
+		cmd == NAV_CMD_LOITER_UNLIMITED ||
+		/* not yet supported: cmd == NAV_CMD_LOITER_TURN_COUNT || */
+		cmd == NAV_CMD_LOITER_TIME_LIMIT ||
+		cmd == NAV_CMD_LAND ||
+		cmd == NAV_CMD_TAKEOFF ||
+		cmd == NAV_CMD_VTOL_LAND ||
+		cmd == NAV_CMD_VTOL_TAKEOFF ||
+		cmd == NAV_CMD_PATHPLANNING ||
+		cmd == NAV_CMD_DO_JUMP ||
+		cmd == NAV_CMD_DO_SET_SERVO ||
+		cmd == NAV_CMD_DO_CHANGE_SPEED ||
+		cmd == NAV_CMD_DO_DIGICAM_CONTROL ||
+		cmd == NAV_CMD_DO_SET_CAM_TRIGG_DIST ||
+		cmd == NAV_CMD_DO_VTOL_TRANSITION;
+}
+
 bool
 MissionFeasibilityChecker::isPositionCommand(unsigned cmd){
 	if( cmd == NAV_CMD_WAYPOINT ||
@@ -46,6 +46,7 @@
 #include <uORB/topics/mission.h>
 #include <uORB/topics/navigation_capabilities.h>
 #include <dataman/dataman.h>
+#include <navigator/navigation.h>
 #include "geofence.h"
 
 
@@ -61,20 +62,82 @@ private:
 	bool _dist_1wp_ok;
 	void init();
 
+	/* Everything the mission checks depend on except the current position */
+	struct mission_key_s {
+		dm_item_t dm_current;
+		size_t nMissionItems;
+		bool isRotarywing;
+		bool home_valid;
+		float home_alt;
+		float default_acceptance_rad;
+		unsigned geofence_updates;
+		float landing_horizontal_slope_displacement;
+		float landing_slope_angle_rad;
+		float landing_flare_length;
+	};
+
+	enum landing_result {
+		LANDING_NONE,			/**< no landing waypoint */
+		LANDING_OK,
+		LANDING_TOO_HIGH,		/**< last waypoint above the landing slope */
+		LANDING_ABOVE_LAST,		/**< landing waypoint above the last waypoint */
+		LANDING_IN_FLARE,		/**< last waypoint in the flare region */
+		LANDING_FIRST			/**< mission starts with the landing waypoint */
+	};
+
+	/* What the checks need to know about the mission, found in one pass over the items.
+	 * Indices are -1 if there is no such item. */
+	struct mission_summary_s {
+		int read_failed_index;		/**< item that could not be read from the dataman */
+
+		int first_position_index;	/**< first item with a position, and its position */
+		double first_position_lat;
+		double first_position_lon;
+		int servo_index;		/**< DO_SET_SERVO out of bounds before the first position */
+		bool servo_number_invalid;	/**< the actuator number is out of bounds, otherwise the value */
+		float servo_param;
+
+		bool starts_with_land;
+		int unsupported_index;		/**< first item with an unsupported command, and the command */
+		unsigned unsupported_cmd;
+
+		int geofence_violation_index;	/**< first position outside the geofence */
+
+		int home_alt_index;		/**< first position which is relative without home, or below home */
+		bool home_alt_relative;		/**< true if the item is relative without home */
+
+		int takeoff_too_low_index;	/**< first takeoff below the acceptance radius (rotary wing) */
+
+		enum landing_result landing;	/**< first landing waypoint (fixed wing), and the correction */
+		float landing_slope_alt_req;
+		float landing_distance_missing;
+	};
+
+	struct mission_key_s _summary_key;
+	struct mission_summary_s _summary;
+	bool _summary_valid;
+
+	/* Read the mission once and run all per-item checks on it */
+	bool updateSummary(const struct mission_key_s &key, Geofence &geofence);
+	void checkItem(const struct mission_key_s &key, Geofence *geofence, size_t index,
+		       const struct mission_item_s &missionitem, const struct mission_item_s &missionitem_previous);
+	void checkLanding(size_t index, const struct mission_item_s &missionitem, const struct mission_item_s &missionitem_previous);
+
 	/* Checks for all airframes */
-	bool checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence);
-	bool checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool home_valid, bool &warning_issued, bool throw_error = false);
-	bool checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed);
-	bool check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued);
+	bool checkGeofence();
+	bool checkHomePositionAltitude(bool &warning_issued, bool throw_error = false);
+	bool checkMissionItemValidity(bool condition_landed);
+	bool check_dist_1wp(double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued);
 	bool isPositionCommand(unsigned cmd);
+	bool isSupportedCommand(unsigned cmd);
 
 	/* Checks specific to fixedwing airframes */
-	bool checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid);
-	bool checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems);
+	bool checkMissionFeasibleFixedwing();
+	bool checkFixedWingLanding();
 	void updateNavigationCapabilities();
 
 	/* Checks specific to rotarywing airframes */
-	bool checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid, float default_acceptance_rad);
+	bool checkMissionFeasibleRotarywing();
 public:
 
 	MissionFeasibilityChecker();
@@ -82,12 +145,21 @@ public:
 
 	/*
 	 * Returns true if mission is feasible and false otherwise
+	 *
+	 * The mission is read from the dataman only if it or the vehicle state it is
+	 * checked against changed since the last call, or invalidate() was called.
 	 */
 	bool checkMissionFeasible(orb_advert_t *mavlink_log_pub, bool isRotarywing, dm_item_t dm_current,
 		size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid,
 		double curr_lat, double curr_lon, float max_waypoint_distance, bool &warning_issued, float default_acceptance_rad,
 		bool condition_landed);
 
+	/*
+	 * Read the mission again on the next check. The storage and the item count
+	 * do not tell whether the items were rewritten in place.
+	 */
+	void invalidate() { _summary_valid = false; }
+
 };
 
 
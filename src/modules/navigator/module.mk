@@ -47,6 +47,7 @@ SRCS		= navigator_main.cpp \
 		  rtl.cpp \
 		  rtl_params.c \
 		  mission_feasibility_checker.cpp \
+		  mission_cache.cpp \
 		  geofence.cpp \
 		  geofence_params.c \
 		  datalinkloss.cpp \
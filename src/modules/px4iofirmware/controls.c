@@ -44,11 +44,9 @@
 #include <drivers/drv_rc_input.h>
 #include <systemlib/perf_counter.h>
 #include <systemlib/ppm_decode.h>
-#include <rc/st24.h>
-#include <rc/sumd.h>
 #include <rc/sbus.h>
 #include <rc/dsm.h>
-#include <rc/srxl.h>
+#include <rc/rc_decode.h>
 
 #include "px4io.h"
 
@@ -110,78 +108,44 @@ bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool
 
 	perf_end(c_gather_dsm);
 
-	/* get data from FD and attempt to parse with DSM and ST24 libs */
-	uint8_t st24_rssi, rx_count;
-	uint16_t st24_channel_count = 0;
+	/* run the other protocols sharing the port over the same bytes */
+	struct rc_decode_s rc_decoded;
+	unsigned decoded = rc_decode(hrt_absolute_time(), bytes, n_bytes,
+				     RC_DECODERS_115200 & ~RC_DECODER_MASK(RC_DECODER_DSM),
+				     r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS, &rc_decoded);
 
-	*st24_updated = false;
-
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		st24_rssi = RC_INPUT_RSSI_MAX;
-		*st24_updated |= (OK == st24_decode(bytes[i], &st24_rssi, &rx_count,
-						    &st24_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
-	}
+	*st24_updated = (decoded & RC_DECODER_MASK(RC_DECODER_ST24)) != 0;
+	*sumd_updated = (decoded & RC_DECODER_MASK(RC_DECODER_SUMD)) != 0;
+	*srxl_updated = (decoded & RC_DECODER_MASK(RC_DECODER_SRXL)) != 0;
 
 	if (*st24_updated) {
-
 		/* ensure ADC RSSI is disabled */
 		r_setup_features &= ~(PX4IO_P_SETUP_FEATURES_ADC_RSSI);
 
-		*rssi = st24_rssi;
-		r_raw_rc_count = st24_channel_count;
-
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_ST24;
-		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
-		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
-	}
-
-
-	/* get data from FD and attempt to parse with SUMD libs */
-	uint8_t sumd_rssi, sumd_rx_count;
-	uint16_t sumd_channel_count = 0;
-
-	*sumd_updated = false;
-
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		sumd_rssi = RC_INPUT_RSSI_MAX;
-		*sumd_updated |= (OK == sumd_decode(bytes[i], &sumd_rssi, &sumd_rx_count,
-						    &sumd_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
 	}
 
 	if (*sumd_updated) {
-
-		/* not setting RSSI since SUMD does not provide one */
-		r_raw_rc_count = sumd_channel_count;
-
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_SUMD;
-		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
-		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
 	}
 
-	/* attempt to parse with SRXL lib */
-	uint8_t srxl_channel_count = 0;
-	hrt_abstime now = hrt_absolute_time();
-        bool failsafe_state;
-
-	*srxl_updated = false;
-
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		*srxl_updated |= (OK == srxl_decode(now, bytes[i],
-						    &srxl_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS, &failsafe_state));
+	if (*srxl_updated) {
+		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_SRXL;
 	}
 
-	if (*srxl_updated) {
+	if (decoded != 0) {
+		/* only ST24 provides a real RSSI */
+		if (rc_decoded.decoder == RC_DECODER_ST24) {
+			*rssi = rc_decoded.rssi;
+		}
 
-		/* not setting RSSI since SRXL does not provide one */
-		r_raw_rc_count = srxl_channel_count;
+		r_raw_rc_count = rc_decoded.num_values;
 
-		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_SRXL;
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
-		if (failsafe_state) {
+
+		if (rc_decoded.failsafe) {
 			r_raw_rc_flags |= PX4IO_P_RAW_RC_FLAGS_FAILSAFE;
+
 		} else {
 			r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
 		}
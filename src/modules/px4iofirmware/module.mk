@@ -15,7 +15,11 @@ SRCS		= adc.c \
 		  ../systemlib/pwm_limit/pwm_limit.c \
 		  ../../lib/rc/st24.c \
 		  ../../lib/rc/sumd.c \
-		  ../../lib/rc/srxl.c
+		  ../../lib/rc/srxl.c \
+		  ../../lib/rc/rc_decode.c
+
+# the compiled mixer does not fit into the IO flash
+EXTRACXXFLAGS	= -DMIXER_NO_COMPILE
 
 ifeq ($(BOARD),px4io-v1)
 SRCS		+= i2c.c
@@ -382,6 +382,8 @@ int sdlog2_main(int argc, char *argv[])
 
 	if (!strcmp(argv[1], "on")) {
 		struct vehicle_command_s cmd;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.timestamp = hrt_absolute_time();
 		cmd.command = VEHICLE_CMD_PREFLIGHT_STORAGE;
 		cmd.param1 = -1;
 		cmd.param2 = -1;
@@ -392,6 +394,8 @@ int sdlog2_main(int argc, char *argv[])
 
 	if (!strcmp(argv[1], "off")) {
 		struct vehicle_command_s cmd;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.timestamp = hrt_absolute_time();
 		cmd.command = VEHICLE_CMD_PREFLIGHT_STORAGE;
 		cmd.param1 = -1;
 		cmd.param2 = -1;
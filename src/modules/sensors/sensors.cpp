@@ -83,11 +83,13 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <conversion/rotation.h>
 
 #include <systemlib/airspeed.h>
 
 #include <lib/ecl/validation/data_validator.h>
+#include <lib/ecl/validation/data_validator_group.h>
 
 #include <uORB/uORB.h>
 #include <uORB/topics/sensor_combined.h>
@@ -139,8 +141,15 @@ using namespace DriverFramework;
 #define STICK_ON_OFF_LIMIT		0.75f
 #define MAG_ROT_VAL_INTERNAL		-1
 
+/*
+ * Number of instances per sensor class, bounded by the sensor_combined
+ * topic. All of them are subscribed and voted on at the same time.
+ */
 #define SENSOR_COUNT_MAX		3
 
+/* time after which a gyro that stopped publishing is failed over, in us */
+#define GYRO_VOTER_TIMEOUT		8000
+
 /* oddly, ERROR is not defined for c++ */
 #ifdef ERROR
 # undef ERROR
@@ -176,6 +185,11 @@ public:
 	 */
 	int		start();
 
+	/**
+	 * Print the state of the sensor voting.
+	 */
+	void		print_status();
+
 private:
 	static const unsigned _rc_max_chan_count =
 		input_rc_s::RC_INPUT_MAX_CHANNELS;	/**< maximum number of r/c channels we handle */
@@ -224,6 +238,9 @@ private:
 	unsigned	_mag_count;			/**< raw mag data count */
 	unsigned	_baro_count;			/**< raw baro data count */
 
+	DataValidatorGroup _gyro_voter;			/**< votes the primary gyro among all instances */
+	int		_gyro_primary;			/**< index of the gyro pacing the output */
+
 	int 		_rc_sub;			/**< raw rc channels data subscription */
 	int		_diff_pres_sub;			/**< raw differential pressure subscription */
 	int		_vcontrol_mode_sub;		/**< vehicle control mode subscription */
@@ -418,8 +435,9 @@ private:
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @return			bitmask of the instances that were updated
 	 */
-	void		gyro_poll(struct sensor_combined_s &raw);
+	unsigned	gyro_poll(struct sensor_combined_s &raw);
 
 	/**
 	 * Poll the magnetometer for updated data.
@@ -526,14 +544,16 @@ Sensors::Sensors() :
 	_armed(false),
 
 	/* subscriptions */
-	_gyro_sub{ -1, -1, -1},
-	_accel_sub{ -1, -1, -1},
-	_mag_sub{ -1, -1, -1},
-	_baro_sub{ -1, -1, -1},
+	_gyro_sub{},
+	_accel_sub{},
+	_mag_sub{},
+	_baro_sub{},
 	_gyro_count(0),
 	_accel_count(0),
 	_mag_count(0),
 	_baro_count(0),
+	_gyro_voter(SENSOR_COUNT_MAX),
+	_gyro_primary(0),
 	_rc_sub(-1),
 	_vcontrol_mode_sub(-1),
 	_params_sub(-1),
@@ -568,6 +588,8 @@ Sensors::Sensors() :
 		_baro_sub[i] = -1;
 	}
 
+	_gyro_voter.set_timeout(GYRO_VOTER_TIMEOUT);
+
 	memset(&_rc, 0, sizeof(_rc));
 	memset(&_diff_pres, 0, sizeof(_diff_pres));
 	memset(&_parameters, 0, sizeof(_parameters));
@@ -1032,9 +1054,11 @@ Sensors::accel_poll(struct sensor_combined_s &raw)
 	}
 }
 
-void
+unsigned
 Sensors::gyro_poll(struct sensor_combined_s &raw)
 {
+	unsigned updated = 0;
+
 	for (unsigned i = 0; i < _gyro_count; i++) {
 		bool gyro_updated;
 		orb_check(_gyro_sub[i], &gyro_updated);
@@ -1065,15 +1089,15 @@ Sensors::gyro_poll(struct sensor_combined_s &raw)
 			raw.gyro_raw[i * 3 + 2] = gyro_report.z_raw;
 
 			raw.gyro_timestamp[i] = gyro_report.timestamp;
-
-			if (i == 0) {
-				raw.timestamp = gyro_report.timestamp;
-			}
-
 			raw.gyro_errcount[i] = gyro_report.error_count;
 			raw.gyro_temp[i] = gyro_report.temperature;
+
+			_gyro_voter.put(i, gyro_report.timestamp, &raw.gyro_rad_s[i * 3], gyro_report.error_count, raw.gyro_priority[i]);
+			updated |= 1 << i;
 		}
 	}
+
+	return updated;
 }
 
 void
@@ -2177,12 +2201,10 @@ Sensors::task_main()
 	/* advertise the sensor_combined topic and make the initial publication */
 	_sensor_pub = orb_advertise(ORB_ID(sensor_combined), &raw);
 
-	/* wakeup source(s) */
+	/* wakeup source: the primary gyro, the voter timeout catches a primary that stops */
 	px4_pollfd_struct_t fds[1] = {};
 
-	/* use the gyro to pace output */
-	fds[0].fd = _gyro_sub[0];
-	fds[0].events = POLLIN;
+	unsigned gyro_failover_count = _gyro_voter.failover_count();
 
 	_task_should_exit = false;
 
@@ -2192,22 +2214,27 @@ Sensors::task_main()
 
 	while (!_task_should_exit) {
 
-		/* wait for up to 50ms for data */
-		int pret = px4_poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 50);
-
-		/* if pret == 0 it timed out - periodic check for _task_should_exit, etc. */
+		/* no gyro available yet, attempt to subscribe once again */
+		if (_gyro_count == 0) {
+			_gyro_count = init_sensor_class(ORB_ID(sensor_gyro), &_gyro_sub[0],
+							&raw.gyro_priority[0], &raw.gyro_errcount[0]);
 
-		/* this is undesirable but not much we can do - might want to flag unhappy status */
-		if (pret < 0) {
-			/* if the polling operation failed because no gyro sensor is available yet,
-			 * then attempt to subscribe once again
-			 */
 			if (_gyro_count == 0) {
-				_gyro_count = init_sensor_class(ORB_ID(sensor_gyro), &_gyro_sub[0],
-								&raw.gyro_priority[0], &raw.gyro_errcount[0]);
-				fds[0].fd = _gyro_sub[0];
+				usleep(50000);
+				continue;
 			}
+		}
+
+		fds[0].fd = _gyro_sub[_gyro_primary];
+		fds[0].events = POLLIN;
+
+		/* wait for data from the primary gyro, for no longer than the voter needs to time it out */
+		int pret = px4_poll(&fds[0], 1, GYRO_VOTER_TIMEOUT / 1000);
+
+		/* if pret == 0 it timed out - vote again, periodic check for _task_should_exit, etc. */
 
+		/* this is undesirable but not much we can do - might want to flag unhappy status */
+		if (pret < 0) {
 			continue;
 		}
 
@@ -2216,38 +2243,48 @@ Sensors::task_main()
 		/* check vehicle status for changes to publication state */
 		vehicle_control_mode_poll();
 
-		/* the timestamp of the raw struct is updated by the gyro_poll() method */
-		/* copy most recent sensor data */
-		gyro_poll(raw);
-		accel_poll(raw);
-		mag_poll(raw);
-		baro_poll(raw);
-
-		// FIXME TODO: this needs more thinking, otherwise we spam the console and keep switching.
-		/* Work out if main gyro timed out and fail over to alternate gyro.
-		 * However, don't do this if the secondary is not available. */
-		if (hrt_elapsed_time(&raw.gyro_timestamp[0]) > 20 * 1000 && _gyro_sub[1] >= 0) {
-			warnx("gyro has timed out");
-
-			/* If the secondary failed as well, go to the tertiary, also only if available. */
-			if (hrt_elapsed_time(&raw.gyro_timestamp[1]) > 20 * 1000 && _gyro_sub[2] >= 0) {
-				fds[0].fd = _gyro_sub[2];
-				warnx("failing over to third gyro");
-
-			} else if (_gyro_sub[1] >= 0) {
-				fds[0].fd = _gyro_sub[1];
-				warnx("failing over to second gyro");
+		/* copy most recent gyro data, the other instances are fed to the voter as well */
+		unsigned gyro_updated = gyro_poll(raw);
+
+		/*
+		 * Vote on every wakeup. All gyros are already subscribed, so a primary
+		 * that times out or degrades is replaced right away.
+		 */
+		int best_gyro = -1;
+		_gyro_voter.get_best(hrt_absolute_time(), &best_gyro);
+
+		if (best_gyro >= 0 && best_gyro != _gyro_primary) {
+			/* a switch to a higher priority instance is not a failover */
+			if (_gyro_voter.failover_count() != gyro_failover_count) {
+				warnx("gyro #%i failed, switching to gyro #%i", _gyro_primary, best_gyro);
 			}
+
+			_gyro_primary = best_gyro;
 		}
 
-		/* check battery voltage */
-		adc_poll(raw);
+		gyro_failover_count = _gyro_voter.failover_count();
+
+		/* the timestamp of the raw struct is the one of the primary gyro */
+		bool primary_updated = gyro_updated & (1 << _gyro_primary);
+
+		if (primary_updated) {
+			raw.timestamp = raw.gyro_timestamp[_gyro_primary];
+
+			/* copy the other sensors only for an output */
+			accel_poll(raw);
+			mag_poll(raw);
+			baro_poll(raw);
+
+			/* check battery voltage */
+			adc_poll(raw);
 
-		diff_pres_poll(raw);
+			diff_pres_poll(raw);
 
-		/* Inform other processes that new data is available to copy */
-		if (_publishing && raw.timestamp > 0) {
-			orb_publish(ORB_ID(sensor_combined), _sensor_pub, &raw);
+			/* Inform other processes that new data is available to copy */
+			if (_publishing) {
+				orb_publish(ORB_ID(sensor_combined), _sensor_pub, &raw);
+				latency_trace_record(LATENCY_STAGE_SENSORS, raw.timestamp);
+			}
 		}
 
 		/* keep adding sensors as long as we are not armed,
@@ -2288,6 +2325,13 @@ Sensors::task_main()
 	px4_task_exit(ret);
 }
 
+void
+Sensors::print_status()
+{
+	warnx("gyros: %u, primary: #%i", _gyro_count, _gyro_primary);
+	_gyro_voter.print();
+}
+
 int
 Sensors::start()
 {
@@ -2358,6 +2402,7 @@ int sensors_main(int argc, char *argv[])
 	if (!strcmp(argv[1], "status")) {
 		if (sensors::g_sensors) {
 			warnx("is running");
+			sensors::g_sensors->print_status();
 			return 0;
 
 		} else {
@@ -61,11 +61,112 @@ Simulator *Simulator::getInstance()
 	return _instance;
 }
 
+MPUFIFO::MPUFIFO() :
+	_interval(0),
+	_next_sample(0),
+	_latest{},
+	_buf{},
+	_head(0),
+	_count(0),
+	_overflow(false)
+{
+	px4_sem_init(&_lock, 0, 1);
+}
+
+MPUFIFO::~MPUFIFO()
+{
+	px4_sem_destroy(&_lock);
+}
+
+void MPUFIFO::configure(unsigned sample_interval_us)
+{
+	px4_sem_wait(&_lock);
+	_interval = sample_interval_us;
+	_next_sample = 0;
+	_head = 0;
+	_count = 0;
+	_overflow = false;
+	px4_sem_post(&_lock);
+}
+
+void MPUFIFO::clock_in(uint64_t now)
+{
+	if (_interval == 0) {
+		return;
+	}
+
+	if (_next_sample == 0) {
+		// first sample after reset
+		_next_sample = now;
+
+	} else if (_next_sample + (uint64_t)SIZE * _interval <= now) {
+		// everything in the FIFO has been overwritten since the last read
+		_head = 0;
+		_count = 0;
+		_overflow = true;
+		_next_sample = now - (uint64_t)(SIZE - 1) * _interval;
+	}
+
+	while (_next_sample <= now) {
+		if (_count == SIZE) {
+			_head = (_head + 1) % SIZE;
+			_count--;
+			_overflow = true;
+		}
+
+		_buf[(_head + _count) % SIZE] = _latest;
+		_count++;
+		_next_sample += _interval;
+	}
+}
+
+void MPUFIFO::write(const RawMPUData &data, uint64_t now)
+{
+	px4_sem_wait(&_lock);
+	// samples taken until now still see the previous value
+	clock_in(now);
+	_latest = data;
+	px4_sem_post(&_lock);
+}
+
+unsigned MPUFIFO::read(RawMPUData *buf, unsigned max_samples, uint64_t now, uint64_t *newest, bool *overflow)
+{
+	px4_sem_wait(&_lock);
+	clock_in(now);
+
+	unsigned n = (_count < max_samples) ? _count : max_samples;
+
+	for (unsigned i = 0; i < n; i++) {
+		buf[i] = _buf[(_head + i) % SIZE];
+	}
+
+	// time of the last sample handed out, counted back from the next one due
+	*newest = _next_sample - (uint64_t)(_count - n + 1) * _interval;
+	*overflow = _overflow;
+
+	_head = (_head + n) % SIZE;
+	_count -= n;
+	_overflow = false;
+	px4_sem_post(&_lock);
+
+	return n;
+}
+
 bool Simulator::getMPUReport(uint8_t *buf, int len)
 {
 	return _mpu.copyData(buf, len);
 }
 
+unsigned Simulator::readMPUFIFO(RawMPUData *buf, unsigned max_samples, uint64_t *newest, bool *overflow)
+{
+	return _mpu_fifo.read(buf, max_samples, hrt_absolute_time(), newest, overflow);
+}
+
+void Simulator::configureMPUFIFO(unsigned sample_interval_us)
+{
+	_mpu_fifo.configure(sample_interval_us);
+}
+
 bool Simulator::getRawAccelReport(uint8_t *buf, int len)
 {
 	return _accel.copyData(buf, len);
@@ -94,6 +195,7 @@ bool Simulator::getAirspeedSample(uint8_t *buf, int len)
 void Simulator::write_MPU_data(void *buf)
 {
 	_mpu.writeData(buf);
+	_mpu_fifo.write(*(RawMPUData *)buf, hrt_absolute_time());
 }
 
 void Simulator::write_accel_data(void *buf)
@@ -177,6 +177,61 @@ protected:
 	RType _buf[2];
 };
 
+/**
+ * Model of the MPU6000/MPU9250 FIFO.
+ *
+ * The sensor samples at the configured rate, independent of how often the
+ * simulator delivers new data, so the latest simulator value is clocked into
+ * the FIFO once per sample interval. A reader gets everything accumulated
+ * since its last read. As on the real device, the oldest samples are lost
+ * when the reader falls behind.
+ */
+class MPUFIFO
+{
+public:
+	/** 1024 byte FIFO with accel, temperature and gyro enabled (14 bytes per sample) */
+	static const unsigned SIZE = 1024 / 14;
+
+	MPUFIFO();
+	~MPUFIFO();
+
+	/**
+	 * Set the sample interval.
+	 *
+	 * @param sample_interval_us	Interval between two samples, 0 disables the FIFO.
+	 */
+	void configure(unsigned sample_interval_us);
+
+	/**
+	 * Update the value the sensor samples from now on.
+	 */
+	void write(const RawMPUData &data, uint64_t now);
+
+	/**
+	 * Read and remove the samples taken up to now, oldest first.
+	 *
+	 * @param buf		Output buffer.
+	 * @param max_samples	Size of buf, samples that do not fit stay in the FIFO.
+	 * @param now		Current time.
+	 * @param newest	Set to the time of the newest sample returned.
+	 * @param overflow	Set if samples were lost since the last read.
+	 * @return		Number of samples returned.
+	 */
+	unsigned read(RawMPUData *buf, unsigned max_samples, uint64_t now, uint64_t *newest, bool *overflow);
+
+private:
+	void clock_in(uint64_t now);
+
+	px4_sem_t _lock;
+	unsigned _interval;
+	uint64_t _next_sample;
+	RawMPUData _latest;
+	RawMPUData _buf[SIZE];
+	unsigned _head;
+	unsigned _count;
+	bool _overflow;
+};
+
 };
 
 class Simulator
@@ -203,6 +258,8 @@ public:
 	bool getRawAccelReport(uint8_t *buf, int len);
 	bool getMagReport(uint8_t *buf, int len);
 	bool getMPUReport(uint8_t *buf, int len);
+	unsigned readMPUFIFO(simulator::RawMPUData *buf, unsigned max_samples, uint64_t *newest, bool *overflow);
+	void configureMPUFIFO(unsigned sample_interval_us);
 	bool getBaroSample(uint8_t *buf, int len);
 	bool getGPSSample(uint8_t *buf, int len);
 	bool getAirspeedSample(uint8_t *buf, int len);
@@ -264,6 +321,7 @@ private:
 	// simulated sensor instances
 	simulator::Report<simulator::RawAccelData>	_accel;
 	simulator::Report<simulator::RawMPUData>	_mpu;
+	simulator::MPUFIFO				_mpu_fifo;
 	simulator::Report<simulator::RawBaroData>	_baro;
 	simulator::Report<simulator::RawMagData>	_mag;
 	simulator::Report<simulator::RawGPSData>	_gps;
@@ -0,0 +1,459 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file stats_export.cpp
+ *
+ * Periodically exports perf counters, uORB topic statistics and task CPU
+ * usage on a Unix domain socket, for monitoring tools that cannot use the
+ * shell.
+ *
+ * Every connected client receives one JSON object per line and interval:
+ *
+ * {"t":<us>,
+ *  "perf":[{"n":name,"ty":type,"ev":events,"ov":overruns,"avg":us,"min":us,"max":us,"p99":us},...],
+ *  "topics":[{"n":path,"gen":generation,"hz":rate,"subs":subscribers,"size":bytes,"age":us},...],
+ *  "tasks":[{"n":name,"cpu":us,"load":fraction},...]}
+ *
+ * Snapshots are only taken while at least one client is connected, so the
+ * exporter costs nothing but a poll() wakeup per interval when unused.
+ * Clients that cannot keep up are disconnected.
+ *
+ * @author PX4 Development Team
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_tasks.h>
+#include <px4_posix.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <string>
+#include <map>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+#include <uORB/uORBDevices_posix.hpp>
+
+extern "C" __EXPORT int stats_export_main(int argc, char *argv[]);
+
+namespace stats_export
+{
+
+static const char *DEFAULT_SOCKET_PATH = "/tmp/px4_stats.sock";
+static const int DEFAULT_INTERVAL_MS = 1000;
+static const int MAX_CLIENTS = 4;
+static const unsigned MAX_TOPICS = 256;
+static const int MAX_TASKS = 64;
+
+static volatile bool _task_should_exit = false;
+static volatile bool _task_running = false;
+static px4_task_t _daemon_task = -1;
+
+static char _socket_path[sizeof(((struct sockaddr_un *)nullptr)->sun_path)] = {};
+static int _interval_ms = DEFAULT_INTERVAL_MS;
+
+static unsigned _snapshot_count = 0;
+static unsigned _dropped_clients = 0;
+
+/**
+ * Values of the previous snapshot, used to turn the cumulative counters
+ * into rates.
+ */
+struct PreviousSample {
+	hrt_abstime timestamp;
+	std::map<std::string, unsigned> topic_generation;
+	std::map<std::string, uint64_t> task_cpu_time;
+};
+
+static const char *perf_type_name(enum perf_counter_type type)
+{
+	switch (type) {
+	case PC_COUNT: return "count";
+
+	case PC_ELAPSED: return "elapsed";
+
+	case PC_ELAPSED_HIST: return "elapsed_hist";
+
+	case PC_INTERVAL: return "interval";
+
+	default: return "unknown";
+	}
+}
+
+/**
+ * Append a string as a JSON string literal.
+ */
+static void append_string(std::string &out, const char *str)
+{
+	out += '"';
+
+	for (; *str != '\0'; str++) {
+		if (*str == '"' || *str == '\\') {
+			out += '\\';
+			out += *str;
+
+		} else if ((unsigned char)*str >= 0x20) {
+			out += *str;
+		}
+	}
+
+	out += '"';
+}
+
+static void append_format(std::string &out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void append_format(std::string &out, const char *fmt, ...)
+{
+	char buf[128];
+	va_list args;
+	va_start(args, fmt);
+	int len = vsnprintf(buf, sizeof(buf), fmt, args);
+	va_end(args);
+
+	if (len > 0) {
+		out.append(buf, (len < (int)sizeof(buf)) ? len : sizeof(buf) - 1);
+	}
+}
+
+static void append_perf_counter(const struct perf_counter_stats *stats, void *user)
+{
+	std::string &out = *(std::string *)user;
+
+	if (out[out.size() - 1] != '[') {
+		out += ',';
+	}
+
+	out += "{\"n\":";
+	append_string(out, stats->name);
+	append_format(out, ",\"ty\":\"%s\",\"ev\":%llu,\"ov\":%llu,\"avg\":%llu,\"min\":%llu,\"max\":%llu,\"p99\":%u}",
+		      perf_type_name(stats->type),
+		      (unsigned long long)stats->event_count,
+		      (unsigned long long)stats->event_overruns,
+		      (unsigned long long)stats->time_avg,
+		      (unsigned long long)stats->time_least,
+		      (unsigned long long)stats->time_most,
+		      (unsigned)stats->time_p99);
+}
+
+/**
+ * Build one snapshot line.
+ */
+static void build_snapshot(std::string &out, PreviousSample &prev)
+{
+	static uORB::DeviceMaster::TopicStats topics[MAX_TOPICS];
+	static px4_task_stats_t tasks[MAX_TASKS];
+
+	const hrt_abstime now = hrt_absolute_time();
+	const float dt = (prev.timestamp != 0 && now > prev.timestamp) ? (now - prev.timestamp) * 1e-6f : 0.0f;
+
+	out.clear();
+	append_format(out, "{\"t\":%llu,\"perf\":[", (unsigned long long)now);
+	perf_iterate_all(append_perf_counter, &out);
+
+	out += "],\"topics\":[";
+	unsigned num_topics = uORB::DeviceMaster::GetTopicStats(topics, MAX_TOPICS);
+
+	if (num_topics > MAX_TOPICS) {
+		num_topics = MAX_TOPICS;
+	}
+
+	for (unsigned i = 0; i < num_topics; i++) {
+		unsigned &prev_generation = prev.topic_generation[topics[i].path];
+		float rate = (dt > 0.0f) ? (topics[i].generation - prev_generation) / dt : 0.0f;
+		prev_generation = topics[i].generation;
+
+		out += (i > 0) ? ",{\"n\":" : "{\"n\":";
+		append_string(out, topics[i].path);
+		append_format(out, ",\"gen\":%u,\"hz\":%.1f,\"subs\":%d,\"size\":%u,\"age\":%llu}",
+			      topics[i].generation, (double)rate, (int)topics[i].subscriber_count, (unsigned)topics[i].size,
+			      (topics[i].last_update == 0) ? 0ULL : (unsigned long long)(now - topics[i].last_update));
+	}
+
+	out += "],\"tasks\":[";
+	int num_tasks = px4_task_get_stats(tasks, MAX_TASKS);
+
+	for (int i = 0; i < num_tasks; i++) {
+		uint64_t &prev_cpu_time = prev.task_cpu_time[tasks[i].name];
+		float load = (dt > 0.0f && prev_cpu_time != 0) ? (tasks[i].cpu_time_us - prev_cpu_time) * 1e-6f / dt : 0.0f;
+		prev_cpu_time = tasks[i].cpu_time_us;
+
+		out += (i > 0) ? ",{\"n\":" : "{\"n\":";
+		append_string(out, tasks[i].name);
+		append_format(out, ",\"cpu\":%llu,\"load\":%.3f}", (unsigned long long)tasks[i].cpu_time_us, (double)load);
+	}
+
+	out += "]}\n";
+
+	prev.timestamp = now;
+	_snapshot_count++;
+}
+
+static int open_listen_socket(const char *path)
+{
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (fd < 0) {
+		PX4_ERR("socket failed: %d", errno);
+		return -1;
+	}
+
+	struct sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+	/* remove a stale socket left behind by a previous instance */
+	unlink(path);
+
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, MAX_CLIENTS) < 0) {
+		PX4_ERR("bind/listen on %s failed: %d", path, errno);
+		close(fd);
+		return -1;
+	}
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+	return fd;
+}
+
+/**
+ * Send a snapshot to a client without blocking.
+ *
+ * @return false if the client is gone or too slow and has to be dropped
+ */
+static bool send_snapshot(int fd, const std::string &snapshot)
+{
+	int flags = MSG_DONTWAIT;
+#ifdef MSG_NOSIGNAL
+	flags |= MSG_NOSIGNAL;
+#endif
+
+	ssize_t sent = send(fd, snapshot.data(), snapshot.size(), flags);
+
+	return sent == (ssize_t)snapshot.size();
+}
+
+static int task_main(int argc, char *argv[])
+{
+	int listen_fd = open_listen_socket(_socket_path);
+
+	if (listen_fd < 0) {
+		_task_running = false;
+		return 1;
+	}
+
+	int clients[MAX_CLIENTS];
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		clients[i] = -1;
+	}
+
+	PreviousSample prev;
+	prev.timestamp = 0;
+	std::string snapshot;
+	hrt_abstime next_snapshot = hrt_absolute_time();
+
+	while (!_task_should_exit) {
+		const hrt_abstime now = hrt_absolute_time();
+		int timeout_ms = (next_snapshot > now) ? (int)((next_snapshot - now) / 1000) : 0;
+
+		struct pollfd fds[1];
+		fds[0].fd = listen_fd;
+		fds[0].events = POLLIN;
+
+		/* the timeout is capped so that stop requests are noticed quickly */
+		int ret = poll(fds, 1, (timeout_ms < 100) ? timeout_ms : 100);
+
+		if (ret > 0 && (fds[0].revents & POLLIN)) {
+			int client_fd = accept(listen_fd, nullptr, nullptr);
+
+			if (client_fd >= 0) {
+				int slot = 0;
+
+				while (slot < MAX_CLIENTS && clients[slot] >= 0) {
+					slot++;
+				}
+
+				if (slot < MAX_CLIENTS) {
+					clients[slot] = client_fd;
+
+				} else {
+					close(client_fd);
+				}
+			}
+		}
+
+		if (hrt_absolute_time() < next_snapshot) {
+			continue;
+		}
+
+		next_snapshot += _interval_ms * 1000;
+
+		bool have_clients = false;
+
+		for (int i = 0; i < MAX_CLIENTS; i++) {
+			have_clients |= (clients[i] >= 0);
+		}
+
+		if (!have_clients) {
+			/* forget the previous sample so rates restart cleanly on the next connection */
+			prev.timestamp = 0;
+			continue;
+		}
+
+		build_snapshot(snapshot, prev);
+
+		for (int i = 0; i < MAX_CLIENTS; i++) {
+			if (clients[i] >= 0 && !send_snapshot(clients[i], snapshot)) {
+				close(clients[i]);
+				clients[i] = -1;
+				_dropped_clients++;
+			}
+		}
+	}
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		if (clients[i] >= 0) {
+			close(clients[i]);
+		}
+	}
+
+	close(listen_fd);
+	unlink(_socket_path);
+
+	_task_running = false;
+
+	return 0;
+}
+
+static void usage()
+{
+	PX4_INFO("usage: stats_export {start|stop|status} [-p <socket path>] [-i <interval ms>]");
+}
+
+} // namespace stats_export
+
+int stats_export_main(int argc, char *argv[])
+{
+	using namespace stats_export;
+
+	if (argc < 2) {
+		usage();
+		return 1;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (_task_running) {
+			PX4_WARN("already running");
+			return 0;
+		}
+
+		strncpy(_socket_path, DEFAULT_SOCKET_PATH, sizeof(_socket_path) - 1);
+		_interval_ms = DEFAULT_INTERVAL_MS;
+
+		for (int i = 2; i + 1 < argc; i += 2) {
+			if (!strcmp(argv[i], "-p")) {
+				strncpy(_socket_path, argv[i + 1], sizeof(_socket_path) - 1);
+
+			} else if (!strcmp(argv[i], "-i")) {
+				_interval_ms = atoi(argv[i + 1]);
+
+			} else {
+				usage();
+				return 1;
+			}
+		}
+
+		if (_interval_ms < 10) {
+			PX4_ERR("interval must be at least 10 ms");
+			return 1;
+		}
+
+		/* set before the spawn, so a second start right away is refused */
+		_task_should_exit = false;
+		_task_running = true;
+		_daemon_task = px4_task_spawn_cmd("stats_export",
+						  SCHED_DEFAULT,
+						  SCHED_PRIORITY_MIN + 5,
+						  2400,
+						  task_main,
+						  nullptr);
+
+		if (_daemon_task < 0) {
+			_task_running = false;
+			PX4_ERR("task start failed");
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		if (!_task_running) {
+			PX4_WARN("not running");
+			return 0;
+		}
+
+		_task_should_exit = true;
+
+		/* wait up to 1s for the task to exit */
+		for (int i = 0; i < 50 && _task_running; i++) {
+			usleep(20000);
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (_task_running) {
+			PX4_INFO("exporting to %s every %d ms, %u snapshots, %u clients dropped",
+				 _socket_path, _interval_ms, _snapshot_count, _dropped_clients);
+
+		} else {
+			PX4_INFO("not running");
+		}
+
+		return 0;
+	}
+
+	usage();
+	return 1;
+}
@@ -58,13 +58,60 @@
 #define BSON_WRITE write
 #define BSON_FSYNC px4_fsync
 
+static int
+read_buffered(bson_decoder_t decoder, void *p, size_t s)
+{
+	uint8_t *dst = (uint8_t *)p;
+
+	while (s > 0) {
+		/* refill the buffer once it has been drained */
+		if (decoder->bufpos >= decoder->bufsize) {
+			int n = BSON_READ(decoder->fd, decoder->buf, decoder->bufcapacity);
+
+			if (n <= 0) {
+				return -1;
+			}
+
+			decoder->bufsize = n;
+			decoder->bufpos = 0;
+		}
+
+		size_t chunk = decoder->bufsize - decoder->bufpos;
+
+		if (chunk > s) {
+			chunk = s;
+		}
+
+		memcpy(dst, decoder->buf + decoder->bufpos, chunk);
+		decoder->bufpos += chunk;
+		dst += chunk;
+		s -= chunk;
+	}
+
+	return 0;
+}
+
 static int
 read_x(bson_decoder_t decoder, void *p, size_t s)
 {
 	CODER_CHECK(decoder);
 
+	if ((decoder->fd > -1) && (decoder->buf != NULL)) {
+		if (read_buffered(decoder, p, s)) {
+			return -1;
+		}
+
+		decoder->total_decoded_size += s;
+		return 0;
+	}
+
 	if (decoder->fd > -1) {
-		return (BSON_READ(decoder->fd, p, s) == (int)s) ? 0 : -1;
+		if (BSON_READ(decoder->fd, p, s) != (int)s) {
+			return -1;
+		}
+
+		decoder->total_decoded_size += s;
+		return 0;
 	}
 
 	if (decoder->buf != NULL) {
@@ -79,6 +126,7 @@ read_x(bson_decoder_t decoder, void *p, size_t s)
 
 		memcpy(p, (decoder->buf + decoder->bufpos), s);
 		decoder->bufpos += s;
+		decoder->total_decoded_size += s;
 		return 0;
 	}
 
@@ -123,6 +171,40 @@ bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback cal
 	decoder->nesting = 1;
 	decoder->pending = 0;
 	decoder->node.type = BSON_UNDEFINED;
+	decoder->total_decoded_size = 0;
+
+	/* read and discard document size */
+	if (read_int32(decoder, &junk)) {
+		CODER_KILL(decoder, "failed discarding length");
+	}
+
+	/* ready for decoding */
+	return 0;
+}
+
+int
+bson_decoder_init_file_buffered(bson_decoder_t decoder, int fd, void *buf, unsigned bufsize,
+				bson_decoder_callback callback, void *private)
+{
+	int32_t	junk;
+
+	/* argument sanity */
+	if ((buf == NULL) || (bufsize == 0)) {
+		return -1;
+	}
+
+	decoder->fd = fd;
+	decoder->buf = (uint8_t *)buf;
+	decoder->bufsize = 0;
+	decoder->bufpos = 0;
+	decoder->bufcapacity = bufsize;
+	decoder->dead = false;
+	decoder->callback = callback;
+	decoder->private = private;
+	decoder->nesting = 1;
+	decoder->pending = 0;
+	decoder->node.type = BSON_UNDEFINED;
+	decoder->total_decoded_size = 0;
 
 	/* read and discard document size */
 	if (read_int32(decoder, &junk)) {
@@ -162,6 +244,7 @@ bson_decoder_init_buf(bson_decoder_t decoder, void *buf, unsigned bufsize, bson_
 	decoder->nesting = 1;
 	decoder->pending = 0;
 	decoder->node.type = BSON_UNDEFINED;
+	decoder->total_decoded_size = 0;
 
 	/* read and discard document size */
 	if (read_int32(decoder, &len)) {
@@ -333,11 +416,43 @@ bson_decoder_data_pending(bson_decoder_t decoder)
 	return decoder->pending;
 }
 
+static int
+flush_x(bson_encoder_t encoder)
+{
+	if (encoder->bufpos > 0) {
+		if (BSON_WRITE(encoder->fd, encoder->buf, encoder->bufpos) != (int)encoder->bufpos) {
+			CODER_KILL(encoder, "write error flushing buffer");
+		}
+
+		debug("flushed %d bytes", encoder->bufpos);
+		encoder->bufpos = 0;
+	}
+
+	return 0;
+}
+
 static int
 write_x(bson_encoder_t encoder, const void *p, size_t s)
 {
 	CODER_CHECK(encoder);
 
+	if ((encoder->fd > -1) && (encoder->buf != NULL)) {
+		if ((encoder->bufpos + s) > encoder->bufsize) {
+			if (flush_x(encoder)) {
+				return -1;
+			}
+
+			/* too big to stage, write it straight through */
+			if (s > encoder->bufsize) {
+				return (BSON_WRITE(encoder->fd, p, s) == (int)s) ? 0 : -1;
+			}
+		}
+
+		memcpy(encoder->buf + encoder->bufpos, p, s);
+		encoder->bufpos += s;
+		return 0;
+	}
+
 	if (encoder->fd > -1) {
 		return (BSON_WRITE(encoder->fd, p, s) == (int)s) ? 0 : -1;
 	}
@@ -416,6 +531,28 @@ bson_encoder_init_file(bson_encoder_t encoder, int fd)
 	return 0;
 }
 
+int
+bson_encoder_init_file_buffered(bson_encoder_t encoder, int fd, void *buf, unsigned bufsize)
+{
+	/* argument sanity */
+	if ((buf == NULL) || (bufsize == 0)) {
+		return -1;
+	}
+
+	encoder->fd = fd;
+	encoder->buf = (uint8_t *)buf;
+	encoder->bufsize = bufsize;
+	encoder->bufpos = 0;
+	encoder->realloc_ok = false;
+	encoder->dead = false;
+
+	if (write_int32(encoder, 0)) {
+		CODER_KILL(encoder, "write error on document length");
+	}
+
+	return 0;
+}
+
 int
 bson_encoder_init_buf(bson_encoder_t encoder, void *buf, unsigned bufsize)
 {
@@ -449,8 +586,14 @@ bson_encoder_fini(bson_encoder_t encoder)
 		CODER_KILL(encoder, "write error on document terminator");
 	}
 
-	/* hack to fix up length for in-buffer documents */
-	if (encoder->buf != NULL) {
+	if (encoder->fd > -1) {
+		/* write out whatever is still staged */
+		if ((encoder->buf != NULL) && flush_x(encoder)) {
+			return -1;
+		}
+
+	} else if (encoder->buf != NULL) {
+		/* hack to fix up length for in-buffer documents */
 		int32_t len = bson_encoder_buf_size(encoder);
 		memcpy(encoder->buf, &len, sizeof(len));
 	}
@@ -105,10 +105,11 @@ struct bson_decoder_s {
 	/* file reader state */
 	int			fd;
 
-	/* buffer reader state */
+	/* buffer reader state, also used to stage file reads when buffered */
 	uint8_t			*buf;
 	size_t			bufsize;
 	unsigned		bufpos;
+	size_t			bufcapacity;
 
 	bool			dead;
 	bson_decoder_callback	callback;
@@ -116,6 +117,9 @@ struct bson_decoder_s {
 	unsigned		nesting;
 	struct bson_node_s	node;
 	int32_t			pending;
+
+	/* bytes consumed from the start of the document */
+	size_t			total_decoded_size;
 };
 
 /**
@@ -129,6 +133,23 @@ struct bson_decoder_s {
  */
 __EXPORT int bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback callback, void *private);
 
+/**
+ * Initialise the decoder to read from a file through a buffer.
+ *
+ * The file is read in blocks of the buffer size rather than one field at
+ * a time, so the decoder may read past the end of the BSON object.
+ *
+ * @param decoder		Decoder state structure to be initialised.
+ * @param fd			File to read BSON data from.
+ * @param buf			Buffer to stage reads in, owned by the caller.
+ * @param bufsize		Size of the buffer.
+ * @param callback		Callback to be invoked by bson_decoder_next
+ * @param private		Callback private data, stored in node.
+ * @return			Zero on success.
+ */
+__EXPORT int bson_decoder_init_file_buffered(bson_decoder_t decoder, int fd, void *buf, unsigned bufsize,
+		bson_decoder_callback callback, void *private);
+
 /**
  * Initialise the decoder to read from a buffer in memory.
  *
@@ -174,7 +195,7 @@ typedef struct bson_encoder_s {
 	/* file writer state */
 	int		fd;
 
-	/* buffer writer state */
+	/* buffer writer state, also used to stage file writes when buffered */
 	uint8_t		*buf;
 	unsigned	bufsize;
 	unsigned	bufpos;
@@ -193,6 +214,20 @@ typedef struct bson_encoder_s {
  */
 __EXPORT int bson_encoder_init_file(bson_encoder_t encoder, int fd);
 
+/**
+ * Initialze the encoder for writing to a file through a buffer.
+ *
+ * The file is written when the buffer is full and by bson_encoder_fini,
+ * instead of once per field.
+ *
+ * @param encoder		Encoder state structure to be initialised.
+ * @param fd			File to write to.
+ * @param buf			Buffer to stage writes in, owned by the caller.
+ * @param bufsize		Size of the buffer.
+ * @return			Zero on success.
+ */
+__EXPORT int bson_encoder_init_file_buffered(bson_encoder_t encoder, int fd, void *buf, unsigned bufsize);
+
 /**
  * Initialze the encoder for writing to a buffer.
  *
@@ -206,7 +241,8 @@ __EXPORT int bson_encoder_init_file(bson_encoder_t encoder, int fd);
 __EXPORT int bson_encoder_init_buf(bson_encoder_t encoder, void *buf, unsigned bufsize);
 
 /**
- * Finalise the encoded stream.
+ * Finalise the encoded stream. For buffered files this writes out the
+ * remaining buffer contents.
  *
  * @param encoder		The encoder to finalise.
  */
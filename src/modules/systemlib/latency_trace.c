@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file latency_trace.c
+ *
+ * Sensor to actuator pipeline latency tracing.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <drivers/drv_hrt.h>
+#include "latency_trace.h"
+
+#ifdef __PX4_QURT
+#define dprintf(...)
+#endif
+
+/**
+ * Number of histogram buckets. Bucket i counts latencies below 2^(i + 1) us,
+ * the last bucket counts everything above.
+ */
+#define LATENCY_TRACE_BUCKETS	16
+
+/**
+ * Statistics of one pipeline stage.
+ */
+struct latency_trace_stats {
+	uint32_t	buckets[LATENCY_TRACE_BUCKETS];
+	uint32_t	event_count;
+	uint32_t	time_least;
+	uint32_t	time_most;
+	uint64_t	time_total;
+};
+
+static struct latency_trace_stats latency_stats[LATENCY_STAGE_COUNT];
+
+static const char *const latency_stage_names[LATENCY_STAGE_COUNT] = {
+	"sensors",
+	"estimator",
+	"controller",
+	"output"
+};
+
+void
+latency_trace_record(enum latency_trace_stage stage, uint64_t timestamp_sample)
+{
+	if (stage >= LATENCY_STAGE_COUNT || timestamp_sample == 0) {
+		return;
+	}
+
+	hrt_abstime now = hrt_absolute_time();
+
+	if (now < timestamp_sample) {
+		return;
+	}
+
+	uint64_t latency64 = now - timestamp_sample;
+	uint32_t latency = (latency64 > UINT32_MAX) ? UINT32_MAX : (uint32_t)latency64;
+	struct latency_trace_stats *stats = &latency_stats[stage];
+
+	/* log2 bucket: index of the highest set bit */
+	unsigned bucket = 0;
+
+	for (uint32_t v = latency >> 1; v != 0 && bucket < LATENCY_TRACE_BUCKETS - 1; v >>= 1) {
+		bucket++;
+	}
+
+	stats->buckets[bucket]++;
+
+	if (stats->event_count == 0 || latency < stats->time_least) {
+		stats->time_least = latency;
+	}
+
+	if (latency > stats->time_most) {
+		stats->time_most = latency;
+	}
+
+	stats->time_total += latency;
+	stats->event_count++;
+}
+
+void
+latency_trace_print(int fd)
+{
+	uint64_t previous_avg = 0;
+
+	for (unsigned stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+		const struct latency_trace_stats *stats = &latency_stats[stage];
+		uint64_t avg = (stats->event_count > 0) ? stats->time_total / stats->event_count : 0;
+		int64_t stage_avg = (stats->event_count > 0) ? (int64_t)(avg - previous_avg) : 0;
+
+		dprintf(fd, "%s: %u events, %lluus avg (stage %lldus), min %uus max %uus\n",
+			latency_stage_names[stage],
+			(unsigned)stats->event_count,
+			(unsigned long long)avg,
+			(long long)stage_avg,
+			(unsigned)stats->time_least,
+			(unsigned)stats->time_most);
+
+		if (stats->event_count == 0) {
+			continue;
+		}
+
+		for (unsigned i = 0; i < LATENCY_TRACE_BUCKETS - 1; i++) {
+			if (stats->buckets[i] > 0) {
+				dprintf(fd, "  <%6u : %u\n", 2u << i, (unsigned)stats->buckets[i]);
+			}
+		}
+
+		if (stats->buckets[LATENCY_TRACE_BUCKETS - 1] > 0) {
+			dprintf(fd, "  >%6u : %u\n", 1u << (LATENCY_TRACE_BUCKETS - 1),
+				(unsigned)stats->buckets[LATENCY_TRACE_BUCKETS - 1]);
+		}
+
+		previous_avg = avg;
+	}
+}
+
+void
+latency_trace_reset(void)
+{
+	memset(latency_stats, 0, sizeof(latency_stats));
+}
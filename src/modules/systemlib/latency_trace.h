@@ -0,0 +1,89 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file latency_trace.h
+ * Sensor to actuator pipeline latency tracing.
+ *
+ * Every stage of the control pipeline forwards the timestamp of the raw
+ * gyro sample its output is based on (sensor_combined.gyro_timestamp,
+ * control_state.timestamp_sample, actuator_controls.timestamp_sample).
+ * When a stage publishes, it records the age of that sample; the
+ * per-stage histograms show the accumulated latency up to that stage.
+ */
+
+#ifndef _SYSTEMLIB_LATENCY_TRACE_H
+#define _SYSTEMLIB_LATENCY_TRACE_H
+
+#include <stdint.h>
+#include <px4_defines.h>
+
+/**
+ * Pipeline stages, in the order the data passes through them.
+ */
+enum latency_trace_stage {
+	LATENCY_STAGE_SENSORS = 0,	/**< sensor_combined published */
+	LATENCY_STAGE_ESTIMATOR,	/**< control_state published */
+	LATENCY_STAGE_CONTROLLER,	/**< actuator_controls published */
+	LATENCY_STAGE_OUTPUT,		/**< outputs written to the hardware */
+	LATENCY_STAGE_COUNT
+};
+
+__BEGIN_DECLS
+
+/**
+ * Record the age of a sample at a pipeline stage.
+ *
+ * Each stage must only be recorded from a single task.
+ *
+ * @param stage			The pipeline stage that just completed.
+ * @param timestamp_sample	The timestamp of the raw sensor sample the
+ *				stage output is based on. Zero is ignored.
+ */
+__EXPORT extern void		latency_trace_record(enum latency_trace_stage stage, uint64_t timestamp_sample);
+
+/**
+ * Print the latency histograms of all stages.
+ *
+ * @param fd			File descriptor to print to - e.g. 1 for stdout
+ */
+__EXPORT extern void		latency_trace_print(int fd);
+
+/**
+ * Reset the latency histograms of all stages.
+ */
+__EXPORT extern void		latency_trace_reset(void);
+
+__END_DECLS
+
+#endif
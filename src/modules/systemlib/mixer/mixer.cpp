@@ -73,6 +73,14 @@ Mixer::get_control(uint8_t group, uint8_t index)
 }
 
 
+#ifndef MIXER_NO_COMPILE
+int
+Mixer::flatten(CompiledMixer &compiled)
+{
+	return compiled.add_mixer(this);
+}
+#endif
+
 float
 Mixer::scale(const mixer_scaler_s &scaler, float input)
 {
@@ -175,6 +183,14 @@ NullMixer::groups_required(uint32_t &groups)
 
 }
 
+#ifndef MIXER_NO_COMPILE
+int
+NullMixer::flatten(CompiledMixer &compiled)
+{
+	return compiled.add_null();
+}
+#endif
+
 NullMixer *
 NullMixer::from_text(const char *buf, unsigned &buflen)
 {
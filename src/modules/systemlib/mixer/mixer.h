@@ -135,6 +135,9 @@
 
 #include "mixer_load.h"
 
+class CompiledMixer;
+class MultirotorMixer;
+
 /**
  * Abstract class defining a mixer mixing zero or more inputs to
  * one or more outputs.
@@ -184,6 +187,19 @@ public:
 	 */
 	virtual void			groups_required(uint32_t &groups) = 0;
 
+#ifndef MIXER_NO_COMPILE
+	/**
+	 * Append the mixer to a compiled mixer.
+	 *
+	 * The default implementation makes the compiled mixer call mix() on
+	 * this mixer; mixers that can be flattened override it.
+	 *
+	 * @param compiled		The compiled mixer to append to.
+	 * @return			Zero on success, nonzero if out of memory.
+	 */
+	virtual int			flatten(CompiledMixer &compiled);
+#endif
+
 protected:
 	/** client-supplied callback used when fetching control values */
 	ControlCallback			_control_cb;
@@ -234,12 +250,115 @@ protected:
 	static const char 		*skipline(const char *buf, unsigned &buflen);
 
 private:
+	friend class CompiledMixer;
 
 	/* do not allow to copy due to pointer data members */
 	Mixer(const Mixer &);
 	Mixer &operator=(const Mixer &);
 };
 
+#ifndef MIXER_NO_COMPILE
+/**
+ * Flattened form of a group of mixers.
+ *
+ * Every control used by the group is fetched once per cycle into a dense
+ * array. Simple mixers become a contiguous table of scalers evaluated in
+ * a single loop, multirotor mixers are invoked directly, and anything else
+ * falls back to its own mix(). Outputs and saturation flags are identical
+ * to mixing the original group.
+ */
+class __EXPORT CompiledMixer
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param control_cb		Callback invoked once per distinct control and cycle.
+	 * @param cb_handle		Passed to control_cb.
+	 */
+	CompiledMixer(Mixer::ControlCallback control_cb, uintptr_t cb_handle);
+	~CompiledMixer();
+
+	/**
+	 * Perform the mixing function.
+	 *
+	 * @param outputs		Array into which mixed output(s) should be placed.
+	 * @param space			The number of available entries in the output array.
+	 * @param status_reg		Saturation flags, as for Mixer::mix().
+	 * @return			The number of entries in the output array that were populated.
+	 */
+	unsigned			mix(float *outputs, unsigned space, uint16_t *status_reg);
+
+	/**
+	 * Append mixers, in output order. Each returns zero on success,
+	 * nonzero if out of memory. Mixers that read their controls through
+	 * a different callback are added with add_mixer().
+	 */
+	int				add_null();
+	int				add_simple(Mixer *mixer, const mixer_simple_s &info);
+	int				add_multirotor(MultirotorMixer *mixer);
+	int				add_mixer(Mixer *mixer);
+
+private:
+	enum OpType : uint8_t {
+		OP_NULL,
+		OP_SIMPLE,
+		OP_MULTIROTOR,
+		OP_MIXER
+	};
+
+	struct Input {
+		uint8_t			control_group;
+		uint8_t			control_index;
+	};
+
+	struct Term {
+		mixer_scaler_s		scaler;
+		uint8_t			input;		/**< index into the input values */
+	};
+
+	struct Op {
+		OpType			type;
+		uint8_t			inputs[4];	/**< OP_MULTIROTOR: roll, pitch, yaw and thrust inputs */
+		uint16_t		first_term;	/**< OP_SIMPLE: first entry in the term table */
+		uint16_t		term_count;	/**< OP_SIMPLE: number of terms */
+		mixer_scaler_s		output_scaler;	/**< OP_SIMPLE */
+		Mixer			*mixer;		/**< OP_MULTIROTOR and OP_MIXER */
+	};
+
+	Mixer::ControlCallback		_control_cb;
+	uintptr_t			_cb_handle;
+
+	Input				*_inputs;
+	float				*_input_values;
+	unsigned			_input_count;
+
+	Term				*_terms;
+	unsigned			_term_count;
+
+	Op				*_ops;
+	unsigned			_op_count;
+
+	/**
+	 * Find or add a control input.
+	 *
+	 * @return			The input index, or -1 if out of memory.
+	 */
+	int				add_input(uint8_t control_group, uint8_t control_index);
+
+	/**
+	 * Append an operation.
+	 *
+	 * @return			The new operation, or nullptr if out of memory.
+	 */
+	Op				*add_op(OpType type);
+
+	/* do not allow to copy due to pointer data members */
+	CompiledMixer(const CompiledMixer &);
+	CompiledMixer &operator=(const CompiledMixer &);
+};
+#endif
+
 /**
  * Group of mixers, built up from single mixers and processed
  * in order when mixing.
@@ -252,6 +371,9 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+#ifndef MIXER_NO_COMPILE
+	virtual int			flatten(CompiledMixer &compiled);
+#endif
 
 	/**
 	 * Add a mixer to the group.
@@ -312,8 +434,41 @@ public:
 	 */
 	int				load_from_buf(const char *buf, unsigned &buflen);
 
+	/**
+	 * Adds mixers to the group from a binary image generated by
+	 * mixer_binary.py, see struct mixer_binary_header_s.
+	 *
+	 * The header and checksum are verified before any mixer is added.
+	 *
+	 * @param buf			The binary image.
+	 * @param buflen		The number of valid bytes at buf.
+	 * @return			Zero on successful load, nonzero otherwise.
+	 */
+	int				load_from_binary(const void *buf, unsigned buflen);
+
+#ifndef MIXER_NO_COMPILE
+	/**
+	 * Flatten the group into a CompiledMixer that mix() uses from then on.
+	 *
+	 * Call once all mixers are loaded. Adding mixers or resetting the
+	 * group discards the compiled form again.
+	 *
+	 * @return			Zero on success, nonzero if out of memory, in
+	 *				which case mix() keeps using the mixer list.
+	 */
+	int				compile();
+#endif
+
 private:
 	Mixer				*_first;	/**< linked list of mixers */
+#ifndef MIXER_NO_COMPILE
+	CompiledMixer			*_compiled;	/**< flattened form of the list, if compiled */
+
+	/**
+	 * Discard the compiled form.
+	 */
+	void				discard_compiled();
+#endif
 
 	/* do not allow to copy due to pointer data members */
 	MixerGroup(const MixerGroup &);
@@ -348,6 +503,9 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+#ifndef MIXER_NO_COMPILE
+	virtual int			flatten(CompiledMixer &compiled);
+#endif
 };
 
 /**
@@ -391,6 +549,22 @@ public:
 			const char *buf,
 			unsigned &buflen);
 
+	/**
+	 * Factory method for a binary record payload.
+	 *
+	 * @param control_cb		The callback to invoke when fetching a
+	 *				control value.
+	 * @param cb_handle		Handle passed to the control callback.
+	 * @param buf			Record payload, a struct mixer_simple_s.
+	 * @param buflen		Length of the payload in bytes.
+	 * @return			A new SimpleMixer instance, or nullptr
+	 *				if the payload is malformed.
+	 */
+	static SimpleMixer		*from_binary(Mixer::ControlCallback control_cb,
+			uintptr_t cb_handle,
+			const void *buf,
+			unsigned buflen);
+
 	/**
 	 * Factory method for PWM/PPM input to internal float representation.
 	 *
@@ -413,6 +587,9 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+#ifndef MIXER_NO_COMPILE
+	virtual int			flatten(CompiledMixer &compiled);
+#endif
 
 	/**
 	 * Check that the mixer configuration as loaded is sensible.
@@ -515,8 +692,41 @@ public:
 			const char *buf,
 			unsigned &buflen);
 
+	/**
+	 * Factory method for a binary record payload.
+	 *
+	 * @param control_cb		The callback to invoke when fetching a
+	 *				control value.
+	 * @param cb_handle		Handle passed to the control callback.
+	 * @param buf			Record payload, a struct mixer_multirotor_s.
+	 * @param buflen		Length of the payload in bytes.
+	 * @return			A new MultirotorMixer instance, or nullptr
+	 *				if the payload is malformed.
+	 */
+	static MultirotorMixer		*from_binary(Mixer::ControlCallback control_cb,
+			uintptr_t cb_handle,
+			const void *buf,
+			unsigned buflen);
+
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+#ifndef MIXER_NO_COMPILE
+	virtual int			flatten(CompiledMixer &compiled);
+#endif
+
+	/**
+	 * Mix already fetched controls.
+	 *
+	 * @param roll			Control group 0, index 0.
+	 * @param pitch			Control group 0, index 1.
+	 * @param yaw			Control group 0, index 2.
+	 * @param thrust		Control group 0, index 3.
+	 * @param outputs		Array into which mixed outputs should be placed.
+	 * @param status_reg		Saturation flags, as for mix().
+	 * @return			The number of entries in the output array that were populated.
+	 */
+	unsigned			mix_controls(float roll, float pitch, float yaw, float thrust,
+			float *outputs, uint16_t *status_reg);
 
 private:
 	float				_roll_scale;
@@ -530,6 +740,13 @@ private:
 	unsigned			_rotor_count;
 	const Rotor			*_rotors;
 
+	/**
+	 * Look up a geometry by its name in the mixer definition.
+	 *
+	 * @return			Zero on success, nonzero if the name is unknown.
+	 */
+	static int			geometry_from_name(const char *name, MultirotorGeometry &geometry);
+
 	/* do not allow to copy due to ptr data members */
 	MultirotorMixer(const MultirotorMixer &);
 	MultirotorMixer operator=(const MultirotorMixer &);
@@ -0,0 +1,194 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Convert a text mixer definition into the binary form loaded by
+# MixerGroup::load_from_binary(). See struct mixer_binary_header_s in
+# drv_mixer.h for the layout.
+#
+
+# for python2.7 compatibility
+from __future__ import print_function
+
+import argparse
+import os
+import struct
+import sys
+
+MIXER_BINARY_MAGIC = 0x584d5850
+MIXER_BINARY_VERSION = 1
+
+GEOMETRIES = ["4+", "4x", "4h", "4v", "4w", "4dc", "6+", "6x", "6c",
+              "8+", "8x", "8c", "2-", "3y"]
+
+
+class MixerError(Exception):
+    pass
+
+
+def crc32part(data, crc=0):
+    """crc32part() as implemented by NuttX and the POSIX layer: reflected
+    0xEDB88320 polynomial without pre- or post-inversion."""
+    for byte in bytearray(data):
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ (0xEDB88320 if crc & 1 else 0)
+    return crc
+
+
+def definition_lines(text):
+    """Yield (line number, tag, arguments) for the significant lines, as
+    load_mixer_file() selects them."""
+    for number, line in enumerate(text.splitlines(), 1):
+        if len(line) < 2 or not line[0].isupper() or line[1] != ':':
+            continue
+        yield number, line[0], line[2:].split()
+
+
+def scaler(number, args, count):
+    if len(args) != count:
+        raise MixerError("line %d: expected %d values, got %d" % (number, count, len(args)))
+    try:
+        values = [int(a) for a in args]
+    except ValueError:
+        raise MixerError("line %d: values must be integers" % number)
+    return values
+
+
+def pack_scaler(values):
+    # the text form stores scalers multiplied by 10000
+    return struct.pack("<5f", *[v / 10000.0 for v in values])
+
+
+def records(text):
+    lines = list(definition_lines(text))
+    i = 0
+    while i < len(lines):
+        number, tag, args = lines[i]
+        i += 1
+
+        if tag == 'Z':
+            yield b'Z', b''
+
+        elif tag == 'M':
+            count = scaler(number, args, 1)[0]
+            if count < 0 or count > 255:
+                raise MixerError("line %d: bad control count %d" % (number, count))
+            if i >= len(lines) or lines[i][1] != 'O':
+                raise MixerError("line %d: simple mixer without output scaler" % number)
+            payload = struct.pack("<B3x", count) + pack_scaler(scaler(lines[i][0], lines[i][2], 5))
+            i += 1
+            for _ in range(count):
+                if i >= len(lines) or lines[i][1] != 'S':
+                    raise MixerError("line %d: simple mixer has fewer than %d controls" % (number, count))
+                values = scaler(lines[i][0], lines[i][2], 7)
+                if not (0 <= values[0] <= 255 and 0 <= values[1] <= 255):
+                    raise MixerError("line %d: bad control group or index" % lines[i][0])
+                payload += struct.pack("<BB2x", values[0], values[1]) + pack_scaler(values[2:])
+                i += 1
+            yield b'M', payload
+
+        elif tag == 'R':
+            if len(args) != 5:
+                raise MixerError("line %d: expected geometry and 4 values" % number)
+            if args[0] not in GEOMETRIES:
+                raise MixerError("line %d: unknown geometry '%s'" % (number, args[0]))
+            values = scaler(number, args[1:], 4)
+            yield b'R', struct.pack("<4s4f", args[0].encode('ascii'), *[v / 10000.0 for v in values])
+
+        else:
+            raise MixerError("line %d: unexpected '%s:' line" % (number, tag))
+
+
+def compile_mixer(text):
+    body = b''
+    count = 0
+    for tag, payload in records(text):
+        body += struct.pack("<cxH", tag, len(payload)) + payload
+        count += 1
+    header = struct.pack("<IHHII", MIXER_BINARY_MAGIC, MIXER_BINARY_VERSION, count,
+                         16 + len(body), crc32part(body))
+    return header + body
+
+
+def c_header(name, source, text, image):
+    """C header with the image as name[] and the definition lines it was
+    generated from, as load_mixer_file() passes them on, as name_text[]."""
+    out = ["/* generated by mixer_binary.py from %s, do not edit */" % source, "",
+           "static const char %s_text[] =" % name]
+    for _, tag, args in definition_lines(text):
+        out.append('\t"%s:%s\\n"' % (tag, "".join(" " + a for a in args)))
+    out[-1] += ";"
+    out += ["", "static const uint8_t %s[] = {" % name]
+    data = bytearray(image)
+    for i in range(0, len(data), 12):
+        out.append("\t" + " ".join("0x%02x," % b for b in data[i:i + 12]))
+    out += ["};", ""]
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a text mixer definition to the binary form.")
+    parser.add_argument("input", help="text mixer definition")
+    parser.add_argument("-o", "--output", help="binary output file (default: input with .mixb suffix)")
+    parser.add_argument("--header", metavar="NAME",
+                        help="write a C header defining the image as NAME[] instead of a binary file")
+    args = parser.parse_args()
+
+    output = args.output
+    if output is None:
+        output = (args.input[:-4] if args.input.endswith(".mix") else args.input) + \
+            (".h" if args.header else ".mixb")
+
+    with open(args.input) as f:
+        text = f.read()
+
+    try:
+        image = compile_mixer(text)
+    except MixerError as e:
+        print("%s: %s" % (args.input, e), file=sys.stderr)
+        return 1
+
+    if args.header:
+        with open(output, "w") as f:
+            f.write(c_header(args.header, os.path.basename(args.input), text, image))
+    else:
+        with open(output, "wb") as f:
+            f.write(image)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
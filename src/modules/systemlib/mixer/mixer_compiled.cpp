@@ -0,0 +1,276 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mixer_compiled.cpp
+ *
+ * Flattened mixer group.
+ */
+
+#include <px4_config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mixer.h"
+
+namespace
+{
+
+/**
+ * Same as Mixer::scale(), but written with conditional selects rather than
+ * branches and visible to the compiler so it is inlined into the term loop.
+ */
+inline float scale(const mixer_scaler_s &scaler, float input)
+{
+	const float gain = (input < 0.0f) ? scaler.negative_scale : scaler.positive_scale;
+	const float output = (input * gain) + scaler.offset;
+
+	return (output > scaler.max_output) ? scaler.max_output :
+	       ((output < scaler.min_output) ? scaler.min_output : output);
+}
+
+/**
+ * Grow an array by one element.
+ */
+template<typename T>
+bool grow(T *&array, unsigned count)
+{
+	T *grown = (T *)realloc(array, (count + 1) * sizeof(T));
+
+	if (grown == nullptr) {
+		return false;
+	}
+
+	array = grown;
+	return true;
+}
+
+} // anonymous namespace
+
+CompiledMixer::CompiledMixer(Mixer::ControlCallback control_cb, uintptr_t cb_handle) :
+	_control_cb(control_cb),
+	_cb_handle(cb_handle),
+	_inputs(nullptr),
+	_input_values(nullptr),
+	_input_count(0),
+	_terms(nullptr),
+	_term_count(0),
+	_ops(nullptr),
+	_op_count(0)
+{
+}
+
+CompiledMixer::~CompiledMixer()
+{
+	free(_inputs);
+	free(_input_values);
+	free(_terms);
+	free(_ops);
+}
+
+int
+CompiledMixer::add_input(uint8_t control_group, uint8_t control_index)
+{
+	for (unsigned i = 0; i < _input_count; i++) {
+		if (_inputs[i].control_group == control_group && _inputs[i].control_index == control_index) {
+			return i;
+		}
+	}
+
+	/* input indices are stored as uint8_t */
+	if (_input_count > UINT8_MAX) {
+		return -1;
+	}
+
+	if (!grow(_inputs, _input_count) || !grow(_input_values, _input_count)) {
+		return -1;
+	}
+
+	_inputs[_input_count].control_group = control_group;
+	_inputs[_input_count].control_index = control_index;
+	_input_values[_input_count] = 0.0f;
+
+	return _input_count++;
+}
+
+CompiledMixer::Op *
+CompiledMixer::add_op(OpType type)
+{
+	if (!grow(_ops, _op_count)) {
+		return nullptr;
+	}
+
+	Op *op = &_ops[_op_count++];
+	memset(op, 0, sizeof(*op));
+	op->type = type;
+
+	return op;
+}
+
+int
+CompiledMixer::add_null()
+{
+	return (add_op(OP_NULL) != nullptr) ? 0 : -1;
+}
+
+int
+CompiledMixer::add_simple(Mixer *mixer, const mixer_simple_s &info)
+{
+	if (mixer->_control_cb != _control_cb || mixer->_cb_handle != _cb_handle ||
+	    _term_count + info.control_count > UINT16_MAX) {
+		return add_mixer(mixer);
+	}
+
+	const unsigned first_term = _term_count;
+
+	for (unsigned i = 0; i < info.control_count; i++) {
+		int input = add_input(info.controls[i].control_group, info.controls[i].control_index);
+
+		if (input < 0 || !grow(_terms, _term_count)) {
+			return -1;
+		}
+
+		_terms[_term_count].scaler = info.controls[i].scaler;
+		_terms[_term_count].input = input;
+		_term_count++;
+	}
+
+	Op *op = add_op(OP_SIMPLE);
+
+	if (op == nullptr) {
+		return -1;
+	}
+
+	op->first_term = first_term;
+	op->term_count = info.control_count;
+	op->output_scaler = info.output_scaler;
+
+	return 0;
+}
+
+int
+CompiledMixer::add_multirotor(MultirotorMixer *mixer)
+{
+	if (mixer->_control_cb != _control_cb || mixer->_cb_handle != _cb_handle) {
+		return add_mixer(mixer);
+	}
+
+	uint8_t inputs[4];
+
+	/* roll, pitch, yaw and thrust are read from group 0, indices 0-3 */
+	for (unsigned i = 0; i < 4; i++) {
+		int input = add_input(0, i);
+
+		if (input < 0) {
+			return -1;
+		}
+
+		inputs[i] = input;
+	}
+
+	Op *op = add_op(OP_MULTIROTOR);
+
+	if (op == nullptr) {
+		return -1;
+	}
+
+	memcpy(op->inputs, inputs, sizeof(op->inputs));
+	op->mixer = mixer;
+
+	return 0;
+}
+
+int
+CompiledMixer::add_mixer(Mixer *mixer)
+{
+	Op *op = add_op(OP_MIXER);
+
+	if (op == nullptr) {
+		return -1;
+	}
+
+	op->mixer = mixer;
+
+	return 0;
+}
+
+unsigned
+CompiledMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
+{
+	/* fetch every control once */
+	for (unsigned i = 0; i < _input_count; i++) {
+		_control_cb(_cb_handle, _inputs[i].control_group, _inputs[i].control_index, _input_values[i]);
+	}
+
+	unsigned index = 0;
+
+	for (unsigned i = 0; (i < _op_count) && (index < space); i++) {
+		const Op &op = _ops[i];
+
+		switch (op.type) {
+		case OP_NULL:
+			outputs[index++] = 0.0f;
+			break;
+
+		case OP_SIMPLE: {
+				const Term *term = &_terms[op.first_term];
+				float sum = 0.0f;
+
+				for (unsigned t = 0; t < op.term_count; t++) {
+					sum += scale(term[t].scaler, _input_values[term[t].input]);
+				}
+
+				outputs[index++] = scale(op.output_scaler, sum);
+				break;
+			}
+
+		case OP_MULTIROTOR:
+			index += static_cast<MultirotorMixer *>(op.mixer)->mix_controls(_input_values[op.inputs[0]],
+					_input_values[op.inputs[1]],
+					_input_values[op.inputs[2]],
+					_input_values[op.inputs[3]],
+					outputs + index, status_reg);
+			break;
+
+		case OP_MIXER:
+			index += op.mixer->mix(outputs + index, space - index, status_reg);
+			break;
+		}
+	}
+
+	return index;
+}
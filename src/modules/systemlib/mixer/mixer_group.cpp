@@ -50,9 +50,17 @@
 #include <stdio.h>
 #include <math.h>
 #include <unistd.h>
+#include <crc32.h>
 
 #include "mixer.h"
 
+/* binary records are copied straight into these structures */
+static_assert(sizeof(mixer_scaler_s) == 20, "binary mixer format assumes packed scalers");
+static_assert(MIXER_SIMPLE_SIZE(1) == 48, "binary mixer format assumes 4-byte aligned simple mixers");
+static_assert(sizeof(mixer_multirotor_s) == 20, "binary mixer format assumes packed multirotor records");
+static_assert(sizeof(mixer_binary_header_s) == 16, "binary mixer header must be 16 bytes");
+static_assert(sizeof(mixer_binary_record_s) == 4, "binary mixer record header must be 4 bytes");
+
 #define debug(fmt, args...)	do { } while(0)
 //#define debug(fmt, args...)	do { printf("[mixer] " fmt "\n", ##args); } while(0)
 //#include <debug.h>
@@ -61,6 +69,9 @@
 MixerGroup::MixerGroup(ControlCallback control_cb, uintptr_t cb_handle) :
 	Mixer(control_cb, cb_handle),
 	_first(nullptr)
+#ifndef MIXER_NO_COMPILE
+	, _compiled(nullptr)
+#endif
 {
 }
 
@@ -74,6 +85,11 @@ MixerGroup::add_mixer(Mixer *mixer)
 {
 	Mixer **mpp;
 
+#ifndef MIXER_NO_COMPILE
+	/* the compiled form no longer matches the list */
+	discard_compiled();
+#endif
+
 	mpp = &_first;
 
 	while (*mpp != nullptr) {
@@ -89,6 +105,10 @@ MixerGroup::reset()
 {
 	Mixer *mixer;
 
+#ifndef MIXER_NO_COMPILE
+	discard_compiled();
+#endif
+
 	/* discard sub-mixers */
 	while (_first != nullptr) {
 		mixer = _first;
@@ -101,6 +121,14 @@ MixerGroup::reset()
 unsigned
 MixerGroup::mix(float *outputs, unsigned space, uint16_t *status_reg)
 {
+#ifndef MIXER_NO_COMPILE
+
+	if (_compiled != nullptr) {
+		return _compiled->mix(outputs, space, status_reg);
+	}
+
+#endif
+
 	Mixer	*mixer = _first;
 	unsigned index = 0;
 
@@ -137,6 +165,56 @@ MixerGroup::groups_required(uint32_t &groups)
 	}
 }
 
+#ifndef MIXER_NO_COMPILE
+int
+MixerGroup::flatten(CompiledMixer &compiled)
+{
+	Mixer	*mixer = _first;
+
+	while (mixer != nullptr) {
+		int ret = mixer->flatten(compiled);
+
+		if (ret != 0) {
+			return ret;
+		}
+
+		mixer = mixer->_next;
+	}
+
+	return 0;
+}
+
+int
+MixerGroup::compile()
+{
+	discard_compiled();
+
+	CompiledMixer *compiled = new CompiledMixer(_control_cb, _cb_handle);
+
+	if (compiled == nullptr) {
+		return -1;
+	}
+
+	if (flatten(*compiled) != 0) {
+		debug("out of memory compiling mixer group");
+		delete compiled;
+		return -1;
+	}
+
+	_compiled = compiled;
+	return 0;
+}
+
+void
+MixerGroup::discard_compiled()
+{
+	if (_compiled != nullptr) {
+		delete _compiled;
+		_compiled = nullptr;
+	}
+}
+#endif
+
 int
 MixerGroup::load_from_buf(const char *buf, unsigned &buflen)
 {
@@ -203,3 +281,114 @@ MixerGroup::load_from_buf(const char *buf, unsigned &buflen)
 	/* nothing more in the buffer for us now */
 	return ret;
 }
+
+int
+MixerGroup::load_from_binary(const void *buf, unsigned buflen)
+{
+	const uint8_t *image = (const uint8_t *)buf;
+	mixer_binary_header_s header;
+
+	if (buflen < sizeof(header)) {
+		debug("binary image too short: %u", buflen);
+		return -1;
+	}
+
+	memcpy(&header, image, sizeof(header));
+
+	if (header.magic != MIXER_BINARY_MAGIC || header.version != MIXER_BINARY_VERSION) {
+		debug("not a binary mixer image, or unsupported version");
+		return -1;
+	}
+
+	if (header.length < sizeof(header) || header.length > buflen) {
+		debug("binary image length %u invalid, %u available", (unsigned)header.length, buflen);
+		return -1;
+	}
+
+	if (crc32part(image + sizeof(header), header.length - sizeof(header), 0) != header.crc) {
+		debug("binary image checksum mismatch");
+		return -1;
+	}
+
+	/* check the record framing before constructing anything */
+	const uint8_t *p = image + sizeof(header);
+	const uint8_t *end = image + header.length;
+	unsigned records = 0;
+
+	while (p < end) {
+		mixer_binary_record_s record;
+
+		if ((unsigned)(end - p) < sizeof(record)) {
+			debug("truncated record header");
+			return -1;
+		}
+
+		memcpy(&record, p, sizeof(record));
+		p += sizeof(record);
+
+		if (record.length > (unsigned)(end - p)) {
+			debug("record %u overruns the image", records);
+			return -1;
+		}
+
+		p += record.length;
+		records++;
+	}
+
+	if (records != header.record_count) {
+		debug("image holds %u records, header says %u", records, (unsigned)header.record_count);
+		return -1;
+	}
+
+	/* construct every mixer before adding any, so a bad record leaves the group unchanged */
+	MixerGroup loaded(_control_cb, _cb_handle);
+	p = image + sizeof(header);
+
+	while (p < end) {
+		Mixer *m = nullptr;
+		mixer_binary_record_s record;
+
+		memcpy(&record, p, sizeof(record));
+		p += sizeof(record);
+
+		switch (record.type) {
+		case 'Z':
+			if (record.length == 0) {
+				m = new NullMixer();
+			}
+
+			break;
+
+		case 'M':
+			m = SimpleMixer::from_binary(_control_cb, _cb_handle, p, record.length);
+			break;
+
+#ifndef ARDUPILOT_BUILD
+
+		case 'R':
+			m = MultirotorMixer::from_binary(_control_cb, _cb_handle, p, record.length);
+			break;
+#endif
+
+		default:
+			debug("unknown record type 0x%02x", record.type);
+			break;
+		}
+
+		if (m == nullptr) {
+			/* the mixers constructed so far go with the temporary group */
+			return -1;
+		}
+
+		loaded.add_mixer(m);
+		p += record.length;
+	}
+
+	while (loaded._first != nullptr) {
+		Mixer *m = loaded._first;
+		loaded._first = m->_next;
+		add_mixer(m);
+	}
+
+	return 0;
+}
@@ -42,6 +42,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <systemlib/err.h>
+#include <drivers/drv_mixer.h>
 
 #include "mixer_load.h"
 
@@ -113,3 +114,42 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 	return 0;
 }
 
+
+int load_mixer_file_binary(const char *fname, void *buf, unsigned maxlen)
+{
+	FILE		*fp;
+	struct mixer_binary_header_s header;
+	int		ret = 0;
+
+	fp = fopen(fname, "rb");
+
+	if (fp == NULL) {
+		warnx("file not found");
+		return -1;
+	}
+
+	/* anything without the magic is left to the text loader */
+	if (fread(&header, sizeof(header), 1, fp) != 1 || header.magic != MIXER_BINARY_MAGIC) {
+		goto out;
+	}
+
+	if (header.length < sizeof(header) || header.length > maxlen) {
+		warnx("binary mixer too large");
+		ret = -1;
+		goto out;
+	}
+
+	memcpy(buf, &header, sizeof(header));
+
+	if (fread((char *)buf + sizeof(header), 1, header.length - sizeof(header), fp) != header.length - sizeof(header)) {
+		warnx("binary mixer truncated");
+		ret = -1;
+		goto out;
+	}
+
+	ret = header.length;
+
+out:
+	fclose(fp);
+	return ret;
+}
@@ -46,6 +46,17 @@ __BEGIN_DECLS
 
 __EXPORT int load_mixer_file(const char *fname, char *buf, unsigned maxlen);
 
+/**
+ * Read a binary mixer image generated by mixer_binary.py.
+ *
+ * @param fname		The file to read.
+ * @param buf		Buffer receiving the image.
+ * @param maxlen	Size of the buffer.
+ * @return		The image length, zero if the file is not a binary
+ *			mixer image, or negative on error.
+ */
+__EXPORT int load_mixer_file_binary(const char *fname, void *buf, unsigned maxlen);
+
 __END_DECLS
 
 #endif
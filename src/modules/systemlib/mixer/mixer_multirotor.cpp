@@ -144,73 +144,121 @@ MultirotorMixer::from_text(Mixer::ControlCallback control_cb, uintptr_t cb_handl
 
 	debug("remaining in buf: %d, first char: %c", buflen, buf[0]);
 
-	if (!strcmp(geomname, "4+")) {
+	if (geometry_from_name(geomname, geometry) != 0) {
+		debug("unrecognised geometry '%s'", geomname);
+		return nullptr;
+	}
+
+	debug("adding multirotor mixer '%s'", geomname);
+
+	return new MultirotorMixer(
+		       control_cb,
+		       cb_handle,
+		       geometry,
+		       s[0] / 10000.0f,
+		       s[1] / 10000.0f,
+		       s[2] / 10000.0f,
+		       s[3] / 10000.0f);
+}
+
+int
+MultirotorMixer::geometry_from_name(const char *name, MultirotorGeometry &geometry)
+{
+	if (!strcmp(name, "4+")) {
 		geometry = MultirotorGeometry::QUAD_PLUS;
 
-	} else if (!strcmp(geomname, "4x")) {
+	} else if (!strcmp(name, "4x")) {
 		geometry = MultirotorGeometry::QUAD_X;
 
-	} else if (!strcmp(geomname, "4h")) {
+	} else if (!strcmp(name, "4h")) {
 		geometry = MultirotorGeometry::QUAD_H;
 
-	} else if (!strcmp(geomname, "4v")) {
+	} else if (!strcmp(name, "4v")) {
 		geometry = MultirotorGeometry::QUAD_V;
 
-	} else if (!strcmp(geomname, "4w")) {
+	} else if (!strcmp(name, "4w")) {
 		geometry = MultirotorGeometry::QUAD_WIDE;
 
-	} else if (!strcmp(geomname, "4dc")) {
+	} else if (!strcmp(name, "4dc")) {
 		geometry = MultirotorGeometry::QUAD_DEADCAT;
 
-	} else if (!strcmp(geomname, "6+")) {
+	} else if (!strcmp(name, "6+")) {
 		geometry = MultirotorGeometry::HEX_PLUS;
 
-	} else if (!strcmp(geomname, "6x")) {
+	} else if (!strcmp(name, "6x")) {
 		geometry = MultirotorGeometry::HEX_X;
 
-	} else if (!strcmp(geomname, "6c")) {
+	} else if (!strcmp(name, "6c")) {
 		geometry = MultirotorGeometry::HEX_COX;
 
-	} else if (!strcmp(geomname, "8+")) {
+	} else if (!strcmp(name, "8+")) {
 		geometry = MultirotorGeometry::OCTA_PLUS;
 
-	} else if (!strcmp(geomname, "8x")) {
+	} else if (!strcmp(name, "8x")) {
 		geometry = MultirotorGeometry::OCTA_X;
 
-	} else if (!strcmp(geomname, "8c")) {
+	} else if (!strcmp(name, "8c")) {
 		geometry = MultirotorGeometry::OCTA_COX;
 
 #if 0
 
-	} else if (!strcmp(geomname, "8cw")) {
+	} else if (!strcmp(name, "8cw")) {
 		geometry = MultirotorGeometry::OCTA_COX_WIDE;
 #endif
 
-	} else if (!strcmp(geomname, "2-")) {
+	} else if (!strcmp(name, "2-")) {
 		geometry = MultirotorGeometry::TWIN_ENGINE;
 
-	} else if (!strcmp(geomname, "3y")) {
+	} else if (!strcmp(name, "3y")) {
 		geometry = MultirotorGeometry::TRI_Y;
 
 	} else {
-		debug("unrecognised geometry '%s'", geomname);
+		return -1;
+	}
+
+	return 0;
+}
+
+MultirotorMixer *
+MultirotorMixer::from_binary(Mixer::ControlCallback control_cb, uintptr_t cb_handle, const void *buf, unsigned buflen)
+{
+	MultirotorGeometry geometry;
+	mixer_multirotor_s info;
+
+	if (buflen != sizeof(info)) {
+		debug("multirotor record length %u, expected %u", buflen, (unsigned)sizeof(info));
 		return nullptr;
 	}
 
-	debug("adding multirotor mixer '%s'", geomname);
+	memcpy(&info, buf, sizeof(info));
+
+	if (info.geometry[sizeof(info.geometry) - 1] != '\0' ||
+	    geometry_from_name(info.geometry, geometry) != 0) {
+		debug("unrecognised geometry in multirotor record");
+		return nullptr;
+	}
+
+	debug("adding multirotor mixer '%s'", info.geometry);
 
 	return new MultirotorMixer(
 		       control_cb,
 		       cb_handle,
 		       geometry,
-		       s[0] / 10000.0f,
-		       s[1] / 10000.0f,
-		       s[2] / 10000.0f,
-		       s[3] / 10000.0f);
+		       info.roll_scale,
+		       info.pitch_scale,
+		       info.yaw_scale,
+		       info.idle_speed);
 }
 
 unsigned
 MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
+{
+	return mix_controls(get_control(0, 0), get_control(0, 1), get_control(0, 2), get_control(0, 3),
+			    outputs, status_reg);
+}
+
+unsigned
+MultirotorMixer::mix_controls(float roll, float pitch, float yaw, float thrust, float *outputs, uint16_t *status_reg)
 {
 	/* Summary of mixing strategy:
 	1) mix roll, pitch and thrust without yaw.
@@ -223,10 +271,10 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	4) scale all outputs to range [idle_speed,1]
 	*/
 
-	float		roll    = constrain(get_control(0, 0) * _roll_scale, -1.0f, 1.0f);
-	float		pitch   = constrain(get_control(0, 1) * _pitch_scale, -1.0f, 1.0f);
-	float		yaw     = constrain(get_control(0, 2) * _yaw_scale, -1.0f, 1.0f);
-	float		thrust  = constrain(get_control(0, 3), 0.0f, 1.0f);
+	roll    = constrain(roll * _roll_scale, -1.0f, 1.0f);
+	pitch   = constrain(pitch * _pitch_scale, -1.0f, 1.0f);
+	yaw     = constrain(yaw * _yaw_scale, -1.0f, 1.0f);
+	thrust  = constrain(thrust, 0.0f, 1.0f);
 	float		min_out = 0.0f;
 	float		max_out = 0.0f;
 
@@ -368,6 +416,14 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	return _rotor_count;
 }
 
+#ifndef MIXER_NO_COMPILE
+int
+MultirotorMixer::flatten(CompiledMixer &compiled)
+{
+	return compiled.add_multirotor(this);
+}
+#endif
+
 void
 MultirotorMixer::groups_required(uint32_t &groups)
 {
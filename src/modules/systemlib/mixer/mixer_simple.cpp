@@ -212,6 +212,42 @@ out:
 	return sm;
 }
 
+SimpleMixer *
+SimpleMixer::from_binary(Mixer::ControlCallback control_cb, uintptr_t cb_handle, const void *buf, unsigned buflen)
+{
+	SimpleMixer *sm = nullptr;
+	mixer_simple_s *mixinfo;
+
+	if (buflen < sizeof(mixer_simple_s)) {
+		debug("simple record too short: %u", buflen);
+		return nullptr;
+	}
+
+	/* the payload is the in-memory layout, so only its size needs checking */
+	if (buflen != MIXER_SIMPLE_SIZE(((const mixer_simple_s *)buf)->control_count)) {
+		debug("simple record length %u does not match control count", buflen);
+		return nullptr;
+	}
+
+	mixinfo = (mixer_simple_s *)malloc(buflen);
+
+	if (mixinfo == nullptr) {
+		debug("could not allocate memory for mixer info");
+		return nullptr;
+	}
+
+	memcpy(mixinfo, buf, buflen);
+
+	sm = new SimpleMixer(control_cb, cb_handle, mixinfo);
+
+	if (sm == nullptr) {
+		debug("could not allocate memory for mixer");
+		free(mixinfo);
+	}
+
+	return sm;
+}
+
 SimpleMixer *
 SimpleMixer::pwm_input(Mixer::ControlCallback control_cb, uintptr_t cb_handle, unsigned input, uint16_t min,
 		       uint16_t mid, uint16_t max)
@@ -310,6 +346,18 @@ SimpleMixer::groups_required(uint32_t &groups)
 	}
 }
 
+#ifndef MIXER_NO_COMPILE
+int
+SimpleMixer::flatten(CompiledMixer &compiled)
+{
+	if (_info == nullptr) {
+		return compiled.add_mixer(this);
+	}
+
+	return compiled.add_simple(this, *_info);
+}
+#endif
+
 int
 SimpleMixer::check()
 {
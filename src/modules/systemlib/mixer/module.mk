@@ -38,6 +38,7 @@
 LIBNAME	= mixerlib
 
 SRCS		= mixer.cpp \
+		  mixer_compiled.cpp \
 		  mixer_group.cpp \
 		  mixer_simple.cpp \
 		  mixer_load.c
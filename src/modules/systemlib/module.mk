@@ -37,6 +37,7 @@
 
 SRCS		 = \
 		   perf_counter.c \
+		   latency_trace.c \
 		   conversions.c \
 		   cpuload.c \
 		   getopt_long.c \
@@ -60,6 +61,12 @@ SRCS		+= param/param.c \
 		   circuit_breaker_params.c
 endif
 
+ifeq ($(PX4_TARGET_OS),posix)
+ifneq ($(ARDUPILOT_BUILD),1)
+SRCS		+= param/param_shm.c
+endif
+endif
+
 ifeq ($(PX4_TARGET_OS),nuttx)
 SRCS		+= err.c \
 		   up_cxxinitialize.c 
@@ -46,13 +46,16 @@
 #include <px4_posix.h>
 #include <px4_config.h>
 #include <px4_spi.h>
+#include <px4_workqueue.h>
 #include <string.h>
+#include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <systemlib/err.h>
 #include <errno.h>
+#include <pthread.h>
 #include <semaphore.h>
 
 #include <sys/stat.h>
@@ -60,6 +63,7 @@
 #include <drivers/drv_hrt.h>
 
 #include "systemlib/param/param.h"
+#include "systemlib/mavlink_log.h"
 #include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
 
@@ -83,6 +87,31 @@
 #define PARAM_CLOSE	close
 #endif
 
+/**
+ * Size of the buffer staging parameter file reads and writes. A typical
+ * parameter set fits in a few blocks, instead of three syscalls per parameter.
+ */
+#define PARAM_FILE_BUFSIZE	1024
+
+/**
+ * Journal record, appended to the default parameter file after the BSON
+ * document and followed by a BSON document of the values changed since the
+ * previous save.
+ */
+struct param_journal_header_s {
+	uint32_t	magic;
+	uint32_t	length;		/**< size of the BSON document following the header */
+	uint32_t	crc;		/**< crc32part() of the BSON document */
+};
+
+#define PARAM_JOURNAL_MAGIC	0x4c4e4a50	/* "PJNL" */
+
+/** journal size after which the default file is rewritten in full */
+#define PARAM_JOURNAL_MAX	4096
+
+/** time after the first of a burst of changes until it is saved (us) */
+#define PARAM_AUTOSAVE_DELAY	300000
+
 /**
  * Array of static parameter info.
  */
@@ -143,6 +172,59 @@ ORB_DEFINE(parameter_update, struct parameter_update_s);
 /** parameter update topic handle */
 static orb_advert_t param_topic = NULL;
 
+/** serialises writes to the default file, and protects the journal state */
+static pthread_mutex_t param_save_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** the default file holds all saved values, so changes may be appended to it */
+static bool param_journal_valid = false;
+
+/** size of the journal records in the default file */
+static size_t param_journal_size = 0;
+
+/** critical messages of the autosave worker */
+static orb_advert_t param_mavlink_log_pub = NULL;
+
+/** autosave state, protected by param_autosave_mutex */
+static pthread_mutex_t param_autosave_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct work_s param_autosave_work;
+static bool param_autosave_enabled = false;
+static bool param_autosave_scheduled = false;
+
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+#define PARAM_SHM_SUPPORTED
+#include "param_shm.h"
+
+/** interval at which the changes of other processes are looked for (us) */
+#define PARAM_SHM_POLL_INTERVAL	100000
+
+/** the values shared with other processes, NULL unless param_share() was called */
+static struct param_shm_s *param_shm = NULL;
+
+/** this process created the shared values and saves all changes */
+static bool param_shm_primary = false;
+
+/** the generation and the value sequences last taken from the shared values */
+static uint32_t param_shm_generation_seen;
+static uint32_t *param_shm_seen = NULL;
+
+/**
+ * Serialises storing and publishing shared values, so the other processes see
+ * the values in the order they were stored in this one. param_lock() does not.
+ */
+static pthread_mutex_t param_shm_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static struct work_s param_shm_work;
+
+static bool param_shared(param_t param);
+static void param_shm_publish(param_t param, const void *val);
+#endif
+
+static void param_autosave(void);
+static void param_journal_invalidate(void);
+static int param_encode(bson_encoder_t encoder, bool only_unsaved);
+static int param_export_file(int fd, bool only_unsaved);
+static int param_import_internal(int fd, bool mark_saved, int *journal_size);
+
 static void param_set_used_internal(param_t param);
 
 static param_t param_find_internal(const char *name, bool notification);
@@ -484,6 +566,20 @@ param_get(param_t param, void *val)
 {
 	int result = -1;
 
+#ifdef PARAM_SHM_SUPPORTED
+
+	/* shared values are read without locking */
+	if (val != NULL && param_shared(param)) {
+		uint32_t value;
+		bool set;
+
+		param_shm_read(param_shm, param, &value, &set);
+		memcpy(val, set ? (const void *)&value : (const void *)&param_info_base[param].val, sizeof(value));
+		return 0;
+	}
+
+#endif
+
 	param_lock();
 
 	const void *v = param_get_value_ptr(param);
@@ -498,11 +594,15 @@ param_get(param_t param, void *val)
 	return result;
 }
 
+/**
+ * Store a parameter value in this process.
+ *
+ * @return 0 on success, -1 on error
+ */
 static int
-param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_changes, bool is_saved)
+param_store_value(param_t param, const void *val, bool mark_saved)
 {
 	int result = -1;
-	bool params_changed = false;
 
 	param_lock();
 
@@ -565,19 +665,43 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 		}
 
 		s->unsaved = !mark_saved;
-		params_changed = true;
 		result = 0;
 	}
 
 out:
 	param_unlock();
 
+	return result;
+}
+
+static int
+param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_changes, bool is_saved)
+{
+#ifdef PARAM_SHM_SUPPORTED
+	pthread_mutex_lock(&param_shm_mutex);
+#endif
+
+	int result = param_store_value(param, val, mark_saved);
+
+#ifdef PARAM_SHM_SUPPORTED
+
+	if (result == 0) {
+		param_shm_publish(param, val);
+	}
+
+	pthread_mutex_unlock(&param_shm_mutex);
+#endif
+
 	/*
 	 * If we set something, now that we have unlocked, go ahead and advertise that
 	 * a thing has been set.
 	 */
-	if (params_changed && notify_changes) {
+	if (result == 0 && notify_changes) {
 		param_notify_changes(is_saved);
+
+		if (!mark_saved && !is_saved) {
+			param_autosave();
+		}
 	}
 
 	return result;
@@ -626,40 +750,70 @@ void param_set_used_internal(param_t param)
 		(1 << param_index % bits_per_allocation_unit);
 }
 
-int
-param_reset(param_t param)
+/**
+ * Remove the value of a parameter in this process, returning it to its default.
+ *
+ * @return true if the parameter had a value
+ */
+static bool
+param_remove_value(param_t param)
 {
 	struct param_wbuf_s *s = NULL;
-	bool param_found = false;
 
 	param_lock();
 
-	if (handle_in_range(param)) {
-
-		/* look for a saved value */
-		s = param_find_changed(param);
-
-		/* if we found one, erase it */
-		if (s != NULL) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
-		}
+	/* look for a saved value */
+	s = param_find_changed(param);
 
-		param_found = true;
+	/* if we found one, erase it */
+	if (s != NULL) {
+		int pos = utarray_eltidx(param_values, s);
+		utarray_erase(param_values, pos, 1);
 	}
 
 	param_unlock();
 
+	/* the journal cannot express a reset, the next save rewrites the file */
 	if (s != NULL) {
+		param_journal_invalidate();
+	}
+
+	return (s != NULL);
+}
+
+int
+param_reset(param_t param)
+{
+	if (!handle_in_range(param)) {
+		return 1;
+	}
+
+#ifdef PARAM_SHM_SUPPORTED
+	pthread_mutex_lock(&param_shm_mutex);
+	param_shm_publish(param, NULL);
+#endif
+
+	bool removed = param_remove_value(param);
+
+#ifdef PARAM_SHM_SUPPORTED
+	pthread_mutex_unlock(&param_shm_mutex);
+#endif
+
+	if (removed) {
 		param_notify_changes(false);
+		param_autosave();
 	}
 
-	return (!param_found);
+	return 0;
 }
 
-void
-param_reset_all(void)
+static void
+param_reset_all_internal(bool auto_save)
 {
+#ifdef PARAM_SHM_SUPPORTED
+	pthread_mutex_lock(&param_shm_mutex);
+#endif
+
 	param_lock();
 
 	if (param_values != NULL) {
@@ -671,7 +825,28 @@ param_reset_all(void)
 
 	param_unlock();
 
+#ifdef PARAM_SHM_SUPPORTED
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		param_shm_publish(param, NULL);
+	}
+
+	pthread_mutex_unlock(&param_shm_mutex);
+#endif
+
+	param_journal_invalidate();
+
 	param_notify_changes(false);
+
+	if (auto_save) {
+		param_autosave();
+	}
+}
+
+void
+param_reset_all(void)
+{
+	param_reset_all_internal(true);
 }
 
 void
@@ -721,6 +896,8 @@ param_set_default_file(const char *filename)
 		param_user_file = strdup(filename);
 	}
 
+	param_journal_invalidate();
+
 	return 0;
 }
 
@@ -730,27 +907,85 @@ param_get_default_file(void)
 	return (param_user_file != NULL) ? param_user_file : param_default_file;
 }
 
-int
-param_save_default(void)
+/**
+ * Stop appending to the default file, the next save rewrites it.
+ */
+static void
+param_journal_invalidate(void)
+{
+	pthread_mutex_lock(&param_save_mutex);
+	param_journal_valid = false;
+	pthread_mutex_unlock(&param_save_mutex);
+}
+
+/**
+ * Name of the temporary file a save writes before renaming it into place.
+ *
+ * @return allocated name, to be freed by the caller, or NULL if out of memory
+ */
+static char *
+param_tmp_name(const char *filename)
+{
+	char *tmpname = malloc(strlen(filename) + sizeof(".tmp"));
+
+	if (tmpname != NULL) {
+		strcpy(tmpname, filename);
+		strcat(tmpname, ".tmp");
+	}
+
+	return tmpname;
+}
+
+/**
+ * Write all saved values to the default file, replacing its contents.
+ */
+static int
+param_write_default(const char *filename)
 {
 	int res;
 	int fd;
 
-	const char *filename = param_get_default_file();
+	char *tmpname = NULL;
+	bool regular = false;
+
+#ifndef __PX4_QURT
+	struct stat st;
+
+	/*
+	 * Write regular files to a temporary file and rename it into place, so
+	 * an interrupted save leaves the previous parameters intact. Devices
+	 * such as the FRAM are written in place.
+	 */
+	if (stat(filename, &st) != 0 || S_ISREG(st.st_mode)) {
+		regular = true;
+		tmpname = param_tmp_name(filename);
+	}
+
+#endif
 
 	/* write parameters to temp file */
-	fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+	if (tmpname != NULL) {
+		fd = PARAM_OPEN(tmpname, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	} else {
+		/* truncate files, so no journal records of the previous contents remain */
+		fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT | (regular ? O_TRUNC : 0), PX4_O_MODE_666);
+	}
 
 	if (fd < 0) {
-		warn("failed to open param file: %s", filename);
+		warn("failed to open param file: %s", (tmpname != NULL) ? tmpname : filename);
+		free(tmpname);
 		return ERROR;
 	}
 
+	/* a reset during the save waits for it to finish, and then invalidates the new file */
+	param_journal_valid = true;
+
 	res = 1;
 	int attempts = 5;
 
 	while (res != OK && attempts > 0) {
-		res = param_export(fd, false);
+		res = param_export_file(fd, false);
 		attempts--;
 	}
 
@@ -760,6 +995,128 @@ param_save_default(void)
 
 	PARAM_CLOSE(fd);
 
+#ifndef __PX4_QURT
+
+	if (tmpname != NULL) {
+		if (res == OK) {
+			/* not all file systems replace an existing file on rename */
+			if (rename(tmpname, filename) != 0 && (unlink(filename) != 0 || rename(tmpname, filename) != 0)) {
+				warn("failed to rename %s to %s", tmpname, filename);
+				res = ERROR;
+			}
+
+		} else {
+			unlink(tmpname);
+		}
+
+		free(tmpname);
+	}
+
+#endif
+
+	if (res == OK) {
+		param_journal_size = 0;
+
+	} else {
+		param_journal_valid = false;
+	}
+
+	return res;
+}
+
+#ifndef __PX4_QURT
+
+/**
+ * Append the values changed since the last save to the default file.
+ *
+ * @return 0 on success, 1 if the journal is full, -1 on error
+ */
+static int
+param_journal_append(const char *filename)
+{
+	struct bson_encoder_s encoder;
+	struct param_journal_header_s header;
+	int result = -1;
+	int fd = -1;
+
+	/* encode the record in memory, so it is written at once */
+	bson_encoder_init_buf(&encoder, NULL, 0);
+
+	if (param_encode(&encoder, true) != 0 || bson_encoder_fini(&encoder) != 0) {
+		warnx("failed to encode parameter journal record");
+		goto out;
+	}
+
+	header.magic = PARAM_JOURNAL_MAGIC;
+	header.length = bson_encoder_buf_size(&encoder);
+	header.crc = crc32part(bson_encoder_buf_data(&encoder), header.length, 0);
+
+	/* nothing changed, just the length and the terminator */
+	if (header.length <= sizeof(int32_t) + 1) {
+		result = 0;
+		goto out;
+	}
+
+	if (param_journal_size + sizeof(header) + header.length > PARAM_JOURNAL_MAX) {
+		result = 1;
+		goto out;
+	}
+
+	fd = PARAM_OPEN(filename, O_WRONLY | O_APPEND);
+
+	if (fd < 0) {
+		warn("failed to open param file: %s", filename);
+		goto out;
+	}
+
+	if (write(fd, &header, sizeof(header)) != sizeof(header)
+	    || write(fd, bson_encoder_buf_data(&encoder), header.length) != (ssize_t)header.length
+	    || px4_fsync(fd) != 0) {
+		warn("failed to append to param file: %s", filename);
+		goto out;
+	}
+
+	param_journal_size += sizeof(header) + header.length;
+	result = 0;
+
+out:
+
+	if (fd >= 0) {
+		PARAM_CLOSE(fd);
+	}
+
+	free(bson_encoder_buf_data(&encoder));
+
+	return result;
+}
+
+#endif
+
+int
+param_save_default(void)
+{
+	int res = 1;
+	const char *filename = param_get_default_file();
+
+	pthread_mutex_lock(&param_save_mutex);
+
+#ifndef __PX4_QURT
+	struct stat st;
+
+	/* only regular files that already hold all saved values are appended to */
+	if (param_journal_valid && stat(filename, &st) == 0 && S_ISREG(st.st_mode)) {
+		res = param_journal_append(filename);
+	}
+
+#endif
+
+	/* compact a full journal, and fall back to a rewrite if the append failed */
+	if (res != OK) {
+		res = param_write_default(filename);
+	}
+
+	pthread_mutex_unlock(&param_save_mutex);
+
 	return res;
 }
 
@@ -770,29 +1127,298 @@ int
 param_load_default(void)
 {
 	warnx("param_load_default\n");
-	int fd_load = PARAM_OPEN(param_get_default_file(), O_RDONLY);
+	const char *filename = param_get_default_file();
+	char *tmpname = NULL;
+	int fd_load = PARAM_OPEN(filename, O_RDONLY);
+
+	/*
+	 * Where rename does not replace an existing file, a save removes the old
+	 * file first. A reset between the two leaves only the complete temporary
+	 * file, so load that one.
+	 */
+#ifndef __PX4_QURT
+
+	if (fd_load < 0 && errno == ENOENT) {
+		tmpname = param_tmp_name(filename);
+
+		if (tmpname != NULL) {
+			fd_load = PARAM_OPEN(tmpname, O_RDONLY);
+		}
+
+		if (fd_load < 0) {
+			free(tmpname);
+			tmpname = NULL;
+			errno = ENOENT;
+		}
+	}
+
+#endif
 
 	if (fd_load < 0) {
 		/* no parameter file is OK, otherwise this is an error */
 		if (errno != ENOENT) {
-			warn("open '%s' for reading failed", param_get_default_file());
+			warn("open '%s' for reading failed", filename);
 			return -1;
 		}
 
 		return 1;
 	}
 
-	int result = param_load(fd_load);
+	int journal_size;
+
+	param_reset_all_internal(false);
+	int result = param_import_internal(fd_load, true, &journal_size);
 	PARAM_CLOSE(fd_load);
 
+#ifndef __PX4_QURT
+
+	if (tmpname != NULL) {
+		if (result != 0) {
+			/* the first save was interrupted while writing, there are no saved parameters */
+			warnx("ignoring incomplete '%s'", tmpname);
+			free(tmpname);
+			param_reset_all_internal(false);
+			return 1;
+		}
+
+		/* finish the interrupted save */
+		warnx("recovered parameters from '%s'", tmpname);
+
+		if (rename(tmpname, filename) != 0) {
+			warn("failed to rename %s to %s", tmpname, filename);
+		}
+
+		free(tmpname);
+	}
+
+#endif
+
 	if (result != 0) {
-		warn("error reading parameters from '%s'", param_get_default_file());
+		warn("error reading parameters from '%s'", filename);
 		return -2;
 	}
 
+	/* a damaged journal is dropped by rewriting the file on the next save */
+	pthread_mutex_lock(&param_save_mutex);
+	param_journal_valid = (journal_size >= 0);
+	param_journal_size = (journal_size >= 0) ? journal_size : 0;
+	pthread_mutex_unlock(&param_save_mutex);
+
 	return 0;
 }
 
+static void
+param_autosave_worker(void *arg)
+{
+	pthread_mutex_lock(&param_autosave_mutex);
+	/* changes from now on schedule another save */
+	param_autosave_scheduled = false;
+	pthread_mutex_unlock(&param_autosave_mutex);
+
+	if (param_save_default() != OK) {
+		mavlink_and_console_log_critical(&param_mavlink_log_pub, "settings auto save error");
+	}
+}
+
+/**
+ * Schedule saving the changed parameters, unless a save is already pending.
+ */
+static void
+param_autosave(void)
+{
+#ifdef PARAM_SHM_SUPPORTED
+
+	/* the process that created the shared values saves them */
+	if (param_shm != NULL && !param_shm_primary) {
+		return;
+	}
+
+#endif
+
+	pthread_mutex_lock(&param_autosave_mutex);
+
+	if (param_autosave_enabled && !param_autosave_scheduled) {
+		param_autosave_scheduled = (work_queue(LPWORK, &param_autosave_work, param_autosave_worker, NULL,
+					    USEC2TICK(PARAM_AUTOSAVE_DELAY)) == 0);
+	}
+
+	pthread_mutex_unlock(&param_autosave_mutex);
+}
+
+void
+param_control_autosave(bool enable)
+{
+	pthread_mutex_lock(&param_autosave_mutex);
+
+	if (!enable && param_autosave_scheduled) {
+		work_cancel(LPWORK, &param_autosave_work);
+		param_autosave_scheduled = false;
+	}
+
+	param_autosave_enabled = enable;
+
+	pthread_mutex_unlock(&param_autosave_mutex);
+}
+
+#ifdef PARAM_SHM_SUPPORTED
+
+/**
+ * Test whether a parameter is shared with other processes, which
+ * is the case for all 32 bit values once param_share() was called.
+ */
+static bool
+param_shared(param_t param)
+{
+	return param_shm != NULL && (param_type(param) == PARAM_TYPE_INT32 || param_type(param) == PARAM_TYPE_FLOAT);
+}
+
+/**
+ * Publish a value set in this process to the other processes.
+ *
+ * @param val		The new value, or NULL after a reset.
+ */
+static void
+param_shm_publish(param_t param, const void *val)
+{
+	if (param_shared(param)) {
+		uint32_t value;
+
+		if (val != NULL) {
+			memcpy(&value, val, sizeof(value));
+		}
+
+		param_shm_seen[param] = param_shm_write(param_shm, param, (val != NULL) ? &value : NULL);
+	}
+}
+
+/**
+ * Take the changes of the other processes into this one.
+ *
+ * @return		True if a parameter changed.
+ */
+static bool
+param_shm_sync(void)
+{
+	bool changed = false;
+
+	/* read before the values, changes made during the scan are found by the next one */
+	uint32_t generation = param_shm_generation(param_shm);
+
+	if (generation == param_shm_generation_seen) {
+		return false;
+	}
+
+	param_shm_generation_seen = generation;
+
+	/* a value set in this process meanwhile is stored and published after the one taken here */
+	pthread_mutex_lock(&param_shm_mutex);
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		if (!param_shared(param) || param_shm_sequence(param_shm, param) == param_shm_seen[param]) {
+			continue;
+		}
+
+		uint32_t value;
+		bool set;
+
+		param_shm_seen[param] = param_shm_read(param_shm, param, &value, &set);
+
+		/* the primary has yet to save values set by other processes */
+		if (set) {
+			changed |= (param_store_value(param, &value, !param_shm_primary) == 0);
+
+		} else {
+			changed |= param_remove_value(param);
+		}
+	}
+
+	pthread_mutex_unlock(&param_shm_mutex);
+
+	return changed;
+}
+
+static void
+param_shm_worker(void *arg)
+{
+	if (param_shm_sync()) {
+		param_notify_changes(false);
+		param_autosave();
+	}
+
+	work_queue(LPWORK, &param_shm_work, param_shm_worker, NULL, USEC2TICK(PARAM_SHM_POLL_INTERVAL));
+}
+
+#endif
+
+int
+param_share(bool create)
+{
+#ifdef PARAM_SHM_SUPPORTED
+
+	if (param_shm != NULL) {
+		warnx("parameters are already shared");
+		return -1;
+	}
+
+	/* all processes have to agree on the parameter indices */
+	unsigned count = get_param_info_count();
+	uint32_t layout = 0;
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		param_type_t type = param_type(param);
+		layout = crc32part((const uint8_t *)param_name(param), strlen(param_name(param)) + 1, layout);
+		layout = crc32part((const uint8_t *)&type, sizeof(type), layout);
+	}
+
+	param_shm_seen = (uint32_t *)malloc(count * sizeof(uint32_t));
+
+	if (param_shm_seen == NULL) {
+		return -1;
+	}
+
+	struct param_shm_s *shm = param_shm_open(PARAM_SHM_NAME, count, layout, create);
+
+	if (shm == NULL) {
+		free(param_shm_seen);
+		param_shm_seen = NULL;
+		return -1;
+	}
+
+	/* no sequence is odd, so the first sync takes all values */
+	memset(param_shm_seen, 0xff, count * sizeof(uint32_t));
+	param_shm_generation_seen = param_shm_generation(shm) - 1;
+	param_shm_primary = create;
+	param_shm = shm;
+
+	if (create) {
+		/* publish the values this process already has */
+		pthread_mutex_lock(&param_shm_mutex);
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			struct param_wbuf_s *s = param_find_changed(param);
+
+			if (s != NULL) {
+				param_shm_publish(param, &s->val);
+			}
+		}
+
+		pthread_mutex_unlock(&param_shm_mutex);
+
+		param_shm_generation_seen = param_shm_generation(shm);
+
+	} else if (param_shm_sync()) {
+		param_notify_changes(false);
+	}
+
+	work_queue(LPWORK, &param_shm_work, param_shm_worker, NULL, USEC2TICK(PARAM_SHM_POLL_INTERVAL));
+
+	return 0;
+#else
+	warnx("parameters cannot be shared in this build");
+	return -1;
+#endif
+}
+
 #if defined (CONFIG_ARCH_BOARD_PX4FMU_V4)
 //struct spi_dev_s *dev = nullptr;
 irqstate_t state;
@@ -825,19 +1451,17 @@ param_bus_lock(bool lock)
 #endif
 }
 
-int
-param_export(int fd, bool only_unsaved)
+/**
+ * Append the modified parameters to a BSON document.
+ */
+static int
+param_encode(bson_encoder_t encoder, bool only_unsaved)
 {
 	struct param_wbuf_s *s = NULL;
-	struct bson_encoder_s encoder;
 	int	result = -1;
 
 	param_lock();
 
-	param_bus_lock(true);
-	bson_encoder_init_file(&encoder, fd);
-	param_bus_lock(false);
-
 	/* no modified parameters -> we are done */
 	if (param_values == NULL) {
 		result = 0;
@@ -869,7 +1493,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_INT32:
 			param_get(s->param, &i);
 
-			if (bson_encoder_append_int(&encoder, param_name(s->param), i)) {
+			if (bson_encoder_append_int(encoder, param_name(s->param), i)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				param_bus_lock(false);
 				goto out;
@@ -880,7 +1504,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_FLOAT:
 			param_get(s->param, &f);
 
-			if (bson_encoder_append_double(&encoder, param_name(s->param), f)) {
+			if (bson_encoder_append_double(encoder, param_name(s->param), f)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				param_bus_lock(false);
 				goto out;
@@ -889,7 +1513,7 @@ param_export(int fd, bool only_unsaved)
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
-			if (bson_encoder_append_binary(&encoder,
+			if (bson_encoder_append_binary(encoder,
 						       param_name(s->param),
 						       BSON_BIN_BINARY,
 						       param_size(s->param),
@@ -918,13 +1542,49 @@ param_export(int fd, bool only_unsaved)
 out:
 	param_unlock();
 
+	return result;
+}
+
+static int
+param_export_file(int fd, bool only_unsaved)
+{
+	struct bson_encoder_s encoder;
+	int	result;
+
+	/* stage the writes, or fall back to writing each parameter if there is no memory */
+	void *buf = malloc(PARAM_FILE_BUFSIZE);
+
+	param_bus_lock(true);
+
+	if (buf != NULL) {
+		bson_encoder_init_file_buffered(&encoder, fd, buf, PARAM_FILE_BUFSIZE);
+
+	} else {
+		bson_encoder_init_file(&encoder, fd);
+	}
+
+	param_bus_lock(false);
+
+	result = param_encode(&encoder, only_unsaved);
+
 	if (result == 0) {
 		result = bson_encoder_fini(&encoder);
 	}
 
+	free(buf);
+
 	return result;
 }
 
+int
+param_export(int fd, bool only_unsaved)
+{
+	/* the unsaved flags are cleared, so the default file cannot be appended to anymore */
+	param_journal_invalidate();
+
+	return param_export_file(fd, only_unsaved);
+}
+
 struct param_import_state {
 	bool mark_saved;
 };
@@ -1037,16 +1697,90 @@ out:
 	return result;
 }
 
+#ifndef __PX4_QURT
+
+/**
+ * Apply the journal records following the BSON document.
+ *
+ * @param fd		File positioned anywhere, offset is where the records start.
+ * @return		Size of the records, or -1 if a record is damaged.
+ */
+static int
+param_journal_replay(int fd, off_t offset, bool mark_saved)
+{
+	struct param_journal_header_s header;
+	int size = 0;
+
+	if (lseek(fd, offset, SEEK_SET) != offset) {
+		return -1;
+	}
+
+	for (;;) {
+		int n = read(fd, &header, sizeof(header));
+
+		if (n == 0) {
+			/* end of file after a complete record */
+			return size;
+		}
+
+		if (n != sizeof(header) || header.magic != PARAM_JOURNAL_MAGIC || header.length > PARAM_JOURNAL_MAX) {
+			return -1;
+		}
+
+		uint8_t *record = malloc(header.length);
+
+		if (record == NULL) {
+			return -1;
+		}
+
+		if (read(fd, record, header.length) != (ssize_t)header.length
+		    || crc32part(record, header.length, 0) != header.crc) {
+			free(record);
+			return -1;
+		}
+
+		struct bson_decoder_s decoder;
+		struct param_import_state state = { .mark_saved = mark_saved };
+		int result = bson_decoder_init_buf(&decoder, record, header.length, param_import_callback, &state);
+
+		while (result == 0 && (result = bson_decoder_next(&decoder)) > 0) {
+			result = 0;
+		}
+
+		free(record);
+
+		if (result < 0) {
+			return -1;
+		}
+
+		size += sizeof(header) + header.length;
+	}
+}
+
+#endif
+
 static int
-param_import_internal(int fd, bool mark_saved)
+param_import_internal(int fd, bool mark_saved, int *journal_size)
 {
 	struct bson_decoder_s decoder;
 	int result = -1;
+	int journal = -1;
 	struct param_import_state state;
 
+	/* stage the reads, or fall back to reading each field if there is no memory */
+	void *buf = malloc(PARAM_FILE_BUFSIZE);
+
 	param_bus_lock(true);
 
-	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
+	if (buf != NULL) {
+		result = bson_decoder_init_file_buffered(&decoder, fd, buf, PARAM_FILE_BUFSIZE, param_import_callback, &state);
+
+	} else {
+		result = bson_decoder_init_file(&decoder, fd, param_import_callback, &state);
+	}
+
+	if (result != 0) {
+		result = -1;
 		debug("decoder init failed");
 		param_bus_lock(false);
 		goto out;
@@ -1064,26 +1798,46 @@ param_import_internal(int fd, bool mark_saved)
 
 	} while (result > 0);
 
+#ifndef __PX4_QURT
+	struct stat st;
+
+	/* regular files may continue with journal records */
+	if (result == 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+		journal = param_journal_replay(fd, decoder.total_decoded_size, mark_saved);
+
+		if (journal < 0) {
+			warnx("ignoring damaged parameter journal");
+		}
+	}
+
+#endif
+
 out:
 
+	free(buf);
+
 	if (result < 0) {
 		debug("BSON error decoding parameters");
 	}
 
+	if (journal_size != NULL) {
+		*journal_size = journal;
+	}
+
 	return result;
 }
 
 int
 param_import(int fd)
 {
-	return param_import_internal(fd, false);
+	return param_import_internal(fd, false, NULL);
 }
 
 int
 param_load(int fd)
 {
-	param_reset_all();
-	return param_import_internal(fd, true);
+	param_reset_all_internal(false);
+	return param_import_internal(fd, true, NULL);
 }
 
 void
@@ -335,19 +335,36 @@ __EXPORT const char	*param_get_default_file(void);
 /**
  * Save parameters to the default file.
  *
- * This function saves all parameters with non-default values.
+ * This function saves all parameters with non-default values. If the default
+ * file is a regular file already holding the saved values, only the values
+ * changed since the last save are appended to it as a journal record; the
+ * file is rewritten in full once the journal grows too large or a parameter
+ * was reset.
  *
  * @return		Zero on success.
  */
 __EXPORT int 		param_save_default(void);
 
 /**
- * Load parameters from the default parameter file.
+ * Load parameters from the default parameter file, including the journal
+ * records appended by param_save_default.
  *
  * @return		Zero on success.
  */
 __EXPORT int 		param_load_default(void);
 
+/**
+ * Enable or disable the automatic saving of parameters.
+ *
+ * While enabled, a change through param_set, param_reset or param_import
+ * schedules param_save_default on the low priority work queue. Changes
+ * following each other closely are saved together.
+ *
+ * @param enable	True to save changes automatically. Disabling cancels
+ *			a pending save.
+ */
+__EXPORT void		param_control_autosave(bool enable);
+
 /**
  * Generate the hash of all parameters and their values
  *
@@ -355,6 +372,21 @@ __EXPORT int 		param_load_default(void);
  */
 __EXPORT uint32_t	param_hash_check(void);
 
+#ifdef __PX4_POSIX
+/**
+ * Share the parameter values with the other PX4 processes on this host.
+ *
+ * One process creates the shared values, before it loads the parameter file,
+ * and saves all changes. The others attach to them afterwards. Reading
+ * a 32 bit parameter then takes no lock, and a change made by any process
+ * is announced on the parameter_update topic of every process.
+ *
+ * @param create	True to create the shared values, false to attach to them.
+ * @return		Zero on success, nonzero if the values could not be shared.
+ */
+__EXPORT int		param_share(bool create);
+#endif
+
 /*
  * Macros creating static parameter definitions.
  *
@@ -0,0 +1,253 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_shm.c
+ *
+ * Parameter values shared by the PX4 processes on one POSIX host.
+ */
+
+#include <px4_defines.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <systemlib/err.h>
+
+#include "param_shm.h"
+
+#define PARAM_SHM_MAGIC		0x4d485350	/* "PSHM" */
+
+/** time to wait for the creator to initialize the segment (us) */
+#define PARAM_SHM_ATTACH_TIMEOUT	1000000
+#define PARAM_SHM_ATTACH_POLL		1000
+
+#define LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(x)		__atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELEASE(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define STORE_RELAXED(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+
+struct param_shm_header_s {
+	uint32_t	magic;		/**< set last by the creator */
+	uint32_t	count;
+	uint32_t	layout;
+	uint32_t	generation;
+};
+
+struct param_shm_slot_s {
+	uint32_t	seq;		/**< odd while the slot is written */
+	uint32_t	value;
+	uint32_t	set;		/**< zero while the parameter is at its default */
+};
+
+struct param_shm_s {
+	struct param_shm_header_s	*header;
+	struct param_shm_slot_s		*slots;
+	size_t				size;
+};
+
+static size_t
+param_shm_size(unsigned count)
+{
+	return sizeof(struct param_shm_header_s) + count * sizeof(struct param_shm_slot_s);
+}
+
+struct param_shm_s *
+param_shm_open(const char *name, unsigned count, uint32_t layout, bool create)
+{
+	size_t size = param_shm_size(count);
+	int fd;
+
+	if (create) {
+		/* values left by a previous run must not leak into this one */
+		shm_unlink(name);
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0666);
+
+		if (fd >= 0 && ftruncate(fd, size) != 0) {
+			warn("param shm: resize");
+			close(fd);
+			shm_unlink(name);
+			return NULL;
+		}
+
+	} else {
+		fd = shm_open(name, O_RDWR, 0);
+	}
+
+	if (fd < 0) {
+		warn("param shm: open %s", name);
+		return NULL;
+	}
+
+	/* the creator may not have sized the segment yet */
+	struct stat st;
+	unsigned waited = 0;
+
+	memset(&st, 0, sizeof(st));
+
+	while (fstat(fd, &st) == 0 && st.st_size == 0 && waited < PARAM_SHM_ATTACH_TIMEOUT) {
+		usleep(PARAM_SHM_ATTACH_POLL);
+		waited += PARAM_SHM_ATTACH_POLL;
+	}
+
+	if ((size_t)st.st_size != size) {
+		warnx("param shm: %s has %u bytes, expected %u", name, (unsigned)st.st_size, (unsigned)size);
+		close(fd);
+		return NULL;
+	}
+
+	void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	/* the mapping stays valid without the descriptor */
+	close(fd);
+
+	if (map == MAP_FAILED) {
+		warn("param shm: map");
+		return NULL;
+	}
+
+	struct param_shm_s *shm = (struct param_shm_s *)malloc(sizeof(struct param_shm_s));
+
+	if (shm == NULL) {
+		munmap(map, size);
+		return NULL;
+	}
+
+	shm->header = (struct param_shm_header_s *)map;
+	shm->slots = (struct param_shm_slot_s *)(shm->header + 1);
+	shm->size = size;
+
+	if (create) {
+		/* the new segment is zeroed, that is all parameters at their defaults */
+		shm->header->count = count;
+		shm->header->layout = layout;
+		STORE_RELEASE(shm->header->magic, PARAM_SHM_MAGIC);
+
+	} else {
+		while (LOAD_ACQUIRE(shm->header->magic) != PARAM_SHM_MAGIC && waited < PARAM_SHM_ATTACH_TIMEOUT) {
+			usleep(PARAM_SHM_ATTACH_POLL);
+			waited += PARAM_SHM_ATTACH_POLL;
+		}
+
+		if (LOAD_ACQUIRE(shm->header->magic) != PARAM_SHM_MAGIC ||
+		    shm->header->count != count || shm->header->layout != layout) {
+			warnx("param shm: %s was created with different parameters", name);
+			param_shm_close(shm);
+			return NULL;
+		}
+	}
+
+	return shm;
+}
+
+void
+param_shm_close(struct param_shm_s *shm)
+{
+	if (shm != NULL) {
+		munmap(shm->header, shm->size);
+		free(shm);
+	}
+}
+
+uint32_t
+param_shm_read(struct param_shm_s *shm, unsigned index, uint32_t *value, bool *set)
+{
+	struct param_shm_slot_s *slot = &shm->slots[index];
+	uint32_t seq;
+
+	for (;;) {
+		seq = LOAD_ACQUIRE(slot->seq);
+
+		if (seq & 1) {
+			/* a write is in progress, it is only a few stores long */
+			sched_yield();
+			continue;
+		}
+
+		*value = LOAD_RELAXED(slot->value);
+		*set = LOAD_RELAXED(slot->set) != 0;
+
+		/* the value reads must not move past the second sequence read */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (LOAD_RELAXED(slot->seq) == seq) {
+			return seq;
+		}
+	}
+}
+
+uint32_t
+param_shm_write(struct param_shm_s *shm, unsigned index, const uint32_t *value)
+{
+	struct param_shm_slot_s *slot = &shm->slots[index];
+	uint32_t seq;
+
+	/* writers of different processes exclude each other by making the sequence odd */
+	do {
+		seq = LOAD_RELAXED(slot->seq) & ~1u;
+	} while (!__atomic_compare_exchange_n(&slot->seq, &seq, seq + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	uint32_t new_value = (value != NULL) ? *value : 0;
+	uint32_t new_set = (value != NULL) ? 1 : 0;
+
+	if (LOAD_RELAXED(slot->value) == new_value && LOAD_RELAXED(slot->set) == new_set) {
+		/* unchanged, nobody has to be told */
+		STORE_RELEASE(slot->seq, seq);
+		return seq;
+	}
+
+	STORE_RELAXED(slot->value, new_value);
+	STORE_RELAXED(slot->set, new_set);
+	STORE_RELEASE(slot->seq, seq + 2);
+
+	__atomic_fetch_add(&shm->header->generation, 1, __ATOMIC_RELEASE);
+
+	return seq + 2;
+}
+
+uint32_t
+param_shm_sequence(struct param_shm_s *shm, unsigned index)
+{
+	return LOAD_ACQUIRE(shm->slots[index].seq);
+}
+
+uint32_t
+param_shm_generation(struct param_shm_s *shm)
+{
+	return LOAD_ACQUIRE(shm->header->generation);
+}
@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_shm.h
+ *
+ * Parameter values shared by the PX4 processes on one POSIX host.
+ *
+ * The values of the 32 bit parameters live in a POSIX shared memory
+ * segment, one slot per parameter. Each slot is guarded by a sequence
+ * counter which is odd while the slot is written, so readers never take
+ * a lock: they retry in the rare case that a write overlapped the read.
+ * Every change also increments a generation counter, which is all a
+ * process has to poll to notice changes made by the others.
+ */
+
+#ifndef _SYSTEMLIB_PARAM_PARAM_SHM_H
+#define _SYSTEMLIB_PARAM_PARAM_SHM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+__BEGIN_DECLS
+
+/** name of the shared memory segment */
+#define PARAM_SHM_NAME		"/px4_params"
+
+/** handle of an attached segment */
+struct param_shm_s;
+
+/**
+ * Attach to the shared parameter values.
+ *
+ * @param name		Name of the shared memory segment.
+ * @param count		Number of parameters.
+ * @param layout	Hash of the parameter names and types, all processes
+ *			have to be built with the same parameters.
+ * @param create	Create a new segment with all parameters at their
+ *			defaults, replacing one left by a previous run, or
+ *			attach to the segment created by another process.
+ * @return		The handle, or NULL if the segment could not be
+ *			created, does not exist or does not match.
+ */
+__EXPORT struct param_shm_s *param_shm_open(const char *name, unsigned count, uint32_t layout, bool create);
+
+/**
+ * Detach from the shared parameter values, the segment remains.
+ */
+__EXPORT void		param_shm_close(struct param_shm_s *shm);
+
+/**
+ * Read a parameter value without locking.
+ *
+ * @param index		The parameter index.
+ * @param value		The value, only valid if the parameter is set.
+ * @param set		True if the value was set, false if the parameter
+ *			is at its default.
+ * @return		The sequence of the value read.
+ */
+__EXPORT uint32_t	param_shm_read(struct param_shm_s *shm, unsigned index, uint32_t *value, bool *set);
+
+/**
+ * Write a parameter value. Writing the value the slot already holds
+ * leaves the sequence and the generation unchanged.
+ *
+ * @param index		The parameter index.
+ * @param value		The new value, or NULL to reset the parameter to its default.
+ * @return		The sequence of the value written.
+ */
+__EXPORT uint32_t	param_shm_write(struct param_shm_s *shm, unsigned index, const uint32_t *value);
+
+/**
+ * The sequence of a parameter value, which changes with every write.
+ */
+__EXPORT uint32_t	param_shm_sequence(struct param_shm_s *shm, unsigned index);
+
+/**
+ * The number of changes to any parameter since the segment was created.
+ */
+__EXPORT uint32_t	param_shm_generation(struct param_shm_s *shm);
+
+__END_DECLS
+
+#endif
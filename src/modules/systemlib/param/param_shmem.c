@@ -46,6 +46,7 @@
 //#include <debug.h>
 #include <px4_defines.h>
 #include <px4_posix.h>
+#include <px4_workqueue.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -53,6 +54,7 @@
 #include <unistd.h>
 #include <systemlib/err.h>
 #include <errno.h>
+#include <pthread.h>
 #include <semaphore.h>
 
 #include <sys/stat.h>
@@ -60,6 +62,7 @@
 #include <drivers/drv_hrt.h>
 
 #include "systemlib/param/param.h"
+#include "systemlib/mavlink_log.h"
 #include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
 
@@ -81,6 +84,11 @@
 #endif
 #define PARAM_CLOSE	close
 
+/**
+ * Size of the buffer staging parameter file reads and writes.
+ */
+#define PARAM_FILE_BUFSIZE	1024
+
 /**
  * Array of static parameter info.
  */
@@ -133,6 +141,20 @@ static int param_import_done =
 
 static int param_load_default_no_notify(void);
 
+/** time after the first of a burst of changes until it is saved (us) */
+#define PARAM_AUTOSAVE_DELAY	300000
+
+/** autosave state, protected by param_autosave_mutex */
+static pthread_mutex_t param_autosave_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct work_s param_autosave_work;
+static bool param_autosave_enabled = false;
+static bool param_autosave_scheduled = false;
+
+/** critical messages of the autosave worker */
+static orb_advert_t param_mavlink_log_pub = NULL;
+
+static void param_autosave(void);
+
 static unsigned
 get_param_info_count(void)
 {
@@ -647,6 +669,10 @@ out:
 
 	if (params_changed && notify_changes) {
 		param_notify_changes(is_saved);
+
+		if (!mark_saved && !is_saved) {
+			param_autosave();
+		}
 	}
 
 	if (result == 0 && !set_called_from_get) {
@@ -744,13 +770,14 @@ param_reset(param_t param)
 
 	if (s != NULL) {
 		param_notify_changes(false);
+		param_autosave();
 	}
 
 	return (!param_found);
 }
 
-void
-param_reset_all(void)
+static void
+param_reset_all_internal(bool auto_save)
 {
 	param_lock();
 
@@ -764,6 +791,16 @@ param_reset_all(void)
 	param_unlock();
 
 	param_notify_changes(false);
+
+	if (auto_save) {
+		param_autosave();
+	}
+}
+
+void
+param_reset_all(void)
+{
+	param_reset_all_internal(true);
 }
 
 void
@@ -877,6 +914,50 @@ exit:
 	return res;
 }
 
+static void
+param_autosave_worker(void *arg)
+{
+	pthread_mutex_lock(&param_autosave_mutex);
+	/* changes from now on schedule another save */
+	param_autosave_scheduled = false;
+	pthread_mutex_unlock(&param_autosave_mutex);
+
+	if (param_save_default() != OK) {
+		mavlink_and_console_log_critical(&param_mavlink_log_pub, "settings auto save error");
+	}
+}
+
+/**
+ * Schedule saving the changed parameters, unless a save is already pending.
+ */
+static void
+param_autosave(void)
+{
+	pthread_mutex_lock(&param_autosave_mutex);
+
+	if (param_autosave_enabled && !param_autosave_scheduled) {
+		param_autosave_scheduled = (work_queue(LPWORK, &param_autosave_work, param_autosave_worker, NULL,
+					    USEC2TICK(PARAM_AUTOSAVE_DELAY)) == 0);
+	}
+
+	pthread_mutex_unlock(&param_autosave_mutex);
+}
+
+void
+param_control_autosave(bool enable)
+{
+	pthread_mutex_lock(&param_autosave_mutex);
+
+	if (!enable && param_autosave_scheduled) {
+		work_cancel(LPWORK, &param_autosave_work);
+		param_autosave_scheduled = false;
+	}
+
+	param_autosave_enabled = enable;
+
+	pthread_mutex_unlock(&param_autosave_mutex);
+}
+
 /**
  * @return 0 on success, 1 if all params have not yet been stored, -1 if device open failed, -2 if writing parameters failed
  */
@@ -949,9 +1030,17 @@ param_export(int fd, bool only_unsaved)
 	struct bson_encoder_s encoder;
 	int	result = -1;
 
+	/* stage the writes, or fall back to writing each parameter if there is no memory */
+	void *buf = malloc(PARAM_FILE_BUFSIZE);
+
 	param_lock();
 
-	bson_encoder_init_file(&encoder, fd);
+	if (buf != NULL) {
+		bson_encoder_init_file_buffered(&encoder, fd, buf, PARAM_FILE_BUFSIZE);
+
+	} else {
+		bson_encoder_init_file(&encoder, fd);
+	}
 
 	/* no modified parameters -> we are done */
 	if (param_values == NULL) {
@@ -1028,6 +1117,8 @@ out:
 		result = bson_encoder_fini(&encoder);
 	}
 
+	free(buf);
+
 	return result;
 }
 
@@ -1152,7 +1243,18 @@ param_import_internal(int fd, bool mark_saved)
 	int result = -1;
 	struct param_import_state state;
 
-	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
+	/* stage the reads, or fall back to reading each field if there is no memory */
+	void *buf = malloc(PARAM_FILE_BUFSIZE);
+
+	if (buf != NULL) {
+		result = bson_decoder_init_file_buffered(&decoder, fd, buf, PARAM_FILE_BUFSIZE, param_import_callback, &state);
+
+	} else {
+		result = bson_decoder_init_file(&decoder, fd, param_import_callback, &state);
+	}
+
+	if (result != 0) {
+		result = -1;
 		debug("decoder init failed");
 		goto out;
 	}
@@ -1166,6 +1268,8 @@ param_import_internal(int fd, bool mark_saved)
 
 out:
 
+	free(buf);
+
 	if (result < 0) {
 		debug("BSON error decoding parameters");
 	}
@@ -1182,7 +1286,7 @@ param_import(int fd)
 int
 param_load(int fd)
 {
-	param_reset_all();
+	param_reset_all_internal(false);
 	return param_import_internal(fd, true);
 }
 
@@ -1206,6 +1310,14 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 	}
 }
 
+int
+param_share(bool create)
+{
+	/* the values are shared through the shared memory of the processors already */
+	warnx("parameters cannot be shared in this build");
+	return -1;
+}
+
 uint32_t param_hash_check(void)
 {
 	uint32_t param_hash = 0;
@@ -41,7 +41,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/queue.h>
+#include <pthread.h>
 #include <drivers/drv_hrt.h>
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
 #include <math.h>
 #include "perf_counter.h"
 
@@ -52,13 +56,35 @@
 #define ddeclare(...) __VA_ARGS__
 #endif
 
+/**
+ * Number of name hash buckets used by perf_alloc_once, must be a power of two.
+ */
+#define PERF_HASH_SIZE		32
+
+/**
+ * Histogram layout of PC_ELAPSED_HIST counters: every power of two is split
+ * into PERF_HIST_SUB_BUCKETS linear sub-buckets, which bounds the error of
+ * the reported percentiles to 25%. The last bucket collects everything
+ * above ~1.8 s.
+ */
+#define PERF_HIST_SUB_BUCKETS_LOG2	2
+#define PERF_HIST_SUB_BUCKETS		(1 << PERF_HIST_SUB_BUCKETS_LOG2)
+#define PERF_HIST_BUCKETS		80
+
+/**
+ * 32 bit atomics are lock-free on all supported targets, 64 bit ones are not
+ * (ARMv7-M has no LDREXD/STREXD), so only 32 bit fields are updated atomically.
+ */
+#define PERF_ATOMIC_INC(_x)		__atomic_fetch_add(&(_x), 1, __ATOMIC_RELAXED)
+
 /**
  * Header common to all counters.
  */
 struct perf_ctr_header {
-	sq_entry_t		link;	/**< list linkage */
-	enum perf_counter_type	type;	/**< counter type */
-	const char		*name;	/**< counter name */
+	sq_entry_t		link;		/**< list linkage */
+	struct perf_ctr_header	*hash_next;	/**< name hash bucket linkage */
+	enum perf_counter_type	type;		/**< counter type */
+	const char		*name;		/**< counter name */
 };
 
 /**
@@ -84,6 +110,14 @@ struct perf_ctr_elapsed {
 	float			M2;
 };
 
+/**
+ * PC_ELAPSED_HIST counter.
+ */
+struct perf_ctr_elapsed_hist {
+	struct perf_ctr_elapsed	elapsed;
+	uint32_t		hist[PERF_HIST_BUCKETS];
+};
+
 /**
  * PC_INTERVAL counter.
  */
@@ -99,66 +133,132 @@ struct perf_ctr_interval {
 	float			M2;
 };
 
+/**
+ * Any counter, large enough for a copy of each type.
+ */
+union perf_ctr_copy {
+	struct perf_ctr_header		hdr;
+	struct perf_ctr_count		count;
+	struct perf_ctr_elapsed		elapsed;
+	struct perf_ctr_elapsed_hist	elapsed_hist;
+	struct perf_ctr_interval	interval;
+};
+
 /**
  * List of all known counters.
  */
 static sq_queue_t	perf_counters;
 
+/**
+ * Counters hashed by name, for perf_alloc_once.
+ */
+static perf_counter_t	perf_counter_hash[PERF_HASH_SIZE];
 
-perf_counter_t
-perf_alloc(enum perf_counter_type type, const char *name)
+/**
+ * Protects the counter list and the hash table.
+ *
+ * Builds without pthreads (px4io) run a single task, which allocates its
+ * counters before it starts.
+ */
+#ifndef CONFIG_DISABLE_PTHREAD
+static pthread_mutex_t	perf_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define perf_lock()	pthread_mutex_lock(&perf_counters_mutex)
+#define perf_unlock()	pthread_mutex_unlock(&perf_counters_mutex)
+#else
+#define perf_lock()
+#define perf_unlock()
+#endif
+
+static unsigned
+perf_hash(const char *name)
 {
-	perf_counter_t ctr = NULL;
+	/* FNV-1a */
+	uint32_t hash = 2166136261u;
+
+	while (*name != '\0') {
+		hash = (hash ^ (uint8_t)*name++) * 16777619u;
+	}
+
+	return hash & (PERF_HASH_SIZE - 1);
+}
 
+static size_t
+perf_size(enum perf_counter_type type)
+{
 	switch (type) {
 	case PC_COUNT:
-		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_count), 1);
-		break;
+		return sizeof(struct perf_ctr_count);
 
 	case PC_ELAPSED:
-		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_elapsed), 1);
-		break;
+		return sizeof(struct perf_ctr_elapsed);
 
-	case PC_INTERVAL:
-		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_interval), 1);
+	case PC_ELAPSED_HIST:
+		return sizeof(struct perf_ctr_elapsed_hist);
 
-		break;
+	case PC_INTERVAL:
+		return sizeof(struct perf_ctr_interval);
 
 	default:
-		break;
+		return 0;
 	}
+}
+
+static perf_counter_t
+perf_alloc_locked(enum perf_counter_type type, const char *name)
+{
+	size_t size = perf_size(type);
+	perf_counter_t ctr = (size > 0) ? (perf_counter_t)calloc(size, 1) : NULL;
 
 	if (ctr != NULL) {
+		unsigned bucket = perf_hash(name);
+
 		ctr->type = type;
 		ctr->name = name;
+		ctr->hash_next = perf_counter_hash[bucket];
+		perf_counter_hash[bucket] = ctr;
 		sq_addfirst(&ctr->link, &perf_counters);
 	}
 
 	return ctr;
 }
 
+perf_counter_t
+perf_alloc(enum perf_counter_type type, const char *name)
+{
+	perf_lock();
+	perf_counter_t ctr = perf_alloc_locked(type, name);
+	perf_unlock();
+
+	return ctr;
+}
+
 perf_counter_t
 perf_alloc_once(enum perf_counter_type type, const char *name)
 {
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_lock();
+
+	perf_counter_t handle = perf_counter_hash[perf_hash(name)];
 
 	while (handle != NULL) {
 		if (!strcmp(handle->name, name)) {
-			if (type == handle->type) {
-				/* they are the same counter */
-				return handle;
-
-			} else {
-				/* same name but different type, assuming this is an error and not intended */
-				return NULL;
-			}
+			break;
 		}
 
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = handle->hash_next;
 	}
 
-	/* if the execution reaches here, no existing counter of that name was found */
-	return perf_alloc(type, name);
+	if (handle == NULL) {
+		/* no existing counter of that name was found */
+		handle = perf_alloc_locked(type, name);
+
+	} else if (type != handle->type) {
+		/* same name but different type, assuming this is an error and not intended */
+		handle = NULL;
+	}
+
+	perf_unlock();
+
+	return handle;
 }
 
 void
@@ -168,10 +268,101 @@ perf_free(perf_counter_t handle)
 		return;
 	}
 
+	perf_lock();
+
+	perf_counter_t *prev = &perf_counter_hash[perf_hash(handle->name)];
+
+	while (*prev != NULL && *prev != handle) {
+		prev = &(*prev)->hash_next;
+	}
+
+	if (*prev != NULL) {
+		*prev = handle->hash_next;
+	}
+
 	sq_rem(&handle->link, &perf_counters);
+
+	perf_unlock();
+
 	free(handle);
 }
 
+/**
+ * Histogram bucket of an elapsed time: values below 8 us map to themselves,
+ * above that each power of two is split into PERF_HIST_SUB_BUCKETS buckets.
+ */
+static unsigned
+perf_hist_bucket(uint64_t elapsed)
+{
+	uint32_t value = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+
+	if (value < 2 * PERF_HIST_SUB_BUCKETS) {
+		return value;
+	}
+
+	unsigned msb = 31 - __builtin_clz(value);
+	unsigned sub = (value >> (msb - PERF_HIST_SUB_BUCKETS_LOG2)) & (PERF_HIST_SUB_BUCKETS - 1);
+	unsigned bucket = (msb - PERF_HIST_SUB_BUCKETS_LOG2 + 1) * PERF_HIST_SUB_BUCKETS + sub;
+
+	return (bucket < PERF_HIST_BUCKETS) ? bucket : PERF_HIST_BUCKETS - 1;
+}
+
+/**
+ * Smallest elapsed time that falls into a histogram bucket.
+ */
+static uint32_t
+perf_hist_bucket_start(unsigned bucket)
+{
+	if (bucket < 2 * PERF_HIST_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	unsigned msb = bucket / PERF_HIST_SUB_BUCKETS + PERF_HIST_SUB_BUCKETS_LOG2 - 1;
+	unsigned sub = bucket % PERF_HIST_SUB_BUCKETS;
+
+	return (uint32_t)(PERF_HIST_SUB_BUCKETS + sub) << (msb - PERF_HIST_SUB_BUCKETS_LOG2);
+}
+
+/**
+ * Upper bound of the given percentile (in 1/1000) of a histogram counter.
+ */
+static uint32_t
+perf_hist_percentile(const struct perf_ctr_elapsed_hist *pch, unsigned permille)
+{
+	uint64_t total = 0;
+
+	for (unsigned i = 0; i < PERF_HIST_BUCKETS; i++) {
+		total += pch->hist[i];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	/* rank of the sample at the requested percentile, rounded up */
+	uint64_t rank = (total * permille + 999) / 1000;
+	uint64_t count = 0;
+
+	for (unsigned i = 0; i < PERF_HIST_BUCKETS - 1; i++) {
+		count += pch->hist[i];
+
+		if (count >= rank) {
+			return perf_hist_bucket_start(i + 1);
+		}
+	}
+
+	return perf_hist_bucket_start(PERF_HIST_BUCKETS - 1);
+}
+
+static void
+perf_hist_record(perf_counter_t handle, int64_t elapsed)
+{
+	if (handle->type == PC_ELAPSED_HIST) {
+		struct perf_ctr_elapsed_hist *pch = (struct perf_ctr_elapsed_hist *)handle;
+		PERF_ATOMIC_INC(pch->hist[perf_hist_bucket(elapsed)]);
+	}
+}
+
 void
 perf_count(perf_counter_t handle)
 {
@@ -240,6 +431,7 @@ perf_begin(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_ELAPSED:
+	case PC_ELAPSED_HIST:
 		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
 		break;
 
@@ -256,7 +448,8 @@ perf_end(perf_counter_t handle)
 	}
 
 	switch (handle->type) {
-	case PC_ELAPSED: {
+	case PC_ELAPSED:
+	case PC_ELAPSED_HIST: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
 			if (pce->time_start != 0) {
@@ -267,6 +460,8 @@ perf_end(perf_counter_t handle)
 
 				} else {
 
+					perf_hist_record(handle, elapsed);
+
 					pce->event_count++;
 					pce->time_total += elapsed;
 
@@ -306,7 +501,8 @@ perf_set(perf_counter_t handle, int64_t elapsed)
 	}
 
 	switch (handle->type) {
-	case PC_ELAPSED: {
+	case PC_ELAPSED:
+	case PC_ELAPSED_HIST: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
 			if (elapsed < 0) {
@@ -314,6 +510,8 @@ perf_set(perf_counter_t handle, int64_t elapsed)
 
 			} else {
 
+				perf_hist_record(handle, elapsed);
+
 				pce->event_count++;
 				pce->time_total += elapsed;
 
@@ -350,7 +548,8 @@ perf_cancel(perf_counter_t handle)
 	}
 
 	switch (handle->type) {
-	case PC_ELAPSED: {
+	case PC_ELAPSED:
+	case PC_ELAPSED_HIST: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
 			pce->time_start = 0;
@@ -376,13 +575,20 @@ perf_reset(perf_counter_t handle)
 		((struct perf_ctr_count *)handle)->event_count = 0;
 		break;
 
-	case PC_ELAPSED: {
+	case PC_ELAPSED:
+	case PC_ELAPSED_HIST: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 			pce->event_count = 0;
 			pce->time_start = 0;
 			pce->time_total = 0;
 			pce->time_least = 0;
 			pce->time_most = 0;
+
+			if (handle->type == PC_ELAPSED_HIST) {
+				memset(((struct perf_ctr_elapsed_hist *)handle)->hist, 0,
+				       sizeof(((struct perf_ctr_elapsed_hist *)handle)->hist));
+			}
+
 			break;
 		}
 
@@ -399,6 +605,29 @@ perf_reset(perf_counter_t handle)
 	}
 }
 
+/**
+ * Copy a counter for reading.
+ *
+ * The counters are updated without a lock, from tasks and interrupt
+ * handlers. On NuttX the copy is taken with interrupts disabled, which on
+ * a single core excludes every writer. On POSIX the writers are threads
+ * running in parallel, so the statistics of a counter updated during the
+ * copy may tear.
+ */
+static void
+perf_copy(perf_counter_t handle, union perf_ctr_copy *copy)
+{
+#ifdef __PX4_NUTTX
+	irqstate_t flags = irqsave();
+#endif
+
+	memcpy(copy, handle, perf_size(handle->type));
+
+#ifdef __PX4_NUTTX
+	irqrestore(flags);
+#endif
+}
+
 void
 perf_print_counter(perf_counter_t handle)
 {
@@ -412,15 +641,18 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 		return;
 	}
 
-	switch (handle->type) {
+	union perf_ctr_copy copy;
+	perf_copy(handle, &copy);
+
+	switch (copy.hdr.type) {
 	case PC_COUNT:
 		dprintf(fd, "%s: %llu events\n",
 			handle->name,
-			(unsigned long long)((struct perf_ctr_count *)handle)->event_count);
+			(unsigned long long)copy.count.event_count);
 		break;
 
 	case PC_ELAPSED: {
-			ddeclare(struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;)
+			ddeclare(const struct perf_ctr_elapsed *pce = &copy.elapsed;)
 			ddeclare(float rms = sqrtf(pce->M2 / (pce->event_count - 1));)
 			dprintf(fd, "%s: %llu events, %llu overruns, %lluus elapsed, %lluus avg, min %lluus max %lluus %5.3fus rms\n",
 				handle->name,
@@ -434,8 +666,24 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 			break;
 		}
 
+	case PC_ELAPSED_HIST: {
+			ddeclare(const struct perf_ctr_elapsed *pce = &copy.elapsed;)
+			ddeclare(const struct perf_ctr_elapsed_hist *pch = &copy.elapsed_hist;)
+			dprintf(fd, "%s: %llu events, %llu overruns, %lluus avg, min %lluus max %lluus, p50 %uus p99 %uus p999 %uus\n",
+				handle->name,
+				(unsigned long long)pce->event_count,
+				(unsigned long long)pce->event_overruns,
+				pce->event_count == 0 ? 0 : (unsigned long long)pce->time_total / pce->event_count,
+				(unsigned long long)pce->time_least,
+				(unsigned long long)pce->time_most,
+				(unsigned)perf_hist_percentile(pch, 500),
+				(unsigned)perf_hist_percentile(pch, 990),
+				(unsigned)perf_hist_percentile(pch, 999));
+			break;
+		}
+
 	case PC_INTERVAL: {
-			ddeclare(struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;)
+			ddeclare(const struct perf_ctr_interval *pci = &copy.interval;)
 			ddeclare(float rms = sqrtf(pci->M2 / (pci->event_count - 1));)
 
 			dprintf(fd, "%s: %llu events, %lluus avg, min %lluus max %lluus %5.3fus rms\n",
@@ -460,19 +708,19 @@ perf_event_count(perf_counter_t handle)
 		return 0;
 	}
 
-	switch (handle->type) {
+	union perf_ctr_copy copy;
+	perf_copy(handle, &copy);
+
+	switch (copy.hdr.type) {
 	case PC_COUNT:
-		return ((struct perf_ctr_count *)handle)->event_count;
+		return copy.count.event_count;
 
-	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			return pce->event_count;
-		}
+	case PC_ELAPSED:
+	case PC_ELAPSED_HIST:
+		return copy.elapsed.event_count;
 
-	case PC_INTERVAL: {
-			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			return pci->event_count;
-		}
+	case PC_INTERVAL:
+		return copy.interval.event_count;
 
 	default:
 		break;
@@ -484,18 +732,78 @@ perf_event_count(perf_counter_t handle)
 void
 perf_print_all(int fd)
 {
+	perf_lock();
+
 	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
 
 	while (handle != NULL) {
 		perf_print_counter_fd(fd, handle);
 		handle = (perf_counter_t)sq_next(&handle->link);
 	}
+
+	perf_unlock();
 }
 
 extern const uint16_t latency_bucket_count;
 extern uint32_t latency_counters[];
 extern const uint16_t latency_buckets[];
 
+void
+perf_iterate_all(perf_iterate_callback cb, void *user)
+{
+	perf_lock();
+
+	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+
+	while (handle != NULL) {
+		union perf_ctr_copy copy;
+		perf_copy(handle, &copy);
+
+		struct perf_counter_stats stats = {};
+		stats.name = handle->name;
+		stats.type = handle->type;
+
+		switch (handle->type) {
+		case PC_COUNT:
+			stats.event_count = copy.count.event_count;
+			break;
+
+		case PC_ELAPSED:
+		case PC_ELAPSED_HIST: {
+				const struct perf_ctr_elapsed *pce = &copy.elapsed;
+				stats.event_count = pce->event_count;
+				stats.event_overruns = pce->event_overruns;
+				stats.time_avg = (pce->event_count == 0) ? 0 : pce->time_total / pce->event_count;
+				stats.time_least = pce->time_least;
+				stats.time_most = pce->time_most;
+
+				if (handle->type == PC_ELAPSED_HIST) {
+					stats.time_p99 = perf_hist_percentile(&copy.elapsed_hist, 990);
+				}
+
+				break;
+			}
+
+		case PC_INTERVAL: {
+				const struct perf_ctr_interval *pci = &copy.interval;
+				stats.event_count = pci->event_count;
+				stats.time_avg = (pci->event_count == 0) ? 0 : (pci->time_last - pci->time_first) / pci->event_count;
+				stats.time_least = pci->time_least;
+				stats.time_most = pci->time_most;
+				break;
+			}
+
+		default:
+			break;
+		}
+
+		cb(&stats, user);
+		handle = (perf_counter_t)sq_next(&handle->link);
+	}
+
+	perf_unlock();
+}
+
 void
 perf_print_latency(int fd)
 {
@@ -512,6 +820,8 @@ perf_print_latency(int fd)
 void
 perf_reset_all(void)
 {
+	perf_lock();
+
 	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
 
 	while (handle != NULL) {
@@ -519,6 +829,8 @@ perf_reset_all(void)
 		handle = (perf_counter_t)sq_next(&handle->link);
 	}
 
+	perf_unlock();
+
 	for (int i = 0; i <= latency_bucket_count; i++) {
 		latency_counters[i] = 0;
 	}
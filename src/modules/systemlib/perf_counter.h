@@ -48,12 +48,32 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_ELAPSED_HIST		/**< PC_ELAPSED that also keeps a log-scale histogram for percentiles */
 };
 
 struct perf_ctr_header;
 typedef struct perf_ctr_header	*perf_counter_t;
 
+/**
+ * Snapshot of a counter, as passed to perf_iterate_all callbacks.
+ *
+ * Time values are in microseconds. For PC_INTERVAL counters they describe
+ * the interval between events, for PC_COUNT counters they are zero.
+ */
+struct perf_counter_stats {
+	const char		*name;
+	enum perf_counter_type	type;
+	uint64_t		event_count;
+	uint64_t		event_overruns;
+	uint64_t		time_avg;
+	uint64_t		time_least;
+	uint64_t		time_most;
+	uint32_t		time_p99;	/**< 99th percentile, PC_ELAPSED_HIST only */
+};
+
+typedef void (*perf_iterate_callback)(const struct perf_counter_stats *stats, void *user);
+
 __BEGIN_DECLS
 
 /**
@@ -69,6 +89,9 @@ __EXPORT extern perf_counter_t	perf_alloc(enum perf_counter_type type, const cha
 /**
  * Get the reference to an existing counter or create a new one if it does not exist.
  *
+ * Counters are looked up by name through a hash table, so this is cheap
+ * regardless of the number of registered counters.
+ *
  * @param type			The type of the counter.
  * @param name			The counter name.
  * @return			Handle for the counter, or NULL if a counter
@@ -165,6 +188,17 @@ __EXPORT extern void		perf_print_counter_fd(int fd, perf_counter_t handle);
  */
 __EXPORT extern void		perf_print_all(int fd);
 
+/**
+ * Call a function with a snapshot of every performance counter.
+ *
+ * The counter list is locked while iterating, so the callback must not
+ * allocate or free counters.
+ *
+ * @param cb			Function called once per counter.
+ * @param user			Opaque pointer passed to cb.
+ */
+__EXPORT extern void		perf_iterate_all(perf_iterate_callback cb, void *user);
+
 /**
  * Print hrt latency counters.
  *
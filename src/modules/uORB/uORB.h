@@ -326,6 +326,40 @@ extern int	orb_copy(const struct orb_metadata *meta, int handle, void *buffer) _
  */
 extern int	orb_check(int handle, bool *updated) __EXPORT;
 
+/**
+ * Maximum number of subscriptions that can be checked by one orb_check_many call.
+ */
+#define ORB_CHECK_MANY_MAX	32
+
+/**
+ * One subscription checked by orb_check_many.
+ */
+struct orb_check_item {
+	const struct orb_metadata *meta;	/**< topic metadata, only needed if buffer is set */
+	int handle;				/**< handle returned from orb_subscribe */
+	void *buffer;				/**< buffer the topic is copied to if updated, or NULL */
+};
+
+/**
+ * Check a set of subscriptions for updates in a single call.
+ *
+ * This is equivalent to calling orb_check on every item and orb_copy on every
+ * updated item that has a buffer, but batches the update check into one
+ * operation. Modules that check many topics every iteration should prefer it
+ * over individual orb_check/orb_copy pairs.
+ *
+ * Items without a buffer are only checked; their update flag is left set
+ * until they are copied with orb_copy.
+ *
+ * @param items		Array of subscriptions to check.
+ * @param count		Number of items, at most ORB_CHECK_MANY_MAX.
+ * @param updated	Returns a bitmask where bit i is set if items[i] has been
+ *			updated since the last time it was copied.
+ * @return		OK if all checks and copies succeeded, ERROR otherwise with
+ *			errno set accordingly. The bitmask is valid in both cases.
+ */
+extern int	orb_check_many(const struct orb_check_item *items, unsigned count, uint32_t *updated) __EXPORT;
+
 /**
  * Return the last time that the topic was updated.
  *
@@ -44,6 +44,7 @@
 #include <stdlib.h>
 
 std::map<std::string, uORB::DeviceNode *> uORB::DeviceMaster::_node_map;
+pthread_mutex_t uORB::DeviceMaster::_node_map_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 
 uORB::DeviceNode::SubscriberData  *uORB::DeviceNode::filp_to_sd(device::file_t *filp)
@@ -659,7 +660,9 @@ uORB::DeviceMaster::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 				} else {
 					// add to the node map;.
+					pthread_mutex_lock(&_node_map_mutex);
 					_node_map[std::string(nodepath)] = node;
+					pthread_mutex_unlock(&_node_map_mutex);
 				}
 
 
@@ -688,9 +691,35 @@ uORB::DeviceNode *uORB::DeviceMaster::GetDeviceNode(const char *nodepath)
 	uORB::DeviceNode *rc = nullptr;
 	std::string np(nodepath);
 
+	pthread_mutex_lock(&_node_map_mutex);
+
 	if (_node_map.find(np) != _node_map.end()) {
 		rc = _node_map[np];
 	}
 
+	pthread_mutex_unlock(&_node_map_mutex);
+
 	return rc;
 }
+
+unsigned uORB::DeviceMaster::GetTopicStats(TopicStats *stats, unsigned max)
+{
+	unsigned count = 0;
+
+	pthread_mutex_lock(&_node_map_mutex);
+
+	for (auto it = _node_map.begin(); it != _node_map.end(); ++it, ++count) {
+		if (count < max) {
+			const uORB::DeviceNode *node = it->second;
+			stats[count].path = it->first.c_str();
+			stats[count].generation = node->published_message_count();
+			stats[count].last_update = node->last_update();
+			stats[count].subscriber_count = node->subscriber_count();
+			stats[count].size = node->get_meta()->o_size;
+		}
+	}
+
+	pthread_mutex_unlock(&_node_map_mutex);
+
+	return count;
+}
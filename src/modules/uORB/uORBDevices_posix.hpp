@@ -37,6 +37,7 @@
 #include <stdint.h>
 #include <string>
 #include <map>
+#include <pthread.h>
 #include "uORBCommon.hpp"
 
 namespace uORB
@@ -103,6 +104,14 @@ public:
 	 * and publish to this node or if another node should be tried. */
 	bool is_published();
 
+	/**
+	 * Accessors for statistics reporting.
+	 */
+	const struct orb_metadata *get_meta() const { return _meta; }
+	unsigned published_message_count() const { return _generation; }
+	hrt_abstime last_update() const { return _last_update; }
+	int32_t subscriber_count() const { return _subscriber_count; }
+
 protected:
 	virtual pollevent_t poll_state(device::file_t *filp);
 	virtual void    poll_notify_one(px4_pollfd_struct_t *fds, pollevent_t events);
@@ -170,10 +179,28 @@ public:
 
 	static uORB::DeviceNode *GetDeviceNode(const char *node_name);
 
+	struct TopicStats {
+		const char *path;		/**< node path, e.g. /obj/sensor_gyro0 */
+		unsigned generation;		/**< number of messages published so far */
+		hrt_abstime last_update;	/**< time of the last publication */
+		int32_t subscriber_count;
+		uint16_t size;			/**< message size */
+	};
+
+	/**
+	 * Snapshot the statistics of all topic nodes.
+	 *
+	 * @param stats    Array receiving one entry per node.
+	 * @param max      Capacity of stats.
+	 * @return         Total number of nodes, which may exceed max.
+	 */
+	static unsigned GetTopicStats(TopicStats *stats, unsigned max);
+
 	virtual int   ioctl(device::file_t *filp, int cmd, unsigned long arg);
 private:
 	Flavor      _flavor;
 	static std::map<std::string, uORB::DeviceNode *> _node_map;
+	static pthread_mutex_t _node_map_mutex;
 };
 
 #endif /* _uORBDeviceNode_posix.hpp */
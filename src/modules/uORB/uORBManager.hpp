@@ -240,6 +240,22 @@ public:
 	 */
 	int  orb_check(int handle, bool *updated) ;
 
+	/**
+	 * Check a set of subscriptions for updates in a single call.
+	 *
+	 * This is equivalent to calling orb_check on every item and orb_copy on every
+	 * updated item that has a buffer, but batches the update check into one
+	 * operation.
+	 *
+	 * @param items   Array of subscriptions to check.
+	 * @param count   Number of items, at most ORB_CHECK_MANY_MAX.
+	 * @param updated Returns a bitmask where bit i is set if items[i] has been
+	 *      updated since the last time it was copied.
+	 * @return    OK if all checks and copies succeeded, ERROR otherwise with
+	 *      errno set accordingly.
+	 */
+	int  orb_check_many(const struct orb_check_item *items, unsigned count, uint32_t *updated) ;
+
 	/**
 	 * Return the last time that the topic was updated.
 	 *
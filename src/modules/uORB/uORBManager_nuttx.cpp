@@ -37,6 +37,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 #include "uORBUtils.hpp"
 #include "uORBManager.hpp"
 
@@ -161,6 +162,50 @@ int uORB::Manager::orb_check(int handle, bool *updated)
 	return ioctl(handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)updated);
 }
 
+int uORB::Manager::orb_check_many(const struct orb_check_item *items, unsigned count, uint32_t *updated)
+{
+	*updated = 0;
+
+	if (count > ORB_CHECK_MANY_MAX) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	if (count == 0) {
+		return OK;
+	}
+
+	/* a subscription polls readable exactly when ORBIOCUPDATED would report it,
+	 * so a single non-blocking poll checks all of them in one system call */
+	struct pollfd fds[ORB_CHECK_MANY_MAX];
+
+	for (unsigned i = 0; i < count; i++) {
+		fds[i].fd = items[i].handle;
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+
+	if (poll(fds, count, 0) < 0) {
+		return ERROR;
+	}
+
+	int ret = OK;
+
+	for (unsigned i = 0; i < count; i++) {
+		if (!(fds[i].revents & POLLIN)) {
+			continue;
+		}
+
+		*updated |= (1u << i);
+
+		if (items[i].buffer != nullptr && orb_copy(items[i].meta, items[i].handle, items[i].buffer) != OK) {
+			ret = ERROR;
+		}
+	}
+
+	return ret;
+}
+
 int uORB::Manager::orb_stat(int handle, uint64_t *time)
 {
 	return ioctl(handle, ORBIOCLASTUPDATE, (unsigned long)(uintptr_t)time);
@@ -169,6 +169,41 @@ int uORB::Manager::orb_check(int handle, bool *updated)
 	return px4_ioctl(handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)updated);
 }
 
+int uORB::Manager::orb_check_many(const struct orb_check_item *items, unsigned count, uint32_t *updated)
+{
+	*updated = 0;
+
+	if (count > ORB_CHECK_MANY_MAX) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	/* px4_poll() allocates a semaphore and sets up every node even for a zero
+	 * timeout, so the virtual device ioctl is the cheaper check here */
+	int ret = PX4_OK;
+
+	for (unsigned i = 0; i < count; i++) {
+		bool item_updated = false;
+
+		if (px4_ioctl(items[i].handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)&item_updated) < 0) {
+			ret = ERROR;
+			continue;
+		}
+
+		if (!item_updated) {
+			continue;
+		}
+
+		*updated |= (1u << i);
+
+		if (items[i].buffer != nullptr && orb_copy(items[i].meta, items[i].handle, items[i].buffer) != PX4_OK) {
+			ret = ERROR;
+		}
+	}
+
+	return ret;
+}
+
 int uORB::Manager::orb_stat(int handle, uint64_t *time)
 {
 	return px4_ioctl(handle, ORBIOCLASTUPDATE, (unsigned long)(uintptr_t)time);
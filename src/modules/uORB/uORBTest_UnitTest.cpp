@@ -158,6 +158,12 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
+	ret = test_check_many();
+
+	if (ret != OK) {
+		return ret;
+	}
+
 	return OK;
 }
 
@@ -392,6 +398,76 @@ int uORBTest::UnitTest::test_multi_reversed()
 	return test_note("PASS multi-topic reversed");
 }
 
+int uORBTest::UnitTest::test_check_many()
+{
+	test_note("try batched update check");
+
+	struct orb_test t, u;
+	struct orb_test_medium m;
+	uint32_t updated;
+
+	t.val = 10;
+	m.val = 20;
+	m.time = hrt_absolute_time();
+
+	orb_advert_t ptopic = orb_advertise(ORB_ID(orb_test), &t);
+	orb_advert_t pmedium = orb_advertise(ORB_ID(orb_test_medium), &m);
+
+	if (ptopic == nullptr || pmedium == nullptr) {
+		return test_fail("advertise failed: %d", errno);
+	}
+
+	int sfd0 = orb_subscribe(ORB_ID(orb_test));
+	int sfd1 = orb_subscribe(ORB_ID(orb_test_medium));
+
+	/* the second item is only checked, never copied */
+	const struct orb_check_item items[] = {
+		{ORB_ID(orb_test), sfd0, &u},
+		{ORB_ID(orb_test_medium), sfd1, nullptr}
+	};
+
+	u.val = 0;
+
+	if (PX4_OK != orb_check_many(items, 2, &updated)) {
+		return test_fail("check_many(1) failed: %d", errno);
+	}
+
+	if (updated != 0x3) {
+		return test_fail("check_many(1) mask: 0x%x expected 0x3", updated);
+	}
+
+	if (u.val != t.val) {
+		return test_fail("check_many(1) copy mismatch: %d expected %d", u.val, t.val);
+	}
+
+	if (PX4_OK != orb_check_many(items, 2, &updated)) {
+		return test_fail("check_many(2) failed: %d", errno);
+	}
+
+	if (updated != 0x2) {
+		return test_fail("check_many(2) mask: 0x%x expected 0x2", updated);
+	}
+
+	t.val = 11;
+
+	if (PX4_OK != orb_publish(ORB_ID(orb_test), ptopic, &t)) {
+		return test_fail("publish failed");
+	}
+
+	if (PX4_OK != orb_check_many(items, 2, &updated)) {
+		return test_fail("check_many(3) failed: %d", errno);
+	}
+
+	if (updated != 0x3 || u.val != t.val) {
+		return test_fail("check_many(3) mask: 0x%x val: %d", updated, u.val);
+	}
+
+	orb_unsubscribe(sfd0);
+	orb_unsubscribe(sfd1);
+
+	return test_note("PASS batched update check");
+}
+
 int uORBTest::UnitTest::test_fail(const char *fmt, ...)
 {
 	va_list ap;
@@ -90,6 +90,7 @@ private:
 	int test_single();
 	int test_multi();
 	int test_multi_reversed();
+	int test_check_many();
 
 	int test_fail(const char *fmt, ...);
 	int test_note(const char *fmt, ...);
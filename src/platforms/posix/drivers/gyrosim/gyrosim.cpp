@@ -103,6 +103,13 @@ using namespace DriverFramework;
 
 #define GYROSIM_GYRO_DEFAULT_RATE	400
 
+/* FIFO mode: the gyro output rate with the DLPF disabled, read in bursts at up to 1 kHz */
+#define GYROSIM_FIFO_MAX_RATE		8000
+#define GYROSIM_FIFO_WAKEUP_RATE	1000
+
+/* a delayed wakeup can complete several integrals, keep them all */
+#define GYROSIM_FIFO_QUEUE_DEPTH	8
+
 #define GYROSIM_ONE_G			9.80665f
 
 #ifdef PX4_SPI_BUS_EXT
@@ -121,7 +128,7 @@ class GYROSIM_gyro;
 class GYROSIM : public VirtDevObj
 {
 public:
-	GYROSIM(const char *path_accel, const char *path_gyro, enum Rotation rotation);
+	GYROSIM(const char *path_accel, const char *path_gyro, enum Rotation rotation, unsigned fifo_rate);
 	virtual ~GYROSIM();
 
 	int             	init();
@@ -172,6 +179,7 @@ private:
 	perf_counter_t		_good_transfers;
 	perf_counter_t		_reset_retries;
 	perf_counter_t		_controller_latency_perf;
+	perf_counter_t		_fifo_overflows;
 
 	Integrator _accel_int;
 	Integrator _gyro_int;
@@ -181,6 +189,10 @@ private:
 	// last temperature reading for print_info()
 	float			_last_temperature;
 
+	unsigned		_fifo_rate;	/** FIFO sample rate requested at start, 0 to read the data registers */
+	unsigned		_fifo_interval;	/** current FIFO sample interval */
+	simulator::RawMPUData	_fifo_buf[simulator::MPUFIFO::SIZE];
+
 	/**
 	 * Reset chip.
 	 *
@@ -193,6 +205,21 @@ private:
 	 */
 	virtual void		_measure();
 
+	/**
+	 * Drain the FIFO and integrate every sample in it.
+	 */
+	void			_measure_fifo();
+
+	/**
+	 * Convert and integrate one sample, queue and publish the reports.
+	 *
+	 * @param sample	The sample in SI units.
+	 * @param timestamp	Time the sample was taken.
+	 * @param queue		Queue the reports even if no integral was completed.
+	 * @return		true if the sample completed an integral.
+	 */
+	bool			_process_sample(const simulator::RawMPUData &sample, hrt_abstime timestamp, bool queue);
+
 	/**
 	 * Read a register from the GYROSIM
 	 *
@@ -308,7 +335,7 @@ private:
 /** driver 'main' command */
 extern "C" { __EXPORT int gyrosim_main(int argc, char *argv[]); }
 
-GYROSIM::GYROSIM(const char *path_accel, const char *path_gyro, enum Rotation rotation) :
+GYROSIM::GYROSIM(const char *path_accel, const char *path_gyro, enum Rotation rotation, unsigned fifo_rate) :
 	VirtDevObj("GYROSIM", path_accel, ACCEL_BASE_DEVICE_PATH, 1e6 / 400),
 	_gyro(new GYROSIM_gyro(this, path_gyro)),
 	_product(GYROSIMES_REV_C4),
@@ -329,11 +356,15 @@ GYROSIM::GYROSIM(const char *path_accel, const char *path_gyro, enum Rotation ro
 	_sample_perf(perf_alloc(PC_ELAPSED, "gyrosim_read")),
 	_good_transfers(perf_alloc(PC_COUNT, "gyrosim_good_transfers")),
 	_reset_retries(perf_alloc(PC_COUNT, "gyrosim_reset_retries")),
-	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency")),
+	_controller_latency_perf(perf_alloc_once(PC_ELAPSED_HIST, "ctrl_latency")),
+	_fifo_overflows(perf_alloc(PC_COUNT, "gyrosim_fifo_overflows")),
 	_accel_int(1000000 / GYROSIM_ACCEL_DEFAULT_RATE, true),
 	_gyro_int(1000000 / GYROSIM_GYRO_DEFAULT_RATE, true),
 	_rotation(rotation),
-	_last_temperature(0)
+	_last_temperature(0),
+	_fifo_rate(fifo_rate),
+	_fifo_interval(0),
+	_fifo_buf{}
 {
 
 	m_id.dev_id_s.bus = 1;
@@ -382,6 +413,7 @@ GYROSIM::~GYROSIM()
 	perf_free(_accel_reads);
 	perf_free(_gyro_reads);
 	perf_free(_good_transfers);
+	perf_free(_fifo_overflows);
 }
 
 int
@@ -403,14 +435,14 @@ GYROSIM::init()
 	}
 
 	/* allocate basic report buffers */
-	_accel_reports = new ringbuffer::RingBuffer(2, sizeof(accel_report));
+	_accel_reports = new ringbuffer::RingBuffer(_fifo_rate ? GYROSIM_FIFO_QUEUE_DEPTH : 2, sizeof(accel_report));
 
 	if (_accel_reports == nullptr) {
 		PX4_WARN("_accel_reports creation failed");
 		goto out;
 	}
 
-	_gyro_reports = new ringbuffer::RingBuffer(2, sizeof(gyro_report));
+	_gyro_reports = new ringbuffer::RingBuffer(_fifo_rate ? GYROSIM_FIFO_QUEUE_DEPTH : 2, sizeof(gyro_report));
 
 	if (_gyro_reports == nullptr) {
 		PX4_WARN("_gyro_reports creation failed");
@@ -447,6 +479,10 @@ GYROSIM::init()
 		return ret;
 	}
 
+	if (_fifo_rate != 0) {
+		_set_sample_rate(_fifo_rate);
+	}
+
 	ret = start();
 
 	if (ret != OK) {
@@ -539,7 +575,40 @@ GYROSIM::_set_sample_rate(unsigned desired_sample_rate_hz)
 	if (desired_sample_rate_hz == 0 ||
 	    desired_sample_rate_hz == GYRO_SAMPLERATE_DEFAULT ||
 	    desired_sample_rate_hz == ACCEL_SAMPLERATE_DEFAULT) {
-		desired_sample_rate_hz = GYROSIM_GYRO_DEFAULT_RATE;
+		desired_sample_rate_hz = (_fifo_rate != 0) ? _fifo_rate : GYROSIM_GYRO_DEFAULT_RATE;
+	}
+
+	if (_fifo_rate != 0) {
+		Simulator *sim = Simulator::getInstance();
+
+		if (sim == nullptr) {
+			PX4_WARN("failed accessing simulator");
+			return;
+		}
+
+		unsigned fifo_div = GYROSIM_FIFO_MAX_RATE / desired_sample_rate_hz;
+
+		if (fifo_div > 200) { fifo_div = 200; }
+
+		if (fifo_div < 1) { fifo_div = 1; }
+
+		write_reg(MPUREG_SMPLRT_DIV, fifo_div - 1);
+
+		unsigned fifo_rate = GYROSIM_FIFO_MAX_RATE / fifo_div;
+		_fifo_interval = 1000000 / fifo_rate;
+		sim->configureMPUFIFO(_fifo_interval);
+
+		/* wake up once per sample, but no more than GYROSIM_FIFO_WAKEUP_RATE */
+		unsigned wakeup_interval = 1000000 / GYROSIM_FIFO_WAKEUP_RATE;
+
+		if (wakeup_interval < _fifo_interval) {
+			wakeup_interval = _fifo_interval;
+		}
+
+		PX4_INFO("GYROSIM: FIFO sampling at %uHz, read at %uHz", fifo_rate, 1000000 / wakeup_interval);
+		setSampleInterval(wakeup_interval);
+		_gyro->setSampleInterval(wakeup_interval);
+		return;
 	}
 
 	uint8_t div = 1000 / desired_sample_rate_hz;
@@ -827,7 +896,7 @@ GYROSIM::devIOCTL(unsigned long cmd, unsigned long arg)
 		return _accel_reports->size();
 
 	case ACCELIOCGSAMPLERATE:
-		return 1e6 / m_sample_interval_usecs;
+		return 1e6 / (_fifo_interval ? _fifo_interval : m_sample_interval_usecs);
 
 	case ACCELIOCSSAMPLERATE:
 		_set_sample_rate(arg);
@@ -898,7 +967,7 @@ GYROSIM::gyro_ioctl(unsigned long cmd, unsigned long arg)
 		return _gyro_reports->size();
 
 	case GYROIOCGSAMPLERATE:
-		return 1e6 / m_sample_interval_usecs;
+		return 1e6 / (_fifo_interval ? _fifo_interval : m_sample_interval_usecs);
 
 	case GYROIOCSSAMPLERATE:
 		_set_sample_rate(arg);
@@ -1034,6 +1103,12 @@ GYROSIM::_measure()
 	}
 
 #endif
+
+	if (_fifo_rate != 0) {
+		_measure_fifo();
+		return;
+	}
+
 	struct MPUReport mpu_report = {};
 
 	/* start measuring */
@@ -1050,14 +1125,68 @@ GYROSIM::_measure()
 		return;
 	}
 
+	simulator::RawMPUData sample;
+	sample.accel_x = mpu_report.accel_x;
+	sample.accel_y = mpu_report.accel_y;
+	sample.accel_z = mpu_report.accel_z;
+	sample.temp = mpu_report.temp;
+	sample.gyro_x = mpu_report.gyro_x;
+	sample.gyro_y = mpu_report.gyro_y;
+	sample.gyro_z = mpu_report.gyro_z;
+
+	// for now use local time but this should be the timestamp of the simulator
+	_process_sample(sample, hrt_absolute_time(), true);
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+}
+
+void
+GYROSIM::_measure_fifo()
+{
+	Simulator *sim = Simulator::getInstance();
+
+	if (sim == nullptr) {
+		return;
+	}
+
+	perf_begin(_sample_perf);
+
+	hrt_abstime newest = 0;
+	bool overflow = false;
+	unsigned samples = sim->readMPUFIFO(_fifo_buf, sizeof(_fifo_buf) / sizeof(_fifo_buf[0]), &newest, &overflow);
+
+	if (overflow) {
+		perf_count(_fifo_overflows);
+	}
+
+	bool integrated = false;
+
+	for (unsigned i = 0; i < samples; i++) {
+		/* the FIFO carries no timestamps, the samples are evenly spaced up to the newest */
+		hrt_abstime timestamp = newest - (hrt_abstime)(samples - 1 - i) * _fifo_interval;
+
+		/* keep the last sample for readers if the burst did not complete an integral */
+		bool last = (i == samples - 1);
+
+		if (_process_sample(_fifo_buf[i], timestamp, last && !integrated)) {
+			integrated = true;
+		}
+	}
+
+	perf_end(_sample_perf);
+}
+
+bool
+GYROSIM::_process_sample(const simulator::RawMPUData &sample, hrt_abstime timestamp, bool queue)
+{
 	/*
 	 * Report buffers.
 	 */
 	accel_report	arb = {};
 	gyro_report	grb = {};
 
-	// for now use local time but this should be the timestamp of the simulator
-	grb.timestamp = hrt_absolute_time();
+	grb.timestamp = timestamp;
 	arb.timestamp = grb.timestamp;
 	// report the error count as the sum of the number of bad
 	// transfers and bad register reads. This allows the higher
@@ -1083,45 +1212,47 @@ GYROSIM::_measure()
 
 	/* NOTE: Axes have been swapped to match the board a few lines above. */
 
-	arb.x_raw = (int16_t)(mpu_report.accel_x / _accel_range_scale);
-	arb.y_raw = (int16_t)(mpu_report.accel_y / _accel_range_scale);
-	arb.z_raw = (int16_t)(mpu_report.accel_z / _accel_range_scale);
+	arb.x_raw = (int16_t)(sample.accel_x / _accel_range_scale);
+	arb.y_raw = (int16_t)(sample.accel_y / _accel_range_scale);
+	arb.z_raw = (int16_t)(sample.accel_z / _accel_range_scale);
 
 	arb.scaling = _accel_range_scale;
 	arb.range_m_s2 = _accel_range_m_s2;
 
-	_last_temperature = mpu_report.temp;
+	_last_temperature = sample.temp;
 
-	arb.temperature_raw = (int16_t)((mpu_report.temp - 35.0f) * 361.0f);
+	arb.temperature_raw = (int16_t)((sample.temp - 35.0f) * 361.0f);
 	arb.temperature = _last_temperature;
 
-	arb.x = mpu_report.accel_x;
-	arb.y = mpu_report.accel_y;
-	arb.z = mpu_report.accel_z;
+	arb.x = sample.accel_x;
+	arb.y = sample.accel_y;
+	arb.z = sample.accel_z;
 
-	math::Vector<3> aval(mpu_report.accel_x, mpu_report.accel_y, mpu_report.accel_z);
+	/* the angular rate is passed along for sculling compensation */
+	math::Vector<3> aval(sample.accel_x, sample.accel_y, sample.accel_z);
+	math::Vector<3> aval_rate(sample.gyro_x, sample.gyro_y, sample.gyro_z);
 	math::Vector<3> aval_integrated;
 
-	bool accel_notify = _accel_int.put(arb.timestamp, aval, aval_integrated, arb.integral_dt);
+	bool accel_notify = _accel_int.put(arb.timestamp, aval, aval_rate, aval_integrated, arb.integral_dt);
 	arb.x_integral = aval_integrated(0);
 	arb.y_integral = aval_integrated(1);
 	arb.z_integral = aval_integrated(2);
 
-	grb.x_raw = (int16_t)(mpu_report.gyro_x / _gyro_range_scale);
-	grb.y_raw = (int16_t)(mpu_report.gyro_y / _gyro_range_scale);
-	grb.z_raw = (int16_t)(mpu_report.gyro_z / _gyro_range_scale);
+	grb.x_raw = (int16_t)(sample.gyro_x / _gyro_range_scale);
+	grb.y_raw = (int16_t)(sample.gyro_y / _gyro_range_scale);
+	grb.z_raw = (int16_t)(sample.gyro_z / _gyro_range_scale);
 
 	grb.scaling = _gyro_range_scale;
 	grb.range_rad_s = _gyro_range_rad_s;
 
-	grb.temperature_raw = (int16_t)((mpu_report.temp - 35.0f) * 361.0f);
+	grb.temperature_raw = (int16_t)((sample.temp - 35.0f) * 361.0f);
 	grb.temperature = _last_temperature;
 
-	grb.x = mpu_report.gyro_x;
-	grb.y = mpu_report.gyro_y;
-	grb.z = mpu_report.gyro_z;
+	grb.x = sample.gyro_x;
+	grb.y = sample.gyro_y;
+	grb.z = sample.gyro_z;
 
-	math::Vector<3> gval(mpu_report.gyro_x, mpu_report.gyro_y, mpu_report.gyro_z);
+	math::Vector<3> gval(sample.gyro_x, sample.gyro_y, sample.gyro_z);
 	math::Vector<3> gval_integrated;
 
 	bool gyro_notify = _gyro_int.put(grb.timestamp, gval, gval_integrated, grb.integral_dt);
@@ -1129,6 +1260,10 @@ GYROSIM::_measure()
 	grb.y_integral = gval_integrated(1);
 	grb.z_integral = gval_integrated(2);
 
+	if (!accel_notify && !gyro_notify && !queue) {
+		return false;
+	}
+
 	_accel_reports->force(&arb);
 	_gyro_reports->force(&grb);
 
@@ -1156,8 +1291,7 @@ GYROSIM::_measure()
 		}
 	}
 
-	/* stop measuring */
-	perf_end(_sample_perf);
+	return accel_notify || gyro_notify;
 }
 
 void
@@ -1168,9 +1302,14 @@ GYROSIM::print_info()
 	perf_print_counter(_gyro_reads);
 	perf_print_counter(_good_transfers);
 	perf_print_counter(_reset_retries);
+	perf_print_counter(_fifo_overflows);
 	_accel_reports->print_info("accel queue");
 	_gyro_reports->print_info("gyro queue");
 	PX4_INFO("temperature: %.1f", (double)_last_temperature);
+
+	if (_fifo_interval != 0) {
+		PX4_INFO("FIFO sample rate: %u Hz", 1000000 / _fifo_interval);
+	}
 }
 
 void
@@ -1250,7 +1389,7 @@ namespace gyrosim
 
 GYROSIM	*g_dev_sim; // on simulated bus
 
-int	start(enum Rotation);
+int	start(enum Rotation, unsigned fifo_rate);
 int	stop();
 int	test();
 int	reset();
@@ -1265,7 +1404,7 @@ void	usage();
  * or failed to detect the sensor.
  */
 int
-start(enum Rotation rotation)
+start(enum Rotation rotation, unsigned fifo_rate)
 {
 	GYROSIM **g_dev_ptr = &g_dev_sim;
 	const char *path_accel = MPU_DEVICE_PATH_ACCEL;
@@ -1279,7 +1418,7 @@ start(enum Rotation rotation)
 	}
 
 	/* create the driver */
-	*g_dev_ptr = new GYROSIM(path_accel, path_gyro, rotation);
+	*g_dev_ptr = new GYROSIM(path_accel, path_gyro, rotation, fifo_rate);
 
 	if (*g_dev_ptr == nullptr) {
 		goto fail;
@@ -1499,6 +1638,7 @@ usage()
 	PX4_INFO("missing command: try 'start', 'info', 'test', 'stop', 'reset', 'regdump'");
 	PX4_INFO("options:");
 	PX4_INFO("    -R rotation");
+	PX4_INFO("    -F rate (sample into the FIFO at rate Hz, up to %d, and read it in bursts)", GYROSIM_FIFO_MAX_RATE);
 }
 
 } // namespace
@@ -1508,18 +1648,23 @@ gyrosim_main(int argc, char *argv[])
 {
 	int ch;
 	enum Rotation rotation = ROTATION_NONE;
+	unsigned fifo_rate = 0;
 	int ret;
 
 	/* jump over start/off/etc and look at options first */
 	int myoptind = 1;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "R:", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "R:F:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'R':
 			rotation = (enum Rotation)atoi(myoptarg);
 			break;
 
+		case 'F':
+			fifo_rate = atoi(myoptarg);
+			break;
+
 		default:
 			gyrosim::usage();
 			return 0;
@@ -1533,7 +1678,7 @@ gyrosim_main(int argc, char *argv[])
 
 	 */
 	if (!strcmp(verb, "start")) {
-		ret = gyrosim::start(rotation);
+		ret = gyrosim::start(rotation, fifo_rate);
 	}
 
 	else if (!strcmp(verb, "stop")) {
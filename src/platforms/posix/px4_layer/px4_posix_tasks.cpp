@@ -350,6 +350,38 @@ void px4_show_tasks()
 
 }
 
+int px4_task_get_stats(px4_task_stats_t *stats, int max)
+{
+	int count = 0;
+
+	pthread_mutex_lock(&task_mutex);
+
+	for (int idx = 0; idx < PX4_MAX_TASKS && count < max; idx++) {
+		if (!taskmap[idx].isused) {
+			continue;
+		}
+
+		px4_task_stats_t *s = &stats[count++];
+		strncpy(s->name, taskmap[idx].name.c_str(), sizeof(s->name) - 1);
+		s->name[sizeof(s->name) - 1] = '\0';
+		s->cpu_time_us = 0;
+
+#ifdef __PX4_LINUX
+		clockid_t cid;
+		struct timespec ts;
+
+		if (pthread_getcpuclockid(taskmap[idx].pid, &cid) == 0 && clock_gettime(cid, &ts) == 0) {
+			s->cpu_time_us = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+		}
+
+#endif
+	}
+
+	pthread_mutex_unlock(&task_mutex);
+
+	return count;
+}
+
 bool px4_task_is_running(const char *taskname)
 {
 	int idx;
@@ -41,6 +41,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __PX4_ROS
 
@@ -134,5 +135,16 @@ __EXPORT bool px4_task_is_running(const char *taskname);
 __EXPORT int px4_prctl(int option, const char *arg2, unsigned pid);
 #endif
 
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+/** Name and CPU usage of a running task */
+typedef struct {
+	char name[24];
+	uint64_t cpu_time_us;	/**< CPU time consumed so far, 0 if the platform cannot tell */
+} px4_task_stats_t;
+
+/** Snapshot the running tasks, returns the number of entries written to stats **/
+__EXPORT int px4_task_get_stats(px4_task_stats_t *stats, int max);
+#endif
+
 __END_DECLS
 
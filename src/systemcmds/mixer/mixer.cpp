@@ -122,14 +122,25 @@ load(const char *devname, const char *fname)
 	}
 
 	char buf[2048];
+	int ret = load_mixer_file_binary(fname, &buf[0], sizeof(buf));
 
-	if (load_mixer_file(fname, &buf[0], sizeof(buf)) < 0) {
+	if (ret < 0) {
 		warnx("can't load mixer: %s", fname);
 		return 1;
-	}
 
-	/* Pass the buffer to the device */
-	int ret = px4_ioctl(dev, MIXERIOCLOADBUF, (unsigned long)buf);
+	} else if (ret > 0) {
+		/* binary images are handed over as they are */
+		ret = px4_ioctl(dev, MIXERIOCLOADBIN, (unsigned long)buf);
+
+	} else {
+		if (load_mixer_file(fname, &buf[0], sizeof(buf)) < 0) {
+			warnx("can't load mixer: %s", fname);
+			return 1;
+		}
+
+		/* Pass the buffer to the device */
+		ret = px4_ioctl(dev, MIXERIOCLOADBUF, (unsigned long)buf);
+	}
 
 	if (ret < 0) {
 		warnx("error loading mixers from %s", fname);
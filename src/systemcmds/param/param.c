@@ -188,6 +188,20 @@ param_main(int argc, char *argv[])
 			}
 		}
 
+#ifdef __PX4_POSIX
+
+		if (!strcmp(argv[1], "shm")) {
+			if (argc >= 3 && (!strcmp(argv[2], "create") || !strcmp(argv[2], "attach"))) {
+				return (param_share(!strcmp(argv[2], "create")) == 0) ? 0 : 1;
+
+			} else {
+				warnx("expected 'create' or 'attach'.\nTry 'param shm create' in the process loading the parameters");
+				return 1;
+			}
+		}
+
+#endif
+
 		if (!strcmp(argv[1], "index_used")) {
 			if (argc >= 3) {
 				return do_show_index(argv[2], true);
@@ -209,7 +223,11 @@ param_main(int argc, char *argv[])
 		}
 	}
 
+#ifdef __PX4_POSIX
+	warnx("expected a command, try 'load', 'import', 'show', 'set', 'compare',\n'index', 'index_used', 'select', 'save' or 'shm'");
+#else
 	warnx("expected a command, try 'load', 'import', 'show', 'set', 'compare',\n'index', 'index_used', 'select' or 'save'");
+#endif
 	return 1;
 }
 
@@ -217,7 +235,7 @@ static int
 do_save(const char *param_file_name)
 {
 	/* create the file */
-	int fd = open(param_file_name, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+	int fd = open(param_file_name, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
 
 	if (fd < 0) {
 		warn("opening '%s' failed", param_file_name);
@@ -42,6 +42,7 @@
 #include <string.h>
 
 #include "systemlib/perf_counter.h"
+#include "systemlib/latency_trace.h"
 
 
 /****************************************************************************
@@ -67,15 +68,21 @@ int perf_main(int argc, char *argv[])
 	if (argc > 1) {
 		if (strcmp(argv[1], "reset") == 0) {
 			perf_reset_all();
+			latency_trace_reset();
 			return 0;
 
 		} else if (strcmp(argv[1], "latency") == 0) {
 			perf_print_latency(1 /* stdout */);
 			fflush(stdout);
 			return 0;
+
+		} else if (strcmp(argv[1], "pipeline") == 0) {
+			latency_trace_print(1 /* stdout */);
+			fflush(stdout);
+			return 0;
 		}
 
-		printf("Usage: perf [reset | latency]\n");
+		printf("Usage: perf [reset | latency | pipeline]\n");
 		return -1;
 	}
 
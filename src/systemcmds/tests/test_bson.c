@@ -40,6 +40,9 @@
 #include <inttypes.h>
 
 #include <px4_defines.h>
+#include <px4_posix.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -48,6 +51,7 @@
 
 #include <systemlib/err.h>
 #include <systemlib/bson/tinybson.h>
+#include <drivers/drv_hrt.h>
 
 #include "tests.h"
 
@@ -57,7 +61,11 @@ static const int64_t sample_big_int = (int64_t)INT_MAX + 123LL;
 static const double sample_double = 2.5f;
 static const char *sample_string = "this is a test";
 static const uint8_t sample_data[256] = {0};
-//static const char *sample_filename = "/fs/microsd/bson.test";
+static const char *sample_filename = PX4_ROOTFSDIR "/fs/microsd/bson.test";
+
+/* about the number of nodes in a full parameter set */
+#define BENCHMARK_NODES		900
+#define BENCHMARK_BUFSIZE	1024
 
 static int
 encode(bson_encoder_t encoder)
@@ -259,6 +267,164 @@ decode(bson_decoder_t decoder)
 	} while (result > 0);
 }
 
+static int
+encode_params(bson_encoder_t encoder)
+{
+	char name[BSON_MAXNAME];
+
+	for (unsigned i = 0; i < BENCHMARK_NODES; i++) {
+		snprintf(name, sizeof(name), "BENCH_PARAM_%u", i);
+
+		if (((i & 1) ? bson_encoder_append_double(encoder, name, i * 0.5) :
+		     bson_encoder_append_int(encoder, name, i)) != 0) {
+			PX4_ERR("FAIL: encoder: append %s failed", name);
+			return 1;
+		}
+	}
+
+	return bson_encoder_fini(encoder);
+}
+
+static int
+decode_params_callback(bson_decoder_t decoder, void *private, bson_node_t node)
+{
+	unsigned *count = (unsigned *)private;
+	char name[BSON_MAXNAME];
+
+	if (node->type == BSON_EOO) {
+		return 1;
+	}
+
+	snprintf(name, sizeof(name), "BENCH_PARAM_%u", *count);
+
+	if (strcmp(node->name, name) ||
+	    ((*count & 1) ? (node->type != BSON_DOUBLE || node->d != *count * 0.5) :
+	     (node->type != BSON_INT32 || node->i != *count))) {
+		PX4_ERR("FAIL: decoder: unexpected node '%s'", node->name);
+		return -1;
+	}
+
+	(*count)++;
+	return 1;
+}
+
+/* save and load a parameter set sized document, with and without buffering */
+static int
+test_param_file(bool buffered)
+{
+	struct bson_encoder_s encoder;
+	struct bson_decoder_s decoder;
+	unsigned count = 0;
+	int result;
+	uint8_t *buf = malloc(BENCHMARK_BUFSIZE);
+
+	if (buf == NULL) {
+		PX4_ERR("FAIL: buffer allocation");
+		return 1;
+	}
+
+	hrt_abstime start = hrt_absolute_time();
+	int fd = open(sample_filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s for writing", sample_filename);
+		free(buf);
+		return 1;
+	}
+
+	result = buffered ? bson_encoder_init_file_buffered(&encoder, fd, buf, BENCHMARK_BUFSIZE) :
+		 bson_encoder_init_file(&encoder, fd);
+
+	if (result == 0) {
+		result = encode_params(&encoder);
+	}
+
+	close(fd);
+	hrt_abstime save_time = hrt_elapsed_time(&start);
+
+	if (result != 0) {
+		PX4_ERR("FAIL: encoding to file");
+		free(buf);
+		return 1;
+	}
+
+	start = hrt_absolute_time();
+	fd = open(sample_filename, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s for reading", sample_filename);
+		free(buf);
+		return 1;
+	}
+
+	result = buffered ?
+		 bson_decoder_init_file_buffered(&decoder, fd, buf, BENCHMARK_BUFSIZE, decode_params_callback, &count) :
+		 bson_decoder_init_file(&decoder, fd, decode_params_callback, &count);
+
+	if (result == 0) {
+		do {
+			result = bson_decoder_next(&decoder);
+		} while (result > 0);
+	}
+
+	close(fd);
+	hrt_abstime load_time = hrt_elapsed_time(&start);
+
+	unlink(sample_filename);
+	free(buf);
+
+	if (result != 0 || count != BENCHMARK_NODES) {
+		PX4_ERR("FAIL: decoded %u of %u nodes from file", count, BENCHMARK_NODES);
+		return 1;
+	}
+
+	PX4_INFO("PASS: %s file, %u nodes: save %" PRIu64 " us, load %" PRIu64 " us",
+		 buffered ? "buffered" : "unbuffered", count, save_time, load_time);
+	return 0;
+}
+
+/* the sample document through a buffer smaller than some of its nodes */
+static int
+test_small_buffer(void)
+{
+	struct bson_encoder_s encoder;
+	struct bson_decoder_s decoder;
+	uint8_t buf[16];
+
+	int fd = open(sample_filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s for writing", sample_filename);
+		return 1;
+	}
+
+	if (bson_encoder_init_file_buffered(&encoder, fd, buf, sizeof(buf)) || encode(&encoder)) {
+		PX4_ERR("FAIL: bson_encoder_init_file_buffered");
+		close(fd);
+		return 1;
+	}
+
+	close(fd);
+	fd = open(sample_filename, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s for reading", sample_filename);
+		return 1;
+	}
+
+	if (bson_decoder_init_file_buffered(&decoder, fd, buf, sizeof(buf), decode_callback, NULL)) {
+		PX4_ERR("FAIL: bson_decoder_init_file_buffered");
+		close(fd);
+		return 1;
+	}
+
+	decode(&decoder);
+	close(fd);
+	unlink(sample_filename);
+
+	return 0;
+}
+
 int
 test_bson(int argc, char *argv[])
 {
@@ -297,5 +463,9 @@ test_bson(int argc, char *argv[])
 	decode(&decoder);
 	free(buf);
 
+	if (test_small_buffer() || test_param_file(false) || test_param_file(true)) {
+		return 1;
+	}
+
 	return PX4_OK;
 }
@@ -146,6 +146,70 @@ fail:
 	return -1;
 }
 
+/* store a block of items at once, as a mission upload does, and compare it to single writes */
+static int
+test_dataman_items(void)
+{
+	static char items[8][DM_MAX_DATA_SIZE];
+	const unsigned num_blocks = NUM_MISSIONS_SUPPORTED / 8;
+	hrt_abstime start, single, block, read;
+
+	start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
+		memset(items[0], i, sizeof(items[0]));
+
+		if (dm_write(DM_KEY_WAYPOINTS_OFFBOARD_1, i, DM_PERSIST_IN_FLIGHT_RESET, items[0], sizeof(items[0])) != sizeof(items[0])) {
+			warnx("write failed, index %d", i);
+			return -1;
+		}
+	}
+
+	single = hrt_elapsed_time(&start);
+	start = hrt_absolute_time();
+
+	for (unsigned b = 0; b < num_blocks; b++) {
+		for (unsigned i = 0; i < 8; i++) {
+			memset(items[i], b * 8 + i + 1, sizeof(items[i]));
+		}
+
+		if (dm_write_items(DM_KEY_WAYPOINTS_OFFBOARD_1, b * 8, DM_PERSIST_IN_FLIGHT_RESET, items, sizeof(items[0]), 8) != 8) {
+			warnx("block write failed, index %d", b * 8);
+			return -1;
+		}
+	}
+
+	block = hrt_elapsed_time(&start);
+	start = hrt_absolute_time();
+
+	for (unsigned b = 0; b < num_blocks; b++) {
+		if (dm_read_items(DM_KEY_WAYPOINTS_OFFBOARD_1, b * 8, items, sizeof(items[0]), 8) != 8) {
+			warnx("block read failed, index %d", b * 8);
+			return -1;
+		}
+
+		for (unsigned i = 0; i < 8; i++) {
+			if (items[i][0] != (char)(b * 8 + i + 1) || items[i][sizeof(items[i]) - 1] != (char)(b * 8 + i + 1)) {
+				warnx("block data verification failed, index %d", b * 8 + i);
+				return -1;
+			}
+		}
+	}
+
+	read = hrt_elapsed_time(&start);
+
+	/* the blocks must not run past the end */
+	if (dm_write_items(DM_KEY_WAYPOINTS_OFFBOARD_1, NUM_MISSIONS_SUPPORTED - 4, DM_PERSIST_IN_FLIGHT_RESET, items,
+			   sizeof(items[0]), 8) >= 0) {
+		warnx("block write past the end failed");
+		return -1;
+	}
+
+	warnx("Block test pass, io time per item: single write %lluus, block write %lluus, block read %lluus",
+	      single / NUM_MISSIONS_SUPPORTED, block / NUM_MISSIONS_SUPPORTED, read / NUM_MISSIONS_SUPPORTED);
+	return 0;
+}
+
 int test_dataman(int argc, char *argv[])
 {
 	int i, num_tasks = 4;
@@ -179,6 +243,11 @@ int test_dataman(int argc, char *argv[])
 	}
 
 	free(sems);
+
+	if (test_dataman_items() != 0) {
+		return -1;
+	}
+
 	dm_restart(DM_INIT_REASON_IN_FLIGHT);
 
 	for (i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
@@ -49,6 +49,7 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <crc32.h>
 
 #include <systemlib/err.h>
 #include <systemlib/mixer/mixer.h>
@@ -60,11 +61,17 @@
 
 #include "tests.h"
 
+/* test_mixer_binary[] and test_mixer_binary_text[], generated from test_mixer_binary.mix */
+#include "test_mixer_binary.generated.h"
+
 static int	mixer_callback(uintptr_t handle,
 			       uint8_t control_group,
 			       uint8_t control_index,
 			       float &control);
 
+static int	test_compiled_mixer(const char *buf, unsigned buflen);
+static int	test_binary_mixer();
+
 const unsigned output_max = 8;
 static float actuator_controls[output_max];
 static bool should_prearm = false;
@@ -182,6 +189,16 @@ int test_mixer(int argc, char *argv[])
 		return 1;
 	}
 
+	if (test_compiled_mixer(&buf[0], loaded) != 0) {
+		return 1;
+	}
+
+	/* run the arming tests below on the compiled mixer */
+	if (mixer_group.compile() != 0) {
+		PX4_ERR("FAIL: mixer compile failed");
+		return 1;
+	}
+
 	/* execute the mixer */
 
 	float	outputs[output_max];
@@ -419,10 +436,101 @@ int test_mixer(int argc, char *argv[])
 		return 1;
 	}
 
+	if (test_compiled_mixer(&buf[0], loaded) != 0) {
+		return 1;
+	}
+
+	/* optional extra mixer, e.g. an octo, to compare the compiled mixer against */
+	if (argc > 3) {
+		load_mixer_file(argv[3], &buf[0], sizeof(buf));
+
+		if (test_compiled_mixer(&buf[0], strlen(buf)) != 0) {
+			return 1;
+		}
+	}
+
+	if (test_binary_mixer() != 0) {
+		return 1;
+	}
+
 	PX4_INFO("SUCCESS: No errors in mixer test");
 	return 0;
 }
 
+/**
+ * Check that a compiled mixer group gives the same outputs and saturation
+ * flags as the mixer list it was built from, and compare their speed.
+ */
+static int
+test_compiled_mixer(const char *buf, unsigned buflen)
+{
+	MixerGroup reference(mixer_callback, 0);
+	MixerGroup compiled(mixer_callback, 0);
+
+	unsigned resid = buflen;
+	reference.load_from_buf(buf, resid);
+	resid = buflen;
+	compiled.load_from_buf(buf, resid);
+
+	if (compiled.compile() != 0) {
+		PX4_ERR("FAIL: mixer compile failed");
+		return 1;
+	}
+
+	float reference_outputs[output_max];
+	float compiled_outputs[output_max];
+
+	/* sweep the controls through and beyond their range to exercise saturation */
+	for (int j = -20; j <= 20; j++) {
+		for (unsigned i = 0; i < output_max; i++) {
+			actuator_controls[i] = 1.2f * sinf(0.37f * j + 1.1f * i);
+		}
+
+		uint16_t reference_status = 0;
+		uint16_t compiled_status = 0;
+		unsigned reference_mixed = reference.mix(&reference_outputs[0], output_max, &reference_status);
+		unsigned compiled_mixed = compiled.mix(&compiled_outputs[0], output_max, &compiled_status);
+
+		if (compiled_mixed != reference_mixed || compiled_status != reference_status) {
+			PX4_ERR("FAIL: compiled mixer: %u outputs, status 0x%x, expected %u outputs, status 0x%x",
+				compiled_mixed, compiled_status, reference_mixed, reference_status);
+			return 1;
+		}
+
+		for (unsigned i = 0; i < reference_mixed; i++) {
+			if (fabsf(compiled_outputs[i] - reference_outputs[i]) > 1e-6f) {
+				PX4_ERR("FAIL: compiled mixer output %u: %8.4f, expected %8.4f",
+					i, (double)compiled_outputs[i], (double)reference_outputs[i]);
+				return 1;
+			}
+		}
+	}
+
+	/* throughput */
+	const unsigned iterations = 10000;
+
+	hrt_abstime starttime = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		reference.mix(&reference_outputs[0], output_max, NULL);
+	}
+
+	hrt_abstime reference_time = hrt_elapsed_time(&starttime);
+
+	starttime = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		compiled.mix(&compiled_outputs[0], output_max, NULL);
+	}
+
+	hrt_abstime compiled_time = hrt_elapsed_time(&starttime);
+
+	PX4_INFO("%u mixers, %u mixes: list %llu us, compiled %llu us", reference.count(), iterations,
+		 (unsigned long long)reference_time, (unsigned long long)compiled_time);
+
+	return 0;
+}
+
 static int
 mixer_callback(uintptr_t handle,
 	       uint8_t control_group,
@@ -446,3 +554,115 @@ mixer_callback(uintptr_t handle,
 
 	return 0;
 }
+
+/**
+ * Check that a binary image loads into the same mixers as the text it was
+ * generated from, that damaged images are rejected, and compare load times.
+ */
+static int
+test_binary_mixer()
+{
+	const char *text = test_mixer_binary_text;
+
+	/* a copy of the image mixer_binary.py generated, to damage */
+	uint8_t image[sizeof(test_mixer_binary)];
+	unsigned length = sizeof(image);
+	memcpy(image, test_mixer_binary, length);
+
+	mixer_binary_header_s header;
+	memcpy(&header, image, sizeof(header));
+
+	/* find the last record */
+	unsigned last_record = sizeof(header);
+	mixer_binary_record_s record;
+
+	for (unsigned offset = sizeof(header), i = 0; i < header.record_count; i++) {
+		last_record = offset;
+		memcpy(&record, image + offset, sizeof(record));
+		offset += sizeof(record) + record.length;
+	}
+
+	MixerGroup from_text(mixer_callback, 0);
+	MixerGroup from_binary(mixer_callback, 0);
+
+	unsigned resid = strlen(text);
+	from_text.load_from_buf(text, resid);
+
+	if (header.length != length || from_binary.load_from_binary(image, length) != 0
+	    || from_binary.count() != from_text.count()) {
+		PX4_ERR("FAIL: binary mixer load: %u mixers, expected %u", from_binary.count(), from_text.count());
+		return 1;
+	}
+
+	float text_outputs[output_max];
+	float binary_outputs[output_max];
+
+	for (int j = -10; j <= 10; j++) {
+		for (unsigned i = 0; i < output_max; i++) {
+			actuator_controls[i] = 1.2f * sinf(0.41f * j + 0.7f * i);
+		}
+
+		unsigned text_mixed = from_text.mix(&text_outputs[0], output_max, NULL);
+		unsigned binary_mixed = from_binary.mix(&binary_outputs[0], output_max, NULL);
+
+		if (binary_mixed != text_mixed || memcmp(text_outputs, binary_outputs, text_mixed * sizeof(float)) != 0) {
+			PX4_ERR("FAIL: binary mixer outputs differ from text mixer");
+			return 1;
+		}
+	}
+
+	/* a damaged image must be rejected without adding anything */
+	MixerGroup damaged(mixer_callback, 0);
+	image[length - 1] ^= 0x01;
+
+	if (damaged.load_from_binary(image, length) == 0 || damaged.count() != 0) {
+		PX4_ERR("FAIL: damaged binary mixer accepted");
+		return 1;
+	}
+
+	image[length - 1] ^= 0x01;
+
+	if (damaged.load_from_binary(image, length - 1) == 0 || damaged.count() != 0) {
+		PX4_ERR("FAIL: truncated binary mixer accepted");
+		return 1;
+	}
+
+	/* an intact image whose last record cannot be constructed must not leave the others behind */
+	image[last_record] = '?';
+	header.crc = crc32part(image + sizeof(header), length - sizeof(header), 0);
+	memcpy(image, &header, sizeof(header));
+
+	if (damaged.load_from_binary(image, length) == 0 || damaged.count() != 0) {
+		PX4_ERR("FAIL: binary mixer with an unknown record partially loaded");
+		return 1;
+	}
+
+	memcpy(image, test_mixer_binary, length);
+
+	/* load time */
+	const unsigned iterations = 100;
+
+	hrt_abstime starttime = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		from_text.reset();
+		resid = strlen(text);
+		from_text.load_from_buf(text, resid);
+	}
+
+	hrt_abstime text_time = hrt_elapsed_time(&starttime);
+
+	starttime = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		from_binary.reset();
+		from_binary.load_from_binary(image, length);
+	}
+
+	hrt_abstime binary_time = hrt_elapsed_time(&starttime);
+
+	PX4_INFO("%u loads: text %llu us, binary %llu us", iterations,
+		 (unsigned long long)text_time, (unsigned long long)binary_time);
+
+	return 0;
+}
@@ -39,6 +39,11 @@
 
 #include <px4_defines.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "systemlib/err.h"
 #include "systemlib/param/param.h"
 #include "tests.h"
@@ -47,6 +52,135 @@
 #define PARAM_MAGIC2 0xa5a5a5a5
 PARAM_DEFINE_INT32(test, PARAM_MAGIC1);
 
+static const char *journal_filename = PX4_ROOTFSDIR "/fs/microsd/param.test";
+static const char *journal_tmp_filename = PX4_ROOTFSDIR "/fs/microsd/param.test.tmp";
+
+static off_t
+file_size(const char *filename)
+{
+	struct stat st;
+	return (stat(filename, &st) == 0) ? st.st_size : -1;
+}
+
+static int
+set_and_save(param_t p, int32_t val)
+{
+	if (param_set(p, &val) != OK || param_save_default() != OK) {
+		warnx("failed to save test parameter");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+load_and_check(param_t p, int32_t expected)
+{
+	int32_t	val;
+
+	if (param_load_default() != OK || param_get(p, &val) != OK) {
+		warnx("failed to load parameters");
+		return 1;
+	}
+
+	if (val != expected) {
+		warnx("loaded parameter mismatch (got 0x%08x)", (unsigned)val);
+		return 1;
+	}
+
+	return 0;
+}
+
+/* saves append the changed values to the file, and loading replays them */
+static int
+test_journal(param_t p)
+{
+	char *default_file = strdup(param_get_default_file());
+	int result = 1;
+
+	if (default_file == NULL) {
+		return 1;
+	}
+
+	unlink(journal_filename);
+	param_set_default_file(journal_filename);
+
+	/* the first save writes every value */
+	if (param_save_default() != OK) {
+		warnx("failed to save parameters");
+		goto out;
+	}
+
+	off_t full_size = file_size(journal_filename);
+
+	if (set_and_save(p, PARAM_MAGIC1)) {
+		goto out;
+	}
+
+	off_t size = file_size(journal_filename);
+
+	if (full_size <= 0 || size <= full_size || size > full_size + 64) {
+		warnx("change not appended (%d to %d bytes)", (int)full_size, (int)size);
+		goto out;
+	}
+
+	/* the most recent record wins */
+	if (set_and_save(p, PARAM_MAGIC2) || load_and_check(p, PARAM_MAGIC2)) {
+		goto out;
+	}
+
+	/* a torn record at the end is ignored */
+	int fd = open(journal_filename, O_WRONLY | O_APPEND);
+	const uint8_t torn[] = {0x50, 0x4a, 0x4e, 0x4c, 0x20};
+
+	if (fd < 0 || write(fd, torn, sizeof(torn)) != sizeof(torn)) {
+		warnx("failed to append to %s", journal_filename);
+
+		if (fd >= 0) {
+			close(fd);
+		}
+
+		goto out;
+	}
+
+	close(fd);
+
+	if (load_and_check(p, PARAM_MAGIC2)) {
+		goto out;
+	}
+
+	/* and the next save rewrites the file without it */
+	if (set_and_save(p, PARAM_MAGIC1) || load_and_check(p, PARAM_MAGIC1)) {
+		goto out;
+	}
+
+	if (file_size(journal_filename) > size) {
+		warnx("damaged journal not rewritten");
+		goto out;
+	}
+
+	/* a reset between removing the old file and renaming the new one leaves only the temporary file */
+	if (rename(journal_filename, journal_tmp_filename) != 0 || load_and_check(p, PARAM_MAGIC1)) {
+		warnx("parameters not recovered from %s", journal_tmp_filename);
+		goto out;
+	}
+
+	if (file_size(journal_filename) <= 0) {
+		warnx("interrupted save not finished");
+		goto out;
+	}
+
+	result = 0;
+
+out:
+	param_set_default_file(default_file);
+	free(default_file);
+	unlink(journal_filename);
+	unlink(journal_tmp_filename);
+
+	return result;
+}
+
 int
 test_param(int argc, char *argv[])
 {
@@ -100,6 +234,11 @@ test_param(int argc, char *argv[])
 		return 1;
 	}
 
+	if (test_journal(p)) {
+		warnx("parameter journal test FAIL");
+		return 1;
+	}
+
 	warnx("parameter test PASS");
 
 	return 0;
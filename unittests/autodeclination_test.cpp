@@ -14,5 +14,77 @@
 
 TEST(AutoDeclinationTest, AutoDeclination)
 {
-	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 0.6, 0.5) << "declination differs more than 1 degree";
+	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 1.8, 0.5) << "declination differs more than 1 degree";
+}
+
+/* WMM-2015 at 2015.0 and sea level, evaluated with src/lib/geo_lookup/mag_tables.py --reference */
+static const struct {
+	float lat;
+	float lon;
+	float declination;	// degrees
+	float inclination;	// degrees
+	float strength;		// nT
+	float tolerance;	// degrees
+} reference[] = {
+	{47.397742f, 8.545594f, 1.9846f, 63.3470f, 47874.9f, 0.3f},
+	{-33.8688f, 151.2093f, 12.5437f, -64.2875f, 57095.4f, 0.3f},
+	{37.7749f, -122.4194f, 13.7870f, 61.2194f, 48526.6f, 0.3f},
+	{0.5f, -0.5f, -5.4462f, -28.5800f, 31847.9f, 0.3f},
+	{-54.8019f, -68.303f, 12.5952f, -50.7655f, 31961.1f, 0.5f},
+	/* high latitudes, which the old table did not cover */
+	{64.1466f, -21.9426f, -14.5693f, 75.5155f, 52375.7f, 0.5f},
+	{61.2181f, -149.9003f, 17.2674f, 74.2345f, 55678.1f, 0.5f},
+	{69.6492f, 18.9553f, 8.1385f, 78.2011f, 53366.3f, 0.5f},
+	{78.2232f, 15.6267f, 7.9051f, 82.2557f, 54778.7f, 1.0f},
+	{89.0f, 0.0f, -5.1763f, 87.5334f, 56474.5f, 2.0f},
+	/* close to the south magnetic pole */
+	{-77.846f, 166.676f, 142.4589f, -80.5777f, 62522.2f, 2.0f},
+};
+
+TEST(AutoDeclinationTest, WorldMagneticModel)
+{
+	for (unsigned i = 0; i < sizeof(reference) / sizeof(reference[0]); i++) {
+		EXPECT_NEAR(reference[i].declination, get_mag_declination(reference[i].lat, reference[i].lon),
+			    reference[i].tolerance) << reference[i].lat << " " << reference[i].lon;
+		EXPECT_NEAR(reference[i].inclination, get_mag_inclination(reference[i].lat, reference[i].lon),
+			    reference[i].tolerance) << reference[i].lat << " " << reference[i].lon;
+		EXPECT_NEAR(reference[i].strength * 1e-5f, get_mag_strength(reference[i].lat, reference[i].lon),
+			    reference[i].strength * 1e-5f * 0.01f) << reference[i].lat << " " << reference[i].lon;
+	}
+}
+
+TEST(AutoDeclinationTest, Bounds)
+{
+	/* the whole globe is covered, including the corners of the tables */
+	EXPECT_NEAR(get_mag_declination(-90.0f, -180.0f), get_mag_declination(-90.0f, 180.0f), 0.01f);
+	EXPECT_NEAR(get_mag_strength(90.0f, 180.0f), get_mag_strength(90.0f, -180.0f), 1e-4f);
+
+	/* continuous across the antimeridian */
+	EXPECT_NEAR(get_mag_declination(51.0f, 179.999f), get_mag_declination(51.0f, -179.999f), 0.01f);
+
+	/* and across cells in which the declination wraps around */
+	for (float lon = 130.0f; lon < 145.0f; lon += 0.5f) {
+		float declination = get_mag_declination(-64.0f, lon);
+		EXPECT_TRUE(declination >= -180.0f && declination <= 180.0f) << lon;
+	}
+
+	EXPECT_FLOAT_EQ(0.0f, get_mag_declination(91.0f, 0.0f));
+	EXPECT_FLOAT_EQ(0.0f, get_mag_inclination(0.0f, -181.0f));
+	EXPECT_FLOAT_EQ(0.0f, get_mag_strength(-91.0f, 0.0f));
+}
+
+TEST(AutoDeclinationTest, Benchmark)
+{
+	const unsigned calls = 100000;
+	volatile float sink = 0.0f;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < calls; i++) {
+		float lat = -89.0f + (i % 179);
+		float lon = -179.5f + (i % 359);
+		sink = sink + get_mag_declination(lat, lon);
+	}
+
+	warnx("declination lookup: %.1f ns/call", hrt_elapsed_time(&start) * 1000.0 / calls);
 }
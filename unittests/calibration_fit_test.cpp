@@ -0,0 +1,299 @@
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <commander/calibration_fit.h>
+
+#include "random.h"
+
+#include "gtest/gtest.h"
+
+/*
+ * Feeds the streaming fits with simulated magnetometer calibrations, the
+ * vehicle turned about each axis in turn, and compares them with the
+ * sphere fit over stored samples that they replace.
+ */
+
+namespace
+{
+
+struct Point {
+	float x, y, z;
+};
+
+struct Distortion {
+	double offset[3];
+	double soft_iron[3][3];	// maps the field onto the sensor axes
+};
+
+/*
+ * An earth field of 0.5 Ga inclined by 60 degrees, seen while turning the
+ * vehicle once around the vertical on each of its six sides.
+ */
+std::vector<Point> simulate_calibration(const Distortion &distortion, unsigned points, double noise, uint32_t seed)
+{
+	std::vector<Point> samples;
+	Random random(seed);
+	const double field_h = 0.5 * cos(60.0 * M_PI / 180.0);
+	const double field_v = 0.5 * sin(60.0 * M_PI / 180.0);
+	const unsigned per_side = points / 6;
+
+	for (unsigned side = 0; side < 6; side++) {
+		/* the body axis pointing down on this side */
+		unsigned axis = side / 2;
+		double sign = (side & 1) ? -1.0 : 1.0;
+
+		for (unsigned i = 0; i < per_side; i++) {
+			double heading = 2.0 * M_PI * i / per_side;
+			double field[3];
+			field[axis] = sign * field_v;
+			field[(axis + 1) % 3] = field_h * cos(heading);
+			field[(axis + 2) % 3] = field_h * sin(heading);
+
+			Point p;
+			float *out[3] = {&p.x, &p.y, &p.z};
+
+			for (unsigned r = 0; r < 3; r++) {
+				double v = distortion.offset[r] + noise * random.gaussian();
+
+				for (unsigned c = 0; c < 3; c++) {
+					v += distortion.soft_iron[r][c] * field[c];
+				}
+
+				*out[r] = v;
+			}
+
+			samples.push_back(p);
+		}
+	}
+
+	return samples;
+}
+
+/* the sphere fit over stored points this replaces */
+void sphere_fit_reference(const std::vector<Point> &points, unsigned int max_iterations, float delta,
+			  float *sphere_x, float *sphere_y, float *sphere_z, float *sphere_radius)
+{
+	float x_sumplain = 0.0f, x_sumsq = 0.0f, x_sumcube = 0.0f;
+	float y_sumplain = 0.0f, y_sumsq = 0.0f, y_sumcube = 0.0f;
+	float z_sumplain = 0.0f, z_sumsq = 0.0f, z_sumcube = 0.0f;
+	float xy_sum = 0.0f, xz_sum = 0.0f, yz_sum = 0.0f;
+	float x2y_sum = 0.0f, x2z_sum = 0.0f, y2x_sum = 0.0f, y2z_sum = 0.0f, z2x_sum = 0.0f, z2y_sum = 0.0f;
+	float size = points.size();
+
+	for (size_t i = 0; i < points.size(); i++) {
+		float x = points[i].x, y = points[i].y, z = points[i].z;
+		float x2 = x * x, y2 = y * y, z2 = z * z;
+		x_sumplain += x; x_sumsq += x2; x_sumcube += x2 * x;
+		y_sumplain += y; y_sumsq += y2; y_sumcube += y2 * y;
+		z_sumplain += z; z_sumsq += z2; z_sumcube += z2 * z;
+		xy_sum += x * y; xz_sum += x * z; yz_sum += y * z;
+		x2y_sum += x2 * y; x2z_sum += x2 * z;
+		y2x_sum += y2 * x; y2z_sum += y2 * z;
+		z2x_sum += z2 * x; z2y_sum += z2 * y;
+	}
+
+	float x_sum = x_sumplain / size, x_sum2 = x_sumsq / size, x_sum3 = x_sumcube / size;
+	float y_sum = y_sumplain / size, y_sum2 = y_sumsq / size, y_sum3 = y_sumcube / size;
+	float z_sum = z_sumplain / size, z_sum2 = z_sumsq / size, z_sum3 = z_sumcube / size;
+	float XY = xy_sum / size, XZ = xz_sum / size, YZ = yz_sum / size;
+	float X2Y = x2y_sum / size, X2Z = x2z_sum / size, Y2X = y2x_sum / size;
+	float Y2Z = y2z_sum / size, Z2X = z2x_sum / size, Z2Y = z2y_sum / size;
+
+	float F0 = x_sum2 + y_sum2 + z_sum2;
+	float F1 =  0.5f * F0;
+	float F2 = -8.0f * (x_sum3 + Y2X + Z2X);
+	float F3 = -8.0f * (X2Y + y_sum3 + Z2Y);
+	float F4 = -8.0f * (X2Z + Y2Z + z_sum3);
+
+	float A = x_sum, B = y_sum, C = z_sum;
+	float A2 = A * A, B2 = B * B, C2 = C * C;
+	float QS = A2 + B2 + C2;
+	float QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
+	float Rsq = F0 + QB + QS;
+	float Q0 = 0.5f * (QS - Rsq);
+	float Q1 = F1 + Q0;
+	float Q2 = 8.0f * (QS - Rsq + QB + F0);
+
+	for (unsigned int n = 0; n < max_iterations; n++) {
+		float aA = Q2 + 16.0f * (A2 - 2.0f * A * x_sum + x_sum2);
+		float aB = Q2 + 16.0f * (B2 - 2.0f * B * y_sum + y_sum2);
+		float aC = Q2 + 16.0f * (C2 - 2.0f * C * z_sum + z_sum2);
+		aA = (fabsf(aA) < FLT_EPSILON) ? 1.0f : aA;
+		aB = (fabsf(aB) < FLT_EPSILON) ? 1.0f : aB;
+		aC = (fabsf(aC) < FLT_EPSILON) ? 1.0f : aC;
+
+		float nA = A - ((F2 + 16.0f * (B * XY + C * XZ + x_sum * (-A2 - Q0) + A * (x_sum2 + Q1 - C * z_sum - B * y_sum))) / aA);
+		float nB = B - ((F3 + 16.0f * (A * XY + C * YZ + y_sum * (-B2 - Q0) + B * (y_sum2 + Q1 - A * x_sum - C * z_sum))) / aB);
+		float nC = C - ((F4 + 16.0f * (A * XZ + B * YZ + z_sum * (-C2 - Q0) + C * (z_sum2 + Q1 - A * x_sum - B * y_sum))) / aC);
+
+		float dA = nA - A, dB = nB - B, dC = nC - C;
+
+		if ((dA * dA + dB * dB + dC * dC) <= delta) { break; }
+
+		A = nA; B = nB; C = nC;
+		A2 = A * A; B2 = B * B; C2 = C * C;
+		QS = A2 + B2 + C2;
+		QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
+		Rsq = F0 + QB + QS;
+		Q0 = 0.5f * (QS - Rsq);
+		Q1 = F1 + Q0;
+		Q2 = 8.0f * (QS - Rsq + QB + F0);
+	}
+
+	*sphere_x = A;
+	*sphere_y = B;
+	*sphere_z = C;
+	*sphere_radius = sqrtf(Rsq);
+}
+
+calibration_fit_s accumulate(const std::vector<Point> &points)
+{
+	calibration_fit_s fit;
+	calibration_fit_reset(&fit);
+
+	for (size_t i = 0; i < points.size(); i++) {
+		calibration_fit_add(&fit, points[i].x, points[i].y, points[i].z);
+	}
+
+	return fit;
+}
+
+/* spread of the corrected field strength, relative to its mean */
+double corrected_spread(const std::vector<Point> &points, const float offset[3], const float soft_iron[3][3])
+{
+	double sum = 0.0, sum_sq = 0.0;
+
+	for (size_t i = 0; i < points.size(); i++) {
+		double d[3] = {points[i].x - offset[0], points[i].y - offset[1], points[i].z - offset[2]};
+		double len_sq = 0.0;
+
+		for (unsigned r = 0; r < 3; r++) {
+			double c = soft_iron[r][0] * d[0] + soft_iron[r][1] * d[1] + soft_iron[r][2] * d[2];
+			len_sq += c * c;
+		}
+
+		sum += sqrt(len_sq);
+		sum_sq += len_sq;
+	}
+
+	double mean = sum / points.size();
+	return sqrt(sum_sq / points.size() - mean * mean) / mean;
+}
+
+const Distortion hard_iron = {{0.12, -0.21, 0.07}, {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+
+/* a soft iron distortion with unit determinant, so the field strength is unchanged on average */
+const Distortion soft_iron = {{0.12, -0.21, 0.07}, {{1.08, 0.04, -0.03}, {0.04, 0.93, 0.02}, {-0.03, 0.02, 0.997}}};
+
+} // namespace
+
+TEST(CalibrationFitTest, SphereMatchesStoredSamples)
+{
+	for (uint32_t seed = 0; seed < 10; seed++) {
+		std::vector<Point> points = simulate_calibration(hard_iron, 240, 0.005, seed);
+		calibration_fit_s fit = accumulate(points);
+
+		float x, y, z, radius;
+		float ref_x, ref_y, ref_z, ref_radius;
+		ASSERT_EQ(0, sphere_fit_least_squares(&fit, 100, 0.0f, &x, &y, &z, &radius));
+		sphere_fit_reference(points, 100, 0.0f, &ref_x, &ref_y, &ref_z, &ref_radius);
+
+		/* the same algorithm, with the sums accumulated in double precision */
+		EXPECT_NEAR(ref_x, x, 1e-4f);
+		EXPECT_NEAR(ref_y, y, 1e-4f);
+		EXPECT_NEAR(ref_z, z, 1e-4f);
+		EXPECT_NEAR(ref_radius, radius, 1e-4f);
+
+		EXPECT_NEAR(hard_iron.offset[0], x, 2e-3);
+		EXPECT_NEAR(hard_iron.offset[1], y, 2e-3);
+		EXPECT_NEAR(hard_iron.offset[2], z, 2e-3);
+		EXPECT_NEAR(0.5, radius, 2e-3);
+	}
+}
+
+TEST(CalibrationFitTest, EllipsoidRecoversSoftIron)
+{
+	std::vector<Point> points = simulate_calibration(soft_iron, 240, 0.002, 1);
+	calibration_fit_s fit = accumulate(points);
+
+	float offset[3];
+	float correction[3][3];
+	float radius;
+	ASSERT_EQ(0, ellipsoid_fit_least_squares(&fit, offset, correction, &radius));
+
+	/* the correction is the inverse of the distortion */
+	for (unsigned r = 0; r < 3; r++) {
+		EXPECT_NEAR(soft_iron.offset[r], offset[r], 3e-3);
+
+		for (unsigned c = 0; c < 3; c++) {
+			double identity = 0.0;
+
+			for (unsigned k = 0; k < 3; k++) {
+				identity += correction[r][k] * soft_iron.soft_iron[k][c];
+			}
+
+			EXPECT_NEAR((r == c) ? 1.0 : 0.0, identity, 1e-2) << r << ", " << c;
+		}
+	}
+
+	EXPECT_NEAR(0.5, radius, 5e-3);
+
+	/* and leaves the field strength far flatter than the sphere fit does */
+	float sphere[3], sphere_radius;
+	ASSERT_EQ(0, sphere_fit_least_squares(&fit, 100, 0.0f, &sphere[0], &sphere[1], &sphere[2], &sphere_radius));
+	const float identity[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+	double sphere_spread = corrected_spread(points, sphere, identity);
+	double ellipsoid_spread = corrected_spread(points, offset, correction);
+	warnx("field strength spread: %.2f%% sphere fit, %.2f%% ellipsoid fit", sphere_spread * 100.0,
+	      ellipsoid_spread * 100.0);
+
+	EXPECT_LT(ellipsoid_spread, 0.5 * sphere_spread);
+	EXPECT_LT(ellipsoid_spread, 0.01);
+}
+
+TEST(CalibrationFitTest, RejectsDegenerateData)
+{
+	/* turning around a single axis only describes a circle */
+	std::vector<Point> points = simulate_calibration(hard_iron, 240, 0.0, 1);
+	points.resize(40);
+
+	calibration_fit_s fit = accumulate(points);
+	float offset[3];
+	float correction[3][3];
+	float radius;
+	EXPECT_NE(0, ellipsoid_fit_least_squares(&fit, offset, correction, &radius));
+
+	calibration_fit_reset(&fit);
+	EXPECT_NE(0, sphere_fit_least_squares(&fit, 100, 0.0f, &offset[0], &offset[1], &offset[2], &radius));
+}
+
+TEST(CalibrationFitTest, ManyPoints)
+{
+	/* memory does not grow with the points, and the fits get more accurate */
+	std::vector<Point> points = simulate_calibration(soft_iron, 24000, 0.005, 3);
+
+	hrt_abstime start = hrt_absolute_time();
+	calibration_fit_s fit = accumulate(points);
+	hrt_abstime accumulate_time = hrt_elapsed_time(&start);
+
+	float offset[3];
+	float correction[3][3];
+	float radius;
+	start = hrt_absolute_time();
+	ASSERT_EQ(0, ellipsoid_fit_least_squares(&fit, offset, correction, &radius));
+	hrt_abstime fit_time = hrt_elapsed_time(&start);
+
+	warnx("%u points in %u bytes: %.3f us per point, ellipsoid fit %llu us", (unsigned)points.size(),
+	      (unsigned)sizeof(fit), accumulate_time / (double)points.size(), (unsigned long long)fit_time);
+
+	for (unsigned r = 0; r < 3; r++) {
+		EXPECT_NEAR(soft_iron.offset[r], offset[r], 1e-3);
+	}
+
+	EXPECT_LT(corrected_spread(points, offset, correction), 0.012);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <ekf_att_pos_estimator/estimator_22states.h>
+
+/*
+ * The covariance prediction and fusion steps of AttPosEKF as they were
+ * before they were reduced to the upper triangle of the covariance matrix:
+ * they evaluate the full matrix and repair its symmetry with ForceSymmetry().
+ */
+class AttPosEKFReference : public AttPosEKF
+{
+public:
+	AttPosEKFReference() : onGround(false) {}
+
+	void CovariancePrediction(float dt);
+
+	void FuseVelposNED();
+
+	void FuseMagnetometer();
+
+	void FuseAirspeed();
+
+	void FuseOptFlow();
+
+	void ForceSymmetry();
+
+	/* the on ground flag of the base class is private */
+	bool onGround;
+};
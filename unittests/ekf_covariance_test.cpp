@@ -0,0 +1,401 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <systemlib/err.h>
+
+#include "ekf_covariance_reference.h"
+#include "random.h"
+
+#include "gtest/gtest.h"
+
+/*
+ * Replays a simulated flight through AttPosEKF and, before every
+ * prediction and fusion step, copies the filter into the reference
+ * implementation with the full matrix covariance update. Both then run
+ * the same step and the covariance matrices and states are compared.
+ *
+ * Where the arithmetic did not change the results have to be identical,
+ * elsewhere only the order of the operations differs and they have to
+ * agree to within the rounding of the single precision matrix.
+ */
+
+/* the clock of the estimator, provided by the application on the target */
+static uint64_t test_time_us = 0;
+
+uint32_t millis()
+{
+	return test_time_us / 1000;
+}
+
+uint64_t getMicros()
+{
+	return test_time_us;
+}
+
+namespace
+{
+
+const float imu_dt = 0.01f;
+
+/* largest difference of two covariance matrices, relative to the standard deviations */
+float covariance_error(const float (&P)[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES],
+		       const float (&P_ref)[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES])
+{
+	float error = 0.0f;
+
+	for (unsigned i = 0; i < EKF_STATE_ESTIMATES; i++) {
+		for (unsigned j = 0; j < EKF_STATE_ESTIMATES; j++) {
+			float scale = sqrtf(fabsf(P_ref[i][i] * P_ref[j][j])) + 1e-12f;
+			error = fmaxf(error, fabsf(P[i][j] - P_ref[i][j]) / scale);
+		}
+	}
+
+	return error;
+}
+
+/* largest difference of two state vectors, relative to the standard deviations */
+float state_error(const float (&states)[EKF_STATE_ESTIMATES], const float (&states_ref)[EKF_STATE_ESTIMATES],
+		  const float (&P_ref)[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES])
+{
+	float error = 0.0f;
+
+	for (unsigned i = 0; i < EKF_STATE_ESTIMATES; i++) {
+		error = fmaxf(error, fabsf(states[i] - states_ref[i]) / (sqrtf(fabsf(P_ref[i][i])) + 1e-12f));
+	}
+
+	return error;
+}
+
+bool symmetric(const float (&P)[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES])
+{
+	for (unsigned i = 0; i < EKF_STATE_ESTIMATES; i++) {
+		for (unsigned j = 0; j < i; j++) {
+			if (P[i][j] != P[j][i]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/* the comparison of one kind of step over the whole flight */
+struct StepStats {
+	StepStats() : count(0), identical(0), covariance(0.0f), states(0.0f) {}
+
+	void add(const AttPosEKF &ekf, const AttPosEKFReference &ref)
+	{
+		count++;
+
+		if (memcmp(ekf.P, ref.P, sizeof(ekf.P)) == 0 && memcmp(ekf.states, ref.states, sizeof(ekf.states)) == 0) {
+			identical++;
+		}
+
+		covariance = fmaxf(covariance, covariance_error(ekf.P, ref.P));
+		states = fmaxf(states, state_error(ekf.states, ref.states, ref.P));
+	}
+
+	void print(const char *name) const
+	{
+		warnx("%-12s %5u steps, %5u identical, covariance error %.2g, state error %.2g",
+		      name, count, identical, (double)covariance, (double)states);
+	}
+
+	unsigned count;
+	unsigned identical;
+	float covariance;
+	float states;
+};
+
+/*
+ * A fixed wing on a circle at 15 m/s and 30 m above flat ground, with the
+ * IMU at 100 Hz, GPS at 5 Hz, the magnetometer and airspeed at 20 Hz and
+ * optical flow at 10 Hz.
+ */
+class EkfCovarianceTest : public ::testing::Test
+{
+protected:
+	EkfCovarianceTest() : random(1), step(0) {}
+
+	virtual void SetUp()
+	{
+		test_time_us = 1000000;
+
+		float vel[3] = {15.0f, 0.0f, 0.0f};
+		ekf.hgtMea = 30.0f;
+		ekf.magData.x = 0.21f;
+		ekf.magData.y = 0.01f;
+		ekf.magData.z = 0.43f;
+		ekf.InitialiseFilter(vel, 0.827f, 0.149f, 0.0f, 0.03f);
+
+		ekf.dtIMU = imu_dt;
+		ekf.useCompass = true;
+		ekf.useAirspeed = true;
+		ekf.useOpticalFlow = true;
+		ekf.useGPS = true;
+		ekf.flowStates[1] = 0.0f;
+		ekf.Tnb_flow = ekf.Tnb;
+
+		/* in the air, with the wind and magnetic field states estimated */
+		ekf.setIsFixedWing(true);
+		ekf.setOnGround(false);
+	}
+
+	/* copy the estimator into the reference before a step */
+	void sync()
+	{
+		static_cast<AttPosEKF &>(ref) = ekf;
+		ref.onGround = false;
+	}
+
+	/* one IMU sample, with a covariance prediction every other sample */
+	void imu()
+	{
+		const float yaw_rate = 0.15f;
+		const float speed = 15.0f;
+
+		test_time_us += imu_dt * 1e6f;
+		step++;
+
+		ekf.angRate.x = random.noise(0.01f);
+		ekf.angRate.y = random.noise(0.01f);
+		ekf.angRate.z = yaw_rate + random.noise(0.01f);
+		ekf.accel.x = random.noise(0.2f);
+		ekf.accel.y = yaw_rate * speed + random.noise(0.2f);
+		ekf.accel.z = -9.81f + random.noise(0.2f);
+
+		ekf.dAngIMU = ekf.angRate * imu_dt;
+		ekf.dVelIMU = ekf.accel * imu_dt;
+
+		ekf.UpdateStrapdownEquationsNED();
+		ekf.summedDelAng = ekf.summedDelAng + ekf.correctedDelAng;
+		ekf.summedDelVel = ekf.summedDelVel + ekf.dVelIMU;
+
+		if (step % 2 == 0) {
+			sync();
+			ekf.CovariancePrediction(2 * imu_dt);
+			ref.CovariancePrediction(2 * imu_dt);
+			prediction.add(ekf, ref);
+
+			ekf.summedDelAng.zero();
+			ekf.summedDelVel.zero();
+		}
+
+		for (unsigned i = 0; i < EKF_STATE_ESTIMATES; i++) {
+			ekf.statesAtVelTime[i] = ekf.states[i];
+			ekf.statesAtPosTime[i] = ekf.states[i];
+			ekf.statesAtHgtTime[i] = ekf.states[i];
+			ekf.statesAtMagMeasTime[i] = ekf.states[i];
+			ekf.statesAtVtasMeasTime[i] = ekf.states[i];
+			ekf.statesAtFlowTime[i] = ekf.states[i];
+		}
+
+		ekf.Tnb_flow = ekf.Tnb;
+		ekf.omegaAcrossFlowTime[0] = ekf.angRate.x;
+		ekf.omegaAcrossFlowTime[1] = ekf.angRate.y;
+		ekf.omegaAcrossFlowTime[2] = ekf.angRate.z;
+	}
+
+	/* GPS velocity and position with the baro height, or the baro height alone */
+	void velpos(bool gps)
+	{
+		ekf.fuseVelData = gps;
+		ekf.fusePosData = gps;
+		ekf.fuseHgtData = true;
+
+		for (unsigned i = 0; i < 3; i++) {
+			ekf.velNED[i] = ekf.states[4 + i] + random.noise(0.2f);
+		}
+
+		ekf.posNE[0] = ekf.states[7] + random.noise(0.5f);
+		ekf.posNE[1] = ekf.states[8] + random.noise(0.5f);
+		ekf.hgtMea = -ekf.states[9] + random.noise(0.3f);
+
+		sync();
+		ekf.FuseVelposNED();
+		ref.FuseVelposNED();
+		(gps ? velpos_gps : velpos_hgt).add(ekf, ref);
+	}
+
+	/* the three axes of a magnetometer sample, fused one per call */
+	void mag()
+	{
+		/* the innovation of a zero measurement is the prediction */
+		AttPosEKF probe = ekf;
+		probe.fuseMagData = true;
+		probe.magstate.obsIndex = 0;
+		probe.magData.zero();
+		probe.FuseMagnetometer();
+
+		ekf.fuseMagData = true;
+		ekf.magstate.obsIndex = 0;
+		ekf.magData.x = probe.magstate.MagPred[0] + random.noise(0.005f);
+		ekf.magData.y = probe.magstate.MagPred[1] + random.noise(0.005f);
+		ekf.magData.z = probe.magstate.MagPred[2] + random.noise(0.005f);
+
+		for (unsigned axis = 0; axis < 3; axis++) {
+			sync();
+			ekf.FuseMagnetometer();
+			ref.FuseMagnetometer();
+			magnetometer.add(ekf, ref);
+		}
+
+		ekf.fuseMagData = false;
+	}
+
+	void airspeed()
+	{
+		float vn = ekf.states[4] - ekf.states[14];
+		float ve = ekf.states[5] - ekf.states[15];
+		float vd = ekf.states[6];
+
+		ekf.fuseVtasData = true;
+		ekf.VtasMeas = sqrtf(vn * vn + ve * ve + vd * vd) + random.noise(0.5f);
+
+		sync();
+		ekf.FuseAirspeed();
+		ref.FuseAirspeed();
+		airspeed_stats.add(ekf, ref);
+
+		ekf.fuseVtasData = false;
+	}
+
+	void flow()
+	{
+		/* the innovation of a zero measurement is the prediction */
+		AttPosEKF probe = ekf;
+		probe.fuseOptFlowData = true;
+		probe.flowRadXYcomp[0] = 0.0f;
+		probe.flowRadXYcomp[1] = 0.0f;
+		probe.FuseOptFlow();
+
+		ekf.fuseOptFlowData = true;
+		ekf.flowRadXYcomp[0] = probe.innovOptFlow[0] + random.noise(0.05f);
+		ekf.flowRadXYcomp[1] = probe.innovOptFlow[1] + random.noise(0.05f);
+
+		sync();
+		ekf.FuseOptFlow();
+		ref.FuseOptFlow();
+		flow_stats.add(ekf, ref);
+
+		ekf.fuseOptFlowData = false;
+	}
+
+	/* fly for the given time, fusing every sensor at its rate */
+	void fly(float seconds)
+	{
+		unsigned steps = seconds / imu_dt;
+
+		for (unsigned i = 0; i < steps; i++) {
+			imu();
+
+			if (step % 10 == 0) {
+				velpos(step % 20 == 0);
+			}
+
+			if (step % 5 == 0) {
+				mag();
+			}
+
+			if (step % 5 == 2) {
+				airspeed();
+			}
+
+			if (step % 10 == 7) {
+				flow();
+			}
+
+			/* the states of the two filters are exchanged at every step, they must not drift apart */
+			ASSERT_FALSE(ekf.last_ekf_error.covariancesExcessive);
+		}
+	}
+
+	AttPosEKF ekf;
+	AttPosEKFReference ref;
+	Random random;
+	unsigned step;
+
+	StepStats prediction;
+	StepStats velpos_gps;
+	StepStats velpos_hgt;
+	StepStats magnetometer;
+	StepStats airspeed_stats;
+	StepStats flow_stats;
+};
+
+} // namespace
+
+TEST_F(EkfCovarianceTest, Replay)
+{
+	fly(60.0f);
+
+	prediction.print("prediction");
+	velpos_gps.print("gps");
+	velpos_hgt.print("height");
+	magnetometer.print("magnetometer");
+	airspeed_stats.print("airspeed");
+	flow_stats.print("flow");
+
+	/* every kind of step actually ran */
+	EXPECT_EQ(3000u, prediction.count);
+	EXPECT_EQ(300u, velpos_gps.count);
+	EXPECT_EQ(300u, velpos_hgt.count);
+	EXPECT_EQ(3600u, magnetometer.count);
+	EXPECT_EQ(1200u, airspeed_stats.count);
+	EXPECT_EQ(600u, flow_stats.count);
+
+	EXPECT_TRUE(symmetric(ekf.P));
+
+	/* a single observation with a measurement matrix of a single one is the old update exactly */
+	EXPECT_EQ(velpos_hgt.count, velpos_hgt.identical);
+
+	/* the gains are unchanged, so are the states after a single observation */
+	EXPECT_EQ(0.0f, magnetometer.states);
+	EXPECT_EQ(0.0f, airspeed_stats.states);
+	EXPECT_EQ(0.0f, flow_stats.states);
+
+	EXPECT_LT(prediction.covariance, 1e-5f);
+	EXPECT_LT(magnetometer.covariance, 1e-5f);
+	EXPECT_LT(airspeed_stats.covariance, 1e-5f);
+	EXPECT_LT(flow_stats.covariance, 1e-5f);
+
+	/*
+	 * The reference carries the asymmetry of the masked gains from one
+	 * GPS observation to the next and only averages it out at the end,
+	 * which changes the gains of the later observations a little.
+	 */
+	EXPECT_LT(velpos_gps.covariance, 1e-3f);
+	EXPECT_LT(velpos_gps.states, 0.05f);
+}
+
+TEST_F(EkfCovarianceTest, NoNumericalProtection)
+{
+	/* without the protection the full matrix is updated as before, symmetric or not */
+	ekf.numericalProtection = false;
+
+	for (unsigned i = 0; i < 200; i++) {
+		imu();
+
+		if (step % 10 == 0) {
+			velpos(true);
+		}
+	}
+
+	EXPECT_EQ(20u, velpos_gps.count);
+	EXPECT_EQ(velpos_gps.count, velpos_gps.identical);
+}
+
+TEST_F(EkfCovarianceTest, Diverged)
+{
+	fly(1.0f);
+
+	/* a covariance beyond any sensible value resets the filter, as ForceSymmetry() did */
+	ekf.P[4][7] = 2e8f;
+	ekf.P[7][4] = 2e8f;
+	velpos(false);
+
+	EXPECT_TRUE(ref.last_ekf_error.covariancesExcessive);
+	EXPECT_TRUE(ekf.last_ekf_error.covariancesExcessive);
+	EXPECT_LT(fabsf(ekf.P[4][7]), 1.0f);
+}
@@ -0,0 +1,192 @@
+#include <math.h>
+#include <stdio.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+/* 3-axis test signal: slow motion, vibration and noise */
+void sample(unsigned n, float out[3])
+{
+	for (unsigned axis = 0; axis < 3; axis++) {
+		float t = n * 0.001f;
+		out[axis] = sinf(2.0f * M_PI_F * (1.0f + axis) * t) + 0.3f * sinf(2.0f * M_PI_F * 180.0f * t + axis)
+			    + 0.01f * (float)((n * 7919 + axis * 104729) % 101 - 50);
+	}
+}
+
+/* peak output after the filter has settled on a sine of frequency f */
+float peak_response(math::NotchFilterBank<1> &filter, float sample_freq, float f)
+{
+	float peak = 0.0f;
+
+	for (unsigned n = 0; n < 4 * (unsigned)sample_freq; n++) {
+		float x[1] = {sinf(2.0f * M_PI_F * f * n / sample_freq)};
+		filter.apply(x);
+
+		if (n > 3 * (unsigned)sample_freq && fabsf(x[0]) > peak) {
+			peak = fabsf(x[0]);
+		}
+	}
+
+	return peak;
+}
+
+} // namespace
+
+TEST(FilterBankTest, MatchesScalarLowPass)
+{
+	const float rate = 1000.0f;
+	math::LowPassFilter2p scalar[3] = {{rate, 30.0f}, {rate, 30.0f}, {rate, 30.0f}};
+	math::LowPassFilter2pBank<3> bank(rate, 30.0f);
+
+	for (unsigned n = 0; n < 3000; n++) {
+		float x[3];
+		sample(n, x);
+
+		/* bad values must not propagate, in any channel */
+		if (n == 500) {
+			x[1] = NAN;
+		}
+
+		if (n == 1000) {
+			/* cutoff changes at runtime keep the state */
+			for (unsigned axis = 0; axis < 3; axis++) {
+				scalar[axis].set_cutoff_frequency(rate, 80.0f);
+			}
+
+			bank.set_cutoff_frequency(rate, 80.0f);
+		}
+
+		if (n == 2000) {
+			for (unsigned axis = 0; axis < 3; axis++) {
+				scalar[axis].set_cutoff_frequency(rate, 0.0f);
+			}
+
+			bank.set_cutoff_frequency(rate, 0.0f);
+		}
+
+		float expected[3];
+
+		for (unsigned axis = 0; axis < 3; axis++) {
+			expected[axis] = scalar[axis].apply(x[axis]);
+		}
+
+		bank.apply(x);
+
+		for (unsigned axis = 0; axis < 3; axis++) {
+			if (isnan(expected[axis])) {
+				EXPECT_TRUE(isnan(x[axis])) << "sample " << n << " axis " << axis;
+
+			} else {
+				EXPECT_FLOAT_EQ(expected[axis], x[axis]) << "sample " << n << " axis " << axis;
+			}
+		}
+
+		if (HasFailure()) {
+			break;
+		}
+	}
+
+	EXPECT_FLOAT_EQ(0.0f, bank.get_cutoff_freq());
+}
+
+TEST(FilterBankTest, ResetSettles)
+{
+	math::LowPassFilter2pBank<3> bank(1000.0f, 30.0f);
+	float x[3] = {1.0f, -2.0f, 9.81f};
+	bank.reset(x);
+
+	for (unsigned n = 0; n < 10; n++) {
+		float y[3] = {1.0f, -2.0f, 9.81f};
+		bank.apply(y);
+		EXPECT_NEAR(1.0f, y[0], 1e-4f);
+		EXPECT_NEAR(-2.0f, y[1], 1e-4f);
+		EXPECT_NEAR(9.81f, y[2], 1e-4f);
+	}
+}
+
+TEST(FilterBankTest, NotchRemovesCentreFrequency)
+{
+	const float rate = 1000.0f;
+	math::NotchFilterBank<1> notch(rate, 80.0f, 20.0f);
+
+	EXPECT_LT(peak_response(notch, rate, 80.0f), 0.02f);
+	EXPECT_GT(peak_response(notch, rate, 10.0f), 0.98f);
+	EXPECT_GT(peak_response(notch, rate, 300.0f), 0.95f);
+
+	/* the edges of the band are attenuated by about 3 dB */
+	float edge = peak_response(notch, rate, 90.0f);
+	EXPECT_GT(edge, 0.6f);
+	EXPECT_LT(edge, 0.8f);
+
+	/* out of range settings pass the signal through */
+	notch.set_notch_frequency(rate, 600.0f, 20.0f);
+	EXPECT_FLOAT_EQ(1.0f, peak_response(notch, rate, 250.0f));
+}
+
+TEST(FilterBankTest, Benchmark)
+{
+	const unsigned samples = 200000;
+	const float rate = 8000.0f;
+	float input[64][3];
+
+	for (unsigned n = 0; n < 64; n++) {
+		sample(n, input[n]);
+	}
+
+	/* accel and gyro of one IMU: six scalar filters against two 3-channel banks */
+	math::LowPassFilter2p accel_x(rate, 30.0f), accel_y(rate, 30.0f), accel_z(rate, 30.0f);
+	math::LowPassFilter2p gyro_x(rate, 80.0f), gyro_y(rate, 80.0f), gyro_z(rate, 80.0f);
+	volatile float sink = 0.0f;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned n = 0; n < samples; n++) {
+		const float *x = input[n % 64];
+		sink = accel_x.apply(x[0]) + accel_y.apply(x[1]) + accel_z.apply(x[2])
+		       + gyro_x.apply(x[2]) + gyro_y.apply(x[1]) + gyro_z.apply(x[0]);
+	}
+
+	hrt_abstime scalar_time = hrt_elapsed_time(&start);
+
+	math::LowPassFilter2pBank<3> accel(rate, 30.0f);
+	math::LowPassFilter2pBank<3> gyro(rate, 80.0f);
+
+	start = hrt_absolute_time();
+
+	for (unsigned n = 0; n < samples; n++) {
+		const float *x = input[n % 64];
+		float a[3] = {x[0], x[1], x[2]};
+		float g[3] = {x[2], x[1], x[0]};
+		accel.apply(a);
+		gyro.apply(g);
+		sink = a[0] + a[1] + a[2] + g[0] + g[1] + g[2];
+	}
+
+	hrt_abstime bank_time = hrt_elapsed_time(&start);
+
+	/* six channels sharing one filter, e.g. two sensors of the same kind */
+	math::LowPassFilter2pBank<6> six(rate, 80.0f);
+
+	start = hrt_absolute_time();
+
+	for (unsigned n = 0; n < samples; n++) {
+		const float *x = input[n % 64];
+		float v[6] = {x[0], x[1], x[2], x[2], x[1], x[0]};
+		six.apply(v);
+		sink = v[0] + v[1] + v[2] + v[3] + v[4] + v[5];
+	}
+
+	hrt_abstime six_time = hrt_elapsed_time(&start);
+	(void)sink;
+
+	warnx("%u samples x 6 channels: scalar %.1f ns, 2 x 3 channels %.1f ns, 6 channels %.1f ns per sample",
+	      samples, scalar_time * 1000.0 / samples, bank_time * 1000.0 / samples, six_time * 1000.0 / samples);
+}
@@ -0,0 +1,159 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <geo/geo.h>
+#include <systemlib/err.h>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const unsigned num_points = 500;
+
+/* points within a few km of the origin, as in a mission or a geofence */
+void make_points(double lat_0, double lon_0, double *lat, double *lon)
+{
+	srand(1);
+
+	for (unsigned i = 0; i < num_points; i++) {
+		lat[i] = lat_0 + ((double)rand() / RAND_MAX - 0.5) * 0.1;
+		lon[i] = lon_0 + ((double)rand() / RAND_MAX - 0.5) * 0.1;
+	}
+}
+
+} // namespace
+
+TEST(GeoTest, PreparedPoints)
+{
+	const double origins[][2] = {{47.397742, 8.545594}, {-33.8688, 151.2093}, {78.2232, 15.6267}, {0.0, -179.99}};
+	double lat[num_points], lon[num_points];
+
+	for (unsigned o = 0; o < sizeof(origins) / sizeof(origins[0]); o++) {
+		make_points(origins[o][0], origins[o][1], lat, lon);
+
+		struct geo_point_s from;
+		geo_point_init(&from, origins[o][0], origins[o][1]);
+
+		for (unsigned i = 0; i < num_points; i++) {
+			struct geo_point_s to;
+			geo_point_init(&to, lat[i], lon[i]);
+
+			float distance = get_distance_to_next_waypoint(origins[o][0], origins[o][1], lat[i], lon[i]);
+			float bearing = get_bearing_to_next_waypoint(origins[o][0], origins[o][1], lat[i], lon[i]);
+
+			EXPECT_NEAR(distance, get_distance_between_points(&from, &to), 1e-3f + distance * 1e-5f) << i;
+			EXPECT_NEAR(bearing, get_bearing_between_points(&from, &to), 1e-4f) << i;
+		}
+
+		/* and the same point again */
+		EXPECT_FLOAT_EQ(0.0f, get_distance_between_points(&from, &from));
+	}
+}
+
+TEST(GeoTest, BatchProjection)
+{
+	struct map_projection_reference_s ref;
+	double lat[num_points], lon[num_points];
+	float x[num_points], y[num_points];
+
+	EXPECT_EQ(0, map_projection_init(&ref, 47.397742, 8.545594));
+	make_points(ref.lat_rad * M_RAD_TO_DEG, ref.lon_rad * M_RAD_TO_DEG, lat, lon);
+
+	EXPECT_EQ(0, map_projection_project_batch(&ref, lat, lon, x, y, num_points));
+
+	for (unsigned i = 0; i < num_points; i++) {
+		/* the batch gives exactly the results of single calls */
+		float x_single, y_single;
+		EXPECT_EQ(0, map_projection_project(&ref, lat[i], lon[i], &x_single, &y_single));
+		EXPECT_EQ(0, memcmp(&x_single, &x[i], sizeof(float))) << i;
+		EXPECT_EQ(0, memcmp(&y_single, &y[i], sizeof(float))) << i;
+
+		struct geo_point_s point;
+		geo_point_init(&point, lat[i], lon[i]);
+		EXPECT_EQ(0, map_projection_project_point(&ref, &point, &x_single, &y_single));
+		EXPECT_FLOAT_EQ(x[i], x_single) << i;
+		EXPECT_FLOAT_EQ(y[i], y_single) << i;
+	}
+
+	/* and back again, to within the resolution of the float coordinates */
+	double lat_back[num_points], lon_back[num_points];
+	EXPECT_EQ(0, map_projection_reproject_batch(&ref, x, y, lat_back, lon_back, num_points));
+
+	for (unsigned i = 0; i < num_points; i++) {
+		double lat_single, lon_single;
+		EXPECT_EQ(0, map_projection_reproject(&ref, x[i], y[i], &lat_single, &lon_single));
+		EXPECT_EQ(lat_single, lat_back[i]) << i;
+		EXPECT_EQ(lon_single, lon_back[i]) << i;
+
+		EXPECT_NEAR(lat[i], lat_back[i], 1e-6) << i;
+		EXPECT_NEAR(lon[i], lon_back[i], 1e-6) << i;
+	}
+
+	/* without a reference nothing is projected */
+	struct map_projection_reference_s uninitialized = {};
+	EXPECT_EQ(-1, map_projection_project_batch(&uninitialized, lat, lon, x, y, num_points));
+	EXPECT_EQ(-1, map_projection_reproject_batch(&uninitialized, x, y, lat_back, lon_back, num_points));
+}
+
+TEST(GeoTest, Benchmark)
+{
+	const unsigned passes = 200;
+	struct map_projection_reference_s ref;
+	double lat[num_points], lon[num_points];
+	float x[num_points], y[num_points];
+	struct geo_point_s points[num_points];
+	volatile float sink = 0.0f;
+
+	map_projection_init(&ref, 47.397742, 8.545594);
+	make_points(47.397742, 8.545594, lat, lon);
+	double calls = (double)num_points * passes;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		for (unsigned i = 0; i < num_points; i++) {
+			map_projection_project(&ref, lat[i], lon[i], &x[i], &y[i]);
+		}
+	}
+
+	double single = hrt_elapsed_time(&start) * 1000.0 / calls;
+	start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		map_projection_project_batch(&ref, lat, lon, x, y, num_points);
+	}
+
+	warnx("project: %.1f ns/point, batch %.1f ns/point", single, hrt_elapsed_time(&start) * 1000.0 / calls);
+
+	/* distances from every point to a fixed one, like a vehicle checking its waypoints */
+	start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		for (unsigned i = 0; i < num_points; i++) {
+			sink = sink + get_distance_to_next_waypoint(47.397742, 8.545594, lat[i], lon[i]);
+		}
+	}
+
+	single = hrt_elapsed_time(&start) * 1000.0 / calls;
+
+	struct geo_point_s origin;
+	geo_point_init(&origin, 47.397742, 8.545594);
+
+	for (unsigned i = 0; i < num_points; i++) {
+		geo_point_init(&points[i], lat[i], lon[i]);
+	}
+
+	start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		for (unsigned i = 0; i < num_points; i++) {
+			sink = sink + get_distance_between_points(&origin, &points[i]);
+		}
+	}
+
+	warnx("distance: %.1f ns/call, prepared points %.1f ns/call", single, hrt_elapsed_time(&start) * 1000.0 / calls);
+}
@@ -0,0 +1,241 @@
+#include <math.h>
+#include <stdio.h>
+
+#include <systemlib/err.h>
+#include <integrator.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * Drives the integrator with the classic coning and sculling motions, whose
+ * attitude and velocity are known in closed form, and checks the published
+ * deltas chain up to the true motion.
+ */
+
+namespace
+{
+
+struct Quat {
+	double w, x, y, z;
+
+	Quat operator*(const Quat &q) const
+	{
+		return {w * q.w - x * q.x - y * q.y - z * q.z,
+			w * q.x + x * q.w + y * q.z - z * q.y,
+			w * q.y - x * q.z + y * q.w + z * q.x,
+			w * q.z + x * q.y - y * q.x + z * q.w};
+	}
+
+	Quat conjugated() const { return {w, -x, -y, -z}; }
+
+	/* rotation by the rotation vector v */
+	static Quat from_rotation_vector(double x, double y, double z)
+	{
+		double angle = sqrt(x * x + y * y + z * z);
+
+		if (angle < 1e-12) {
+			return {1.0, x / 2, y / 2, z / 2};
+		}
+
+		double s = sin(angle / 2) / angle;
+		return {cos(angle / 2), x * s, y * s, z * s};
+	}
+
+	/* angle of the rotation */
+	double angle() const
+	{
+		return 2.0 * atan2(sqrt(x * x + y * y + z * z), fabs(w));
+	}
+};
+
+/*
+ * Coning: the body axis x sweeps a cone of half angle beta at omega rad/s. The
+ * attitude is q(t) = [cos(beta/2), 0, sin(beta/2) cos(omega t), sin(beta/2) sin(omega t)].
+ */
+const double coning_beta = 0.05;
+const double coning_omega = 2.0 * M_PI * 10.0;
+
+Quat coning_attitude(double t)
+{
+	return {cos(coning_beta / 2), 0.0, sin(coning_beta / 2) * cos(coning_omega * t),
+		sin(coning_beta / 2) * sin(coning_omega * t)};
+}
+
+math::Vector<3> coning_rate(double t)
+{
+	return math::Vector<3>(-2.0 * coning_omega * sin(coning_beta / 2) * sin(coning_beta / 2),
+			       -coning_omega * sin(coning_beta) * sin(coning_omega * t),
+			       coning_omega * sin(coning_beta) * cos(coning_omega * t));
+}
+
+/* attitude error after integrating coning motion for duration seconds */
+double coning_error(bool coning_compensation, uint64_t sample_interval, double duration)
+{
+	Integrator integrator(4000, coning_compensation);
+	Quat attitude = coning_attitude(0.0);
+	uint64_t integrated = 0;
+
+	for (uint64_t t = 0; t <= (uint64_t)(duration * 1e6); t += sample_interval) {
+		math::Vector<3> rate = coning_rate(t * 1e-6);
+		math::Vector<3> delta;
+		uint64_t delta_dt;
+
+		/* the integrator treats timestamp 0 as not started */
+		if (integrator.put(t + 1, rate, delta, delta_dt)) {
+			attitude = attitude * Quat::from_rotation_vector(delta(0), delta(1), delta(2));
+			integrated += delta_dt;
+		}
+	}
+
+	return (coning_attitude(integrated * 1e-6).conjugated() * attitude).angle();
+}
+
+/*
+ * Sculling: the body rolls sinusoidally while accelerating sinusoidally along y
+ * in phase, so the velocity rectifies along the navigation z axis.
+ */
+const double sculling_roll = 0.05;
+const double sculling_accel = 5.0;
+const double sculling_omega = 2.0 * M_PI * 10.0;
+
+double sculling_angle(double t)
+{
+	return sculling_roll * sin(sculling_omega * t);
+}
+
+void sculling_sample(double t, math::Vector<3> &accel, math::Vector<3> &rate)
+{
+	accel = math::Vector<3>(0.0f, sculling_accel * sin(sculling_omega * t), 0.0f);
+	rate = math::Vector<3>(sculling_roll * sculling_omega * cos(sculling_omega * t), 0.0f, 0.0f);
+}
+
+/* body y axis in the navigation frame */
+void sculling_rotate(double t, double y, double z, double &nav_y, double &nav_z)
+{
+	double angle = sculling_angle(t);
+	nav_y = cos(angle) * y - sin(angle) * z;
+	nav_z = sin(angle) * y + cos(angle) * z;
+}
+
+/* navigation frame velocity error after integrating sculling motion for duration seconds */
+double sculling_error(bool sculling_compensation, uint64_t sample_interval, double duration)
+{
+	Integrator integrator(4000);
+	double velocity[2] = {0.0, 0.0};
+	uint64_t start = 0;
+	uint64_t integrated = 0;
+
+	for (uint64_t t = 0; t <= (uint64_t)(duration * 1e6); t += sample_interval) {
+		math::Vector<3> accel;
+		math::Vector<3> rate;
+		math::Vector<3> delta;
+		uint64_t delta_dt;
+		sculling_sample(t * 1e-6, accel, rate);
+
+		bool reset = sculling_compensation ? integrator.put(t + 1, accel, rate, delta, delta_dt) :
+			     integrator.put(t + 1, accel, delta, delta_dt);
+
+		if (reset) {
+			/* the delta is in the body frame at the start of the interval */
+			double nav_y, nav_z;
+			sculling_rotate(start * 1e-6, delta(1), delta(2), nav_y, nav_z);
+			velocity[0] += nav_y;
+			velocity[1] += nav_z;
+			start = t;
+			integrated += delta_dt;
+		}
+	}
+
+	/* the true velocity, by fine midpoint integration */
+	const unsigned steps = 1000000;
+	double h = integrated * 1e-6 / steps;
+	double truth[2] = {0.0, 0.0};
+
+	for (unsigned i = 0; i < steps; i++) {
+		double t = (i + 0.5) * h;
+		double nav_y, nav_z;
+		sculling_rotate(t, sculling_accel * sin(sculling_omega * t), 0.0, nav_y, nav_z);
+		truth[0] += nav_y * h;
+		truth[1] += nav_z * h;
+	}
+
+	return sqrt((velocity[0] - truth[0]) * (velocity[0] - truth[0]) + (velocity[1] - truth[1]) * (velocity[1] - truth[1]));
+}
+
+/* number of integrals published in the second starting at now */
+unsigned output_rate(Integrator &integrator, uint64_t sample_interval, uint64_t &now)
+{
+	unsigned resets = 0;
+	math::Vector<3> val(1.0f, 2.0f, 3.0f);
+	uint64_t end = now + 1000000;
+
+	for (; now <= end; now += sample_interval) {
+		math::Vector<3> integral;
+		uint64_t integral_dt;
+
+		if (integrator.put(now, val, integral, integral_dt)) {
+			EXPECT_NEAR(integral_dt * 1e-6f, integral(0), 1e-6f);
+			EXPECT_NEAR(3.0f * integral(0), integral(2), 1e-6f);
+
+			/* published on the sample closest to the interval */
+			EXPECT_NEAR((double)integrator.get_autoreset_interval(), (double)integral_dt, sample_interval / 2.0);
+			resets++;
+		}
+	}
+
+	return resets;
+}
+
+} // namespace
+
+TEST(IntegratorTest, OutputRate)
+{
+	/* the driver configurations: 1 kHz sampling published at 250 Hz */
+	uint64_t now = 1;
+	Integrator integrator(1000000 / 280);
+	EXPECT_EQ(250u, output_rate(integrator, 1000, now));
+
+	/* sampling at the output rate publishes every sample */
+	now = 1;
+	Integrator every_sample(2500);
+	EXPECT_EQ(400u, output_rate(every_sample, 2500, now));
+
+	/* the output rate does not depend on the sample rate */
+	now = 1;
+	Integrator slow(10000);
+	EXPECT_EQ(100u, output_rate(slow, 125, now));
+	slow.set_autoreset_interval(4000);
+	EXPECT_EQ(250u, output_rate(slow, 125, now));
+}
+
+TEST(IntegratorTest, ConingMotion)
+{
+	const double duration = 10.0;
+
+	for (uint64_t sample_interval = 125; sample_interval <= 1000; sample_interval *= 2) {
+		double uncompensated = coning_error(false, sample_interval, duration);
+		double compensated = coning_error(true, sample_interval, duration);
+
+		warnx("coning at %u Hz: %.2e rad uncompensated, %.2e rad compensated", (unsigned)(1000000 / sample_interval),
+		      uncompensated, compensated);
+
+		EXPECT_LT(compensated, 0.1 * uncompensated);
+		EXPECT_LT(compensated, 1e-3);
+	}
+}
+
+TEST(IntegratorTest, ScullingMotion)
+{
+	const double duration = 10.0;
+
+	for (uint64_t sample_interval = 125; sample_interval <= 1000; sample_interval *= 2) {
+		double uncompensated = sculling_error(false, sample_interval, duration);
+		double compensated = sculling_error(true, sample_interval, duration);
+
+		warnx("sculling at %u Hz: %.2e m/s uncompensated, %.2e m/s compensated", (unsigned)(1000000 / sample_interval),
+		      uncompensated, compensated);
+
+		EXPECT_LT(compensated, 0.1 * uncompensated);
+		EXPECT_LT(compensated, 1e-3);
+	}
+}
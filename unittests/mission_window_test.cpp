@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include <vector>
+
+#include <systemlib/err.h>
+#include <navigator/navigation.h>
+#include <mavlink/mavlink_mission_window.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * Uploads missions over a simulated telemetry link, with the vehicle side
+ * driving the window the way the mission manager does, and compares the upload
+ * time with one outstanding request to the windowed transfer.
+ */
+
+namespace
+{
+
+struct Link {
+	uint64_t latency;		// one way, us
+	uint64_t request_time;		// time to send a MISSION_REQUEST, us
+	uint64_t item_time;		// time to send a MISSION_ITEM, us
+	unsigned loss;			// one in loss messages gets lost, 0 for none
+};
+
+/* dataman cost: the flush to the SD card dominates */
+const uint64_t store_flush_time = 10000;
+const uint64_t store_item_time = 500;
+const uint64_t retry_timeout = 500000;
+
+struct Upload {
+	uint64_t duration;		// us
+	unsigned requests;
+	unsigned stores;
+	std::vector<unsigned> stored;	// sequence of the stored items, in order
+};
+
+enum EventType {
+	REQUEST_ARRIVES,		// at the ground station
+	ITEM_ARRIVES,			// at the vehicle
+	RETRY
+};
+
+struct Event {
+	EventType type;
+	unsigned seq;
+};
+
+Upload upload(unsigned count, unsigned window_size, const Link &link)
+{
+	Upload result = {0, 0, 0, {}};
+	std::multimap<uint64_t, Event> events;
+	MavlinkMissionWindow window;
+	uint64_t uplink_free = 0, downlink_free = 0;	// when the links are idle again
+	uint64_t last_sent = 0;
+	srand(1);
+
+	auto lost = [&]() {
+		return link.loss > 0 && (unsigned)rand() % link.loss == 0;
+	};
+
+	auto request_missing = [&](uint64_t now) {
+		for (unsigned seq = window.next_missing(window.first()); seq < window.first() + window.size();
+		     seq = window.next_missing(seq + 1)) {
+			uplink_free = (uplink_free > now ? uplink_free : now) + link.request_time;
+			result.requests++;
+
+			if (!lost()) {
+				events.insert(std::make_pair(uplink_free + link.latency, Event{REQUEST_ARRIVES, seq}));
+			}
+		}
+
+		last_sent = now;
+		events.insert(std::make_pair(now + retry_timeout, Event{RETRY, 0}));
+	};
+
+	/* the MISSION_COUNT has just arrived */
+	window.start(count, window_size);
+	request_missing(0);
+
+	while (!events.empty() && !window.finished()) {
+		uint64_t now = events.begin()->first;
+		Event event = events.begin()->second;
+		events.erase(events.begin());
+
+		switch (event.type) {
+		case REQUEST_ARRIVES:
+			/* the ground station answers every request in turn */
+			downlink_free = (downlink_free > now ? downlink_free : now) + link.item_time;
+
+			if (!lost()) {
+				events.insert(std::make_pair(downlink_free + link.latency, Event{ITEM_ARRIVES, event.seq}));
+			}
+
+			break;
+
+		case ITEM_ARRIVES:
+			if (!window.set_received(event.seq) || !window.complete()) {
+				break;
+			}
+
+			for (unsigned seq = window.first(); seq < window.first() + window.size(); seq++) {
+				result.stored.push_back(seq);
+			}
+
+			result.stores++;
+			now += store_flush_time + store_item_time * window.size();
+
+			if (window.advance()) {
+				request_missing(now);
+
+			} else {
+				result.duration = now;
+			}
+
+			break;
+
+		case RETRY:
+			if (now - last_sent >= retry_timeout) {
+				request_missing(now);
+			}
+
+			break;
+		}
+	}
+
+	return result;
+}
+
+/* 57600 baud radio, MISSION_REQUEST 12 bytes, MISSION_ITEM 45 bytes */
+const Link radio = {50000, 2100, 7800, 0};
+
+} // namespace
+
+TEST(MissionWindowTest, Blocks)
+{
+	MavlinkMissionWindow window;
+	window.start(10, 4);
+
+	EXPECT_EQ(0u, window.first());
+	EXPECT_EQ(4u, window.size());
+	EXPECT_TRUE(window.empty());
+
+	/* out of order, duplicates and items of other blocks */
+	EXPECT_TRUE(window.set_received(2));
+	EXPECT_FALSE(window.set_received(2));
+	EXPECT_FALSE(window.set_received(4));
+	EXPECT_EQ(0u, window.next_missing(0));
+	EXPECT_EQ(3u, window.next_missing(2));
+	EXPECT_TRUE(window.set_received(0));
+	EXPECT_TRUE(window.set_received(3));
+	EXPECT_FALSE(window.complete());
+	EXPECT_TRUE(window.set_received(1));
+	EXPECT_TRUE(window.complete());
+	EXPECT_EQ(4u, window.next_missing(0));
+
+	EXPECT_TRUE(window.advance());
+	EXPECT_EQ(4u, window.first());
+	EXPECT_TRUE(window.empty());
+	EXPECT_FALSE(window.received(2));
+
+	for (unsigned seq = 4; seq < 8; seq++) {
+		EXPECT_TRUE(window.set_received(seq));
+	}
+
+	/* the last block is short */
+	EXPECT_TRUE(window.advance());
+	EXPECT_EQ(8u, window.first());
+	EXPECT_EQ(2u, window.size());
+	EXPECT_TRUE(window.set_received(9));
+	EXPECT_TRUE(window.set_received(8));
+	EXPECT_TRUE(window.complete());
+	EXPECT_FALSE(window.advance());
+	EXPECT_TRUE(window.finished());
+
+	/* the size is limited */
+	window.start(100, 0);
+	EXPECT_EQ(1u, window.size());
+	window.start(100, 1000);
+	EXPECT_EQ(MavlinkMissionWindow::MAX_SIZE, window.size());
+}
+
+TEST(MissionWindowTest, LossyLink)
+{
+	Link lossy = radio;
+	lossy.loss = 10;
+
+	for (unsigned window_size = 1; window_size <= 16; window_size *= 2) {
+		Upload result = upload(250, window_size, lossy);
+
+		/* every item is stored exactly once, in order */
+		ASSERT_EQ(250u, result.stored.size()) << "window " << window_size;
+
+		for (unsigned i = 0; i < result.stored.size(); i++) {
+			EXPECT_EQ(i, result.stored[i]) << "window " << window_size;
+		}
+
+		EXPECT_GT(result.requests, 250u);
+	}
+}
+
+TEST(MissionWindowTest, UploadTime)
+{
+	/* the largest mission the vehicle accepts */
+	const unsigned count = NUM_MISSIONS_SUPPORTED;
+	Upload single = upload(count, 1, radio);
+
+	warnx("%u items one at a time: %.1f s, %u stores", count, single.duration * 1e-6, single.stores);
+
+	for (unsigned window_size = 2; window_size <= 16; window_size *= 2) {
+		Upload windowed = upload(count, window_size, radio);
+
+		warnx("%u items in windows of %u: %.1f s, %u stores", count, window_size, windowed.duration * 1e-6,
+		      windowed.stores);
+
+		EXPECT_EQ(count, windowed.stored.size());
+		EXPECT_EQ(count, windowed.requests);
+		EXPECT_LT(windowed.duration, single.duration);
+	}
+
+	/* a window of 8 hides most of the link latency and of the SD card flushes */
+	Upload windowed = upload(count, 8, radio);
+	EXPECT_LT(windowed.duration * 4, single.duration);
+	EXPECT_EQ((count + 7) / 8, windowed.stores);
+}
@@ -7,6 +7,6 @@
 
 TEST(MixerTest, Mixer)
 {
-	const char *args[] = {"empty", "../ROMFS/px4fmu_common/mixers/IO_pass.mix", "../ROMFS/px4fmu_common/mixers/quad_w.main.mix"};
-	ASSERT_EQ(test_mixer(3, (char **)args), 0) << "IO_pass.mix failed";
+	const char *args[] = {"empty", "../ROMFS/px4fmu_common/mixers/IO_pass.mix", "../ROMFS/px4fmu_common/mixers/quad_w.main.mix", "../ROMFS/px4fmu_common/mixers/octo_x.main.mix"};
+	ASSERT_EQ(test_mixer(4, (char **)args), 0) << "IO_pass.mix failed";
 }
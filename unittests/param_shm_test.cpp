@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <systemlib/param/param_shm.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * Each process maps the segment on its own, two handles in one process
+ * behave the same as two processes.
+ */
+
+namespace
+{
+
+const unsigned count = 64;
+const uint32_t layout = 0x12345678;
+
+class ParamShmTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		snprintf(name, sizeof(name), "/px4_params_test_%d", (int)getpid());
+	}
+
+	virtual void TearDown()
+	{
+		shm_unlink(name);
+	}
+
+	char name[32];
+};
+
+} // namespace
+
+TEST_F(ParamShmTest, CreateAttach)
+{
+	/* nothing to attach to yet */
+	EXPECT_EQ(nullptr, param_shm_open(name, count, layout, false));
+
+	struct param_shm_s *primary = param_shm_open(name, count, layout, true);
+	ASSERT_NE(nullptr, primary);
+	struct param_shm_s *secondary = param_shm_open(name, count, layout, false);
+	ASSERT_NE(nullptr, secondary);
+
+	uint32_t value = 1;
+	bool set = true;
+
+	/* all parameters start at their defaults */
+	EXPECT_EQ(0u, param_shm_read(secondary, 3, &value, &set));
+	EXPECT_FALSE(set);
+	EXPECT_EQ(0u, param_shm_generation(secondary));
+
+	/* a value set by one process is seen by the other */
+	uint32_t written = 42;
+	uint32_t seq = param_shm_write(primary, 3, &written);
+	EXPECT_EQ(2u, seq);
+	EXPECT_EQ(seq, param_shm_read(secondary, 3, &value, &set));
+	EXPECT_TRUE(set);
+	EXPECT_EQ(42u, value);
+	EXPECT_EQ(1u, param_shm_generation(secondary));
+
+	/* setting the same value again is no change */
+	EXPECT_EQ(seq, param_shm_write(secondary, 3, &written));
+	EXPECT_EQ(1u, param_shm_generation(primary));
+
+	/* neither is resetting a value at its default */
+	EXPECT_EQ(0u, param_shm_write(secondary, 4, nullptr));
+	EXPECT_EQ(1u, param_shm_generation(primary));
+
+	/* a reset is */
+	EXPECT_EQ(4u, param_shm_write(secondary, 3, nullptr));
+	EXPECT_EQ(4u, param_shm_sequence(primary, 3));
+	param_shm_read(primary, 3, &value, &set);
+	EXPECT_FALSE(set);
+	EXPECT_EQ(2u, param_shm_generation(primary));
+
+	/* the parameters of the segment have to match */
+	EXPECT_EQ(nullptr, param_shm_open(name, count + 1, layout, false));
+	EXPECT_EQ(nullptr, param_shm_open(name, count, layout + 1, false));
+
+	param_shm_close(secondary);
+
+	/* a new segment replaces the values of a previous run */
+	param_shm_write(primary, 5, &written);
+	param_shm_close(primary);
+	primary = param_shm_open(name, count, layout, true);
+	ASSERT_NE(nullptr, primary);
+	param_shm_read(primary, 5, &value, &set);
+	EXPECT_FALSE(set);
+	EXPECT_EQ(0u, param_shm_generation(primary));
+	param_shm_close(primary);
+}
+
+TEST_F(ParamShmTest, Concurrent)
+{
+	const unsigned writes = 100000;
+	const unsigned index = 7;
+
+	struct param_shm_s *shm[3];
+
+	for (unsigned i = 0; i < 3; i++) {
+		shm[i] = param_shm_open(name, count, layout, i == 0);
+		ASSERT_NE(nullptr, shm[i]);
+	}
+
+	std::atomic<bool> done(false);
+	unsigned torn = 0;
+	unsigned reads = 0;
+
+	/* every value is odd and set, or zero and reset */
+	std::thread reader([&]() {
+		uint32_t last_seq = 0;
+
+		while (!done) {
+			uint32_t value;
+			bool set;
+			uint32_t seq = param_shm_read(shm[2], index, &value, &set);
+
+			if (set != (value != 0) || (set && (value & 1) == 0) || (seq & 1) || seq < last_seq) {
+				torn++;
+			}
+
+			last_seq = seq;
+			reads++;
+		}
+	});
+
+	/* two writers, each of whose writes is a change of the initially reset slot */
+	std::vector<std::thread> writers;
+
+	for (unsigned w = 0; w < 2; w++) {
+		writers.push_back(std::thread([&, w]() {
+			for (unsigned i = 0; i < writes; i++) {
+				if (w == 0) {
+					uint32_t value = 2 * i + 1;
+					param_shm_write(shm[w], index, &value);
+
+				} else {
+					/* alternate between a value the other writer never writes and a reset */
+					uint32_t value = 0xffffffff;
+					param_shm_write(shm[w], index, (i & 1) ? nullptr : &value);
+				}
+			}
+		}));
+	}
+
+	for (unsigned w = 0; w < writers.size(); w++) {
+		writers[w].join();
+	}
+
+	done = true;
+	reader.join();
+
+	warnx("%u reads during %u writes", reads, 2 * writes);
+	EXPECT_EQ(0u, torn);
+
+	/* no write got lost, the sequence counts every change */
+	EXPECT_EQ(2 * writes, param_shm_generation(shm[0]));
+	EXPECT_EQ(4 * writes, param_shm_sequence(shm[0], index));
+
+	for (unsigned i = 0; i < 3; i++) {
+		param_shm_close(shm[i]);
+	}
+}
+
+TEST_F(ParamShmTest, Benchmark)
+{
+	const unsigned reads = 1000000;
+	struct param_shm_s *shm = param_shm_open(name, count, layout, true);
+	ASSERT_NE(nullptr, shm);
+
+	uint32_t written = 42;
+	param_shm_write(shm, 0, &written);
+
+	volatile uint32_t sink = 0;
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < reads; i++) {
+		uint32_t value;
+		bool set;
+		param_shm_read(shm, i % count, &value, &set);
+		sink = sink + value;
+	}
+
+	double shared = hrt_elapsed_time(&start) * 1000.0 / reads;
+
+	/* the same read behind a lock shared by the processes */
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutex_t lock;
+	pthread_mutex_init(&lock, &attr);
+
+	start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < reads; i++) {
+		uint32_t value;
+		bool set;
+		pthread_mutex_lock(&lock);
+		param_shm_read(shm, i % count, &value, &set);
+		pthread_mutex_unlock(&lock);
+		sink = sink + value;
+	}
+
+	warnx("read: %.1f ns, %.1f ns with a lock", shared, hrt_elapsed_time(&start) * 1000.0 / reads);
+
+	pthread_mutex_destroy(&lock);
+	pthread_mutexattr_destroy(&attr);
+	param_shm_close(shm);
+}
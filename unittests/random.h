@@ -0,0 +1,45 @@
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+ * Small deterministic xorshift generator for the tests, so failures can be
+ * reproduced from the seed on every host.
+ */
+class Random
+{
+public:
+	explicit Random(uint32_t seed) : _state(seed * 2654435761u + 1) {}
+
+	uint32_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	/* 0 ... n - 1 */
+	unsigned below(unsigned n) { return next() % n; }
+
+	/* 0 ... 1, excluding 1 */
+	double uniform() { return next() / 4294967296.0; }
+
+	/* normal distribution, zero mean and unit standard deviation */
+	double gaussian()
+	{
+		double u = uniform() + 1e-12;
+		return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * uniform());
+	}
+
+	/* bell shaped noise within +-3 sigma, with a standard deviation of sigma */
+	float noise(float sigma)
+	{
+		return ((float)uniform() + (float)uniform() + (float)uniform() - 1.5f) * 2.0f * sigma;
+	}
+
+private:
+	uint32_t _state;
+};
@@ -0,0 +1,361 @@
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <rc/rc_decode.h>
+#include <rc/st24.h>
+#include <rc/sumd.h>
+#include <rc/srxl.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * Runs the serial RC decoders over the logic analyzer captures in testdata/,
+ * cut into the reads a driver polling the UART would see.
+ */
+
+namespace
+{
+
+struct Capture {
+	std::vector<uint64_t> time;	// us
+	std::vector<uint8_t> data;
+};
+
+struct Read {
+	uint64_t now;
+	size_t offset;
+	unsigned len;
+};
+
+Capture load_capture(const char *filepath)
+{
+	Capture capture;
+	FILE *fp = fopen(filepath, "rt");
+
+	if (fp == nullptr) {
+		return capture;
+	}
+
+	// Trash the first 20 lines
+	for (unsigned i = 0; i < 20; i++) {
+		char buf[200];
+		(void)fgets(buf, sizeof(buf), fp);
+	}
+
+	double f;
+	unsigned x;
+
+	while (fscanf(fp, "%lf,%x,,", &f, &x) == 2) {
+		// some captures start at a negative time
+		capture.time.push_back((uint64_t)((f + 1.0) * 1e6));
+		capture.data.push_back(x);
+	}
+
+	fclose(fp);
+	return capture;
+}
+
+/* SRXL v1 frames, as there is no capture of it */
+Capture synthesise_srxl(unsigned frames)
+{
+	Capture capture;
+	uint64_t t = 1000000;
+
+	for (unsigned frame = 0; frame < frames; frame++) {
+		uint8_t buf[27] = {0xA1};
+
+		for (unsigned i = 0; i < 12; i++) {
+			uint16_t value = (frame * 37 + i * 300) % 4096;
+			buf[1 + 2 * i] = value >> 8;
+			buf[2 + 2 * i] = value & 0xff;
+		}
+
+		uint16_t crc = 0;
+
+		for (unsigned i = 0; i < sizeof(buf) - 2; i++) {
+			crc ^= (uint16_t)buf[i] << 8;
+
+			for (unsigned bit = 0; bit < 8; bit++) {
+				crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+			}
+		}
+
+		buf[25] = crc >> 8;
+		buf[26] = crc & 0xff;
+
+		for (unsigned i = 0; i < sizeof(buf); i++) {
+			capture.time.push_back(t);
+			capture.data.push_back(buf[i]);
+			t += 87;	// 115200 baud
+		}
+
+		t += 14000;
+	}
+
+	return capture;
+}
+
+/* what a driver reading at most max_len bytes every period us would get */
+std::vector<Read> split_reads(const Capture &capture, uint64_t period, unsigned max_len)
+{
+	std::vector<Read> reads;
+	size_t i = 0;
+	uint64_t now = capture.time.empty() ? 0 : capture.time[0];
+
+	while (i < capture.data.size()) {
+		now += period;
+		Read read = {now, i, 0};
+
+		while (i < capture.data.size() && capture.time[i] < now && read.len < max_len) {
+			i++;
+			read.len++;
+		}
+
+		if (read.len > 0) {
+			reads.push_back(read);
+		}
+	}
+
+	return reads;
+}
+
+struct Frame {
+	size_t read;
+	uint16_t num_values;
+	uint16_t values[20];
+
+	bool operator==(const Frame &other) const
+	{
+		return read == other.read && num_values == other.num_values
+		       && memcmp(values, other.values, num_values * sizeof(values[0])) == 0;
+	}
+};
+
+enum Method {
+	BYTEWISE,
+	BUFFER
+};
+
+/* run one of the decoders with a byte and a buffer interface over the reads */
+std::vector<Frame> decode(enum RC_DECODER decoder, enum Method method, const Capture &capture,
+			  const std::vector<Read> &reads, uint64_t time_offset)
+{
+	std::vector<Frame> frames;
+
+	for (size_t r = 0; r < reads.size(); r++) {
+		const uint8_t *buf = &capture.data[reads[r].offset];
+		unsigned len = reads[r].len;
+		uint64_t now = reads[r].now + time_offset;
+		Frame frame = {r, 0, {}};
+		uint8_t rssi, rx_count = 0, num_values = 0;
+		bool failsafe;
+		bool updated = false;
+
+		switch (decoder) {
+		case RC_DECODER_ST24:
+			if (method == BUFFER) {
+				updated = st24_parse(buf, len, &rssi, &rx_count, &frame.num_values, frame.values, 20);
+
+			} else {
+				for (unsigned i = 0; i < len; i++) {
+					updated |= st24_decode(buf[i], &rssi, &rx_count, &frame.num_values, frame.values, 20) == 0;
+				}
+			}
+
+			break;
+
+		case RC_DECODER_SUMD:
+			if (method == BUFFER) {
+				updated = sumd_parse(buf, len, &rssi, &rx_count, &frame.num_values, frame.values, 20);
+
+			} else {
+				for (unsigned i = 0; i < len; i++) {
+					updated |= sumd_decode(buf[i], &rssi, &rx_count, &frame.num_values, frame.values, 20) == 0;
+				}
+			}
+
+			break;
+
+		case RC_DECODER_SRXL:
+			if (method == BUFFER) {
+				updated = srxl_parse(now, buf, len, &num_values, frame.values, 20, &failsafe);
+
+			} else {
+				for (unsigned i = 0; i < len; i++) {
+					updated |= srxl_decode(now, buf[i], &num_values, frame.values, 20, &failsafe) == 0;
+				}
+			}
+
+			frame.num_values = num_values;
+			break;
+
+		default:
+			break;
+		}
+
+		if (updated) {
+			frames.push_back(frame);
+		}
+	}
+
+	/* leave the decoder out of sync, ready for the next run */
+	uint8_t flush[80] = {};
+	uint8_t rssi, rx_count = 0, num_values;
+	uint16_t channel_count, values[20];
+	bool failsafe;
+	st24_parse(flush, sizeof(flush), &rssi, &rx_count, &channel_count, values, 20);
+	sumd_parse(flush, sizeof(flush), &rssi, &rx_count, &channel_count, values, 20);
+	srxl_parse(time_offset + 10000000, flush, 1, &num_values, values, 20, &failsafe);
+
+	return frames;
+}
+
+struct Detection {
+	unsigned decoded;	// mask of decoders that decoded a frame
+	enum RC_DECODER first;	// decoder of the first frame
+	uint64_t latency;	// capture time from the first byte to the first frame
+	unsigned frames;
+};
+
+Detection detect(const Capture &capture, const std::vector<Read> &reads, unsigned decoders, uint64_t time_offset)
+{
+	Detection detection = {0, RC_DECODER_COUNT, 0, 0};
+
+	for (size_t r = 0; r < reads.size(); r++) {
+		uint16_t values[20];
+		rc_decode_s result;
+		unsigned decoded = rc_decode(reads[r].now + time_offset, &capture.data[reads[r].offset], reads[r].len,
+					     decoders, values, 20, &result);
+
+		if (decoded != 0) {
+			if (detection.frames == 0) {
+				detection.first = result.decoder;
+				detection.latency = reads[r].now - capture.time[0];
+			}
+
+			detection.decoded |= decoded;
+			detection.frames++;
+		}
+	}
+
+	return detection;
+}
+
+const struct {
+	const char *filepath;
+	enum RC_DECODER decoder;
+	unsigned port_decoders;
+} captures[] = {
+	{"testdata/st24_data.txt", RC_DECODER_ST24, RC_DECODERS_115200},
+	{"testdata/sumd_data.txt", RC_DECODER_SUMD, RC_DECODERS_115200},
+	{"testdata/dsm_x_data.txt", RC_DECODER_DSM, RC_DECODERS_115200},
+	{"testdata/sbus2_r7008SB.txt", RC_DECODER_SBUS, RC_DECODER_MASK(RC_DECODER_SBUS)},
+};
+
+/* every run gets its own time range, so the decoders see a frame gap between runs */
+uint64_t next_time_offset()
+{
+	static uint64_t offset = 0;
+	offset += 100000000;
+	return offset;
+}
+
+} // namespace
+
+TEST(RCDecodeTest, BufferMatchesBytewise)
+{
+	const struct {
+		enum RC_DECODER decoder;
+		Capture capture;
+	} runs[] = {
+		{RC_DECODER_ST24, load_capture("testdata/st24_data.txt")},
+		{RC_DECODER_SUMD, load_capture("testdata/sumd_data.txt")},
+		{RC_DECODER_SRXL, synthesise_srxl(200)},
+	};
+
+	for (unsigned i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+		ASSERT_FALSE(runs[i].capture.data.empty());
+
+		for (unsigned max_len = 1; max_len <= 64; max_len *= 4) {
+			std::vector<Read> reads = split_reads(runs[i].capture, 2000, max_len);
+			std::vector<Frame> bytewise = decode(runs[i].decoder, BYTEWISE, runs[i].capture, reads, next_time_offset());
+			std::vector<Frame> buffer = decode(runs[i].decoder, BUFFER, runs[i].capture, reads, next_time_offset());
+
+			EXPECT_FALSE(bytewise.empty()) << "decoder " << runs[i].decoder << " reads of " << max_len;
+			EXPECT_TRUE(bytewise == buffer) << "decoder " << runs[i].decoder << " reads of " << max_len;
+		}
+	}
+}
+
+TEST(RCDecodeTest, DetectsProtocol)
+{
+	for (unsigned i = 0; i < sizeof(captures) / sizeof(captures[0]); i++) {
+		Capture capture = load_capture(captures[i].filepath);
+		ASSERT_FALSE(capture.data.empty()) << captures[i].filepath;
+
+		std::vector<Read> reads = split_reads(capture, 1000, 32);
+
+		/* all decoders for the port run in parallel, the right one has to win */
+		Detection detection = detect(capture, reads, captures[i].port_decoders, next_time_offset());
+		EXPECT_EQ(captures[i].decoder, detection.first) << captures[i].filepath;
+		EXPECT_EQ(RC_DECODER_MASK(captures[i].decoder), detection.decoded) << captures[i].filepath;
+
+		warnx("%s: detected decoder %d after %llu us, %u frames", captures[i].filepath, detection.first,
+		      (unsigned long long)detection.latency, detection.frames);
+
+		/* and none of the others may take the data for their own */
+		detection = detect(capture, reads, RC_DECODERS_115200 & ~RC_DECODER_MASK(captures[i].decoder), next_time_offset());
+		EXPECT_EQ(0u, detection.decoded) << captures[i].filepath;
+	}
+}
+
+TEST(RCDecodeTest, Benchmark)
+{
+	const unsigned passes = 20;
+
+	for (unsigned i = 0; i < sizeof(captures) / sizeof(captures[0]); i++) {
+		Capture capture = load_capture(captures[i].filepath);
+		ASSERT_FALSE(capture.data.empty()) << captures[i].filepath;
+
+		std::vector<Read> reads = split_reads(capture, 1000, 32);
+		double bytes = (double)capture.data.size() * passes;
+
+		/* the decoder for the protocol on its own, then everything that shares the port */
+		double ns_per_byte[2];
+		const unsigned decoders[2] = {RC_DECODER_MASK(captures[i].decoder), RC_DECODERS_115200 | RC_DECODER_MASK(RC_DECODER_SBUS)};
+
+		for (unsigned d = 0; d < 2; d++) {
+			hrt_abstime start = hrt_absolute_time();
+
+			for (unsigned pass = 0; pass < passes; pass++) {
+				detect(capture, reads, decoders[d], next_time_offset());
+			}
+
+			ns_per_byte[d] = hrt_elapsed_time(&start) * 1000.0 / bytes;
+		}
+
+		warnx("%s: %.1f ns/byte, %.1f ns/byte with all decoders", captures[i].filepath, ns_per_byte[0], ns_per_byte[1]);
+
+		if (captures[i].decoder == RC_DECODER_ST24 || captures[i].decoder == RC_DECODER_SUMD) {
+			hrt_abstime start = hrt_absolute_time();
+
+			for (unsigned pass = 0; pass < passes; pass++) {
+				decode(captures[i].decoder, BYTEWISE, capture, reads, next_time_offset());
+			}
+
+			double bytewise = hrt_elapsed_time(&start) * 1000.0 / bytes;
+
+			start = hrt_absolute_time();
+
+			for (unsigned pass = 0; pass < passes; pass++) {
+				decode(captures[i].decoder, BUFFER, capture, reads, next_time_offset());
+			}
+
+			warnx("%s: bytewise %.1f ns/byte, buffer %.1f ns/byte", captures[i].filepath, bytewise,
+			      hrt_elapsed_time(&start) * 1000.0 / bytes);
+		}
+	}
+}
@@ -0,0 +1,265 @@
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+
+#include <systemlib/err.h>
+#include <drivers/device/ringbuffer.h>
+
+#include "random.h"
+
+#include "gtest/gtest.h"
+
+/*
+ * Runs a producer and a consumer thread against one RingBuffer and checks that
+ * every item arrives whole and in order.
+ */
+
+namespace
+{
+
+struct Item {
+	uint32_t seq;
+	uint32_t check[7];	// derived from seq, a torn copy does not match
+};
+
+Item make_item(uint32_t seq)
+{
+	Item item;
+	item.seq = seq;
+
+	for (unsigned i = 0; i < 7; i++) {
+		item.check[i] = (seq + 1) * 2654435761u ^ i;
+	}
+
+	return item;
+}
+
+bool intact(const Item &item)
+{
+	Item expected = make_item(item.seq);
+	return memcmp(&item, &expected, sizeof(item)) == 0;
+}
+
+/* with a single CPU yielding may not run the other thread, so fall back to sleeping */
+void backoff(unsigned &spins)
+{
+	if (++spins < 100) {
+		std::this_thread::yield();
+
+	} else {
+		usleep(10);
+		spins = 0;
+	}
+}
+
+enum Mode {
+	SINGLE,		// put() and get()
+	BULK,		// put_many() and get_many()
+	FORCE		// force() and get_many(), the consumer may miss items
+};
+
+struct Result {
+	uint32_t received;
+	uint32_t last;
+	bool torn;
+	bool out_of_order;
+};
+
+Result stress(enum Mode mode, unsigned depth, uint32_t items)
+{
+	ringbuffer::RingBuffer buffer(depth, sizeof(Item));
+	std::atomic<bool> done(false);
+
+	std::thread producer([&]() {
+		Random random(1);
+		Item batch[16];
+		unsigned spins = 0;
+
+		for (uint32_t seq = 0; seq < items;) {
+			switch (mode) {
+			case SINGLE: {
+					Item item = make_item(seq);
+
+					if (buffer.put(&item, sizeof(item))) {
+						seq++;
+
+					} else {
+						backoff(spins);
+					}
+
+					break;
+				}
+
+			case BULK: {
+					unsigned n = 1 + random.below(16);
+
+					if (n > items - seq) {
+						n = items - seq;
+					}
+
+					for (unsigned i = 0; i < n; i++) {
+						batch[i] = make_item(seq + i);
+					}
+
+					n = buffer.put_many(batch, n);
+
+					if (n == 0) {
+						backoff(spins);
+					}
+
+					seq += n;
+					break;
+				}
+
+			case FORCE: {
+					Item item = make_item(seq++);
+					buffer.force(&item, sizeof(item));
+
+					/* let the consumer in now and then, it would see nothing but the end otherwise */
+					if ((seq % 64) == 0) {
+						usleep(1);
+					}
+
+					break;
+				}
+			}
+		}
+
+		done = true;
+	});
+
+	Result result = {0, 0, false, false};
+	Random random(2);
+	Item batch[16];
+	bool first = true;
+	unsigned spins = 0;
+
+	for (;;) {
+		/* read done before draining, so nothing put before it is missed */
+		bool finished = done;
+		unsigned n;
+
+		if (mode == SINGLE) {
+			n = buffer.get(&batch[0], sizeof(batch[0])) ? 1 : 0;
+
+		} else {
+			n = buffer.get_many(batch, 1 + random.below(16));
+		}
+
+		for (unsigned i = 0; i < n; i++) {
+			if (!intact(batch[i])) {
+				result.torn = true;
+			}
+
+			/* every item in order, or at least increasing if the producer may discard */
+			if (!first && ((mode == FORCE) ? batch[i].seq <= result.last : batch[i].seq != result.last + 1)) {
+				result.out_of_order = true;
+			}
+
+			first = false;
+			result.last = batch[i].seq;
+			result.received++;
+		}
+
+		if (n == 0) {
+			if (finished) {
+				break;
+			}
+
+			backoff(spins);
+		}
+	}
+
+	producer.join();
+	return result;
+}
+
+} // namespace
+
+TEST(RingBufferTest, Semantics)
+{
+	ringbuffer::RingBuffer buffer(5, sizeof(Item));
+	Item in[8];
+	Item out[8];
+
+	for (unsigned i = 0; i < 8; i++) {
+		in[i] = make_item(i);
+	}
+
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(0u, buffer.get_many(out, 8));
+
+	/* wrap around the end of the storage a few times */
+	for (unsigned round = 0; round < 7; round++) {
+		EXPECT_EQ(3u, buffer.put_many(in, 3));
+		EXPECT_EQ(3u, buffer.count());
+		EXPECT_EQ(2u, buffer.get_many(out, 2));
+		EXPECT_EQ(0u, out[0].seq);
+		EXPECT_EQ(1u, out[1].seq);
+		EXPECT_TRUE(buffer.get(&out[0], sizeof(out[0])));
+		EXPECT_EQ(2u, out[0].seq);
+		EXPECT_TRUE(buffer.empty());
+	}
+
+	/* only what fits is put */
+	EXPECT_EQ(5u, buffer.put_many(in, 8));
+	EXPECT_TRUE(buffer.full());
+	EXPECT_EQ(0u, buffer.put_many(in, 1));
+	EXPECT_FALSE(buffer.put(&in[0], sizeof(in[0])));
+
+	/* force discards the oldest */
+	EXPECT_TRUE(buffer.force(&in[7], sizeof(in[7])));
+	EXPECT_EQ(5u, buffer.get_many(out, 8));
+	EXPECT_EQ(1u, out[0].seq);
+	EXPECT_EQ(7u, out[4].seq);
+
+	for (unsigned i = 0; i < 5; i++) {
+		EXPECT_TRUE(intact(out[i]));
+	}
+
+	/* a single slot buffer emptied by force() */
+	ringbuffer::RingBuffer one(1, sizeof(Item));
+	EXPECT_FALSE(one.force(&in[0], sizeof(in[0])));
+	EXPECT_TRUE(one.force(&in[1], sizeof(in[1])));
+	EXPECT_TRUE(one.get(&out[0], sizeof(out[0])));
+	EXPECT_EQ(1u, out[0].seq);
+	EXPECT_FALSE(one.get(&out[0], sizeof(out[0])));
+}
+
+TEST(RingBufferTest, StressSingle)
+{
+	const uint32_t items = 200000;
+	Result result = stress(SINGLE, 4, items);
+
+	EXPECT_EQ(items, result.received);
+	EXPECT_EQ(items - 1, result.last);
+	EXPECT_FALSE(result.torn);
+	EXPECT_FALSE(result.out_of_order);
+}
+
+TEST(RingBufferTest, StressBulk)
+{
+	const uint32_t items = 200000;
+	Result result = stress(BULK, 24, items);
+
+	EXPECT_EQ(items, result.received);
+	EXPECT_EQ(items - 1, result.last);
+	EXPECT_FALSE(result.torn);
+	EXPECT_FALSE(result.out_of_order);
+}
+
+TEST(RingBufferTest, StressForce)
+{
+	const uint32_t items = 200000;
+	Result result = stress(FORCE, 2, items);
+
+	/* the consumer may miss items, but never sees a partial or old one */
+	EXPECT_GT(result.received, 0u);
+	EXPECT_EQ(items - 1, result.last);
+	EXPECT_FALSE(result.torn);
+	EXPECT_FALSE(result.out_of_order);
+
+	warnx("force: received %u of %u items", result.received, items);
+}
@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/satellite_info.h>
+
+#include <drivers/gps/ubx.h>
+
+#include "random.h"
+
+#include "gtest/gtest.h"
+
+/*
+ * Replays a UBX stream through the block parser and compares every step with
+ * the byte-by-byte state machine. The stream is synthesised unless
+ * UBX_REPLAY_FILE names a recorded receiver log.
+ */
+
+namespace
+{
+
+void append_message(std::vector<uint8_t> &stream, uint16_t msg, const void *payload, uint16_t length)
+{
+	const uint8_t header[] = {UBX_SYNC1, UBX_SYNC2, (uint8_t)(msg & 0xff), (uint8_t)(msg >> 8),
+				  (uint8_t)(length & 0xff), (uint8_t)(length >> 8)
+				 };
+	size_t start = stream.size();
+
+	stream.insert(stream.end(), header, header + sizeof(header));
+	stream.insert(stream.end(), (const uint8_t *)payload, (const uint8_t *)payload + length);
+
+	uint8_t ck_a = 0;
+	uint8_t ck_b = 0;
+
+	for (size_t i = start + 2; i < stream.size(); i++) {
+		ck_a += stream[i];
+		ck_b += ck_a;
+	}
+
+	stream.push_back(ck_a);
+	stream.push_back(ck_b);
+}
+
+/* 10 Hz NAV-PVT with satellite info, raw measurements the driver disables, and NMEA noise */
+std::vector<uint8_t> synthesise_stream(unsigned epochs)
+{
+	std::vector<uint8_t> stream;
+	Random random(1);
+
+	for (unsigned epoch = 0; epoch < epochs; epoch++) {
+		ubx_payload_rx_nav_pvt_t pvt = {};
+		pvt.iTOW = 100 * epoch;
+		pvt.fixType = 3;
+		pvt.flags = UBX_RX_NAV_PVT_FLAGS_GNSSFIXOK;
+		pvt.numSV = 8 + epoch % 7;
+		pvt.lat = 473977420 + epoch * 13;
+		pvt.lon = 85455940 - epoch * 7;
+		pvt.hMSL = 488000 + epoch;
+		pvt.hAcc = 900 + epoch % 50;
+		pvt.velN = epoch % 300;
+		pvt.velE = -(int32_t)(epoch % 200);
+		pvt.gSpeed = 400;
+		append_message(stream, UBX_MSG_NAV_PVT, &pvt, sizeof(pvt));
+
+		/* RXM-RAWX, with payloads that look like sync now and then */
+		uint8_t rawx[16 + 32 * 12];
+
+		for (unsigned i = 0; i < sizeof(rawx); i++) {
+			rawx[i] = (random.below(40) == 0) ? UBX_SYNC1 : (uint8_t)random.next();
+		}
+
+		append_message(stream, 0x1502, rawx, sizeof(rawx));
+
+		if (epoch % 10 == 0) {
+			uint8_t svinfo[sizeof(ubx_payload_rx_nav_svinfo_part1_t) + 24 * sizeof(ubx_payload_rx_nav_svinfo_part2_t)] = {};
+			ubx_payload_rx_nav_svinfo_part1_t *part1 = (ubx_payload_rx_nav_svinfo_part1_t *)svinfo;
+			part1->iTOW = pvt.iTOW;
+			part1->numCh = 24;
+
+			for (unsigned sv = 0; sv < 24; sv++) {
+				ubx_payload_rx_nav_svinfo_part2_t *part2 = (ubx_payload_rx_nav_svinfo_part2_t *)
+						(svinfo + sizeof(*part1) + sv * sizeof(ubx_payload_rx_nav_svinfo_part2_t));
+				part2->chn = sv;
+				part2->svid = 1 + (sv + epoch) % 32;
+				part2->flags = sv & 1;
+				part2->cno = 20 + sv;
+				part2->elev = sv * 3;
+				part2->azim = sv * 15;
+			}
+
+			append_message(stream, UBX_MSG_NAV_SVINFO, svinfo, sizeof(svinfo));
+
+			ubx_payload_rx_nav_dop_t dop = {};
+			dop.iTOW = pvt.iTOW;
+			dop.hDOP = 90 + epoch % 10;
+			dop.vDOP = 120;
+			append_message(stream, UBX_MSG_NAV_DOP, &dop, sizeof(dop));
+
+			const char nmea[] = "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n";
+			stream.insert(stream.end(), nmea, nmea + sizeof(nmea) - 1);
+		}
+	}
+
+	return stream;
+}
+
+std::vector<uint8_t> load_stream()
+{
+	const char *path = getenv("UBX_REPLAY_FILE");
+
+	if (path == nullptr) {
+		return synthesise_stream(600);
+	}
+
+	std::vector<uint8_t> stream;
+	FILE *fp = fopen(path, "rb");
+
+	if (fp == nullptr) {
+		warnx("cannot open %s", path);
+		return stream;
+	}
+
+	uint8_t buf[4096];
+	size_t n;
+
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+		stream.insert(stream.end(), buf, buf + n);
+	}
+
+	fclose(fp);
+	warnx("replaying %u bytes from %s", (unsigned)stream.size(), path);
+	return stream;
+}
+
+struct Decoder {
+	vehicle_gps_position_s gps_position = {};
+	satellite_info_s satellite_info = {};
+	UBX ubx;
+
+	explicit Decoder(bool use_nav_pvt) : ubx(-1, &gps_position, &satellite_info)
+	{
+		ubx.set_replay_mode(use_nav_pvt);
+	}
+};
+
+/* everything the decoder publishes except the timestamps */
+void expect_same_output(const Decoder &a, const Decoder &b, size_t offset)
+{
+	EXPECT_EQ(a.gps_position.lat, b.gps_position.lat) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.lon, b.gps_position.lon) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.alt, b.gps_position.alt) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.fix_type, b.gps_position.fix_type) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.satellites_used, b.gps_position.satellites_used) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.eph, b.gps_position.eph) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.vel_n_m_s, b.gps_position.vel_n_m_s) << "at byte " << offset;
+	EXPECT_EQ(a.gps_position.hdop, b.gps_position.hdop) << "at byte " << offset;
+	EXPECT_EQ(a.satellite_info.count, b.satellite_info.count) << "at byte " << offset;
+	EXPECT_EQ(0, memcmp(a.satellite_info.svid, b.satellite_info.svid, sizeof(a.satellite_info.svid)))
+			<< "at byte " << offset;
+	EXPECT_EQ(0, memcmp(a.satellite_info.snr, b.satellite_info.snr, sizeof(a.satellite_info.snr)))
+			<< "at byte " << offset;
+}
+
+/* feed the stream in random chunks, returns the number of chunks that completed a message */
+unsigned compare_parsers(const std::vector<uint8_t> &stream, bool use_nav_pvt, uint32_t seed)
+{
+	Decoder bytewise(use_nav_pvt);
+	Decoder block(use_nav_pvt);
+	Random random(seed);
+	unsigned handled_chunks = 0;
+
+	for (size_t offset = 0; offset < stream.size();) {
+		size_t len = 1 + random.below(300);
+
+		if (len > stream.size() - offset) {
+			len = stream.size() - offset;
+		}
+
+		int expected = 0;
+
+		for (size_t i = 0; i < len; i++) {
+			expected |= bytewise.ubx.parse_char(stream[offset + i]);
+		}
+
+		int handled = block.ubx.parse(&stream[offset], len);
+		offset += len;
+
+		EXPECT_EQ(expected, handled) << "at byte " << offset;
+		expect_same_output(bytewise, block, offset);
+
+		if (handled != 0) {
+			handled_chunks++;
+		}
+
+		if (::testing::Test::HasFailure()) {
+			break;
+		}
+	}
+
+	return handled_chunks;
+}
+
+} // namespace
+
+TEST(UBXTest, BlockParserMatchesBytewise)
+{
+	std::vector<uint8_t> stream = load_stream();
+	ASSERT_FALSE(stream.empty());
+
+	EXPECT_GT(compare_parsers(stream, true, 1), 0u);
+	compare_parsers(stream, false, 2);
+}
+
+TEST(UBXTest, Fuzz)
+{
+	std::vector<uint8_t> original = load_stream();
+	ASSERT_FALSE(original.empty());
+
+	for (uint32_t seed = 0; seed < 20 && !HasFailure(); seed++) {
+		std::vector<uint8_t> stream = original;
+		Random random(seed + 100);
+
+		/* flip, drop and duplicate bytes to exercise resync and the length checks */
+		for (unsigned i = 0; i < stream.size() / 500; i++) {
+			size_t at = random.below(stream.size() - 1);
+
+			switch (random.below(3)) {
+			case 0:
+				stream[at] ^= 1 << random.below(8);
+				break;
+
+			case 1:
+				stream.erase(stream.begin() + at);
+				break;
+
+			default:
+				stream.insert(stream.begin() + at, stream[at + 1]);
+				break;
+			}
+		}
+
+		compare_parsers(stream, seed & 1, seed);
+	}
+}
+
+TEST(UBXTest, Benchmark)
+{
+	std::vector<uint8_t> stream = load_stream();
+	ASSERT_FALSE(stream.empty());
+
+	const unsigned passes = 20;
+	const size_t chunk = 128;	// UBX::receive() read size
+
+	Decoder bytewise(true);
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		for (size_t i = 0; i < stream.size(); i++) {
+			bytewise.ubx.parse_char(stream[i]);
+		}
+	}
+
+	hrt_abstime bytewise_time = hrt_elapsed_time(&start);
+
+	Decoder block(true);
+	start = hrt_absolute_time();
+
+	for (unsigned pass = 0; pass < passes; pass++) {
+		for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+			size_t len = (stream.size() - offset < chunk) ? stream.size() - offset : chunk;
+			block.ubx.parse(&stream[offset], len);
+		}
+	}
+
+	hrt_abstime block_time = hrt_elapsed_time(&start);
+
+	warnx("%u bytes x %u: bytewise %llu us, block %llu us", (unsigned)stream.size(), passes,
+	      (unsigned long long)bytewise_time, (unsigned long long)block_time);
+}